@@ -0,0 +1,482 @@
+#include "BatchMath.h"
+#include "pluginconstants.h"
+#include "synthfunctions.h"
+
+//	the project builds with /fp:fast; the kernels must not be contracted
+//	or reassociated, or the paths stop matching
+#if defined _MSC_VER
+#pragma float_control(precise, on, push)
+#endif
+
+//	float versions of the scalar constants
+static const float fSineB = (float)B;
+static const float fSineC = (float)C;
+static const float fSineP = (float)P;
+static const float fLog2Atanh = 2.8853900817779268f;	//	2/ln2
+static const float fConvexScale = (float)(5.0 / 12.0 * 0.30102999566398120);	//	5/12 * log10(2)
+static const float fConvexLimit = (float)CONVEX_LIMIT;
+static const float fTanhTableMax = 4095.0f;
+
+//------------------------------------------------------------------------
+//	scalar reference; the SIMD kernels below repeat these, operation for operation
+//------------------------------------------------------------------------
+static inline float parabolicSineRef(float x) {
+	float y = fSineB * x + fSineC * x * fabsf(x);
+	return fSineP * (y * fabsf(y) - y) + y;
+}
+
+//	x > 0; mantissa centred on 1.0, then an atanh series
+static inline float log2Ref(float x) {
+	union { float f; int i; } bits = { x };
+	int nExponent = ((bits.i >> 23) & 0xFF) - 127;
+	bits.i = (bits.i & 0x007FFFFF) | 0x3F800000;
+
+	float m = bits.f;
+	bool bHigh = m > 1.41421356f;
+	m = bHigh ? m * 0.5f : m;
+	float e = (float)(nExponent + (bHigh ? 1 : 0));
+
+	float s = (m - 1.0f) / (m + 1.0f);
+	float s2 = s * s;
+	return e + fLog2Atanh * s * (1.0f + s2 * (1.0f / 3.0f + s2 * (1.0f / 5.0f + s2 * (1.0f / 7.0f))));
+}
+
+static inline float convexRef(float x) {
+	float y = 1.0f + fConvexScale * log2Ref(x);
+	return x <= fConvexLimit ? 0.0f : y;
+}
+
+static inline float concaveInvertedRef(float x) {
+	float y = -fConvexScale * log2Ref(x);
+	return x <= fConvexLimit ? 1.0f : y;
+}
+
+//	the clamps order NaN the way _mm_max_ps/_mm_min_ps do: NaN -> entry 0
+static inline int tanhIndexRef(float x) {
+	float u = 0.5f * x + 0.5f;
+	u = u > 0.0f ? u : 0.0f;
+	u = u < 1.0f ? u : 1.0f;
+	return (int)(u * fTanhTableMax);
+}
+
+static inline float tanhRef(float x) {
+	float y = (float)dTanhTable[tanhIndexRef(x)];
+	y = x == 0.0f ? 0.0f : y;
+	y = x > 1.0f ? 1.0f : y;
+	return x < -1.0f ? -1.0f : y;
+}
+
+static inline float linTerpRef(float y1, float y2, float x) {
+	return x * y2 + (1.0f - x) * y1;
+}
+
+static void parabolicSineScalar(const float* pX, float* pY, int nCount) {
+	for (int i = 0; i < nCount; i++) {
+		pY[i] = parabolicSineRef(pX[i]);
+	}
+}
+
+static void unipolarToBipolarScalar(const float* pX, float* pY, int nCount) {
+	for (int i = 0; i < nCount; i++) {
+		pY[i] = 2.0f * pX[i] - 1.0f;
+	}
+}
+
+static void bipolarToUnipolarScalar(const float* pX, float* pY, int nCount) {
+	for (int i = 0; i < nCount; i++) {
+		pY[i] = 0.5f * pX[i] + 0.5f;
+	}
+}
+
+static void convexScalar(const float* pX, float* pY, int nCount) {
+	for (int i = 0; i < nCount; i++) {
+		pY[i] = convexRef(pX[i]);
+	}
+}
+
+static void concaveInvertedScalar(const float* pX, float* pY, int nCount) {
+	for (int i = 0; i < nCount; i++) {
+		pY[i] = concaveInvertedRef(pX[i]);
+	}
+}
+
+static void tanhScalar(const float* pX, float* pY, int nCount) {
+	for (int i = 0; i < nCount; i++) {
+		pY[i] = tanhRef(pX[i]);
+	}
+}
+
+static void linTerpScalar(const float* pY1, const float* pY2, const float* pFrac, float* pY, int nCount) {
+	for (int i = 0; i < nCount; i++) {
+		pY[i] = linTerpRef(pY1[i], pY2[i], pFrac[i]);
+	}
+}
+
+//	(A + C) + (B + D), the order of the SSE2 horizontal add
+static void vectorMixScalar(const float* pSources, const float* pWeights, const float* pDeltas, float* pY, int nStride, int nCount) {
+	float fWA = pWeights[0];
+	float fWB = pWeights[1];
+	float fWC = pWeights[2];
+	float fWD = pWeights[3];
+	for (int i = 0; i < nCount; i++) {
+		fWA += pDeltas[0];
+		fWB += pDeltas[1];
+		fWC += pDeltas[2];
+		fWD += pDeltas[3];
+		const float* pS = pSources + i * 4;
+		float fA = pS[0] * fWA;
+		float fB = pS[1] * fWB;
+		float fC = pS[2] * fWC;
+		float fD = pS[3] * fWD;
+		pY[i * nStride] = (fA + fC) + (fB + fD);
+	}
+}
+
+#if BATCH_MATH_X86
+//------------------------------------------------------------------------
+//	SSE2, 4 wide
+//------------------------------------------------------------------------
+BATCH_TARGET_SSE2 static inline __m128 absSSE2(__m128 v) {
+	return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+}
+
+BATCH_TARGET_SSE2 static inline __m128 selectSSE2(__m128 vMask, __m128 vTrue, __m128 vFalse) {
+	return _mm_or_ps(_mm_and_ps(vMask, vTrue), _mm_andnot_ps(vMask, vFalse));
+}
+
+BATCH_TARGET_SSE2 static inline __m128 log2SSE2(__m128 x) {
+	__m128i vBits = _mm_castps_si128(x);
+	__m128i vExponent = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(vBits, 23), _mm_set1_epi32(0xFF)), _mm_set1_epi32(127));
+	__m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(vBits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+
+	__m128 vHigh = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356f));
+	m = selectSSE2(vHigh, _mm_mul_ps(m, _mm_set1_ps(0.5f)), m);
+	__m128 e = _mm_cvtepi32_ps(_mm_add_epi32(vExponent, _mm_and_si128(_mm_castps_si128(vHigh), _mm_set1_epi32(1))));
+
+	__m128 s = _mm_div_ps(_mm_sub_ps(m, _mm_set1_ps(1.0f)), _mm_add_ps(m, _mm_set1_ps(1.0f)));
+	__m128 s2 = _mm_mul_ps(s, s);
+	__m128 vPoly = _mm_add_ps(_mm_set1_ps(1.0f / 5.0f), _mm_mul_ps(s2, _mm_set1_ps(1.0f / 7.0f)));
+	vPoly = _mm_add_ps(_mm_set1_ps(1.0f / 3.0f), _mm_mul_ps(s2, vPoly));
+	vPoly = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(s2, vPoly));
+	return _mm_add_ps(e, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(fLog2Atanh), s), vPoly));
+}
+
+BATCH_TARGET_SSE2 static void parabolicSineSSE2(const float* pX, float* pY, int nCount) {
+	const __m128 vB = _mm_set1_ps(fSineB);
+	const __m128 vC = _mm_set1_ps(fSineC);
+	const __m128 vP = _mm_set1_ps(fSineP);
+	int i = 0;
+
+	for (; i + 4 <= nCount; i += 4) {
+		__m128 x = _mm_loadu_ps(pX + i);
+		__m128 y = _mm_add_ps(_mm_mul_ps(vB, x), _mm_mul_ps(_mm_mul_ps(vC, x), absSSE2(x)));
+		y = _mm_add_ps(_mm_mul_ps(vP, _mm_sub_ps(_mm_mul_ps(y, absSSE2(y)), y)), y);
+		_mm_storeu_ps(pY + i, y);
+	}
+	parabolicSineScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_SSE2 static void unipolarToBipolarSSE2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 4 <= nCount; i += 4) {
+		_mm_storeu_ps(pY + i, _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.0f), _mm_loadu_ps(pX + i)), _mm_set1_ps(1.0f)));
+	}
+	unipolarToBipolarScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_SSE2 static void bipolarToUnipolarSSE2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 4 <= nCount; i += 4) {
+		_mm_storeu_ps(pY + i, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.5f), _mm_loadu_ps(pX + i)), _mm_set1_ps(0.5f)));
+	}
+	bipolarToUnipolarScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_SSE2 static void convexSSE2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 4 <= nCount; i += 4) {
+		__m128 x = _mm_loadu_ps(pX + i);
+		__m128 y = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(fConvexScale), log2SSE2(x)));
+		_mm_storeu_ps(pY + i, selectSSE2(_mm_cmple_ps(x, _mm_set1_ps(fConvexLimit)), _mm_setzero_ps(), y));
+	}
+	convexScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_SSE2 static void concaveInvertedSSE2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 4 <= nCount; i += 4) {
+		__m128 x = _mm_loadu_ps(pX + i);
+		__m128 y = _mm_mul_ps(_mm_set1_ps(-fConvexScale), log2SSE2(x));
+		_mm_storeu_ps(pY + i, selectSSE2(_mm_cmple_ps(x, _mm_set1_ps(fConvexLimit)), _mm_set1_ps(1.0f), y));
+	}
+	concaveInvertedScalar(pX + i, pY + i, nCount - i);
+}
+
+//	no gather in SSE2; the index math is vectorized, the loads are not
+BATCH_TARGET_SSE2 static void tanhSSE2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 4 <= nCount; i += 4) {
+		__m128 x = _mm_loadu_ps(pX + i);
+		__m128 u = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), _mm_set1_ps(0.5f));
+		u = _mm_min_ps(_mm_max_ps(u, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+
+		int nIndex[4];
+		_mm_storeu_si128((__m128i*)nIndex, _mm_cvttps_epi32(_mm_mul_ps(u, _mm_set1_ps(fTanhTableMax))));
+		__m128 y = _mm_setr_ps((float)dTanhTable[nIndex[0]], (float)dTanhTable[nIndex[1]],
+			(float)dTanhTable[nIndex[2]], (float)dTanhTable[nIndex[3]]);
+
+		y = selectSSE2(_mm_cmpeq_ps(x, _mm_setzero_ps()), _mm_setzero_ps(), y);
+		y = selectSSE2(_mm_cmpgt_ps(x, _mm_set1_ps(1.0f)), _mm_set1_ps(1.0f), y);
+		y = selectSSE2(_mm_cmplt_ps(x, _mm_set1_ps(-1.0f)), _mm_set1_ps(-1.0f), y);
+		_mm_storeu_ps(pY + i, y);
+	}
+	tanhScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_SSE2 static void linTerpSSE2(const float* pY1, const float* pY2, const float* pFrac, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 4 <= nCount; i += 4) {
+		__m128 x = _mm_loadu_ps(pFrac + i);
+		__m128 y = _mm_add_ps(_mm_mul_ps(x, _mm_loadu_ps(pY2 + i)), _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x), _mm_loadu_ps(pY1 + i)));
+		_mm_storeu_ps(pY + i, y);
+	}
+	linTerpScalar(pY1 + i, pY2 + i, pFrac + i, pY + i, nCount - i);
+}
+
+//	one sample (the four sources) per register; AVX2 uses this one too
+BATCH_TARGET_SSE2 static void vectorMixSSE2(const float* pSources, const float* pWeights, const float* pDeltas, float* pY, int nStride, int nCount) {
+	__m128 vW = _mm_loadu_ps(pWeights);
+	__m128 vD = _mm_loadu_ps(pDeltas);
+	for (int i = 0; i < nCount; i++) {
+		vW = _mm_add_ps(vW, vD);
+		__m128 v = _mm_mul_ps(_mm_loadu_ps(pSources + i * 4), vW);
+		v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+		v = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+		pY[i * nStride] = _mm_cvtss_f32(v);
+	}
+}
+
+//------------------------------------------------------------------------
+//	AVX2, 8 wide
+//------------------------------------------------------------------------
+BATCH_TARGET_AVX2 static inline __m256 absAVX2(__m256 v) {
+	return _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF)));
+}
+
+BATCH_TARGET_AVX2 static inline __m256 log2AVX2(__m256 x) {
+	__m256i vBits = _mm256_castps_si256(x);
+	__m256i vExponent = _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(vBits, 23), _mm256_set1_epi32(0xFF)), _mm256_set1_epi32(127));
+	__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(vBits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+
+	__m256 vHigh = _mm256_cmp_ps(m, _mm256_set1_ps(1.41421356f), _CMP_GT_OQ);
+	m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), vHigh);
+	__m256 e = _mm256_cvtepi32_ps(_mm256_add_epi32(vExponent, _mm256_and_si256(_mm256_castps_si256(vHigh), _mm256_set1_epi32(1))));
+
+	__m256 s = _mm256_div_ps(_mm256_sub_ps(m, _mm256_set1_ps(1.0f)), _mm256_add_ps(m, _mm256_set1_ps(1.0f)));
+	__m256 s2 = _mm256_mul_ps(s, s);
+	__m256 vPoly = _mm256_add_ps(_mm256_set1_ps(1.0f / 5.0f), _mm256_mul_ps(s2, _mm256_set1_ps(1.0f / 7.0f)));
+	vPoly = _mm256_add_ps(_mm256_set1_ps(1.0f / 3.0f), _mm256_mul_ps(s2, vPoly));
+	vPoly = _mm256_add_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(s2, vPoly));
+	return _mm256_add_ps(e, _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(fLog2Atanh), s), vPoly));
+}
+
+BATCH_TARGET_AVX2 static void parabolicSineAVX2(const float* pX, float* pY, int nCount) {
+	const __m256 vB = _mm256_set1_ps(fSineB);
+	const __m256 vC = _mm256_set1_ps(fSineC);
+	const __m256 vP = _mm256_set1_ps(fSineP);
+	int i = 0;
+
+	for (; i + 8 <= nCount; i += 8) {
+		__m256 x = _mm256_loadu_ps(pX + i);
+		__m256 y = _mm256_add_ps(_mm256_mul_ps(vB, x), _mm256_mul_ps(_mm256_mul_ps(vC, x), absAVX2(x)));
+		y = _mm256_add_ps(_mm256_mul_ps(vP, _mm256_sub_ps(_mm256_mul_ps(y, absAVX2(y)), y)), y);
+		_mm256_storeu_ps(pY + i, y);
+	}
+	parabolicSineScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_AVX2 static void unipolarToBipolarAVX2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 8 <= nCount; i += 8) {
+		_mm256_storeu_ps(pY + i, _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), _mm256_loadu_ps(pX + i)), _mm256_set1_ps(1.0f)));
+	}
+	unipolarToBipolarScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_AVX2 static void bipolarToUnipolarAVX2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 8 <= nCount; i += 8) {
+		_mm256_storeu_ps(pY + i, _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), _mm256_loadu_ps(pX + i)), _mm256_set1_ps(0.5f)));
+	}
+	bipolarToUnipolarScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_AVX2 static void convexAVX2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 8 <= nCount; i += 8) {
+		__m256 x = _mm256_loadu_ps(pX + i);
+		__m256 y = _mm256_add_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(fConvexScale), log2AVX2(x)));
+		_mm256_storeu_ps(pY + i, _mm256_blendv_ps(y, _mm256_setzero_ps(), _mm256_cmp_ps(x, _mm256_set1_ps(fConvexLimit), _CMP_LE_OQ)));
+	}
+	convexScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_AVX2 static void concaveInvertedAVX2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 8 <= nCount; i += 8) {
+		__m256 x = _mm256_loadu_ps(pX + i);
+		__m256 y = _mm256_mul_ps(_mm256_set1_ps(-fConvexScale), log2AVX2(x));
+		_mm256_storeu_ps(pY + i, _mm256_blendv_ps(y, _mm256_set1_ps(1.0f), _mm256_cmp_ps(x, _mm256_set1_ps(fConvexLimit), _CMP_LE_OQ)));
+	}
+	concaveInvertedScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_AVX2 static void tanhAVX2(const float* pX, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 8 <= nCount; i += 8) {
+		__m256 x = _mm256_loadu_ps(pX + i);
+		__m256 u = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), _mm256_set1_ps(0.5f));
+		u = _mm256_min_ps(_mm256_max_ps(u, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+		__m256i vIndex = _mm256_cvttps_epi32(_mm256_mul_ps(u, _mm256_set1_ps(fTanhTableMax)));
+
+		//	the table is double: two 4-wide gathers
+		__m128 yLow = _mm256_cvtpd_ps(_mm256_i32gather_pd(dTanhTable, _mm256_castsi256_si128(vIndex), 8));
+		__m128 yHigh = _mm256_cvtpd_ps(_mm256_i32gather_pd(dTanhTable, _mm256_extracti128_si256(vIndex, 1), 8));
+		__m256 y = _mm256_insertf128_ps(_mm256_castps128_ps256(yLow), yHigh, 1);
+
+		y = _mm256_blendv_ps(y, _mm256_setzero_ps(), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_EQ_OQ));
+		y = _mm256_blendv_ps(y, _mm256_set1_ps(1.0f), _mm256_cmp_ps(x, _mm256_set1_ps(1.0f), _CMP_GT_OQ));
+		y = _mm256_blendv_ps(y, _mm256_set1_ps(-1.0f), _mm256_cmp_ps(x, _mm256_set1_ps(-1.0f), _CMP_LT_OQ));
+		_mm256_storeu_ps(pY + i, y);
+	}
+	tanhScalar(pX + i, pY + i, nCount - i);
+}
+
+BATCH_TARGET_AVX2 static void linTerpAVX2(const float* pY1, const float* pY2, const float* pFrac, float* pY, int nCount) {
+	int i = 0;
+	for (; i + 8 <= nCount; i += 8) {
+		__m256 x = _mm256_loadu_ps(pFrac + i);
+		__m256 y = _mm256_add_ps(_mm256_mul_ps(x, _mm256_loadu_ps(pY2 + i)), _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), x), _mm256_loadu_ps(pY1 + i)));
+		_mm256_storeu_ps(pY + i, y);
+	}
+	linTerpScalar(pY1 + i, pY2 + i, pFrac + i, pY + i, nCount - i);
+}
+#endif // BATCH_MATH_X86
+
+#if defined _MSC_VER
+#pragma float_control(pop)
+#endif
+
+//------------------------------------------------------------------------
+//	dispatch
+//------------------------------------------------------------------------
+typedef void (*BatchUnaryKernel)(const float*, float*, int);
+typedef void (*BatchLinTerpKernel)(const float*, const float*, const float*, float*, int);
+typedef void (*BatchVectorMixKernel)(const float*, const float*, const float*, float*, int, int);
+
+struct BatchMathKernels {
+	BatchUnaryKernel parabolicSine;
+	BatchUnaryKernel unipolarToBipolar;
+	BatchUnaryKernel bipolarToUnipolar;
+	BatchUnaryKernel convexTransform;
+	BatchUnaryKernel concaveInvertedTransform;
+	BatchUnaryKernel tanhTable;
+	BatchLinTerpKernel linTerp;
+	BatchVectorMixKernel vectorMix;
+};
+
+static const BatchMathKernels batchKernels[] = {
+	{ parabolicSineScalar, unipolarToBipolarScalar, bipolarToUnipolarScalar, convexScalar, concaveInvertedScalar, tanhScalar, linTerpScalar, vectorMixScalar },
+#if BATCH_MATH_X86
+	{ parabolicSineSSE2, unipolarToBipolarSSE2, bipolarToUnipolarSSE2, convexSSE2, concaveInvertedSSE2, tanhSSE2, linTerpSSE2, vectorMixSSE2 },
+	{ parabolicSineAVX2, unipolarToBipolarAVX2, bipolarToUnipolarAVX2, convexAVX2, concaveInvertedAVX2, tanhAVX2, linTerpAVX2, vectorMixSSE2 },
+#endif
+};
+
+//	CPUID, and XGETBV for the OS saving the YMM registers
+static int detectBatchMathISA() {
+#if BATCH_MATH_X86 && defined _MSC_VER
+	int nInfo[4];
+	__cpuid(nInfo, 0);
+	int nMaxLeaf = nInfo[0];
+
+	__cpuid(nInfo, 1);
+	bool bSSE2 = (nInfo[3] & (1 << 26)) != 0;
+	bool bOSXSAVE = (nInfo[2] & (1 << 27)) != 0;
+	bool bAVX = (nInfo[2] & (1 << 28)) != 0;
+
+	bool bAVX2 = false;
+	if (nMaxLeaf >= 7 && bOSXSAVE && bAVX && (_xgetbv(0) & 0x6) == 0x6) {
+		__cpuidex(nInfo, 7, 0);
+		bAVX2 = (nInfo[1] & (1 << 5)) != 0;
+	}
+
+	return bAVX2 ? BATCH_MATH_AVX2 : (bSSE2 ? BATCH_MATH_SSE2 : BATCH_MATH_SCALAR);
+#elif BATCH_MATH_X86
+	//	these check the OS side as well
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return BATCH_MATH_AVX2;
+	}
+	return __builtin_cpu_supports("sse2") ? BATCH_MATH_SSE2 : BATCH_MATH_SCALAR;
+#else
+	return BATCH_MATH_SCALAR;
+#endif
+}
+
+static int getBestBatchMathISA() {
+	static const int nBestISA = detectBatchMathISA();
+	return nBestISA;
+}
+
+static const BatchMathKernels* pBatchKernels = 0;
+
+static inline const BatchMathKernels* getBatchKernels() {
+	if (!pBatchKernels) {
+		pBatchKernels = &batchKernels[getBestBatchMathISA()];
+	}
+	return pBatchKernels;
+}
+
+int getBatchMathISA() {
+	return (int)(getBatchKernels() - batchKernels);
+}
+
+int setBatchMathISA(int nISA) {
+	int nBestISA = getBestBatchMathISA();
+	nISA = nISA < BATCH_MATH_SCALAR ? BATCH_MATH_SCALAR : (nISA > nBestISA ? nBestISA : nISA);
+	pBatchKernels = &batchKernels[nISA];
+	return nISA;
+}
+
+void parabolicSine(const float* pX, float* pY, int nCount) {
+	getBatchKernels()->parabolicSine(pX, pY, nCount);
+}
+
+void unipolarToBipolar(const float* pX, float* pY, int nCount) {
+	getBatchKernels()->unipolarToBipolar(pX, pY, nCount);
+}
+
+void bipolarToUnipolar(const float* pX, float* pY, int nCount) {
+	getBatchKernels()->bipolarToUnipolar(pX, pY, nCount);
+}
+
+void convexTransform(const float* pX, float* pY, int nCount) {
+	getBatchKernels()->convexTransform(pX, pY, nCount);
+}
+
+void concaveInvertedTransform(const float* pX, float* pY, int nCount) {
+	getBatchKernels()->concaveInvertedTransform(pX, pY, nCount);
+}
+
+void tanh_table(const float* pX, float* pY, int nCount) {
+	getBatchKernels()->tanhTable(pX, pY, nCount);
+}
+
+void dLinTerp(const float* pY1, const float* pY2, const float* pFrac, float* pY, int nCount) {
+	getBatchKernels()->linTerp(pY1, pY2, pFrac, pY, nCount);
+}
+
+void vectorMix(const float* pSources, const float* pWeights, const float* pDeltas, float* pY, int nStride, int nCount) {
+	getBatchKernels()->vectorMix(pSources, pWeights, pDeltas, pY, nStride, nCount);
+}
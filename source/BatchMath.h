@@ -0,0 +1,74 @@
+#pragma once
+
+#if defined _M_X64 || defined _M_IX86 || defined __x86_64__ || defined __i386__
+#define BATCH_MATH_X86 1
+#include <immintrin.h>
+#if defined _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define BATCH_MATH_X86 0
+#endif
+
+//	MSVC takes intrinsics for any instruction set; gcc/clang need the
+//	function compiled for it. For any kernel dispatched on getBatchMathISA()
+#if defined _MSC_VER
+#define BATCH_TARGET_SSE2
+#define BATCH_TARGET_AVX2
+#else
+#define BATCH_TARGET_SSE2 __attribute__((target("sse2")))
+#define BATCH_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+//	instruction sets, in order of preference
+enum {
+	BATCH_MATH_SCALAR,
+	BATCH_MATH_SSE2,
+	BATCH_MATH_AVX2
+};
+
+/*
+	Batch versions of the synthfunctions.h/pluginconstants.h helpers
+
+	Each one runs a float array through the same math as its scalar
+	namesake, 4 (SSE2) or 8 (AVX2) at a time, picked at runtime from
+	what the CPU and OS support. Every path, including the scalar one,
+	does the same float operations in the same order, so all three give
+	bit-identical output; the SIMD paths only differ in speed.
+
+	The results are float, not double, so they are not bit-identical to
+	the scalar helpers; the error against them is noted per function.
+
+	pX and pY may be the same buffer. No allocation; audio thread safe.
+*/
+
+//	the path in use; the best available unless setBatchMathISA() was called
+int getBatchMathISA();
+
+//	force a path, e.g. to compare against the scalar reference; clamped
+//	to what is supported, returns the path actually chosen. Not while processing
+int setBatchMathISA(int nISA);
+
+//	sine of -pi -> +pi, high precision form; same error as the scalar version
+void parabolicSine(const float* pX, float* pY, int nCount);
+
+//	0 -> 1 to -1 -> +1 and back; float rounding only
+void unipolarToBipolar(const float* pX, float* pY, int nCount);
+void bipolarToUnipolar(const float* pX, float* pY, int nCount);
+
+//	0 -> 1 control curves; < 2e-7 from the double versions
+void convexTransform(const float* pX, float* pY, int nCount);
+void concaveInvertedTransform(const float* pX, float* pY, int nCount);
+
+//	same table and truncation as tanh_table(); the index is computed in
+//	float, so it can land one entry away from the double version
+void tanh_table(const float* pX, float* pY, int nCount);
+
+//	dLinTerp(0, 1, y1, y2, frac) for each element; exact
+void dLinTerp(const float* pY1, const float* pY2, const float* pFrac, float* pY, int nCount);
+
+//	vector synthesis mix of four sources, interleaved pSources[sample * 4 + source]
+//	(A, B, C, D), into pY[0], pY[nStride], ...; the weights step by pDeltas
+//	before each sample, so the last one gets pWeights + nCount * pDeltas.
+//	pWeights itself is not updated
+void vectorMix(const float* pSources, const float* pWeights, const float* pDeltas, float* pY, int nStride, int nCount);
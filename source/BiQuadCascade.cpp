@@ -0,0 +1,373 @@
+#include "BiQuadCascade.h"
+#include "BatchMath.h"
+#include <string.h>
+
+//	the project builds with /fp:fast; the kernels must not be contracted
+//	or reassociated, or the paths stop matching
+#if defined _MSC_VER
+#pragma float_control(precise, on, push)
+#endif
+
+/*
+	TDF-II, one stage of one channel group over the block
+		y = a0 x + z1
+		z1 = a1 x - b1 y + z2
+		z2 = a2 x - b2 y
+	with bRamp the coefficients step by fDelta before every sample, so
+	the last sample of the block runs on (nearly) the target
+*/
+
+//------------------------------------------------------------------------
+//	scalar reference, one channel per call
+//------------------------------------------------------------------------
+static void biQuadScalar(BiQuadCascadeLanes& lanes, float* pBlock, int nStride, int nLane, int nStage, int nSamples, bool bRamp) {
+	float z1 = lanes.fZ1[nStage][nLane];
+	float z2 = lanes.fZ2[nStage][nLane];
+	float a0 = lanes.fCoeff[0][nStage][nLane];
+	float a1 = lanes.fCoeff[1][nStage][nLane];
+	float a2 = lanes.fCoeff[2][nStage][nLane];
+	float b1 = lanes.fCoeff[3][nStage][nLane];
+	float b2 = lanes.fCoeff[4][nStage][nLane];
+
+	if (bRamp) {
+		float da0 = lanes.fDelta[0][nStage][nLane];
+		float da1 = lanes.fDelta[1][nStage][nLane];
+		float da2 = lanes.fDelta[2][nStage][nLane];
+		float db1 = lanes.fDelta[3][nStage][nLane];
+		float db2 = lanes.fDelta[4][nStage][nLane];
+		for (int n = 0; n < nSamples; n++) {
+			a0 += da0;
+			a1 += da1;
+			a2 += da2;
+			b1 += db1;
+			b2 += db2;
+			float* p = pBlock + n * nStride + nLane;
+			float x = *p;
+			float y = a0 * x + z1;
+			z1 = a1 * x - b1 * y + z2;
+			z2 = a2 * x - b2 * y;
+			*p = y;
+		}
+	} else {
+		for (int n = 0; n < nSamples; n++) {
+			float* p = pBlock + n * nStride + nLane;
+			float x = *p;
+			float y = a0 * x + z1;
+			z1 = a1 * x - b1 * y + z2;
+			z2 = a2 * x - b2 * y;
+			*p = y;
+		}
+	}
+
+	lanes.fZ1[nStage][nLane] = z1;
+	lanes.fZ2[nStage][nLane] = z2;
+}
+
+#if BATCH_MATH_X86
+//------------------------------------------------------------------------
+//	SSE2, 4 channels per pass
+//------------------------------------------------------------------------
+BATCH_TARGET_SSE2 static void biQuadSSE2(BiQuadCascadeLanes& lanes, float* pBlock, int nStride, int nLane, int nStage, int nSamples, bool bRamp) {
+	__m128 z1 = _mm_loadu_ps(&lanes.fZ1[nStage][nLane]);
+	__m128 z2 = _mm_loadu_ps(&lanes.fZ2[nStage][nLane]);
+	__m128 a0 = _mm_loadu_ps(&lanes.fCoeff[0][nStage][nLane]);
+	__m128 a1 = _mm_loadu_ps(&lanes.fCoeff[1][nStage][nLane]);
+	__m128 a2 = _mm_loadu_ps(&lanes.fCoeff[2][nStage][nLane]);
+	__m128 b1 = _mm_loadu_ps(&lanes.fCoeff[3][nStage][nLane]);
+	__m128 b2 = _mm_loadu_ps(&lanes.fCoeff[4][nStage][nLane]);
+
+	if (bRamp) {
+		const __m128 da0 = _mm_loadu_ps(&lanes.fDelta[0][nStage][nLane]);
+		const __m128 da1 = _mm_loadu_ps(&lanes.fDelta[1][nStage][nLane]);
+		const __m128 da2 = _mm_loadu_ps(&lanes.fDelta[2][nStage][nLane]);
+		const __m128 db1 = _mm_loadu_ps(&lanes.fDelta[3][nStage][nLane]);
+		const __m128 db2 = _mm_loadu_ps(&lanes.fDelta[4][nStage][nLane]);
+		for (int n = 0; n < nSamples; n++) {
+			a0 = _mm_add_ps(a0, da0);
+			a1 = _mm_add_ps(a1, da1);
+			a2 = _mm_add_ps(a2, da2);
+			b1 = _mm_add_ps(b1, db1);
+			b2 = _mm_add_ps(b2, db2);
+			float* p = pBlock + n * nStride + nLane;
+			__m128 x = _mm_loadu_ps(p);
+			__m128 y = _mm_add_ps(_mm_mul_ps(a0, x), z1);
+			z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a1, x), _mm_mul_ps(b1, y)), z2);
+			z2 = _mm_sub_ps(_mm_mul_ps(a2, x), _mm_mul_ps(b2, y));
+			_mm_storeu_ps(p, y);
+		}
+	} else {
+		for (int n = 0; n < nSamples; n++) {
+			float* p = pBlock + n * nStride + nLane;
+			__m128 x = _mm_loadu_ps(p);
+			__m128 y = _mm_add_ps(_mm_mul_ps(a0, x), z1);
+			z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a1, x), _mm_mul_ps(b1, y)), z2);
+			z2 = _mm_sub_ps(_mm_mul_ps(a2, x), _mm_mul_ps(b2, y));
+			_mm_storeu_ps(p, y);
+		}
+	}
+
+	_mm_storeu_ps(&lanes.fZ1[nStage][nLane], z1);
+	_mm_storeu_ps(&lanes.fZ2[nStage][nLane], z2);
+}
+
+//------------------------------------------------------------------------
+//	AVX2, 8 channels per pass
+//------------------------------------------------------------------------
+BATCH_TARGET_AVX2 static void biQuadAVX2(BiQuadCascadeLanes& lanes, float* pBlock, int nStride, int nLane, int nStage, int nSamples, bool bRamp) {
+	__m256 z1 = _mm256_loadu_ps(&lanes.fZ1[nStage][nLane]);
+	__m256 z2 = _mm256_loadu_ps(&lanes.fZ2[nStage][nLane]);
+	__m256 a0 = _mm256_loadu_ps(&lanes.fCoeff[0][nStage][nLane]);
+	__m256 a1 = _mm256_loadu_ps(&lanes.fCoeff[1][nStage][nLane]);
+	__m256 a2 = _mm256_loadu_ps(&lanes.fCoeff[2][nStage][nLane]);
+	__m256 b1 = _mm256_loadu_ps(&lanes.fCoeff[3][nStage][nLane]);
+	__m256 b2 = _mm256_loadu_ps(&lanes.fCoeff[4][nStage][nLane]);
+
+	if (bRamp) {
+		const __m256 da0 = _mm256_loadu_ps(&lanes.fDelta[0][nStage][nLane]);
+		const __m256 da1 = _mm256_loadu_ps(&lanes.fDelta[1][nStage][nLane]);
+		const __m256 da2 = _mm256_loadu_ps(&lanes.fDelta[2][nStage][nLane]);
+		const __m256 db1 = _mm256_loadu_ps(&lanes.fDelta[3][nStage][nLane]);
+		const __m256 db2 = _mm256_loadu_ps(&lanes.fDelta[4][nStage][nLane]);
+		for (int n = 0; n < nSamples; n++) {
+			a0 = _mm256_add_ps(a0, da0);
+			a1 = _mm256_add_ps(a1, da1);
+			a2 = _mm256_add_ps(a2, da2);
+			b1 = _mm256_add_ps(b1, db1);
+			b2 = _mm256_add_ps(b2, db2);
+			float* p = pBlock + n * nStride + nLane;
+			__m256 x = _mm256_loadu_ps(p);
+			__m256 y = _mm256_add_ps(_mm256_mul_ps(a0, x), z1);
+			z1 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a1, x), _mm256_mul_ps(b1, y)), z2);
+			z2 = _mm256_sub_ps(_mm256_mul_ps(a2, x), _mm256_mul_ps(b2, y));
+			_mm256_storeu_ps(p, y);
+		}
+	} else {
+		for (int n = 0; n < nSamples; n++) {
+			float* p = pBlock + n * nStride + nLane;
+			__m256 x = _mm256_loadu_ps(p);
+			__m256 y = _mm256_add_ps(_mm256_mul_ps(a0, x), z1);
+			z1 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a1, x), _mm256_mul_ps(b1, y)), z2);
+			z2 = _mm256_sub_ps(_mm256_mul_ps(a2, x), _mm256_mul_ps(b2, y));
+			_mm256_storeu_ps(p, y);
+		}
+	}
+
+	_mm256_storeu_ps(&lanes.fZ1[nStage][nLane], z1);
+	_mm256_storeu_ps(&lanes.fZ2[nStage][nLane], z2);
+}
+#endif // BATCH_MATH_X86
+
+#if defined _MSC_VER
+#pragma float_control(pop)
+#endif
+
+//------------------------------------------------------------------------
+//	dispatch; indexed by getBatchMathISA()
+//------------------------------------------------------------------------
+typedef void (*BiQuadKernel)(BiQuadCascadeLanes&, float*, int, int, int, int, bool);
+
+struct BiQuadKernels {
+	int nLanes;		//	channels per call
+	BiQuadKernel kernel;
+};
+
+static const BiQuadKernels biQuadKernels[] = {
+	{ 1, biQuadScalar },
+#if BATCH_MATH_X86
+	{ 4, biQuadSSE2 },
+	{ 8, biQuadAVX2 },
+#endif
+};
+
+//------------------------------------------------------------------------
+//	BiQuadCascade
+//------------------------------------------------------------------------
+BiQuadCascade::BiQuadCascade(void) {
+	init(1, 1);
+}
+
+BiQuadCascade::~BiQuadCascade(void) {
+}
+
+void BiQuadCascade::init(int nChannels, int nStages) {
+	m_nChannels = nChannels < 1 ? 1 : (nChannels > BIQUAD_CASCADE_MAX_CHANNELS ? BIQUAD_CASCADE_MAX_CHANNELS : nChannels);
+	m_nStages = nStages < 1 ? 1 : (nStages > BIQUAD_CASCADE_MAX_STAGES ? BIQUAD_CASCADE_MAX_STAGES : nStages);
+	m_bRampPending = false;
+
+	memset(&m_Lanes, 0, sizeof(m_Lanes));
+	BiQuadCoeffs bypass = calculateBypass();
+	for (int i = 0; i < BIQUAD_CASCADE_MAX_STAGES; i++) {
+		setCoefficients(i, bypass, false);
+	}
+}
+
+void BiQuadCascade::setLane(int nStage, int nChannel, const BiQuadCoeffs& coeffs, bool bRamp) {
+	m_Lanes.fTarget[0][nStage][nChannel] = coeffs.a0;
+	m_Lanes.fTarget[1][nStage][nChannel] = coeffs.a1;
+	m_Lanes.fTarget[2][nStage][nChannel] = coeffs.a2;
+	m_Lanes.fTarget[3][nStage][nChannel] = coeffs.b1;
+	m_Lanes.fTarget[4][nStage][nChannel] = coeffs.b2;
+
+	if (!bRamp) {
+		for (int i = 0; i < 5; i++) {
+			m_Lanes.fCoeff[i][nStage][nChannel] = m_Lanes.fTarget[i][nStage][nChannel];
+		}
+	}
+}
+
+void BiQuadCascade::setCoefficients(int nStage, const BiQuadCoeffs& coeffs, bool bRamp) {
+	if (nStage < 0 || nStage >= BIQUAD_CASCADE_MAX_STAGES) {
+		return;
+	}
+
+	for (int i = 0; i < BIQUAD_CASCADE_MAX_CHANNELS; i++) {
+		setLane(nStage, i, coeffs, bRamp);
+	}
+	m_bRampPending |= bRamp;
+}
+
+void BiQuadCascade::setCoefficients(int nStage, int nChannel, const BiQuadCoeffs& coeffs, bool bRamp) {
+	if (nStage < 0 || nStage >= BIQUAD_CASCADE_MAX_STAGES || nChannel < 0 || nChannel >= BIQUAD_CASCADE_MAX_CHANNELS) {
+		return;
+	}
+
+	setLane(nStage, nChannel, coeffs, bRamp);
+	m_bRampPending |= bRamp;
+}
+
+void BiQuadCascade::flushDelays() {
+	memset(&m_Lanes.fZ1, 0, sizeof(m_Lanes.fZ1));
+	memset(&m_Lanes.fZ2, 0, sizeof(m_Lanes.fZ2));
+}
+
+void BiQuadCascade::flushDelays(int nChannel) {
+	if (nChannel < 0 || nChannel >= BIQUAD_CASCADE_MAX_CHANNELS) {
+		return;
+	}
+
+	for (int i = 0; i < BIQUAD_CASCADE_MAX_STAGES; i++) {
+		m_Lanes.fZ1[i][nChannel] = 0.0f;
+		m_Lanes.fZ2[i][nChannel] = 0.0f;
+	}
+}
+
+/*
+	BiQuadCascade::process()
+	Each channel group runs through every stage in turn, widest kernel
+	first; what is left over goes to the narrower ones. A pending ramp
+	is spread over this block and the coefficients land on the targets
+	exactly at the end of it, for skipped groups too.
+*/
+void BiQuadCascade::process(float* pBlock, int nSamples, UINT uChannelMask) {
+	if (nSamples <= 0) {
+		return;
+	}
+
+	bool bRamp = m_bRampPending;
+	if (bRamp) {
+		float fInvSamples = 1.0f / (float)nSamples;
+		for (int i = 0; i < 5; i++) {
+			for (int nStage = 0; nStage < m_nStages; nStage++) {
+				for (int nLane = 0; nLane < m_nChannels; nLane++) {
+					m_Lanes.fDelta[i][nStage][nLane] = (m_Lanes.fTarget[i][nStage][nLane] - m_Lanes.fCoeff[i][nStage][nLane]) * fInvSamples;
+				}
+			}
+		}
+	}
+
+	int nLane = 0;
+	for (int nISA = getBatchMathISA(); nISA >= 0; nISA--) {
+		const BiQuadKernels& kernels = biQuadKernels[nISA];
+		UINT uGroupMask = (1u << kernels.nLanes) - 1;
+
+		for (; nLane + kernels.nLanes <= m_nChannels; nLane += kernels.nLanes) {
+			if (uChannelMask & (uGroupMask << nLane)) {
+				for (int nStage = 0; nStage < m_nStages; nStage++) {
+					kernels.kernel(m_Lanes, pBlock, m_nChannels, nLane, nStage, nSamples, bRamp);
+				}
+			}
+		}
+	}
+
+	if (bRamp) {
+		memcpy(m_Lanes.fCoeff, m_Lanes.fTarget, sizeof(m_Lanes.fCoeff));
+		m_bRampPending = false;
+	}
+}
+
+//------------------------------------------------------------------------
+//	coefficient cooking (RBJ Audio EQ Cookbook); the cookbook's b (zeros)
+//	are our a, its a (poles) our b, all normalized to its a0
+//------------------------------------------------------------------------
+static BiQuadCoeffs normalizeBiQuad(double b0, double b1, double b2, double a0, double a1, double a2) {
+	BiQuadCoeffs coeffs;
+	double dInvA0 = 1.0 / a0;
+	coeffs.a0 = (float)(b0 * dInvA0);
+	coeffs.a1 = (float)(b1 * dInvA0);
+	coeffs.a2 = (float)(b2 * dInvA0);
+	coeffs.b1 = (float)(a1 * dInvA0);
+	coeffs.b2 = (float)(a2 * dInvA0);
+	return coeffs;
+}
+
+BiQuadCoeffs BiQuadCascade::calculateBypass() {
+	return normalizeBiQuad(1.0, 0.0, 0.0, 1.0, 0.0, 0.0);
+}
+
+//	one zero at DC, one pole just inside it: y(n) = x(n) - x(n-1) + R y(n-1)
+BiQuadCoeffs BiQuadCascade::calculateDCBlocker(double dFc, double dFs) {
+	double R = 1.0 - 2.0 * pi * dFc / dFs;
+	return normalizeBiQuad(1.0, -1.0, 0.0, 1.0, -R, 0.0);
+}
+
+BiQuadCoeffs BiQuadCascade::calculateLPF(double dFc, double dQ, double dFs) {
+	double w0 = 2.0 * pi * dFc / dFs;
+	double dCos = cos(w0);
+	double dAlpha = sin(w0) / (2.0 * dQ);
+	return normalizeBiQuad((1.0 - dCos) / 2.0, 1.0 - dCos, (1.0 - dCos) / 2.0,
+		1.0 + dAlpha, -2.0 * dCos, 1.0 - dAlpha);
+}
+
+BiQuadCoeffs BiQuadCascade::calculateHPF(double dFc, double dQ, double dFs) {
+	double w0 = 2.0 * pi * dFc / dFs;
+	double dCos = cos(w0);
+	double dAlpha = sin(w0) / (2.0 * dQ);
+	return normalizeBiQuad((1.0 + dCos) / 2.0, -(1.0 + dCos), (1.0 + dCos) / 2.0,
+		1.0 + dAlpha, -2.0 * dCos, 1.0 - dAlpha);
+}
+
+BiQuadCoeffs BiQuadCascade::calculatePeakingEQ(double dFc, double dQ, double dGain_dB, double dFs) {
+	double A = pow(10.0, dGain_dB / 40.0);
+	double w0 = 2.0 * pi * dFc / dFs;
+	double dCos = cos(w0);
+	double dAlpha = sin(w0) / (2.0 * dQ);
+	return normalizeBiQuad(1.0 + dAlpha * A, -2.0 * dCos, 1.0 - dAlpha * A,
+		1.0 + dAlpha / A, -2.0 * dCos, 1.0 - dAlpha / A);
+}
+
+//	shelves with slope S = 1
+BiQuadCoeffs BiQuadCascade::calculateLowShelf(double dFc, double dGain_dB, double dFs) {
+	double A = pow(10.0, dGain_dB / 40.0);
+	double w0 = 2.0 * pi * dFc / dFs;
+	double dCos = cos(w0);
+	double d2SqrtAAlpha = sin(w0) * sqrt(2.0 * A);	//	2 sqrt(A) alpha, alpha = sin(w0)/sqrt(2)
+	return normalizeBiQuad(A * ((A + 1.0) - (A - 1.0) * dCos + d2SqrtAAlpha),
+		2.0 * A * ((A - 1.0) - (A + 1.0) * dCos),
+		A * ((A + 1.0) - (A - 1.0) * dCos - d2SqrtAAlpha),
+		(A + 1.0) + (A - 1.0) * dCos + d2SqrtAAlpha,
+		-2.0 * ((A - 1.0) + (A + 1.0) * dCos),
+		(A + 1.0) + (A - 1.0) * dCos - d2SqrtAAlpha);
+}
+
+BiQuadCoeffs BiQuadCascade::calculateHighShelf(double dFc, double dGain_dB, double dFs) {
+	double A = pow(10.0, dGain_dB / 40.0);
+	double w0 = 2.0 * pi * dFc / dFs;
+	double dCos = cos(w0);
+	double d2SqrtAAlpha = sin(w0) * sqrt(2.0 * A);
+	return normalizeBiQuad(A * ((A + 1.0) + (A - 1.0) * dCos + d2SqrtAAlpha),
+		-2.0 * A * ((A - 1.0) + (A + 1.0) * dCos),
+		A * ((A + 1.0) + (A - 1.0) * dCos - d2SqrtAAlpha),
+		(A + 1.0) - (A - 1.0) * dCos + d2SqrtAAlpha,
+		2.0 * ((A - 1.0) - (A + 1.0) * dCos),
+		(A + 1.0) - (A - 1.0) * dCos - d2SqrtAAlpha);
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "pluginconstants.h"
+
+//	most channels (or voices) one cascade runs; a multiple of 8 so the
+//	channels split evenly into SIMD groups, and at most 32 for the UINT
+//	channel masks; 32 is both lanes of every voice
+#define BIQUAD_CASCADE_MAX_CHANNELS 32
+
+//	most biquads in series per channel
+#define BIQUAD_CASCADE_MAX_STAGES 4
+
+//	one biquad, same form as CBiQuad:
+//	H(z) = (a0 + a1 z^-1 + a2 z^-2) / (1 + b1 z^-1 + b2 z^-2)
+struct BiQuadCoeffs {
+	float a0, a1, a2;
+	float b1, b2;
+};
+
+//	per channel state and coefficients, one float per channel
+//	(structure of arrays), so a group of channels is one SIMD load
+struct BiQuadCascadeLanes {
+	float fZ1[BIQUAD_CASCADE_MAX_STAGES][BIQUAD_CASCADE_MAX_CHANNELS];	//	TDF-II state
+	float fZ2[BIQUAD_CASCADE_MAX_STAGES][BIQUAD_CASCADE_MAX_CHANNELS];
+
+	//	[a0, a1, a2, b1, b2][stage][channel]
+	float fCoeff[5][BIQUAD_CASCADE_MAX_STAGES][BIQUAD_CASCADE_MAX_CHANNELS];	//	in use
+	float fTarget[5][BIQUAD_CASCADE_MAX_STAGES][BIQUAD_CASCADE_MAX_CHANNELS];	//	reached at the end of the next block
+	float fDelta[5][BIQUAD_CASCADE_MAX_STAGES][BIQUAD_CASCADE_MAX_CHANNELS];	//	per sample step towards fTarget
+};
+
+/*
+	BiQuadCascade
+	Up to BIQUAD_CASCADE_MAX_STAGES biquads in series on up to
+	BIQUAD_CASCADE_MAX_CHANNELS channels, a whole block per call.
+
+	CBiQuad is one sample of one channel per call, which cannot be
+	vectorized. Here the block is interleaved by channel,
+	pBlock[sample * nChannels + channel], and the channels are the SIMD
+	lanes: each pass runs 8 (AVX2) or 4 (SSE2) channels of one stage
+	through the whole block in transposed direct form II. The path comes
+	from getBatchMathISA(); channels left over after the SIMD groups run
+	on the scalar kernel, so any channel count works. All paths give
+	bit-identical output.
+
+	New coefficients are ramped to linearly over the next block instead
+	of being switched in, so EQ and filter moves do not click.
+
+	For the master EQ (2 channels), DC blocking and per voice filtering
+	(one channel per voice). No allocation or locks; process() runs on
+	the audio thread.
+*/
+class BiQuadCascade {
+public:
+	BiQuadCascade(void);
+	~BiQuadCascade(void);
+
+	//	block layout and size; clears the state, all stages pass through
+	void init(int nChannels, int nStages);
+
+	int getChannels() { return m_nChannels; }
+	int getStages() { return m_nStages; }
+
+	//	new coefficients for one stage of all channels or of one channel;
+	//	bRamp = false switches immediately, e.g. before the first block
+	void setCoefficients(int nStage, const BiQuadCoeffs& coeffs, bool bRamp = true);
+	void setCoefficients(int nStage, int nChannel, const BiQuadCoeffs& coeffs, bool bRamp = true);
+
+	//	flush Delays
+	void flushDelays();
+	void flushDelays(int nChannel);
+
+	//	filter in place; pBlock[n * getChannels() + channel]. Only SIMD
+	//	groups with a channel in uChannelMask are processed
+	void process(float* pBlock, int nSamples, UINT uChannelMask = 0xFFFFFFFF);
+
+	//	coefficient cooking; dFc and dFs in Hz
+	static BiQuadCoeffs calculateBypass();
+	static BiQuadCoeffs calculateDCBlocker(double dFc, double dFs);
+	static BiQuadCoeffs calculateLPF(double dFc, double dQ, double dFs);
+	static BiQuadCoeffs calculateHPF(double dFc, double dQ, double dFs);
+	static BiQuadCoeffs calculatePeakingEQ(double dFc, double dQ, double dGain_dB, double dFs);
+	static BiQuadCoeffs calculateLowShelf(double dFc, double dGain_dB, double dFs);
+	static BiQuadCoeffs calculateHighShelf(double dFc, double dGain_dB, double dFs);
+
+protected:
+	int m_nChannels;
+	int m_nStages;
+
+	//	a setCoefficients() is waiting to be ramped to
+	bool m_bRampPending;
+
+	BiQuadCascadeLanes m_Lanes;
+
+	void setLane(int nStage, int nChannel, const BiQuadCoeffs& coeffs, bool bRamp);
+};
@@ -0,0 +1,239 @@
+#include "DSPProfiler.h"
+
+#if DSP_PROFILER
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char* profilerStageNames[PROFILER_STAGES] = { "control", "events", "render", "mix" };
+
+DSPProfiler::DSPProfiler(void) {
+	m_bStopDump = false;
+	m_szDumpPath[0] = 0;
+	setSampleRate(44100.0);
+}
+
+DSPProfiler::~DSPProfiler(void) {
+	stopDumpThread();
+}
+
+void DSPProfiler::setSampleRate(double dFs) {
+	m_dNanoSecondsPerSample = 1.0e9 / dFs;
+	reset();
+}
+
+void DSPProfiler::reset() {
+	m_dBudget_nSec = 0.0;
+	m_dSmoothedLoad = 0.0;
+	m_dPeakLoad = 0.0;
+
+	for (int i = 0; i < PROFILER_STAGES; i++) {
+		m_dStageTime_nSec[i] = 0.0;
+		m_uStageTotal_nSec[i].store(0);
+	}
+	for (int i = 0; i < PROFILER_BUCKETS; i++) {
+		m_uHistogram[i].store(0);
+	}
+
+	m_uBlocks.store(0);
+	m_uOverruns.store(0);
+	m_uNearMisses.store(0);
+	m_uTotalTime_nSec.store(0);
+	m_uTotalBudget_nSec.store(0);
+	m_uMaxLoad_PPM.store(0);
+}
+
+//	bucket 0 is everything below 2^PROFILER_MIN_OCTAVE, the last is 2^PROFILER_MAX_OCTAVE and up
+int DSPProfiler::getBucket(double dLoad) {
+	if (dLoad <= 0.0) {
+		return 0;
+	}
+
+	int nBucket = (int)floor(log2(dLoad) * PROFILER_BUCKETS_PER_OCTAVE) - PROFILER_MIN_OCTAVE * PROFILER_BUCKETS_PER_OCTAVE + 1;
+	if (nBucket < 0) {
+		return 0;
+	}
+	if (nBucket > PROFILER_BUCKETS - 1) {
+		return PROFILER_BUCKETS - 1;
+	}
+	return nBucket;
+}
+
+double DSPProfiler::getBucketUpperEdge(int nBucket) {
+	return pow(2.0, PROFILER_MIN_OCTAVE + (double)nBucket / PROFILER_BUCKETS_PER_OCTAVE);
+}
+
+/*
+	DSPProfiler::endBlock()
+	Files the block: histogram, overrun/near miss counts, stage totals.
+	A handful of relaxed stores; no locks, no allocation.
+*/
+void DSPProfiler::endBlock() {
+	double dTime_nSec = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_BlockStart).count();
+	double dLoad = m_dBudget_nSec > 0.0 ? dTime_nSec / m_dBudget_nSec : 0.0;
+
+	increment(m_uHistogram[getBucket(dLoad)]);
+	increment(m_uBlocks);
+	if (dLoad > 1.0) {
+		increment(m_uOverruns);
+	}
+	else if (dLoad > PROFILER_WARNING_LOAD) {
+		increment(m_uNearMisses);
+	}
+
+	m_uTotalTime_nSec.store(m_uTotalTime_nSec.load(std::memory_order_relaxed) + (unsigned long long)dTime_nSec, std::memory_order_relaxed);
+	m_uTotalBudget_nSec.store(m_uTotalBudget_nSec.load(std::memory_order_relaxed) + (unsigned long long)m_dBudget_nSec, std::memory_order_relaxed);
+
+	for (int i = 0; i < PROFILER_STAGES; i++) {
+		m_uStageTotal_nSec[i].store(m_uStageTotal_nSec[i].load(std::memory_order_relaxed) + (unsigned long long)m_dStageTime_nSec[i], std::memory_order_relaxed);
+	}
+
+	unsigned int uLoad_PPM = dLoad < 4000.0 ? (unsigned int)(dLoad * 1.0e6) : 4000000000u;
+	if (uLoad_PPM > m_uMaxLoad_PPM.load(std::memory_order_relaxed)) {
+		m_uMaxLoad_PPM.store(uLoad_PPM, std::memory_order_relaxed);
+	}
+
+	//	for the output parameters
+	m_dSmoothedLoad = PROFILER_LOAD_SMOOTHING * m_dSmoothedLoad + (1.0 - PROFILER_LOAD_SMOOTHING) * dLoad;
+	if (dLoad > m_dPeakLoad) {
+		m_dPeakLoad = dLoad;
+	}
+}
+
+void DSPProfiler::getMeterValues(double& dLoad, double& dPeakLoad, unsigned int& uOverruns) {
+	dLoad = m_dSmoothedLoad;
+	dPeakLoad = m_dPeakLoad;
+	uOverruns = m_uOverruns.load(std::memory_order_relaxed);
+
+	//	peak is per meter interval
+	m_dPeakLoad = 0.0;
+}
+
+//	upper edge of the bucket holding the percentile
+double DSPProfiler::getPercentile(const unsigned int* pHistogram, unsigned int uTotal, double dPercentile) {
+	double dTarget = dPercentile * uTotal;
+	double dCount = 0.0;
+
+	for (int i = 0; i < PROFILER_BUCKETS; i++) {
+		dCount += pHistogram[i];
+		if (dCount >= dTarget) {
+			return getBucketUpperEdge(i);
+		}
+	}
+	return getBucketUpperEdge(PROFILER_BUCKETS - 1);
+}
+
+/*
+	DSPProfiler::writeReport()
+	Plain text so it can be read while the host is running. The
+	p99 and the near miss count are the early warning: an instance
+	whose p99 is creeping toward 100% is the next one to glitch.
+*/
+bool DSPProfiler::writeReport(const char* pPath) {
+	//	snapshot first so the report is consistent with itself
+	unsigned int uHistogram[PROFILER_BUCKETS];
+	unsigned int uTotal = 0;
+	for (int i = 0; i < PROFILER_BUCKETS; i++) {
+		uHistogram[i] = m_uHistogram[i].load(std::memory_order_relaxed);
+		uTotal += uHistogram[i];
+	}
+
+	unsigned long long uTime = m_uTotalTime_nSec.load(std::memory_order_relaxed);
+	unsigned long long uBudget = m_uTotalBudget_nSec.load(std::memory_order_relaxed);
+
+	FILE* pFile = fopen(pPath, "w");
+	if (!pFile) {
+		return false;
+	}
+
+	fprintf(pFile, "NanoSynth DSP load report\n\n");
+	fprintf(pFile, "blocks      %u\n", m_uBlocks.load(std::memory_order_relaxed));
+	fprintf(pFile, "overruns    %u\n", m_uOverruns.load(std::memory_order_relaxed));
+	fprintf(pFile, "near misses %u (> %.0f%%)\n", m_uNearMisses.load(std::memory_order_relaxed), PROFILER_WARNING_LOAD * 100.0);
+	fprintf(pFile, "mean load   %.2f%%\n", uBudget > 0 ? 100.0 * (double)uTime / (double)uBudget : 0.0);
+	fprintf(pFile, "max load    %.2f%%\n", m_uMaxLoad_PPM.load(std::memory_order_relaxed) / 1.0e4);
+
+	if (uTotal > 0) {
+		fprintf(pFile, "p50 load   <%.2f%%\n", 100.0 * getPercentile(uHistogram, uTotal, 0.5));
+		fprintf(pFile, "p90 load   <%.2f%%\n", 100.0 * getPercentile(uHistogram, uTotal, 0.9));
+		fprintf(pFile, "p99 load   <%.2f%%\n", 100.0 * getPercentile(uHistogram, uTotal, 0.99));
+	}
+
+	fprintf(pFile, "\nstage        %% of budget\n");
+	for (int i = 0; i < PROFILER_STAGES; i++) {
+		unsigned long long uStage = m_uStageTotal_nSec[i].load(std::memory_order_relaxed);
+		fprintf(pFile, "%-12s %.2f%%\n", profilerStageNames[i], uBudget > 0 ? 100.0 * (double)uStage / (double)uBudget : 0.0);
+	}
+
+	fprintf(pFile, "\nload <      blocks\n");
+	for (int i = 0; i < PROFILER_BUCKETS; i++) {
+		if (uHistogram[i] > 0) {
+			if (i == PROFILER_BUCKETS - 1) {
+				fprintf(pFile, "(over)      %u\n", uHistogram[i]);
+			}
+			else {
+				fprintf(pFile, "%8.3f%%   %u\n", 100.0 * getBucketUpperEdge(i), uHistogram[i]);
+			}
+		}
+	}
+
+	return fclose(pFile) == 0;
+}
+
+void DSPProfiler::startDumpThread(const char* pPath) {
+	stopDumpThread();
+
+	snprintf(m_szDumpPath, sizeof(m_szDumpPath), "%s", pPath);
+	m_bStopDump = false;
+
+	m_DumpThread = std::thread([this]() {
+		std::unique_lock<std::mutex> lock(m_DumpMutex);
+		bool bStop = false;
+
+		//	one last report on the way out
+		while (!bStop) {
+			bStop = m_DumpCondition.wait_for(lock, std::chrono::milliseconds(PROFILER_DUMP_INTERVAL_MSEC), [this]() { return m_bStopDump; });
+			writeReport(m_szDumpPath);
+		}
+	});
+}
+
+void DSPProfiler::stopDumpThread() {
+	if (!m_DumpThread.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_DumpMutex);
+		m_bStopDump = true;
+	}
+	m_DumpCondition.notify_all();
+	m_DumpThread.join();
+}
+
+/*
+	DSPProfiler::getDefaultDumpPath()
+	One report per instance in the temp folder, named by the instance
+	address so two NanoSynths on different tracks can be told apart.
+*/
+bool DSPProfiler::getDefaultDumpPath(char* pPath, int nMaxLength, const void* pInstance) {
+#if defined _WIN32
+	const char* pBase = getenv("TEMP");
+	const char* pFormat = "%s\\NanoSynth_load_%p.txt";
+#else
+	const char* pBase = getenv("TMPDIR");
+	const char* pFormat = "%s/NanoSynth_load_%p.txt";
+	if (!pBase) {
+		pBase = "/tmp";
+	}
+#endif
+	if (!pBase) {
+		return false;
+	}
+
+	int nLength = snprintf(pPath, nMaxLength, pFormat, pBase, pInstance);
+	return nLength > 0 && nLength < nMaxLength;
+}
+
+#endif // DSP_PROFILER
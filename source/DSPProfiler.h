@@ -0,0 +1,142 @@
+#pragma once
+
+//	compiled into debug builds; define NANOSYNTH_PROFILE to get it in a
+//	release build. It runs a dump thread, so shipping builds leave it out
+#if defined _DEBUG || defined NANOSYNTH_PROFILE
+#define DSP_PROFILER 1
+#else
+#define DSP_PROFILER 0
+#endif
+
+//	sub-stages of process(), timed in this order
+enum {
+	PROFILER_STAGE_CONTROL,	//	doControlUpdate()
+	PROFILER_STAGE_EVENTS,	//	note events
+	PROFILER_STAGE_RENDER,	//	oscillators/LFO
+	PROFILER_STAGE_MIX,		//	meters, scope, output params
+	PROFILER_STAGES
+};
+
+#if DSP_PROFILER
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//	histogram of block time / budget, 4 buckets per octave from
+//	1/1024 of the budget to 4x the budget, plus under and over
+#define PROFILER_BUCKETS_PER_OCTAVE 4
+#define PROFILER_MIN_OCTAVE -10
+#define PROFILER_MAX_OCTAVE 2
+#define PROFILER_BUCKETS ((PROFILER_MAX_OCTAVE - PROFILER_MIN_OCTAVE) * PROFILER_BUCKETS_PER_OCTAVE + 2)
+
+#define PROFILER_WARNING_LOAD 0.8		//	blocks above this are "near misses"
+#define PROFILER_LOAD_SMOOTHING 0.99	//	one pole, per block
+#define PROFILER_DUMP_INTERVAL_MSEC 5000
+
+/*
+	DSPProfiler
+	Per-block timing of process() against the buffer deadline
+	numSamples / sampleRate.
+
+	The audio thread calls beginBlock(), markStage() after each sub-stage
+	and endBlock(). Everything it writes is a relaxed atomic store from
+	that one thread, so the dump thread can read it at any time without
+	locks; the numbers may be one block apart, which is fine for a report.
+
+	The dump thread rewrites a text report every PROFILER_DUMP_INTERVAL_MSEC.
+*/
+class DSPProfiler {
+public:
+	DSPProfiler(void);
+	~DSPProfiler(void);
+
+	//	clears everything; not while processing
+	void setSampleRate(double dFs);
+	void reset();
+
+	//	audio thread
+	inline void beginBlock(int nSamples) {
+		m_BlockStart = std::chrono::steady_clock::now();
+		m_StageStart = m_BlockStart;
+		m_dBudget_nSec = nSamples * m_dNanoSecondsPerSample;
+
+		//	in case the last block returned early
+		for (int i = 0; i < PROFILER_STAGES; i++) {
+			m_dStageTime_nSec[i] = 0.0;
+		}
+	}
+
+	inline void markStage(int nStage) {
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		m_dStageTime_nSec[nStage] += (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_StageStart).count();
+		m_StageStart = now;
+	}
+
+	void endBlock();
+
+	//	audio thread; values for the output parameters. dLoad is smoothed,
+	//	dPeakLoad is the worst block since the last call. Both are 1.0 at the deadline.
+	void getMeterValues(double& dLoad, double& dPeakLoad, unsigned int& uOverruns);
+
+	//	the report; dump thread or any non-audio thread
+	bool writeReport(const char* pPath);
+
+	//	start/stop rewriting the report in the background
+	void startDumpThread(const char* pPath);
+	void stopDumpThread();
+
+	//	the per-instance report location
+	static bool getDefaultDumpPath(char* pPath, int nMaxLength, const void* pInstance);
+
+protected:
+	double m_dNanoSecondsPerSample;
+
+	//	audio thread only
+	std::chrono::steady_clock::time_point m_BlockStart;
+	std::chrono::steady_clock::time_point m_StageStart;
+	double m_dBudget_nSec;
+	double m_dStageTime_nSec[PROFILER_STAGES];
+	double m_dSmoothedLoad;
+	double m_dPeakLoad;
+
+	//	shared with the dump thread
+	std::atomic<unsigned int> m_uHistogram[PROFILER_BUCKETS];
+	std::atomic<unsigned int> m_uBlocks;
+	std::atomic<unsigned int> m_uOverruns;
+	std::atomic<unsigned int> m_uNearMisses;
+	std::atomic<unsigned long long> m_uTotalTime_nSec;
+	std::atomic<unsigned long long> m_uTotalBudget_nSec;
+	std::atomic<unsigned long long> m_uStageTotal_nSec[PROFILER_STAGES];
+	std::atomic<unsigned int> m_uMaxLoad_PPM;	//	parts per million of the budget
+
+	//	report thread
+	std::thread m_DumpThread;
+	std::mutex m_DumpMutex;
+	std::condition_variable m_DumpCondition;
+	bool m_bStopDump;
+	char m_szDumpPath[1024];
+
+	static inline void increment(std::atomic<unsigned int>& uCounter) {
+		uCounter.store(uCounter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	static int getBucket(double dLoad);
+	static double getBucketUpperEdge(int nBucket);
+	double getPercentile(const unsigned int* pHistogram, unsigned int uTotal, double dPercentile);
+};
+
+//	process() instrumentation; these vanish in shipping builds
+#define PROFILER_BEGIN_BLOCK(profiler, samples) (profiler).beginBlock(samples)
+#define PROFILER_MARK(profiler, stage) (profiler).markStage(stage)
+#define PROFILER_END_BLOCK(profiler) (profiler).endBlock()
+
+#else
+
+#define PROFILER_BEGIN_BLOCK(profiler, samples)
+#define PROFILER_MARK(profiler, stage)
+#define PROFILER_END_BLOCK(profiler)
+
+#endif // DSP_PROFILER
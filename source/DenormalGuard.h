@@ -0,0 +1,55 @@
+#pragma once
+
+#if defined _M_X64 || defined _M_IX86 || defined __x86_64__ || defined __i386__
+#include <xmmintrin.h>
+#define DENORMAL_GUARD_SSE 1
+#elif defined __aarch64__ && !defined _MSC_VER
+#define DENORMAL_GUARD_ARM64 1
+#endif
+
+#define DENORMAL_MXCSR_FTZ 0x8000			//	denormal results -> 0
+#define DENORMAL_MXCSR_DAZ 0x0040			//	denormal inputs -> 0
+#define DENORMAL_FPCR_FZ (1ULL << 24)		//	ARM: both
+
+/*
+	DenormalGuard
+	Puts the FPU in flush-to-zero/denormals-are-zero mode for the life of
+	the object and puts back whatever the host had on the way out,
+	including early returns. One at the top of process() covers every
+	filter, detector and decaying oscillator below it, so the DSP code
+	does not need per-sample underflow tests.
+
+	Only affects the calling thread. x86 MXCSR (SSE math, which is all
+	x64 code) and ARM64 FPCR; a no-op anywhere else.
+*/
+class DenormalGuard {
+public:
+	DenormalGuard(void) {
+#if DENORMAL_GUARD_SSE
+		m_uSavedState = _mm_getcsr();
+		_mm_setcsr((unsigned int)m_uSavedState | DENORMAL_MXCSR_FTZ | DENORMAL_MXCSR_DAZ);
+#elif DENORMAL_GUARD_ARM64
+		unsigned long long uFPCR;
+		__asm__ __volatile__("mrs %0, fpcr" : "=r"(uFPCR));
+		m_uSavedState = uFPCR;
+		uFPCR |= DENORMAL_FPCR_FZ;
+		__asm__ __volatile__("msr fpcr, %0" : : "r"(uFPCR));
+#else
+		m_uSavedState = 0;
+#endif
+	}
+
+	~DenormalGuard(void) {
+#if DENORMAL_GUARD_SSE
+		_mm_setcsr((unsigned int)m_uSavedState);
+#elif DENORMAL_GUARD_ARM64
+		__asm__ __volatile__("msr fpcr, %0" : : "r"(m_uSavedState));
+#endif
+	}
+
+	DenormalGuard(const DenormalGuard&) = delete;
+	DenormalGuard& operator=(const DenormalGuard&) = delete;
+
+protected:
+	unsigned long long m_uSavedState;
+};
@@ -0,0 +1,261 @@
+#include "EnvelopeGenerator.h"
+
+//	a segment never runs longer than this (about 12 hours at 48kHz)
+#define EG_MAX_SEGMENT_SAMPLES 0x7FFFFFFF
+
+EnvelopeGenerator::EnvelopeGenerator(void) {
+	m_dSampleRate = 44100.0;
+
+	m_dAttackTime_mSec = DEFAULT_EG_ATTACK_TIME;
+	m_dDecayTime_mSec = DEFAULT_EG_DECAY_TIME;
+	m_dSustainLevel = DEFAULT_EG_SUSTAIN_LEVEL;
+	m_dReleaseTime_mSec = DEFAULT_EG_RELEASE_TIME;
+	m_dShutdownTime_mSec = DEFAULT_EG_SHUTDOWN_TIME;
+	m_bResetToZero = DEFAULT_RESET_TO_ZERO != 0;
+	m_bLegatoMode = DEFAULT_LEGATO_MODE != 0;
+
+	m_uState = off;
+	m_dLevel = 0.0;
+	m_bRestartPending = false;
+	m_dCoeff = 0.0;
+	m_dOffset = 0.0;
+	m_dTarget = 0.0;
+	m_nSegmentSamples = 0;
+
+	update();
+}
+
+EnvelopeGenerator::~EnvelopeGenerator(void) {
+}
+
+void EnvelopeGenerator::setSampleRate(double dFs) {
+	m_dSampleRate = dFs;
+	update();
+}
+
+/*
+	EnvelopeGenerator::update()
+	For a segment of N samples aiming TCO past its end,
+		coeff = exp(-log((1 + TCO)/TCO) / N)
+	so a full scale move (0 -> 1 or 1 -> 0) takes the set time.
+	A zero time gives coeff = 0 and the segment is skipped.
+*/
+void EnvelopeGenerator::update() {
+	double dSamples = m_dAttackTime_mSec * m_dSampleRate / 1000.0;
+	m_dAttackCoeff = dSamples >= 1.0 ? exp(-log((1.0 + EG_ATTACK_TCO) / EG_ATTACK_TCO) / dSamples) : 0.0;
+	m_dAttackOffset = (1.0 + EG_ATTACK_TCO) * (1.0 - m_dAttackCoeff);
+
+	dSamples = m_dDecayTime_mSec * m_dSampleRate / 1000.0;
+	m_dDecayCoeff = dSamples >= 1.0 ? exp(-log((1.0 + EG_DECAY_TCO) / EG_DECAY_TCO) / dSamples) : 0.0;
+	m_dDecayOffset = (m_dSustainLevel - EG_DECAY_TCO) * (1.0 - m_dDecayCoeff);
+
+	dSamples = m_dReleaseTime_mSec * m_dSampleRate / 1000.0;
+	m_dReleaseCoeff = dSamples >= 1.0 ? exp(-log((1.0 + EG_DECAY_TCO) / EG_DECAY_TCO) / dSamples) : 0.0;
+	m_dReleaseOffset = -EG_DECAY_TCO * (1.0 - m_dReleaseCoeff);
+
+	dSamples = m_dShutdownTime_mSec * m_dSampleRate / 1000.0;
+	m_dShutdownInc = dSamples >= 1.0 ? 1.0 / dSamples : 0.0;
+
+	//	the running segment picks up the new curve from where it is
+	switch (m_uState) {
+		case attack:
+		case decay:
+		case release:
+		case shutdown:
+			enterState(m_uState);
+			break;
+		case sustain:
+			m_dLevel = m_dSustainLevel;
+			break;
+		default:
+			break;
+	}
+}
+
+void EnvelopeGenerator::startEG() {
+	//	legato: the held envelope carries on under the new note
+	if (m_bLegatoMode && isHeld()) {
+		return;
+	}
+
+	//	fade out first rather than jump to 0
+	if (m_bResetToZero && m_uState != off && m_dLevel > 0.0) {
+		m_bRestartPending = true;
+		enterState(shutdown);
+		return;
+	}
+
+	//	otherwise the attack starts from where the level is, so a
+	//	retriggered or stolen voice does not click
+	if (m_bResetToZero || m_uState == off) {
+		m_dLevel = 0.0;
+	}
+	m_bRestartPending = false;
+	enterState(attack);
+}
+
+void EnvelopeGenerator::noteOff() {
+	if (isHeld()) {
+		enterState(release);
+	}
+	//	released during a retrigger fade
+	m_bRestartPending = false;
+}
+
+void EnvelopeGenerator::shutdownEG() {
+	m_bRestartPending = false;
+	if (isActive()) {
+		enterState(shutdown);
+	}
+}
+
+void EnvelopeGenerator::stopEG() {
+	m_bRestartPending = false;
+	m_dLevel = 0.0;
+	m_uState = off;
+}
+
+void EnvelopeGenerator::enterState(UINT uState) {
+	m_uState = uState;
+
+	switch (uState) {
+		case attack:
+			m_dCoeff = m_dAttackCoeff;
+			m_dOffset = m_dAttackOffset;
+			m_dTarget = 1.0;
+			m_nSegmentSamples = segmentLength();
+			break;
+		case decay:
+			m_dCoeff = m_dDecayCoeff;
+			m_dOffset = m_dDecayOffset;
+			m_dTarget = m_dSustainLevel;
+			m_nSegmentSamples = segmentLength();
+			break;
+		case release:
+			m_dCoeff = m_dReleaseCoeff;
+			m_dOffset = m_dReleaseOffset;
+			m_dTarget = 0.0;
+			m_nSegmentSamples = segmentLength();
+			break;
+		case shutdown:
+			m_dTarget = 0.0;
+			m_nSegmentSamples = m_dShutdownInc > 0.0 ? (int)ceil(m_dLevel / m_dShutdownInc) : 0;
+			break;
+		case sustain:
+			m_dLevel = m_dSustainLevel;
+			break;
+		case off:
+		default:
+			m_dLevel = 0.0;
+			break;
+	}
+}
+
+/*
+	EnvelopeGenerator::segmentLength()
+	After n samples the level is A + (L - A) coeff^n, A = offset/(1 - coeff)
+	being the asymptote, so it passes the target T after
+		n = log((T - A)/(L - A)) / log(coeff)
+	0 if the level is already at or past the target.
+*/
+int EnvelopeGenerator::segmentLength() {
+	if (m_dCoeff <= 0.0) {
+		return 0;
+	}
+
+	double dAsymptote = m_dOffset / (1.0 - m_dCoeff);
+	double dRatio = (m_dTarget - dAsymptote) / (m_dLevel - dAsymptote);
+	if (!(dRatio > 0.0 && dRatio < 1.0)) {
+		return 0;
+	}
+
+	double dSamples = ceil(log(dRatio) / log(m_dCoeff));
+	return dSamples < (double)EG_MAX_SEGMENT_SAMPLES ? (int)dSamples : EG_MAX_SEGMENT_SAMPLES;
+}
+
+/*
+	EnvelopeGenerator::process()
+	Runs the block through as many segments as it spans. Inside a
+	segment it is only the multiply-add; a segment that ends lands on its
+	target and the next one starts on the following sample. A stereo
+	voice's second side, nPairOffset on, gets the same level.
+*/
+bool EnvelopeGenerator::process(float* pBuffer, int nStride, int nSamples, int nPairOffset) {
+	bool bPair = nPairOffset != 0;
+	int n = 0;
+	while (n < nSamples) {
+		switch (m_uState) {
+			case off: {
+				for (; n < nSamples; n++) {
+					pBuffer[n * nStride] = 0.0f;
+					if (bPair) {
+						pBuffer[n * nStride + nPairOffset] = 0.0f;
+					}
+				}
+				break;
+			}
+
+			case sustain: {
+				float fLevel = (float)m_dLevel;
+				for (; n < nSamples; n++) {
+					pBuffer[n * nStride] *= fLevel;
+					if (bPair) {
+						pBuffer[n * nStride + nPairOffset] *= fLevel;
+					}
+				}
+				break;
+			}
+
+			case shutdown: {
+				int nRun = nSamples - n < m_nSegmentSamples ? nSamples - n : m_nSegmentSamples;
+				double dLevel = m_dLevel;
+				for (int i = 0; i < nRun; i++, n++) {
+					dLevel -= m_dShutdownInc;
+					float fLevel = (float)(dLevel > 0.0 ? dLevel : 0.0);
+					pBuffer[n * nStride] *= fLevel;
+					if (bPair) {
+						pBuffer[n * nStride + nPairOffset] *= fLevel;
+					}
+				}
+				m_dLevel = dLevel;
+				m_nSegmentSamples -= nRun;
+
+				if (m_nSegmentSamples <= 0) {
+					m_dLevel = 0.0;
+					if (m_bRestartPending) {
+						m_bRestartPending = false;
+						enterState(attack);
+					} else {
+						enterState(off);
+					}
+				}
+				break;
+			}
+
+			//	attack, decay, release
+			default: {
+				int nRun = nSamples - n < m_nSegmentSamples ? nSamples - n : m_nSegmentSamples;
+				double dLevel = m_dLevel;
+				const double dCoeff = m_dCoeff;
+				const double dOffset = m_dOffset;
+				for (int i = 0; i < nRun; i++, n++) {
+					dLevel = dOffset + dCoeff * dLevel;
+					pBuffer[n * nStride] *= (float)dLevel;
+					if (bPair) {
+						pBuffer[n * nStride + nPairOffset] *= (float)dLevel;
+					}
+				}
+				m_dLevel = dLevel;
+				m_nSegmentSamples -= nRun;
+
+				if (m_nSegmentSamples <= 0) {
+					m_dLevel = m_dTarget;
+					enterState(m_uState == attack ? decay : (m_uState == decay ? sustain : off));
+				}
+				break;
+			}
+		}
+	}
+
+	return m_uState != off;
+}
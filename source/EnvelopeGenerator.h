@@ -0,0 +1,106 @@
+#pragma once
+#include "pluginconstants.h"
+#include "synthfunctions.h"
+#include "SynthParamLimits.h"
+
+//	time constant overshoot, as on an analog RC envelope: the attack aims
+//	EG_ATTACK_TCO above 1 and stops at 1, decay and release aim
+//	EG_DECAY_TCO below their target and stop on it
+#define EG_ATTACK_TCO 0.2231301601	//	exp(-1.5)
+#define EG_DECAY_TCO 0.0070834089	//	exp(-4.95)
+
+/*
+	EnvelopeGenerator
+	ADSR with analog style exponential segments.
+
+	Each segment is one recursive multiply per sample,
+		level = offset + coeff * level
+	with the coefficients from update(), so there is no exp() in the
+	audio path. The number of samples a segment runs for is worked out
+	when it starts (one log() at control rate), so process() runs whole
+	blocks through a plain multiply-add loop and only changes state on
+	segment boundaries; each segment ends exactly on its target.
+
+	When the release (or a shutdown) reaches 0 the envelope turns off;
+	the voice uses that to free itself.
+*/
+class EnvelopeGenerator {
+public:
+	EnvelopeGenerator(void);
+	~EnvelopeGenerator(void);
+
+	//	states
+	enum { off, attack, decay, sustain, release, shutdown };
+
+	//	GUI controls; call update() after changing them
+	double m_dAttackTime_mSec;		//	0 -> 1
+	double m_dDecayTime_mSec;		//	1 -> 0, so 1 -> sustain is shorter
+	double m_dSustainLevel;
+	double m_dReleaseTime_mSec;		//	1 -> 0
+	double m_dShutdownTime_mSec;	//	linear, from 1
+	bool m_bResetToZero;			//	retrigger from 0 (after a shutdown) instead of from the current level
+	bool m_bLegatoMode;				//	a new note does not retrigger a held envelope
+
+	void setSampleRate(double dFs);
+
+	//	rebuild the segment coefficients; a running segment carries on with them
+	void update();
+
+	//	note on/off
+	void startEG();
+	void noteOff();
+
+	//	fast linear fade to 0, then off
+	void shutdownEG();
+
+	//	off now, no fade
+	void stopEG();
+
+	inline UINT getState() {
+		return m_uState;
+	}
+	inline bool isActive() {
+		return m_uState != off;
+	}
+	//	attack, decay or sustain
+	inline bool isHeld() {
+		return m_uState == attack || m_uState == decay || m_uState == sustain;
+	}
+	inline double getLevel() {
+		return m_dLevel;
+	}
+
+	//	multiply nSamples of pBuffer[0], pBuffer[nStride], ... (and, if
+	//	nPairOffset is not 0, pBuffer[nPairOffset], ...) by the envelope;
+	//	returns false once it has turned off
+	bool process(float* pBuffer, int nStride, int nSamples, int nPairOffset = 0);
+
+protected:
+	double m_dSampleRate;
+	UINT m_uState;
+	double m_dLevel;
+
+	//	attack after the shutdown finishes (reset to zero)
+	bool m_bRestartPending;
+
+	//	level = offset + coeff * level, per segment
+	double m_dAttackCoeff;
+	double m_dAttackOffset;
+	double m_dDecayCoeff;
+	double m_dDecayOffset;
+	double m_dReleaseCoeff;
+	double m_dReleaseOffset;
+	double m_dShutdownInc;
+
+	//	the running segment
+	double m_dCoeff;
+	double m_dOffset;
+	double m_dTarget;			//	where it stops
+	int m_nSegmentSamples;		//	samples left in it
+
+	//	start a segment from the current level
+	void enterState(UINT uState);
+
+	//	samples for the running segment to get from the current level to m_dTarget
+	int segmentLength();
+};
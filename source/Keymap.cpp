@@ -0,0 +1,275 @@
+#include "Keymap.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//	next line that is not blank or a comment, trimmed
+static bool readKeymapLine(FILE* pFile, char* pLine, int nMaxLength) {
+	while (fgets(pLine, nMaxLength, pFile)) {
+		char* pStart = pLine;
+		while (*pStart && isspace((unsigned char)*pStart)) {
+			pStart++;
+		}
+		char* pEnd = pStart + strlen(pStart);
+		while (pEnd > pStart && isspace((unsigned char)pEnd[-1])) {
+			pEnd--;
+		}
+		*pEnd = 0;
+		if (*pStart == 0 || *pStart == '#') {
+			continue;
+		}
+		memmove(pLine, pStart, pEnd - pStart + 1);
+		return true;
+	}
+	return false;
+}
+
+static inline bool regionCovers(const KeymapRegion& region, UINT uNote, UINT uVelocity) {
+	return uNote >= region.range.uMIDINoteLow && uNote <= region.range.uMIDINoteHigh &&
+		uVelocity >= region.range.uMIDIVelocityLow && uVelocity <= region.range.uMIDIVelocityHigh;
+}
+
+Keymap::Keymap(void) {
+	m_uRegionCount = 0;
+	m_uSampleCount = 0;
+	m_uColumns = 0;
+	m_uRows = 0;
+	m_pCellFirst = 0;
+	m_pCellRegions = 0;
+	memset(m_uNoteColumn, 0, sizeof(m_uNoteColumn));
+	memset(m_uVelocityRow, 0, sizeof(m_uVelocityRow));
+	resetRoundRobin();
+}
+
+Keymap::~Keymap(void) {
+	clear();
+}
+
+void Keymap::clear() {
+	freeTable();
+
+	for (UINT i = 0; i < m_uSampleCount; i++) {
+		if (m_bSampleOwned[i]) {
+			delete m_pSamples[i];
+		}
+	}
+	m_uSampleCount = 0;
+	m_uRegionCount = 0;
+	resetRoundRobin();
+}
+
+void Keymap::freeTable() {
+	if (m_pCellFirst) {
+		delete[] m_pCellFirst;
+	}
+	if (m_pCellRegions) {
+		delete[] m_pCellRegions;
+	}
+	m_pCellFirst = 0;
+	m_pCellRegions = 0;
+	m_uColumns = 0;
+	m_uRows = 0;
+}
+
+void Keymap::resetRoundRobin() {
+	memset(m_uRoundRobinCount, 0, sizeof(m_uRoundRobinCount));
+}
+
+UINT Keymap::addSample(StreamedSample* pSample) {
+	if (m_uSampleCount >= KEYMAP_MAX_SAMPLES) {
+		return KEYMAP_MAX_SAMPLES;
+	}
+	m_pSamples[m_uSampleCount] = pSample;
+	m_bSampleOwned[m_uSampleCount] = false;
+	return m_uSampleCount++;
+}
+
+bool Keymap::addRegion(const KeymapRegion& region) {
+	const noteRegion& range = region.range;
+	if (m_uRegionCount >= KEYMAP_MAX_REGIONS || region.uSample >= m_uSampleCount ||
+		range.uMIDINoteLow > range.uMIDINoteHigh || range.uMIDINoteHigh >= KEYMAP_NOTES ||
+		range.uMIDIVelocityLow > range.uMIDIVelocityHigh || range.uMIDIVelocityHigh >= KEYMAP_VELOCITIES) {
+		return false;
+	}
+	if (region.uRoundRobinLength > 1 && region.uRoundRobinPosition >= region.uRoundRobinLength) {
+		return false;
+	}
+
+	m_Regions[m_uRegionCount++] = region;
+	return true;
+}
+
+/*
+	Keymap::compile()
+	A new column starts at every region's low note and after its high
+	note (rows likewise for velocity), so every note in a column is in
+	exactly the same regions. Two passes over the cells, one to size the
+	region lists and one to fill them, each testing one note/velocity of
+	the cell against every region.
+*/
+bool Keymap::compile() {
+	freeTable();
+	resetRoundRobin();
+	if (m_uRegionCount == 0) {
+		return false;
+	}
+
+	bool bNoteEdge[KEYMAP_NOTES + 1];
+	bool bVelocityEdge[KEYMAP_VELOCITIES + 1];
+	memset(bNoteEdge, 0, sizeof(bNoteEdge));
+	memset(bVelocityEdge, 0, sizeof(bVelocityEdge));
+	for (UINT i = 0; i < m_uRegionCount; i++) {
+		const noteRegion& range = m_Regions[i].range;
+		bNoteEdge[range.uMIDINoteLow] = true;
+		bNoteEdge[range.uMIDINoteHigh + 1] = true;
+		bVelocityEdge[range.uMIDIVelocityLow] = true;
+		bVelocityEdge[range.uMIDIVelocityHigh + 1] = true;
+	}
+
+	//	the first note (velocity) of each column (row) stands for all of it
+	UINT uColumnNote[KEYMAP_NOTES];
+	UINT uRowVelocity[KEYMAP_VELOCITIES];
+
+	UINT uColumn = 0;
+	uColumnNote[0] = 0;
+	for (UINT i = 0; i < KEYMAP_NOTES; i++) {
+		if (i > 0 && bNoteEdge[i]) {
+			uColumnNote[++uColumn] = i;
+		}
+		m_uNoteColumn[i] = (unsigned char)uColumn;
+	}
+	m_uColumns = uColumn + 1;
+
+	UINT uRow = 0;
+	uRowVelocity[0] = 0;
+	for (UINT i = 0; i < KEYMAP_VELOCITIES; i++) {
+		if (i > 0 && bVelocityEdge[i]) {
+			uRowVelocity[++uRow] = i;
+		}
+		m_uVelocityRow[i] = (unsigned char)uRow;
+	}
+	m_uRows = uRow + 1;
+
+	UINT uCells = m_uColumns * m_uRows;
+	m_pCellFirst = new UINT[uCells + 1];
+
+	UINT uTotal = 0;
+	for (UINT c = 0; c < uCells; c++) {
+		m_pCellFirst[c] = uTotal;
+		UINT uNote = uColumnNote[c / m_uRows];
+		UINT uVelocity = uRowVelocity[c % m_uRows];
+		for (UINT i = 0; i < m_uRegionCount; i++) {
+			if (regionCovers(m_Regions[i], uNote, uVelocity)) {
+				uTotal++;
+			}
+		}
+	}
+	m_pCellFirst[uCells] = uTotal;
+
+	//	never empty, so isLoaded() can test the pointer
+	m_pCellRegions = new unsigned short[uTotal > 0 ? uTotal : 1];
+	for (UINT c = 0; c < uCells; c++) {
+		UINT uNext = m_pCellFirst[c];
+		UINT uNote = uColumnNote[c / m_uRows];
+		UINT uVelocity = uRowVelocity[c % m_uRows];
+		for (UINT i = 0; i < m_uRegionCount; i++) {
+			if (regionCovers(m_Regions[i], uNote, uVelocity)) {
+				m_pCellRegions[uNext++] = (unsigned short)i;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+	Keymap::load()
+	Reads the regions, opens each sample once however many regions use
+	it, and compiles. Any bad line or missing sample fails the whole
+	keymap, rather than leaving holes in it.
+*/
+bool Keymap::load(const char* pPath) {
+	clear();
+
+	FILE* pFile = fopen(pPath, "r");
+	if (!pFile) {
+		return false;
+	}
+
+	//	sample names are relative to the keymap
+	char szDirectory[KEYMAP_LINE_LENGTH];
+	snprintf(szDirectory, sizeof(szDirectory), "%s", pPath);
+	char* pSlash = strrchr(szDirectory, '/');
+	char* pBackslash = strrchr(szDirectory, '\\');
+	if (pBackslash > pSlash) {
+		pSlash = pBackslash;
+	}
+	if (pSlash) {
+		pSlash[1] = 0;
+	} else {
+		szDirectory[0] = 0;
+	}
+
+	//	full paths of the samples opened so far, to share them
+	char (*pSamplePaths)[KEYMAP_LINE_LENGTH * 2] = new char[KEYMAP_MAX_SAMPLES][KEYMAP_LINE_LENGTH * 2];
+
+	char szLine[KEYMAP_LINE_LENGTH];
+	bool bOK = true;
+	while (bOK && readKeymapLine(pFile, szLine, sizeof(szLine))) {
+		int nNoteLow, nNoteHigh, nVelocityLow, nVelocityHigh, nNameOffset = 0;
+		unsigned int uLength, uPosition;
+		double dRoot;
+		bOK = sscanf(szLine, "%d %d %d %d %lf %u %u %n", &nNoteLow, &nNoteHigh, &nVelocityLow, &nVelocityHigh,
+			&dRoot, &uLength, &uPosition, &nNameOffset) == 7 && nNameOffset > 0 && szLine[nNameOffset] != 0 &&
+			nNoteLow >= 0 && nVelocityLow >= 0;
+		if (!bOK) {
+			break;
+		}
+
+		char szSamplePath[KEYMAP_LINE_LENGTH * 2];
+		const char* pName = szLine + nNameOffset;
+		bool bAbsolute = pName[0] == '/' || pName[0] == '\\' || (pName[0] != 0 && pName[1] == ':');
+		snprintf(szSamplePath, sizeof(szSamplePath), "%s%s", bAbsolute ? "" : szDirectory, pName);
+
+		UINT uSample = 0;
+		while (uSample < m_uSampleCount && strcmp(pSamplePaths[uSample], szSamplePath) != 0) {
+			uSample++;
+		}
+		if (uSample == m_uSampleCount) {
+			if (m_uSampleCount >= KEYMAP_MAX_SAMPLES) {
+				bOK = false;
+				break;
+			}
+			StreamedSample* pSample = new StreamedSample;
+			if (!pSample->open(szSamplePath)) {
+				delete pSample;
+				bOK = false;
+				break;
+			}
+			strcpy(pSamplePaths[uSample], szSamplePath);
+			addSample(pSample);
+			m_bSampleOwned[uSample] = true;
+		}
+
+		KeymapRegion region;
+		region.range.uMIDINoteLow = (UINT)nNoteLow;
+		region.range.uMIDINoteHigh = (UINT)nNoteHigh;
+		region.range.uMIDIVelocityLow = (UINT)nVelocityLow;
+		region.range.uMIDIVelocityHigh = (UINT)nVelocityHigh;
+		region.uSample = uSample;
+		region.dRootNote = dRoot;
+		region.uRoundRobinLength = uLength;
+		region.uRoundRobinPosition = uPosition;
+		bOK = addRegion(region);
+	}
+	fclose(pFile);
+	delete[] pSamplePaths;
+
+	if (!bOK || !compile()) {
+		clear();
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "pluginconstants.h"
+#include "synthfunctions.h"
+#include "SampleStream.h"
+
+#define KEYMAP_NOTES 128
+#define KEYMAP_VELOCITIES 128
+#define KEYMAP_MAX_REGIONS 1024
+#define KEYMAP_MAX_SAMPLES 256
+#define KEYMAP_MAX_LAYERS 8				//	regions one note-on plays
+#define KEYMAP_LINE_LENGTH 1024
+#define KEYMAP_FILE_NAME "NanoSynth.keymap"
+
+/*
+	KeymapRegion
+	A sample on a note/velocity rectangle. Regions that overlap are
+	layers and all play; a region with a round robin length of n plays
+	on every nth note-on of a note, at uRoundRobinPosition (0 -> n-1).
+*/
+struct KeymapRegion {
+	noteRegion range;
+	UINT uSample;				//	index into the keymap's samples
+	double dRootNote;			//	< 0 for the sample's own (smpl chunk)
+	UINT uRoundRobinLength;		//	0 or 1 plays every time
+	UINT uRoundRobinPosition;
+};
+
+/*
+	Keymap
+	Note/velocity -> regions for multisampled instruments.
+
+	compile() turns the region list into a two-level table: every note
+	maps to a column and every velocity to a row, where a column (row)
+	is a run of notes (velocities) that no region edge falls inside.
+	Each column/row cell holds the regions covering it, so a note-on is
+	two byte lookups and a walk over its own layers, however many
+	regions the map has. There are at most 2 * regions + 1 columns and
+	rows, and never more than 128 of either.
+
+	load() reads a text keymap, one region per line:
+		lokey hikey lovel hivel root rr_length rr_position file.wav
+	root -1 takes the sample's root note; the file name is the rest of
+	the line, relative to the keymap. '#' starts a comment line.
+
+	load()/addRegion()/compile() allocate and may not run alongside
+	getRegions(); getRegions() is realtime (it only bumps the round
+	robin counters).
+*/
+class Keymap {
+public:
+	Keymap(void);
+	~Keymap(void);
+
+	//	the regions and samples of a keymap file; false leaves it empty
+	bool load(const char* pPath);
+	void clear();
+
+	bool isLoaded() { return m_pCellFirst != 0; }
+
+	//	build a map by hand; uSample indexes the samples added so far
+	UINT addSample(StreamedSample* pSample);
+	bool addRegion(const KeymapRegion& region);
+	bool compile();
+
+	/*
+		the regions a note-on plays, layers in region order, up to
+		nMaxRegions; advances the note's round robin
+	*/
+	inline int getRegions(UINT uNote, UINT uVelocity, UINT* pRegions, int nMaxRegions) {
+		uNote &= 0x7F;
+		uVelocity &= 0x7F;
+		UINT uCell = m_uNoteColumn[uNote] * m_uRows + m_uVelocityRow[uVelocity];
+		UINT uRoundRobin = m_uRoundRobinCount[uNote]++;
+
+		int nCount = 0;
+		for (UINT i = m_pCellFirst[uCell]; i < m_pCellFirst[uCell + 1] && nCount < nMaxRegions; i++) {
+			const KeymapRegion& region = m_Regions[m_pCellRegions[i]];
+			if (region.uRoundRobinLength <= 1 || uRoundRobin % region.uRoundRobinLength == region.uRoundRobinPosition) {
+				pRegions[nCount++] = m_pCellRegions[i];
+			}
+		}
+		return nCount;
+	}
+
+	inline const KeymapRegion& getRegion(UINT uRegion) { return m_Regions[uRegion]; }
+	inline StreamedSample* getSample(UINT uSample) { return m_pSamples[uSample]; }
+
+	UINT getRegionCount() { return m_uRegionCount; }
+	UINT getSampleCount() { return m_uSampleCount; }
+
+	//	start every note's round robin over
+	void resetRoundRobin();
+
+protected:
+	KeymapRegion m_Regions[KEYMAP_MAX_REGIONS];
+	UINT m_uRegionCount;
+
+	//	the ones load() opened are closed and deleted by clear()
+	StreamedSample* m_pSamples[KEYMAP_MAX_SAMPLES];
+	bool m_bSampleOwned[KEYMAP_MAX_SAMPLES];
+	UINT m_uSampleCount;
+
+	//	the compiled table: column/row per note/velocity, and the regions
+	//	of cell c are m_pCellRegions[m_pCellFirst[c] -> m_pCellFirst[c + 1])
+	unsigned char m_uNoteColumn[KEYMAP_NOTES];
+	unsigned char m_uVelocityRow[KEYMAP_VELOCITIES];
+	UINT m_uColumns;
+	UINT m_uRows;
+	UINT* m_pCellFirst;
+	unsigned short* m_pCellRegions;
+
+	UINT m_uRoundRobinCount[KEYMAP_NOTES];
+
+	//	the compiled table only
+	void freeTable();
+};
@@ -1,5 +1,5 @@
 #pragma once
-#include "oscillator.h"
+#include "Oscillator.h"
 
 class LFO : public Oscillator {
 public:
@@ -131,7 +131,7 @@ public:
 				//	this is the first run
 				if (m_nRSHCounter < 0) {
 					if (m_uWaveform == rsh) {
-						m_dRSHValue = doWhiteNoise();
+						m_dRSHValue = doWhiteNoise(m_uNoiseRegister);
 					} else {
 						m_dRSHValue = doPNSequence(m_uPNRegister);
 					}
@@ -142,7 +142,7 @@ public:
 					m_nRSHCounter -= m_dSampleRate / m_dFo;
 
 					if (m_uWaveform == rsh) {
-						m_dRSHValue = doWhiteNoise();
+						m_dRSHValue = doWhiteNoise(m_uNoiseRegister);
 					} else {
 						m_dRSHValue = doPNSequence(m_uPNRegister);
 					}
@@ -6,6 +6,7 @@
 
 #include "pluginterfaces/base/funknown.h"
 #include "pluginterfaces/vst/vsttypes.h"
+#include "pluginterfaces/vst/ivstnoteexpression.h"
 
 namespace Quero {
 //------------------------------------------------------------------------
@@ -14,5 +15,8 @@ static const Steinberg::FUID kNanoSynthControllerUID (0x1929149B, 0x92185FCD, 0x
 
 #define NanoSynthVST3Category "Instrument"
 
+//	our note expression past the standard ones: per-note pressure, 0 -> 1
+static const Steinberg::Vst::NoteExpressionTypeID kPressureTypeID = Steinberg::Vst::kCustomStart;
+
 //------------------------------------------------------------------------
 } // namespace Quero
@@ -7,12 +7,17 @@
 #include "vstgui/plugin-bindings/vst3editor.h"
 #include "pluginterfaces/base/ustring.h"
 #include "pluginterfaces/base/futils.h"
+#include "pluginterfaces/base/smartpointer.h"
 #include "pluginterfaces/vst/ivstmidicontrollers.h"
 #include "base/source/fstring.h"
 #include "logscale.h"
 #include "base/source/fstreamer.h"
 #include "synthfunctions.h"
 #include "synthparamlimits.h"
+#include "SynthState.h"
+#include "VoiceExpression.h"
+#include "DSPProfiler.h"
+#include <stdio.h>
 
 using namespace Steinberg;
 
@@ -88,6 +93,263 @@ tresult PLUGIN_API NanoSynthController::initialize (FUnknown* context)
 		enumStringParam->appendString(USTRING("free"));
 		parameters.addParameter(enumStringParam);
 
+		//	Filter 1 - Fc uses the log taper; the Processor cooks it with the same curve
+		param = new Vst::LogScaleParameter<Vst::ParamValue>(USTRING("Filter Fc"), FILTER1_FC, filterLogScale, USTRING("Hz"));
+		param->setPrecision(0); // fractional sig digits
+		param->getInfo().defaultNormalizedValue = filterLogScale.invscale(DEFAULT_FILTER_FC);
+		param->setNormalized(param->getInfo().defaultNormalizedValue);
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Filter Q"), FILTER1_Q, USTRING(""),
+			MIN_FILTER_Q, MAX_FILTER_Q, DEFAULT_FILTER_Q);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Filter Type"), FILTER1_TYPE);
+		//	same order as the VoiceFilterBank enum
+		enumStringParam->appendString(USTRING("SVF LP"));
+		enumStringParam->appendString(USTRING("SVF HP"));
+		enumStringParam->appendString(USTRING("SVF BP"));
+		enumStringParam->appendString(USTRING("SVF NOTCH"));
+		enumStringParam->appendString(USTRING("LADDER 2"));
+		enumStringParam->appendString(USTRING("LADDER 4"));
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Filter Keytrack"), FILTER1_KEYTRACK);
+		enumStringParam->appendString(USTRING("OFF"));
+		enumStringParam->appendString(USTRING("ON"));
+		parameters.addParameter(enumStringParam);
+
+		param = new Vst::RangeParameter(USTRING("Filter Keytrack Int"), FILTER1_KEYTRACK_INTENSITY, USTRING(""),
+			MIN_FILTER_KEYTRACK_INTENSITY, MAX_FILTER_KEYTRACK_INTENSITY, DEFAULT_FILTER_KEYTRACK_INTENSITY);
+		param->setPrecision(2); // fractional sig digits
+		parameters.addParameter(param);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Filter NLP"), FILTER1_NLP);
+		enumStringParam->appendString(USTRING("OFF"));
+		enumStringParam->appendString(USTRING("ON"));
+		parameters.addParameter(enumStringParam);
+
+		param = new Vst::RangeParameter(USTRING("Filter Saturation"), FILTER1_SATURATION, USTRING(""),
+			MIN_FILTER_SATURATION, MAX_FILTER_SATURATION, DEFAULT_FILTER_SATURATION);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		//	EG1 -> amplitude
+		param = new Vst::RangeParameter(USTRING("EG1 Attack"), EG1_ATTACK_TIME, USTRING("mSec"),
+			MIN_EG_ATTACK_TIME, MAX_EG_ATTACK_TIME, DEFAULT_EG_ATTACK_TIME);
+		param->setPrecision(0); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("EG1 Decay"), EG1_DECAY_TIME, USTRING("mSec"),
+			MIN_EG_DECAY_TIME, MAX_EG_DECAY_TIME, DEFAULT_EG_DECAY_TIME);
+		param->setPrecision(0); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("EG1 Sustain"), EG1_SUSTAIN_LEVEL, USTRING(""),
+			MIN_EG_SUSTAIN_LEVEL, MAX_EG_SUSTAIN_LEVEL, DEFAULT_EG_SUSTAIN_LEVEL);
+		param->setPrecision(2); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("EG1 Release"), EG1_RELEASE_TIME, USTRING("mSec"),
+			MIN_EG_RELEASE_TIME, MAX_EG_RELEASE_TIME, DEFAULT_EG_RELEASE_TIME);
+		param->setPrecision(0); // fractional sig digits
+		parameters.addParameter(param);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("EG1 Legato"), EG1_LEGATO_MODE);
+		enumStringParam->appendString(USTRING("OFF"));
+		enumStringParam->appendString(USTRING("ON"));
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("EG1 Reset To Zero"), EG1_RESET_TO_ZERO);
+		enumStringParam->appendString(USTRING("OFF"));
+		enumStringParam->appendString(USTRING("ON"));
+		parameters.addParameter(enumStringParam);
+
+		//	DCA
+		param = new Vst::RangeParameter(USTRING("Volume"), DCA_AMPLITUDE_DB, USTRING("dB"),
+			MIN_OUTPUT_AMPLITUDE_DB, MAX_OUTPUT_AMPLITUDE_DB, DEFAULT_OUTPUT_AMPLITUDE_DB);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Pan"), DCA_PAN, USTRING(""),
+			MIN_BIPOLAR, MAX_BIPOLAR, DEFAULT_BIPOLAR);
+		param->setPrecision(2); // fractional sig digits
+		parameters.addParameter(param);
+
+		//	oversampling of the filter while its NLP is on; realtime and
+		//	offline (bounce) quality are separate
+		enumStringParam = new Vst::StringListParameter(USTRING("Filter Oversampling"), FILTER1_OVERSAMPLING);
+		enumStringParam->appendString(USTRING("OFF"));
+		enumStringParam->appendString(USTRING("2x"));
+		enumStringParam->appendString(USTRING("4x"));
+		enumStringParam->appendString(USTRING("8x"));
+		enumStringParam->getInfo().defaultNormalizedValue = enumStringParam->toNormalized(DEFAULT_FILTER_OVERSAMPLING);
+		enumStringParam->setNormalized(enumStringParam->getInfo().defaultNormalizedValue);
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("OS Quality"), OVERSAMPLING_QUALITY);
+		//	same order as the Oversampler tiers
+		enumStringParam->appendString(USTRING("ECO"));
+		enumStringParam->appendString(USTRING("NORMAL"));
+		enumStringParam->appendString(USTRING("HIGH"));
+		enumStringParam->getInfo().defaultNormalizedValue = enumStringParam->toNormalized(DEFAULT_OVERSAMPLING_QUALITY);
+		enumStringParam->setNormalized(enumStringParam->getInfo().defaultNormalizedValue);
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("OS Offline Quality"), OVERSAMPLING_OFFLINE_QUALITY);
+		enumStringParam->appendString(USTRING("ECO"));
+		enumStringParam->appendString(USTRING("NORMAL"));
+		enumStringParam->appendString(USTRING("HIGH"));
+		enumStringParam->getInfo().defaultNormalizedValue = enumStringParam->toNormalized(DEFAULT_OVERSAMPLING_OFFLINE_QUALITY);
+		enumStringParam->setNormalized(enumStringParam->getInfo().defaultNormalizedValue);
+		parameters.addParameter(enumStringParam);
+
+		//	vector voice; sources A-D sit at the joystick corners
+		enumStringParam = new Vst::StringListParameter(USTRING("Vector Mode"), VECTOR_MODE);
+		enumStringParam->appendString(USTRING("OFF"));
+		enumStringParam->appendString(USTRING("ON"));
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Vector A Waveform"), VECTOR_A_WAVEFORM);
+		//	same list as Osc Waveform
+		enumStringParam->appendString(USTRING("SINE"));
+		enumStringParam->appendString(USTRING("SAW1"));
+		enumStringParam->appendString(USTRING("SAW2"));
+		enumStringParam->appendString(USTRING("SAW3"));
+		enumStringParam->appendString(USTRING("TRI"));
+		enumStringParam->appendString(USTRING("SQUARE"));
+		enumStringParam->appendString(USTRING("NOISE"));
+		enumStringParam->appendString(USTRING("PNOISE"));
+		enumStringParam->getInfo().defaultNormalizedValue = enumStringParam->toNormalized(DEFAULT_VECTOR_A_WAVEFORM);
+		enumStringParam->setNormalized(enumStringParam->getInfo().defaultNormalizedValue);
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Vector B Waveform"), VECTOR_B_WAVEFORM);
+		enumStringParam->appendString(USTRING("SINE"));
+		enumStringParam->appendString(USTRING("SAW1"));
+		enumStringParam->appendString(USTRING("SAW2"));
+		enumStringParam->appendString(USTRING("SAW3"));
+		enumStringParam->appendString(USTRING("TRI"));
+		enumStringParam->appendString(USTRING("SQUARE"));
+		enumStringParam->appendString(USTRING("NOISE"));
+		enumStringParam->appendString(USTRING("PNOISE"));
+		enumStringParam->getInfo().defaultNormalizedValue = enumStringParam->toNormalized(DEFAULT_VECTOR_B_WAVEFORM);
+		enumStringParam->setNormalized(enumStringParam->getInfo().defaultNormalizedValue);
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Vector C Waveform"), VECTOR_C_WAVEFORM);
+		enumStringParam->appendString(USTRING("SINE"));
+		enumStringParam->appendString(USTRING("SAW1"));
+		enumStringParam->appendString(USTRING("SAW2"));
+		enumStringParam->appendString(USTRING("SAW3"));
+		enumStringParam->appendString(USTRING("TRI"));
+		enumStringParam->appendString(USTRING("SQUARE"));
+		enumStringParam->appendString(USTRING("NOISE"));
+		enumStringParam->appendString(USTRING("PNOISE"));
+		enumStringParam->getInfo().defaultNormalizedValue = enumStringParam->toNormalized(DEFAULT_VECTOR_C_WAVEFORM);
+		enumStringParam->setNormalized(enumStringParam->getInfo().defaultNormalizedValue);
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Vector D Waveform"), VECTOR_D_WAVEFORM);
+		enumStringParam->appendString(USTRING("SINE"));
+		enumStringParam->appendString(USTRING("SAW1"));
+		enumStringParam->appendString(USTRING("SAW2"));
+		enumStringParam->appendString(USTRING("SAW3"));
+		enumStringParam->appendString(USTRING("TRI"));
+		enumStringParam->appendString(USTRING("SQUARE"));
+		enumStringParam->appendString(USTRING("NOISE"));
+		enumStringParam->appendString(USTRING("PNOISE"));
+		enumStringParam->getInfo().defaultNormalizedValue = enumStringParam->toNormalized(DEFAULT_VECTOR_D_WAVEFORM);
+		enumStringParam->setNormalized(enumStringParam->getInfo().defaultNormalizedValue);
+		parameters.addParameter(enumStringParam);
+
+		param = new Vst::RangeParameter(USTRING("Joystick X"), VECTOR_JOYSTICK_X, USTRING(""),
+			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR_HALF);
+		param->setPrecision(2); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Joystick Y"), VECTOR_JOYSTICK_Y, USTRING(""),
+			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR_HALF);
+		param->setPrecision(2); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Orbit X"), VECTOR_ORBIT_X, USTRING(""),
+			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR);
+		param->setPrecision(2); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Orbit Y"), VECTOR_ORBIT_Y, USTRING(""),
+			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR);
+		param->setPrecision(2); // fractional sig digits
+		parameters.addParameter(param);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Vector Path Mode"), VECTOR_PATH_MODE);
+		//	same order as the CJoystickProgram modes
+		enumStringParam->appendString(USTRING("ONE SHOT"));
+		enumStringParam->appendString(USTRING("LOOP"));
+		enumStringParam->appendString(USTRING("SUSTAIN"));
+		enumStringParam->appendString(USTRING("BACK+FORTH"));
+		parameters.addParameter(enumStringParam);
+
+		param = new Vst::RangeParameter(USTRING("Vector Path Time"), VECTOR_PATH_TIME, USTRING("mSec"),
+			MIN_VECTOR_PATH_TIME, MAX_VECTOR_PATH_TIME, DEFAULT_VECTOR_PATH_TIME);
+		param->setPrecision(0); // fractional sig digits
+		parameters.addParameter(param);
+
+		//	Sample mode - plays the sample next to the preset bank, streamed from disk
+		enumStringParam = new Vst::StringListParameter(USTRING("Sample Mode"), SAMPLE_MODE);
+		enumStringParam->appendString(USTRING("OFF"));
+		enumStringParam->appendString(USTRING("ON"));
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Sample Loop Mode"), SAMPLE_LOOP_MODE);
+		enumStringParam->appendString(USTRING("LOOP"));
+		enumStringParam->appendString(USTRING("SUSTAIN"));
+		enumStringParam->appendString(USTRING("ONE SHOT"));
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Sample Quality"), SAMPLE_QUALITY);
+		//	same order as the SincResampler tiers
+		enumStringParam->appendString(USTRING("LINEAR"));
+		enumStringParam->appendString(USTRING("4 POINT"));
+		enumStringParam->appendString(USTRING("16 POINT"));
+		enumStringParam->appendString(USTRING("64 POINT"));
+		enumStringParam->getInfo().defaultNormalizedValue = enumStringParam->toNormalized(DEFAULT_SAMPLE_QUALITY);
+		enumStringParam->setNormalized(enumStringParam->getInfo().defaultNormalizedValue);
+		parameters.addParameter(enumStringParam);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("MPE Mode"), MPE_MODE);
+		enumStringParam->appendString(USTRING("OFF"));
+		enumStringParam->appendString(USTRING("ON"));
+		parameters.addParameter(enumStringParam);
+
+		//	Unison - detuned copies of Osc1 in place of the Osc1/Osc2 pair
+		param = new Vst::RangeParameter(USTRING("Unison Voices"), UNISON_VOICES, USTRING(""),
+			MIN_UNISON_VOICES, MAX_UNISON_VOICES, DEFAULT_UNISON_VOICES, MAX_UNISON_VOICES - MIN_UNISON_VOICES);
+		param->setPrecision(0); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Unison Detune"), UNISON_DETUNE, USTRING("cents"),
+			MIN_UNISON_DETUNE_CENTS, MAX_UNISON_DETUNE_CENTS, DEFAULT_UNISON_DETUNE_CENTS);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Unison Curve"), UNISON_CURVE, USTRING(""),
+			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR);
+		param->setPrecision(2); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Unison Spread"), UNISON_SPREAD, USTRING(""),
+			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR_HALF);
+		param->setPrecision(2); // fractional sig digits
+		parameters.addParameter(param);
+
+		enumStringParam = new Vst::StringListParameter(USTRING("Unison Phase"), UNISON_PHASE);
+		enumStringParam->appendString(USTRING("RANDOM"));
+		enumStringParam->appendString(USTRING("LOCKED"));
+		parameters.addParameter(enumStringParam);
+
 		// MIDI Params - these have no knobs in main GUI but do have to appear in default
 		// NOTE: this is for VST3 ONLY!
 		param = new Vst::RangeParameter(USTRING("PitchBend"), MIDI_PITCHBEND, USTRING(""),
@@ -96,12 +358,12 @@ tresult PLUGIN_API NanoSynthController::initialize (FUnknown* context)
 		parameters.addParameter(param);
 
 		param = new Vst::RangeParameter(USTRING("MIDI Vol"), MIDI_VOLUME_CC7, USTRING(""),
-			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR);
+			MIN_UNIPOLAR, MAX_UNIPOLAR, midiToUnipolar(DEFAULT_MIDI_VOLUME));
 		param->setPrecision(1); // fractional sig digits
 		parameters.addParameter(param);
 
 		param = new Vst::RangeParameter(USTRING("MIDI Pan"), MIDI_PAN_CC10, USTRING(""),
-			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR);
+			MIN_UNIPOLAR, MAX_UNIPOLAR, midiToUnipolar(DEFAULT_MIDI_PAN));
 		param->setPrecision(1); // fractional sig digits
 		parameters.addParameter(param);
 
@@ -111,7 +373,7 @@ tresult PLUGIN_API NanoSynthController::initialize (FUnknown* context)
 		parameters.addParameter(param);
 
 		param = new Vst::RangeParameter(USTRING("MIDI Expression"), MIDI_EXPRESSION_CC11, USTRING(""),
-			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR);
+			MIN_UNIPOLAR, MAX_UNIPOLAR, midiToUnipolar(DEFAULT_MIDI_EXPRESSION));
 		param->setPrecision(1); // fractional sig digits
 		parameters.addParameter(param);
 
@@ -129,10 +391,114 @@ tresult PLUGIN_API NanoSynthController::initialize (FUnknown* context)
 			MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR);
 		param->setPrecision(1); // fractional sig digits
 		parameters.addParameter(param);
+
+		//	MPE member channels 2 -> 16; hidden, they only carry the MIDI mapping
+		for (int i = 0; i < MPE_MEMBER_CHANNELS; i++) {
+			char szTitle[32];
+			UString128 title;
+
+			snprintf(szTitle, sizeof(szTitle), "MPE PitchBend %d", i + 2);
+			title.fromAscii(szTitle);
+			param = new Vst::RangeParameter(title, MPE_PITCHBEND + i, USTRING(""),
+				MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR_HALF, 0, Vst::ParameterInfo::kIsHidden);
+			param->setPrecision(1); // fractional sig digits
+			parameters.addParameter(param);
+
+			snprintf(szTitle, sizeof(szTitle), "MPE Timbre %d", i + 2);
+			title.fromAscii(szTitle);
+			param = new Vst::RangeParameter(title, MPE_TIMBRE + i, USTRING(""),
+				MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR_HALF, 0, Vst::ParameterInfo::kIsHidden);
+			param->setPrecision(1); // fractional sig digits
+			parameters.addParameter(param);
+
+			snprintf(szTitle, sizeof(szTitle), "MPE Pressure %d", i + 2);
+			title.fromAscii(szTitle);
+			param = new Vst::RangeParameter(title, MPE_PRESSURE + i, USTRING(""),
+				MIN_UNIPOLAR, MAX_UNIPOLAR, DEFAULT_UNIPOLAR, 0, Vst::ParameterInfo::kIsHidden);
+			param->setPrecision(1); // fractional sig digits
+			parameters.addParameter(param);
+		}
+
+		//	note expression; the Processor scales these as VoiceExpression does
+		m_NoteExpressionTypes.addNoteExpressionType(new Vst::RangeNoteExpressionType(Vst::kTuningTypeID,
+			USTRING("Tuning"), USTRING("Tun"), USTRING("Half Tone"), -1,
+			0.0, -VOICE_EXPRESSION_TUNING_RANGE, VOICE_EXPRESSION_TUNING_RANGE, Vst::NoteExpressionTypeInfo::kIsBipolar));
+		m_NoteExpressionTypes.addNoteExpressionType(new Vst::NoteExpressionType(Vst::kBrightnessTypeID,
+			USTRING("Brightness"), USTRING("Bright"), USTRING(""), -1,
+			DEFAULT_UNIPOLAR_HALF, MIN_UNIPOLAR, MAX_UNIPOLAR, 0, Vst::NoteExpressionTypeInfo::kIsBipolar));
+		m_NoteExpressionTypes.addNoteExpressionType(new Vst::NoteExpressionType(kPressureTypeID,
+			USTRING("Pressure"), USTRING("Press"), USTRING(""), -1,
+			DEFAULT_UNIPOLAR, MIN_UNIPOLAR, MAX_UNIPOLAR, 0, 0));
+
+		//	Program change - switches to a program in the PresetBank
+		param = new Vst::RangeParameter(USTRING("Program"), MIDI_PROGRAM_CHANGE, USTRING(""),
+			MIN_MIDI_PROGRAM, MAX_MIDI_PROGRAM, DEFAULT_MIDI_PROGRAM, MAX_MIDI_PROGRAM - MIN_MIDI_PROGRAM,
+			Vst::ParameterInfo::kCanAutomate | Vst::ParameterInfo::kIsProgramChange);
+		param->setPrecision(0); // fractional sig digits
+		parameters.addParameter(param);
+
+		//	Output meters - written by the Processor, so they are read-only here
+		param = new Vst::RangeParameter(USTRING("Peak L"), METER_PEAK_LEFT, USTRING("dB"),
+			MIN_METER_DB, MAX_METER_DB, MIN_METER_DB, 0, Vst::ParameterInfo::kIsReadOnly);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Peak R"), METER_PEAK_RIGHT, USTRING("dB"),
+			MIN_METER_DB, MAX_METER_DB, MIN_METER_DB, 0, Vst::ParameterInfo::kIsReadOnly);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("RMS L"), METER_RMS_LEFT, USTRING("dB"),
+			MIN_METER_DB, MAX_METER_DB, MIN_METER_DB, 0, Vst::ParameterInfo::kIsReadOnly);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("RMS R"), METER_RMS_RIGHT, USTRING("dB"),
+			MIN_METER_DB, MAX_METER_DB, MIN_METER_DB, 0, Vst::ParameterInfo::kIsReadOnly);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("Active Voices"), METER_ACTIVE_VOICES, USTRING(""),
+			MIN_ACTIVE_VOICES, MAX_ACTIVE_VOICES, MIN_ACTIVE_VOICES, MAX_ACTIVE_VOICES - MIN_ACTIVE_VOICES,
+			Vst::ParameterInfo::kIsReadOnly);
+		param->setPrecision(0); // fractional sig digits
+		parameters.addParameter(param);
+
+		//	sample streaming - times a voice ran out of streamed frames
+		param = new Vst::RangeParameter(USTRING("Stream Underruns"), SAMPLE_STREAM_UNDERRUNS, USTRING(""),
+			MIN_STREAM_UNDERRUNS, MAX_STREAM_UNDERRUNS, MIN_STREAM_UNDERRUNS, MAX_STREAM_UNDERRUNS - MIN_STREAM_UNDERRUNS,
+			Vst::ParameterInfo::kIsReadOnly);
+		param->setPrecision(0); // fractional sig digits
+		parameters.addParameter(param);
+
+#if DSP_PROFILER
+		//	DSP load - written by the Processor, read-only
+		param = new Vst::RangeParameter(USTRING("DSP Load"), PROFILER_LOAD, USTRING("%"),
+			MIN_DSP_LOAD_PCT, MAX_DSP_LOAD_PCT, MIN_DSP_LOAD_PCT, 0, Vst::ParameterInfo::kIsReadOnly);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("DSP Peak Load"), PROFILER_PEAK_LOAD, USTRING("%"),
+			MIN_DSP_LOAD_PCT, MAX_DSP_LOAD_PCT, MIN_DSP_LOAD_PCT, 0, Vst::ParameterInfo::kIsReadOnly);
+		param->setPrecision(1); // fractional sig digits
+		parameters.addParameter(param);
+
+		param = new Vst::RangeParameter(USTRING("DSP Overruns"), PROFILER_OVERRUNS, USTRING(""),
+			MIN_DSP_OVERRUNS, MAX_DSP_OVERRUNS, MIN_DSP_OVERRUNS, MAX_DSP_OVERRUNS - MIN_DSP_OVERRUNS,
+			Vst::ParameterInfo::kIsReadOnly);
+		param->setPrecision(0); // fractional sig digits
+		parameters.addParameter(param);
+#endif
 	}
 
 	// Here you could register some parameters
 
+	//	map the preset bank for program changes
+	char szBankPath[1024];
+	if (PresetBank::getDefaultPath(szBankPath, sizeof(szBankPath))) {
+		m_PresetBank.open(szBankPath);
+	}
+
 	return kResultOk;
 }
 
@@ -144,33 +510,12 @@ tresult PLUGIN_API NanoSynthController::initialize (FUnknown* context)
 tresult PLUGIN_API NanoSynthController::terminate ()
 {
 	// Here the Plug-in will be de-instanciated, last possibility to remove some memory!
+	m_PresetBank.close();
 
 	//---do not forget to call parent ------
 	return EditControllerEx1::terminate ();
 }
 
-/*
-	Controller::setParamNormalizedFromFile()
-	This sets the normalized (raw) parameter value
-	from the file's cooked (plain) value
-
-	tag - the Index value of a control
-	value - the cooked value from the file
-*/
-tresult PLUGIN_API NanoSynthController::setParamNormalizedFromFile(Vst::ParamID tag, Vst::ParamValue value)
-{
-	//	get the parameter
-	Vst::Parameter* pParam = EditController::getParameterObject(tag);
-
-	//	verify pointer
-	if (!pParam) {
-		return kResultFalse;
-	}
-
-	//	convert serialized value to normalized (raw)
-	return setParamNormalized(tag, pParam->toNormalized(value));
-}
-
 //------------------------------------------------------------------------
 /*
 	Controller::setComponentState()
@@ -181,55 +526,17 @@ tresult PLUGIN_API NanoSynthController::setParamNormalizedFromFile(Vst::ParamID
 */
 tresult PLUGIN_API NanoSynthController::setComponentState (IBStream* state)
 {
-	//	make a streamer interface using the 
-	//  IBStream* fileStream; this is for PC so
-	//  data is LittleEndian
-	IBStreamer stream(state, kLittleEndian);
-
-	//	variables for reading
-	uint64 version = 0;
-	double dDoubleParam = 0;
-
-	//	needed to convert to our UINT reads
-	uint32 udata = 0;
-	int32 data = 0;
-
-	//	read the version
-	if (!stream.readInt64u(version)) {
+	//	read the whole Processor state in one pass
+	SynthState synthState;
+	if (!synthState.read(state)) {
 		return kResultFalse;
 	}
 
-	//	reading the controlers values
-	// NOTE: reading and writting order must be the same
-	if (!stream.readInt32u(udata)) {
-		return kResultFalse;
-	} else {
-		setParamNormalizedFromFile(OSC_WAVEFORM, (Vst::ParamValue)udata);
-	}
-	if (!stream.readInt32u(udata)) {
-		return kResultFalse;
-	} else {
-		setParamNormalizedFromFile(LFO1_WAVEFORM, (Vst::ParamValue)udata);
-	}
-	if (!stream.readDouble(dDoubleParam)) {
-		return kResultFalse;
-	} else {
-		setParamNormalizedFromFile(LFO1_RATE, dDoubleParam);
-	}
-	if (!stream.readDouble(dDoubleParam)) {
-		return kResultFalse;
-	} else {
-		setParamNormalizedFromFile(LFO1_AMPLITUDE, dDoubleParam);
-	}
-	if (!stream.readInt32u(udata)) {
-		return kResultFalse;
-	} else {
-		setParamNormalizedFromFile(LFO1_MODE, (Vst::ParamValue)udata);
-	}
-
-	//	do next version...
-	if (version >= 1) {
-		//	add v1 stuff here
+	//	the schema ranges match our Parameters, so the normalized
+	//	values come straight from the table
+	const SynthStateField* pSchema = SynthState::getSchema();
+	for (int i = 0; i < SynthState::getFieldCount(); i++) {
+		setParamNormalized(pSchema[i].uParamID, synthState.getNormalized(i));
 	}
 
 	return kResultOk;
@@ -269,6 +576,26 @@ tresult PLUGIN_API NanoSynthController::getMidiControllerAssignment(int32 busInd
 	//       but it has 16 channels on it
 	if (busIndex == 0) {
 		id = -1;
+
+		//	MPE member channels have their own pitch bend, timbre and
+		//	pressure; the master channel (1) keeps the ones below
+		if (channel >= 1 && channel <= MPE_MEMBER_CHANNELS) {
+			switch (midiControllerNumber) {
+			case Vst::kPitchBend:
+				id = MPE_PITCHBEND + channel - 1;
+				break;
+			case Vst::kCtrlFilterCutoff:
+				id = MPE_TIMBRE + channel - 1;
+				break;
+			case Vst::kAfterTouch:
+				id = MPE_PRESSURE + channel - 1;
+				break;
+			}
+			if (id != -1) {
+				return kResultTrue;
+			}
+		}
+
 		switch (midiControllerNumber) {
 			// these messages handled in the Processor::process() method
 		case Vst::kPitchBend:
@@ -295,6 +622,10 @@ tresult PLUGIN_API NanoSynthController::getMidiControllerAssignment(int32 busInd
 		case Vst::kCtrlAllNotesOff:
 			id = MIDI_ALL_NOTES_OFF;
 			break;
+		//	same program on all 16 channels
+		case Vst::kCtrlProgramChange:
+			id = MIDI_PROGRAM_CHANGE;
+			break;
 		}
 		if (id == -1) {
 			id = 0;
@@ -308,6 +639,72 @@ tresult PLUGIN_API NanoSynthController::getMidiControllerAssignment(int32 busInd
 	return kResultFalse;
 }
 
+/* --- INoteExpressionController Interface
+	Controller::getNoteExpressionCount() etc.
+
+	Tuning, brightness and our own pressure, on every channel of the one event bus;
+	the Processor routes them to the note's voices by noteId.
+*/
+int32 PLUGIN_API NanoSynthController::getNoteExpressionCount(int32 busIndex, int16 channel)
+{
+	return busIndex == 0 ? m_NoteExpressionTypes.getNoteExpressionCount() : 0;
+}
+
+tresult PLUGIN_API NanoSynthController::getNoteExpressionInfo(int32 busIndex, int16 channel, int32 noteExpressionIndex, Vst::NoteExpressionTypeInfo& info /*out*/)
+{
+	if (busIndex == 0) {
+		return m_NoteExpressionTypes.getNoteExpressionInfo(noteExpressionIndex, info);
+	}
+	return kResultFalse;
+}
+
+tresult PLUGIN_API NanoSynthController::getNoteExpressionStringByValue(int32 busIndex, int16 channel, Vst::NoteExpressionTypeID id, Vst::NoteExpressionValue valueNormalized, Vst::String128 string /*out*/)
+{
+	if (busIndex == 0) {
+		return m_NoteExpressionTypes.getNoteExpressionStringByValue(id, valueNormalized, string);
+	}
+	return kResultFalse;
+}
+
+tresult PLUGIN_API NanoSynthController::getNoteExpressionValueByString(int32 busIndex, int16 channel, Vst::NoteExpressionTypeID id, const Vst::TChar* string, Vst::NoteExpressionValue& valueNormalized /*out*/)
+{
+	if (busIndex == 0) {
+		return m_NoteExpressionTypes.getNoteExpressionValueByString(id, string, valueNormalized);
+	}
+	return kResultFalse;
+}
+
+/* --- INoteExpressionPhysicalUIMapping Interface
+	Controller::getPhysicalUIMapping()
+
+	An MPE controller's X (pitch bend), Y (CC74) and pressure, for hosts that hand MPE
+	to the plugin as note expression rather than as member channel MIDI.
+*/
+tresult PLUGIN_API NanoSynthController::getPhysicalUIMapping(int32 busIndex, int16 channel, Vst::PhysicalUIMapList& list)
+{
+	if (busIndex != 0) {
+		return kResultFalse;
+	}
+
+	for (uint32 i = 0; i < list.count; i++) {
+		switch (list.map[i].physicalUITypeID) {
+		case Vst::kPUIXMovement:
+			list.map[i].noteExpressionTypeID = Vst::kTuningTypeID;
+			break;
+		case Vst::kPUIYMovement:
+			list.map[i].noteExpressionTypeID = Vst::kBrightnessTypeID;
+			break;
+		case Vst::kPUIPressure:
+			list.map[i].noteExpressionTypeID = kPressureTypeID;
+			break;
+		default:
+			list.map[i].noteExpressionTypeID = Vst::kInvalidTypeID;
+			break;
+		}
+	}
+	return kResultTrue;
+}
+
 //------------------------------------------------------------------------
 /*
 	Controller::createView()
@@ -324,14 +721,123 @@ IPlugView* PLUGIN_API NanoSynthController::createView (FIDString name)
 	return nullptr;
 }
 
+/*
+	Controller::createCustomView()
+	VST3EditorDelegate; makes the views named with custom-view-name
+	in the .uidesc. VSTGUI applies the size/origin attributes after.
+*/
+VSTGUI::CView* NanoSynthController::createCustomView (VSTGUI::UTF8StringPtr name, const VSTGUI::UIAttributes& attributes,
+													  const VSTGUI::IUIDescription* description, VSTGUI::VST3Editor* editor)
+{
+	if (name && strcmp(name, "ScopeView") == 0) {
+		return new ScopeView(VSTGUI::CRect(0, 0, 0, 0), this);
+	}
+	return nullptr;
+}
+
+/*
+	Controller::requestScopeFrame()
+	Called by the ScopeView timer; the Processor answers with a
+	SCOPE_FRAME_MSG_ID message.
+*/
+void NanoSynthController::requestScopeFrame()
+{
+	IPtr<Vst::IMessage> message = owned(allocateMessage());
+	if (message) {
+		message->setMessageID(SCOPE_REQUEST_MSG_ID);
+		sendMessage(message);
+	}
+}
+
+/*
+	Controller::notify()
+	Messages from the Processor, on the UI thread.
+*/
+tresult PLUGIN_API NanoSynthController::notify (Vst::IMessage* message)
+{
+	if (!message) {
+		return kInvalidArgument;
+	}
+
+	if (FIDStringsEqual(message->getMessageID(), SCOPE_FRAME_MSG_ID)) {
+		const void* pData = nullptr;
+		uint32 uSize = 0;
+		double dSampleRate = 0.0;
+
+		if (message->getAttributes()->getBinary(SCOPE_ATTR_SAMPLES, pData, uSize) == kResultOk &&
+			message->getAttributes()->getFloat(SCOPE_ATTR_SAMPLE_RATE, dSampleRate) == kResultOk) {
+			//	FFT happens here
+			m_ScopeAnalyzer.pushSamples((const float*)pData, uSize / sizeof(float), dSampleRate);
+		}
+		return kResultOk;
+	}
+
+	return EditControllerEx1::notify(message);
+}
+
 //------------------------------------------------------------------------
+//	the controls that change the Processor's latency (oversampling)
+static bool isLatencyParameter(Vst::ParamID tag)
+{
+	return tag == FILTER1_NLP || tag == FILTER1_OVERSAMPLING ||
+		tag == OVERSAMPLING_QUALITY || tag == OVERSAMPLING_OFFLINE_QUALITY;
+}
+
 tresult PLUGIN_API NanoSynthController::setParamNormalized (Vst::ParamID tag, Vst::ParamValue value)
 {
+	bool bLatencyChange = isLatencyParameter(tag) && getParamNormalized(tag) != value;
+
 	// called by host to update your parameters
 	tresult result = EditControllerEx1::setParamNormalized (tag, value);
+
+	//	the Processor loads the program on its own; follow it here
+	if (tag == MIDI_PROGRAM_CHANGE && result == kResultOk) {
+		loadProgram(value);
+	}
+
+	//	have the host ask for getLatencySamples() again
+	if (bLatencyChange && result == kResultOk && componentHandler) {
+		componentHandler->restartComponent(Vst::kLatencyChanged);
+	}
 	return result;
 }
 
+/*
+	Controller::loadProgram()
+	Moves the GUI controls to a program from the PresetBank.
+	The bank values are cooked, so they are normalized with the
+	SynthState schema ranges.
+
+	returns false for an empty slot
+*/
+bool NanoSynthController::loadProgram(Vst::ParamValue programNormalized)
+{
+	UINT uProgram = (UINT)(cookVSTGUIVariable(MIN_MIDI_PROGRAM, MAX_MIDI_PROGRAM, fmin(fmax(programNormalized, 0.0), 1.0)) + 0.5);
+	const double* pValues = m_PresetBank.getProgramValues(uProgram);
+	if (!pValues) {
+		return false;
+	}
+
+	int32 nFlags = Vst::kParamValuesChanged;
+	for (int i = 0; i < m_PresetBank.getFieldCount(); i++) {
+		Vst::ParamID uParamID = m_PresetBank.getFieldID(i);
+		int nField = SynthState::findField(uParamID);
+		if (nField >= 0) {
+			Vst::ParamValue value = SynthState::normalizeValue(nField, pValues[i]);
+			if (isLatencyParameter(uParamID) && getParamNormalized(uParamID) != value) {
+				nFlags |= Vst::kLatencyChanged;
+			}
+			EditControllerEx1::setParamNormalized(uParamID, value);
+		}
+	}
+
+	//	let the host refresh its view of the controls (and the latency)
+	if (componentHandler) {
+		componentHandler->restartComponent(nFlags);
+	}
+	return true;
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API NanoSynthController::getParamStringByValue (Vst::ParamID tag, Vst::ParamValue valueNormalized, Vst::String128 string)
 {
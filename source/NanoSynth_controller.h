@@ -7,7 +7,11 @@
 
 #include "public.sdk/source/vst/vsteditcontroller.h"
 #include "pluginterfaces/vst/ivstnoteexpression.h"
+#include "pluginterfaces/vst/ivstphysicalui.h"
+#include "public.sdk/source/vst/vstnoteexpressiontypes.h"
 #include "vstgui/plugin-bindings/vst3editor.h"
+#include "PresetBank.h"
+#include "ScopeView.h"
 
 
 namespace Quero {
@@ -25,9 +29,16 @@ namespace Quero {
 	NOTE: Multiple Inheriance
 		  EditController - the base controller stuff
 		  IMidiMapping - the MIDI Mapping Interface allowing us to RX MIDI
+		  INoteExpressionController - the per-note pitch, timbre and pressure we take
+		  INoteExpressionPhysicalUIMapping - which of them an MPE controller's X, Y and
+		  pressure move, for hosts that turn MPE into note expression
+		  VST3EditorDelegate - creates the custom views in the .uidesc
+		  IScopeDataSource - feeds the ScopeView
 
 */
-class NanoSynthController : public Steinberg::Vst::EditControllerEx1, public Steinberg::Vst::IMidiMapping
+class NanoSynthController : public Steinberg::Vst::EditControllerEx1, public Steinberg::Vst::IMidiMapping,
+	public Steinberg::Vst::INoteExpressionController, public Steinberg::Vst::INoteExpressionPhysicalUIMapping,
+	public VSTGUI::VST3EditorDelegate, public IScopeDataSource
 {
 public:
 //------------------------------------------------------------------------
@@ -58,20 +69,56 @@ public:
                                                          Steinberg::Vst::TChar* string,
                                                          Steinberg::Vst::ParamValue& valueNormalized) SMTG_OVERRIDE;
 
+	//	messages from the Processor
+	Steinberg::tresult PLUGIN_API notify (Steinberg::Vst::IMessage* message) SMTG_OVERRIDE;
+
+	//	VST3EditorDelegate
+	VSTGUI::CView* createCustomView (VSTGUI::UTF8StringPtr name, const VSTGUI::UIAttributes& attributes,
+									 const VSTGUI::IUIDescription* description, VSTGUI::VST3Editor* editor) SMTG_OVERRIDE;
+
+	//	IScopeDataSource
+	void requestScopeFrame() SMTG_OVERRIDE;
+	ScopeAnalyzer* getScopeAnalyzer() SMTG_OVERRIDE { return &m_ScopeAnalyzer; }
+
 	//	IMidiMapping
 	virtual Steinberg::tresult PLUGIN_API getMidiControllerAssignment(Steinberg::int32 busIndex, Steinberg::int16 channel, Steinberg::Vst::CtrlNumber midiControllerNumber, Steinberg::Vst::ParamID& id/*out*/);
 
-	Steinberg::tresult PLUGIN_API setParamNormalizedFromFile(Steinberg::Vst::ParamID tag, Steinberg::Vst::ParamValue value);
+	//	INoteExpressionController
+	Steinberg::int32 PLUGIN_API getNoteExpressionCount(Steinberg::int32 busIndex, Steinberg::int16 channel) SMTG_OVERRIDE;
+	Steinberg::tresult PLUGIN_API getNoteExpressionInfo(Steinberg::int32 busIndex, Steinberg::int16 channel,
+														Steinberg::int32 noteExpressionIndex, Steinberg::Vst::NoteExpressionTypeInfo& info /*out*/) SMTG_OVERRIDE;
+	Steinberg::tresult PLUGIN_API getNoteExpressionStringByValue(Steinberg::int32 busIndex, Steinberg::int16 channel,
+																 Steinberg::Vst::NoteExpressionTypeID id, Steinberg::Vst::NoteExpressionValue valueNormalized,
+																 Steinberg::Vst::String128 string /*out*/) SMTG_OVERRIDE;
+	Steinberg::tresult PLUGIN_API getNoteExpressionValueByString(Steinberg::int32 busIndex, Steinberg::int16 channel,
+																 Steinberg::Vst::NoteExpressionTypeID id, const Steinberg::Vst::TChar* string,
+																 Steinberg::Vst::NoteExpressionValue& valueNormalized /*out*/) SMTG_OVERRIDE;
+
+	//	INoteExpressionPhysicalUIMapping
+	Steinberg::tresult PLUGIN_API getPhysicalUIMapping(Steinberg::int32 busIndex, Steinberg::int16 channel,
+													   Steinberg::Vst::PhysicalUIMapList& list) SMTG_OVERRIDE;
 
 	//	oridinarily not needed; see documentation on Automation for using these
 	virtual Steinberg::Vst::ParamValue PLUGIN_API normalizedParamToPlain(Steinberg::Vst::ParamID id, Steinberg::Vst::ParamValue valueNormalized);
 	virtual Steinberg::Vst::ParamValue PLUGIN_API plainParamToNormalized(Steinberg::Vst::ParamID id, Steinberg::Vst::ParamValue plainValue);
 
 	
+	//	scope samples from the Processor, analyzed on the UI thread
+	ScopeAnalyzer m_ScopeAnalyzer;
+
+	//	the note expressions the Processor takes; the same on every channel
+	Steinberg::Vst::NoteExpressionTypeContainer m_NoteExpressionTypes;
+
+	//	programs; the same bank file the Processor maps
+	PresetBank m_PresetBank;
+	bool loadProgram(Steinberg::Vst::ParamValue programNormalized);
+
 	//	define the controller and interface
 	OBJ_METHODS(NanoSynthController, EditControllerEx1)
 	DEFINE_INTERFACES
 		DEF_INTERFACE(IMidiMapping)
+		DEF_INTERFACE(INoteExpressionController)
+		DEF_INTERFACE(INoteExpressionPhysicalUIMapping)
 	END_DEFINE_INTERFACES(EditControllerEx1)
 	REFCOUNT_METHODS(EditControllerEx1)
 
@@ -11,20 +11,14 @@
 #include "pluginterfaces/base/ustring.h"
 #include "pluginterfaces/base/ftypes.h"
 #include "pluginterfaces/base/futils.h"
+#include "pluginterfaces/base/smartpointer.h"
 #include "logscale.h"
 #include "SynthParamLimits.h"
-
-//	Synth Stuff
-#define SYNTH_PROC_BLOCKSIZE 32 // 32 samples per processing block = 0.7 mSec = OK for tactile response WP
-
-//	MIDI Logging -- comment out to disable
-#define LOG_MIDI 1
+#include "SynthState.h"
 
 using namespace Steinberg;
 
 namespace Quero {
-//	for versioning in serialization
-static uint64 NanoSynthVersion = 0;
 
 //	this defines a logarithmig scaling for the filter Fc control
 Vst::LogScale<Vst::ParamValue> filterLogScale2(0.0,		/* VST GUI Variable MIN */
@@ -52,6 +46,63 @@ NanoSynthProcessor::NanoSynthProcessor ()
 	m_dLFO1Amplitude = DEFAULT_UNIPOLAR;
 	m_uLFO1Mode = DEFAULT_LFO_MODE;
 
+	m_Filter1Params.dFcControl = DEFAULT_FILTER_FC;
+	m_Filter1Params.dQControl = DEFAULT_FILTER_Q;
+	m_Filter1Params.dAuxControl = 0.0;
+	m_Filter1Params.dSaturation = DEFAULT_FILTER_SATURATION;
+	m_Filter1Params.uFilterType = DEFAULT_FILTER_TYPE;
+	m_Filter1Params.uNLP = DEFAULT_ONOFF_SWITCH;
+	m_uFilter1KeyTrack = DEFAULT_FILTER_KEYTRACK;
+	m_dFilter1KeyTrackIntensity = DEFAULT_FILTER_KEYTRACK_INTENSITY;
+
+	m_EG1Params.dAttackTime_mSec = DEFAULT_EG_ATTACK_TIME;
+	m_EG1Params.dDecayTime_mSec = DEFAULT_EG_DECAY_TIME;
+	m_EG1Params.dSustainLevel = DEFAULT_EG_SUSTAIN_LEVEL;
+	m_EG1Params.dReleaseTime_mSec = DEFAULT_EG_RELEASE_TIME;
+	m_EG1Params.dShutdownTime_mSec = DEFAULT_EG_SHUTDOWN_TIME;
+	m_EG1Params.bLegatoMode = DEFAULT_LEGATO_MODE != 0;
+	m_EG1Params.bResetToZero = DEFAULT_RESET_TO_ZERO != 0;
+
+	m_DCAParams.dAmplitude_dB = DEFAULT_OUTPUT_AMPLITUDE_DB;
+	m_DCAParams.dPanControl = DEFAULT_BIPOLAR;
+
+	m_uFilter1Oversampling = DEFAULT_FILTER_OVERSAMPLING;
+	m_uOversamplingQuality = DEFAULT_OVERSAMPLING_QUALITY;
+	m_uOversamplingOfflineQuality = DEFAULT_OVERSAMPLING_OFFLINE_QUALITY;
+
+	memset(&m_VoiceParams, 0, sizeof(globalVoiceParams));
+	m_VoiceParams.dAmplitude_ACmix = DEFAULT_UNIPOLAR_HALF;
+	m_VoiceParams.dAmplitude_BDmix = DEFAULT_UNIPOLAR_HALF;
+	m_VoiceParams.dOrbitXAmp = DEFAULT_UNIPOLAR;
+	m_VoiceParams.dOrbitYAmp = DEFAULT_UNIPOLAR;
+	m_VoiceParams.uVectorPathMode = DEFAULT_PATH_MODE;
+	m_uVectorMode = DEFAULT_ONOFF_SWITCH;
+	m_uVectorWaveform[0] = DEFAULT_VECTOR_A_WAVEFORM;
+	m_uVectorWaveform[1] = DEFAULT_VECTOR_B_WAVEFORM;
+	m_uVectorWaveform[2] = DEFAULT_VECTOR_C_WAVEFORM;
+	m_uVectorWaveform[3] = DEFAULT_VECTOR_D_WAVEFORM;
+	m_dVectorPathTime = DEFAULT_VECTOR_PATH_TIME;
+
+	m_uSampleMode = DEFAULT_ONOFF_SWITCH;
+	memset(&m_SampleOscParams, 0, sizeof(globalOscillatorParams));
+	m_SampleOscParams.uLoopMode = DEFAULT_LOOP_MODE;
+	m_uSampleQuality = DEFAULT_SAMPLE_QUALITY;
+	m_uMPEMode = DEFAULT_ONOFF_SWITCH;
+
+	m_uUnisonVoices = DEFAULT_UNISON_VOICES;
+	m_dUnisonDetune = DEFAULT_UNISON_DETUNE_CENTS;
+	m_dUnisonCurve = DEFAULT_UNIPOLAR;
+	m_dUnisonSpread = DEFAULT_UNIPOLAR_HALF;
+	m_uUnisonPhase = DEFAULT_UNISON_PHASE;
+	m_uStereoMask = 0;
+
+	//	the voices read the path from here
+	updateVectorPath();
+	for (UINT i = 0; i < MAX_VOICES; i++) {
+		m_Voices[i].setVectorPath(m_fVectorPathTable);
+	}
+
+	m_uNoteOnCount = 0;
 	m_dLastNoteFrequency = 0.0;
 
 	//	sus pedal support
@@ -66,6 +117,7 @@ NanoSynthProcessor::NanoSynthProcessor ()
 	m_uMIDIVolumeCC7 = DEFAULT_MIDI_VOLUME;  // note defaults to 127
 	m_uMIDIPanCC10 = DEFAULT_MIDI_PAN;     // 64 = center pan
 	m_uMIDIExpressionCC11 = DEFAULT_MIDI_EXPRESSION;
+	m_uMIDIProgram = DEFAULT_MIDI_PROGRAM;
 }
 
 //------------------------------------------------------------------------
@@ -98,6 +150,37 @@ tresult PLUGIN_API NanoSynthProcessor::initialize (FUnknown* context)
 	//	MIDI event input bus, 16 channels
 	addEventInput (STR16 ("Event Input"), 16);
 
+	//	map the preset bank, if there is one; program changes are ignored without it
+	char szBankPath[1024];
+	if (PresetBank::getDefaultPath(szBankPath, sizeof(szBankPath))) {
+		m_PresetBank.open(szBankPath);
+	}
+
+	//	a Scala scale (and mapping) next to the bank replaces 12-TET
+	char szScalaPath[1024];
+	char szKbmPath[1024];
+	if (PresetBank::getDataPath(szScalaPath, sizeof(szScalaPath), TUNING_SCALA_FILE_NAME) &&
+		PresetBank::getDataPath(szKbmPath, sizeof(szKbmPath), TUNING_KBM_FILE_NAME)) {
+		if (!m_Tuning.loadScala(szScalaPath, szKbmPath)) {
+			m_Tuning.loadScala(szScalaPath);
+		}
+	}
+
+	//	a sample next to the bank is played in sample mode; only its head
+	//	is loaded, the rest streams while notes play. A keymap there
+	//	takes over from it
+	char szSamplePath[1024];
+	if (PresetBank::getDataPath(szSamplePath, sizeof(szSamplePath), SAMPLE_STREAM_FILE_NAME)) {
+		m_StreamedSample.open(szSamplePath);
+	}
+	char szKeymapPath[1024];
+	if (PresetBank::getDataPath(szKeymapPath, sizeof(szKeymapPath), KEYMAP_FILE_NAME)) {
+		m_Keymap.load(szKeymapPath);
+	}
+	for (UINT i = 0; i < MAX_VOICES; i++) {
+		m_Voices[i].m_SampleOsc.setSample(&m_StreamedSample);
+	}
+
 	return kResultOk;
 }
 
@@ -105,6 +188,10 @@ tresult PLUGIN_API NanoSynthProcessor::initialize (FUnknown* context)
 tresult PLUGIN_API NanoSynthProcessor::terminate ()
 {
 	// Here the Plug-in will be de-instanciated, last possibility to remove some memory!
+	m_PresetBank.close();
+	m_SampleStreamer.stop();
+	m_StreamedSample.close();
+	m_Keymap.clear();
 	
 	//---do not forget to call parent ------
 	return AudioEffect::terminate ();
@@ -125,17 +212,60 @@ tresult PLUGIN_API NanoSynthProcessor::setActive (TBool state)
 		// 
 		// 
 		//	set sample rates
-		m_Osc1.setSampleRate((double)processSetup.sampleRate);
-		m_Osc2.setSampleRate((double)processSetup.sampleRate);
-		m_LFO1.setSampleRate((double)processSetup.sampleRate);
+		for (UINT i = 0; i < MAX_VOICES; i++) {
+			m_Voices[i].setSampleRate((double)processSetup.sampleRate);
+#ifdef NANOSYNTH_RENDER_SEED
+			//	reference renders: identical noise on every run
+			m_Voices[i].setNoiseSeed(NANOSYNTH_RENDER_SEED + 3 * i);
+#endif
+		}
+		m_DCBlocker.init(VOICE_FILTER_LANES, 1);
+		m_DCBlocker.setCoefficients(0, BiQuadCascade::calculateDCBlocker(SYNTH_DC_BLOCK_FC, (double)processSetup.sampleRate), false);
+		//	also sets the filter bank's (oversampled) rate; the quality
+		//	follows processSetup.processMode, so a bounce gets its own
+		updateOversampling(true);
+		m_Tuning.setSampleRate((double)processSetup.sampleRate);
+
+		//	meters run once per processing block
+		m_OutputMeter.setSampleRate((double)processSetup.sampleRate, SYNTH_PROC_BLOCKSIZE);
+		m_ScopeTap.setSampleRate((double)processSetup.sampleRate);
+		m_Expression.setSampleRate((double)processSetup.sampleRate, SYNTH_PROC_BLOCKSIZE);
+		m_Expression.reset();
+
+		//	one stream per voice
+		SampleStream* pStreams[MAX_VOICES];
+		for (UINT i = 0; i < MAX_VOICES; i++) {
+			pStreams[i] = &m_Voices[i].m_SampleOsc.m_Stream;
+		}
+		m_SampleStreamer.start(pStreams, MAX_VOICES);
+
+#if DSP_PROFILER
+		//	start a fresh report for this run
+		m_Profiler.setSampleRate((double)processSetup.sampleRate);
+		char szReportPath[1024];
+		if (DSPProfiler::getDefaultDumpPath(szReportPath, sizeof(szReportPath), this)) {
+			m_Profiler.startDumpThread(szReportPath);
+		}
+#endif
 
-		//	detune
-		m_Osc2.m_nCents = 2.5; // +2.5 cents detuned
+#if TRACE_LOG
+		char szTracePath[1024];
+		if (TraceLog::getDefaultPath(szTracePath, sizeof(szTracePath), this)) {
+			m_TraceLog.open(szTracePath);
+		}
+#endif
 
 		//	update all
 		update();
 	} else {
 		//	do OFF stuff
+		m_SampleStreamer.stop();
+#if DSP_PROFILER
+		m_Profiler.stopDumpThread();
+#endif
+#if TRACE_LOG
+		m_TraceLog.close();
+#endif
 	}
 
 	//--- called when the Plug-in is enable/disable (On/Off) -----
@@ -150,16 +280,360 @@ void NanoSynthProcessor::update()
 {
 	//	Connection of the GUI controls to the synth
 	//	transfering the GUI control variables over to the synth objects
-	m_Osc1.m_uWaveform = m_uOscWaveform;
-	m_Osc2.m_uWaveform = m_uOscWaveform;
-	m_Osc1.update();
-	m_Osc2.update();
-
-	m_LFO1.m_uWaveform = m_uLFO1Waveform;
-	m_LFO1.m_dAmplitude = m_dLFO1Amplitude;
-	m_LFO1.m_dOscFo = m_dLFO1Rate;
-	m_LFO1.m_uLFOMode = m_uLFO1Mode;
-	m_LFO1.update();
+	updateVectorPath();
+
+	for (UINT i = 0; i < MAX_VOICES; i++) {
+		SynthVoice& voice = m_Voices[i];
+		//	in vector mode the oscillators are sources A-D
+		voice.m_bVectorMode = m_uVectorMode != 0;
+		voice.m_Osc1.m_uWaveform = voice.m_bVectorMode ? m_uVectorWaveform[0] : m_uOscWaveform;
+		voice.m_Osc2.m_uWaveform = voice.m_bVectorMode ? m_uVectorWaveform[1] : m_uOscWaveform;
+		voice.m_Osc3.m_uWaveform = m_uVectorWaveform[2];
+		voice.m_Osc4.m_uWaveform = m_uVectorWaveform[3];
+		voice.m_dJoystickX = m_VoiceParams.dAmplitude_ACmix;
+		voice.m_dJoystickY = m_VoiceParams.dAmplitude_BDmix;
+		voice.setVectorPathMode(m_VoiceParams.uVectorPathMode);
+
+		//	sample mode needs a sample
+		voice.m_bSampleMode = m_uSampleMode != 0 && (m_StreamedSample.isOpen() || m_Keymap.isLoaded());
+		voice.m_SampleOsc.m_uLoopMode = m_SampleOscParams.uLoopMode;
+		voice.m_SampleOsc.setQuality(m_uSampleQuality);
+
+		voice.m_Unison.setUnison(m_uUnisonVoices, m_dUnisonDetune, m_dUnisonCurve, m_dUnisonSpread);
+		voice.m_Unison.setPhaseMode(m_uUnisonPhase);
+
+		voice.m_LFO1.m_uWaveform = m_uLFO1Waveform;
+		voice.m_LFO1.m_dAmplitude = m_dLFO1Amplitude;
+		voice.m_LFO1.setOscFo(m_dLFO1Rate);
+		voice.m_LFO1.m_uLFOMode = m_uLFO1Mode;
+
+		voice.m_EG1.m_dAttackTime_mSec = m_EG1Params.dAttackTime_mSec;
+		voice.m_EG1.m_dDecayTime_mSec = m_EG1Params.dDecayTime_mSec;
+		voice.m_EG1.m_dSustainLevel = m_EG1Params.dSustainLevel;
+		voice.m_EG1.m_dReleaseTime_mSec = m_EG1Params.dReleaseTime_mSec;
+		voice.m_EG1.m_dShutdownTime_mSec = m_EG1Params.dShutdownTime_mSec;
+		voice.m_EG1.m_bLegatoMode = m_EG1Params.bLegatoMode;
+		voice.m_EG1.m_bResetToZero = m_EG1Params.bResetToZero;
+		voice.update();
+	}
+
+	m_FilterBank.m_dFcControl = m_Filter1Params.dFcControl;
+	m_FilterBank.m_dQControl = m_Filter1Params.dQControl;
+	m_FilterBank.m_uFilterType = m_Filter1Params.uFilterType;
+	m_FilterBank.m_uNLP = m_Filter1Params.uNLP;
+	m_FilterBank.m_dSaturation = m_Filter1Params.dSaturation;
+	m_FilterBank.m_uKeyTrack = m_uFilter1KeyTrack;
+	m_FilterBank.m_dKeyTrackIntensity = m_dFilter1KeyTrackIntensity;
+	m_FilterBank.update();
+	updateOversampling(false);
+
+	m_DCA.m_dAmplitude_dB = m_DCAParams.dAmplitude_dB;
+	m_DCA.m_dPanControl = m_DCAParams.dPanControl;
+	m_DCA.m_uMIDIVolumeCC7 = m_uMIDIVolumeCC7;
+	m_DCA.m_uMIDIPanCC10 = m_uMIDIPanCC10;
+	m_DCA.m_uMIDIExpressionCC11 = m_uMIDIExpressionCC11;
+	m_DCA.update();
+
+	m_Expression.m_bMPE = m_uMPEMode != 0;
+}
+
+/*
+	Processor::updateExpression()
+	One block of note expression smoothing; only the voices whose values
+	moved (or that just started) are touched. Pressure adds up to
+	VOICE_EXPRESSION_PRESSURE_DB of level, timbre moves the filter Fc
+	VOICE_EXPRESSION_TIMBRE_OCTAVES either way.
+*/
+void NanoSynthProcessor::updateExpression()
+{
+	UINT uMoved = m_Expression.update();
+	for (UINT i = 0; i < MAX_VOICES && uMoved; i++) {
+		if (!(uMoved & (1u << i))) {
+			continue;
+		}
+		uMoved &= ~(1u << i);
+
+		m_Voices[i].setExpressionPitch(m_Expression.getValue(i, EXPRESSION_PITCH));
+		m_DCA.setVoiceExpression(i, pow(10.0, m_Expression.getValue(i, EXPRESSION_PRESSURE) * VOICE_EXPRESSION_PRESSURE_DB / 20.0));
+		m_FilterBank.setVoiceFcMod(i, unipolarToBipolar(m_Expression.getValue(i, EXPRESSION_TIMBRE)) * VOICE_EXPRESSION_TIMBRE_OCTAVES);
+	}
+}
+
+/*
+	Processor::updateVectorPath()
+	The path is a loop round the joystick through the A, B, C and D
+	sides of the orbit: (-x, +y), (+x, +y), (+x, -y), (-x, -y). The
+	AC/BD columns hold these as offsets, which the voices add to the
+	joystick, so moving the joystick moves a running path with it; the
+	A-D columns hold the mixes at the points for a centred joystick.
+	Each leg takes the path time; the steps after the last are unused.
+*/
+void NanoSynthProcessor::updateVectorPath()
+{
+	static const double dPointX[4] = { -1.0, +1.0, +1.0, -1.0 };
+	static const double dPointY[4] = { +1.0, +1.0, -1.0, -1.0 };
+
+	memset(m_fVectorPathTable, 0, sizeof(m_fVectorPathTable));
+	for (int i = 0; i < 4; i++) {
+		double dX = dPointX[i] * 0.5 * m_VoiceParams.dOrbitXAmp;
+		double dY = dPointY[i] * 0.5 * m_VoiceParams.dOrbitYAmp;
+
+		double dA, dB, dC, dD, dACMix, dBDMix;
+		calculateVectorJoystickValues(0.5 + dX, 0.5 + dY, dA, dB, dC, dD, dACMix, dBDMix);
+
+		m_fVectorPathTable[JS_PROG_INDEX(i, 0)] = (float)dA;
+		m_fVectorPathTable[JS_PROG_INDEX(i, 1)] = (float)dB;
+		m_fVectorPathTable[JS_PROG_INDEX(i, 2)] = (float)dC;
+		m_fVectorPathTable[JS_PROG_INDEX(i, 3)] = (float)dD;
+		m_fVectorPathTable[JS_PROG_INDEX(i, 4)] = (float)m_dVectorPathTime;
+		m_fVectorPathTable[JS_PROG_INDEX(i, 5)] = (float)dX;
+		m_fVectorPathTable[JS_PROG_INDEX(i, 6)] = (float)dY;
+	}
+}
+
+int NanoSynthProcessor::getOversamplingFactor()
+{
+	//	only the saturating filter makes harmonics that can alias
+	return m_Filter1Params.uNLP != 0 ? 1 << m_uFilter1Oversampling : 1;
+}
+
+UINT NanoSynthProcessor::getOversamplingQuality()
+{
+	return processSetup.processMode == Vst::kOffline ? m_uOversamplingOfflineQuality : m_uOversamplingQuality;
+}
+
+/*
+	Processor::updateOversampling()
+	Re-inits the Oversampler when the factor or quality changes; a new
+	factor is also a new sample rate for the filter bank, which clears
+	its state. No allocation, so this is fine from process().
+*/
+void NanoSynthProcessor::updateOversampling(bool bReset)
+{
+	int nFactor = getOversamplingFactor();
+	UINT uQuality = getOversamplingQuality();
+	if (!bReset && nFactor == m_Oversampler.getFactor() && uQuality == m_Oversampler.getQuality()) {
+		return;
+	}
+
+	bool bNewRate = bReset || nFactor != m_Oversampler.getFactor();
+	m_Oversampler.init(VOICE_FILTER_LANES, nFactor, uQuality);
+	if (bNewRate) {
+		m_FilterBank.setSampleRate((double)processSetup.sampleRate * nFactor);
+	}
+}
+
+/*
+	Processor::setCookedParameter()
+	Sets a GUI control variable from a cooked value; used for
+	state and program loading. Does not call update().
+
+	The value is clamped to the parameter's schema range first; a
+	bank or stream value out of range must not reach the (UINT)
+	casts below, which index waveform and mode tables.
+*/
+void NanoSynthProcessor::setCookedParameter(Vst::ParamID uParamID, double dCookedValue)
+{
+	int nField = SynthState::findField(uParamID);
+	if (nField < 0) {
+		return;
+	}
+	dCookedValue = SynthState::clampToField(nField, dCookedValue);
+
+	switch (uParamID) {
+		case OSC_WAVEFORM: {
+			m_uOscWaveform = (UINT)dCookedValue;
+			break;
+		}
+		case LFO1_WAVEFORM: {
+			m_uLFO1Waveform = (UINT)dCookedValue;
+			break;
+		}
+		case LFO1_RATE: {
+			m_dLFO1Rate = dCookedValue;
+			break;
+		}
+		case LFO1_AMPLITUDE: {
+			m_dLFO1Amplitude = dCookedValue;
+			break;
+		}
+		case LFO1_MODE: {
+			m_uLFO1Mode = (UINT)dCookedValue;
+			break;
+		}
+		case FILTER1_FC: {
+			m_Filter1Params.dFcControl = dCookedValue;
+			break;
+		}
+		case FILTER1_Q: {
+			m_Filter1Params.dQControl = dCookedValue;
+			break;
+		}
+		case FILTER1_TYPE: {
+			m_Filter1Params.uFilterType = (UINT)dCookedValue;
+			break;
+		}
+		case FILTER1_KEYTRACK: {
+			m_uFilter1KeyTrack = (UINT)dCookedValue;
+			break;
+		}
+		case FILTER1_KEYTRACK_INTENSITY: {
+			m_dFilter1KeyTrackIntensity = dCookedValue;
+			break;
+		}
+		case FILTER1_NLP: {
+			m_Filter1Params.uNLP = (UINT)dCookedValue;
+			break;
+		}
+		case FILTER1_SATURATION: {
+			m_Filter1Params.dSaturation = dCookedValue;
+			break;
+		}
+		case EG1_ATTACK_TIME: {
+			m_EG1Params.dAttackTime_mSec = dCookedValue;
+			break;
+		}
+		case EG1_DECAY_TIME: {
+			m_EG1Params.dDecayTime_mSec = dCookedValue;
+			break;
+		}
+		case EG1_SUSTAIN_LEVEL: {
+			m_EG1Params.dSustainLevel = dCookedValue;
+			break;
+		}
+		case EG1_RELEASE_TIME: {
+			m_EG1Params.dReleaseTime_mSec = dCookedValue;
+			break;
+		}
+		case EG1_LEGATO_MODE: {
+			m_EG1Params.bLegatoMode = dCookedValue > 0.5;
+			break;
+		}
+		case EG1_RESET_TO_ZERO: {
+			m_EG1Params.bResetToZero = dCookedValue > 0.5;
+			break;
+		}
+		case DCA_AMPLITUDE_DB: {
+			m_DCAParams.dAmplitude_dB = dCookedValue;
+			break;
+		}
+		case DCA_PAN: {
+			m_DCAParams.dPanControl = dCookedValue;
+			break;
+		}
+		case FILTER1_OVERSAMPLING: {
+			m_uFilter1Oversampling = (UINT)dCookedValue;
+			break;
+		}
+		case OVERSAMPLING_QUALITY: {
+			m_uOversamplingQuality = (UINT)dCookedValue;
+			break;
+		}
+		case OVERSAMPLING_OFFLINE_QUALITY: {
+			m_uOversamplingOfflineQuality = (UINT)dCookedValue;
+			break;
+		}
+		case VECTOR_MODE: {
+			m_uVectorMode = (UINT)dCookedValue;
+			break;
+		}
+		case VECTOR_A_WAVEFORM: {
+			m_uVectorWaveform[0] = (UINT)dCookedValue;
+			break;
+		}
+		case VECTOR_B_WAVEFORM: {
+			m_uVectorWaveform[1] = (UINT)dCookedValue;
+			break;
+		}
+		case VECTOR_C_WAVEFORM: {
+			m_uVectorWaveform[2] = (UINT)dCookedValue;
+			break;
+		}
+		case VECTOR_D_WAVEFORM: {
+			m_uVectorWaveform[3] = (UINT)dCookedValue;
+			break;
+		}
+		case VECTOR_JOYSTICK_X: {
+			m_VoiceParams.dAmplitude_ACmix = dCookedValue;
+			break;
+		}
+		case VECTOR_JOYSTICK_Y: {
+			m_VoiceParams.dAmplitude_BDmix = dCookedValue;
+			break;
+		}
+		case VECTOR_ORBIT_X: {
+			m_VoiceParams.dOrbitXAmp = dCookedValue;
+			break;
+		}
+		case VECTOR_ORBIT_Y: {
+			m_VoiceParams.dOrbitYAmp = dCookedValue;
+			break;
+		}
+		case VECTOR_PATH_MODE: {
+			m_VoiceParams.uVectorPathMode = (UINT)dCookedValue;
+			break;
+		}
+		case VECTOR_PATH_TIME: {
+			m_dVectorPathTime = dCookedValue;
+			break;
+		}
+		case SAMPLE_MODE: {
+			m_uSampleMode = (UINT)dCookedValue;
+			break;
+		}
+		case SAMPLE_LOOP_MODE: {
+			m_SampleOscParams.uLoopMode = (UINT)dCookedValue;
+			break;
+		}
+		case SAMPLE_QUALITY: {
+			m_uSampleQuality = (UINT)dCookedValue;
+			break;
+		}
+		case MPE_MODE: {
+			m_uMPEMode = (UINT)dCookedValue;
+			break;
+		}
+		case UNISON_VOICES: {
+			m_uUnisonVoices = (UINT)dCookedValue;
+			break;
+		}
+		case UNISON_DETUNE: {
+			m_dUnisonDetune = dCookedValue;
+			break;
+		}
+		case UNISON_CURVE: {
+			m_dUnisonCurve = dCookedValue;
+			break;
+		}
+		case UNISON_SPREAD: {
+			m_dUnisonSpread = dCookedValue;
+			break;
+		}
+		case UNISON_PHASE: {
+			m_uUnisonPhase = (UINT)dCookedValue;
+			break;
+		}
+	}
+}
+
+/*
+	Processor::loadProgram()
+	Copies a program's cooked values out of the mapped bank; two table
+	lookups and one pass over the columns, so it is safe in process().
+	returns false for an empty slot
+*/
+bool NanoSynthProcessor::loadProgram(UINT uProgram)
+{
+	const double* pValues = m_PresetBank.getProgramValues(uProgram);
+	if (!pValues) {
+		return false;
+	}
+
+	int nFieldCount = m_PresetBank.getFieldCount();
+	for (int i = 0; i < nFieldCount; i++) {
+		setCookedParameter(m_PresetBank.getFieldID(i), pValues[i]);
+	}
+	return true;
 }
 
 /*
@@ -177,7 +651,7 @@ bool NanoSynthProcessor::doControlUpdate(Steinberg::Vst::ProcessData& data)
 	}
 
 	//	get the param count and setup a loop for processing queue data
-	int32 count = data.inputParameterChanges->getParameterCount();
+	int32 count = REALTIME_HOST_CALL(data.inputParameterChanges->getParameterCount());
 
 	//	make sure there is something there
 	if (count <= 0) {
@@ -186,23 +660,18 @@ bool NanoSynthProcessor::doControlUpdate(Steinberg::Vst::ProcessData& data)
 
 	//	loop
 	for (int32 i = 0; i < count; i++) {
-		#if(LOG_MIDI && _DEBUG)
-			FDebugPrint("Something changed\n");
-		#endif
 		//	get the message queue for ith parameter
-		Vst::IParamValueQueue* queue = data.inputParameterChanges->getParameterData(i);
+		Vst::IParamValueQueue* queue = REALTIME_HOST_CALL(data.inputParameterChanges->getParameterData(i));
 
 		if (queue) {
-			#if(LOG_MIDI && _DEBUG)
-						FDebugPrint("Inside queue\n");
-			#endif
 			//	check for control points
-			if (queue->getPointCount() <= 0) {
+			int32 pointCount = REALTIME_HOST_CALL(queue->getPointCount());
+			if (pointCount <= 0) {
 				return false;
 			}
 			int32 sampleOffset = 0.0;
 			Vst::ParamValue value = 0.0;
-			Vst::ParamID pid = queue->getParameterId();
+			Vst::ParamID pid = REALTIME_HOST_CALL(queue->getParameterId());
 
 			//	this is the same as userInterfaceChange(); these only are updated if a change has 
 			//	occurred (a control got moved)
@@ -213,10 +682,25 @@ bool NanoSynthProcessor::doControlUpdate(Steinberg::Vst::ProcessData& data)
 			// NOTE: These are NOT MIDI Events! Not possible to get the channel directly
 
 			//	get the last point in queue
-			if (queue->getPoint(queue->getPointCount() - 1, /* last update point */
+			if (REALTIME_HOST_CALL(queue->getPoint(pointCount - 1, /* last update point */
 				sampleOffset,			/* sample offset */
-				value) == kResultTrue)	/* value = [0..1] */
+				value)) == kResultTrue)	/* value = [0..1] */
 			{
+				//	MPE member channels 2 -> 16 stream every block; the
+				//	VoiceExpression holds them and updateExpression() passes
+				//	them on to the channel's voices, so they skip update()
+				if (pid >= MPE_PITCHBEND && pid < MPE_PRESSURE + MPE_MEMBER_CHANNELS) {
+					if (pid < MPE_TIMBRE) {
+						m_Expression.setChannelValue(pid - MPE_PITCHBEND + 1, EXPRESSION_PITCH, unipolarToBipolar(value) * VOICE_EXPRESSION_MPE_BEND_RANGE);
+					} else if (pid < MPE_PRESSURE) {
+						m_Expression.setChannelValue(pid - MPE_TIMBRE + 1, EXPRESSION_TIMBRE, value);
+					} else {
+						m_Expression.setChannelValue(pid - MPE_PRESSURE + 1, EXPRESSION_PRESSURE, value);
+					}
+					TRACE_PARAM(m_TraceLog, TRACE_CAT_MIDI, TRACE_PARAM_CHANGE, pid, (float)value, sampleOffset);
+					continue;
+				}
+
 				//	at least one param changed
 				paramChange = true;
 
@@ -224,26 +708,260 @@ bool NanoSynthProcessor::doControlUpdate(Steinberg::Vst::ProcessData& data)
 					//	GUI control code
 					case OSC_WAVEFORM: {
 						m_uOscWaveform = (UINT)cookVSTGUIVariable(MIN_PITCHED_OSC_WAVEFORM, MAX_PITCHED_OSC_WAVEFORM, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uOscWaveform, sampleOffset);
 						break;
 					}
 
 					case LFO1_WAVEFORM: {
 						m_uLFO1Waveform = (UINT)cookVSTGUIVariable(MIN_LFO_WAVEFORM, MAX_LFO_WAVEFORM, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uLFO1Waveform, sampleOffset);
 						break;
 					}
 
 					case LFO1_RATE: {
 						m_dLFO1Rate = cookVSTGUIVariable(MIN_LFO_RATE, MAX_LFO_RATE, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_dLFO1Rate, sampleOffset);
 						break;
 					}
 
 					case LFO1_AMPLITUDE: {
 						m_dLFO1Amplitude = cookVSTGUIVariable(MIN_UNIPOLAR, MAX_UNIPOLAR, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_dLFO1Amplitude, sampleOffset);
 						break;
 					}
 
 					case LFO1_MODE: {
 						m_uLFO1Mode = cookVSTGUIVariable(MIN_LFO_MODE, MAX_LFO_MODE, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uLFO1Mode, sampleOffset);
+						break;
+					}
+
+					//	log taper, same as the Controller's Parameter
+					case FILTER1_FC: {
+						m_Filter1Params.dFcControl = filterLogScale2.scale(value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_Filter1Params.dFcControl, sampleOffset);
+						break;
+					}
+
+					case FILTER1_Q: {
+						m_Filter1Params.dQControl = cookVSTGUIVariable(MIN_FILTER_Q, MAX_FILTER_Q, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_Filter1Params.dQControl, sampleOffset);
+						break;
+					}
+
+					case FILTER1_TYPE: {
+						m_Filter1Params.uFilterType = (UINT)cookVSTGUIVariable(MIN_FILTER_TYPE, MAX_FILTER_TYPE, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_Filter1Params.uFilterType, sampleOffset);
+						break;
+					}
+
+					case FILTER1_KEYTRACK: {
+						m_uFilter1KeyTrack = (UINT)cookVSTGUIVariable(MIN_ONOFF_SWITCH, MAX_ONOFF_SWITCH, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uFilter1KeyTrack, sampleOffset);
+						break;
+					}
+
+					case FILTER1_KEYTRACK_INTENSITY: {
+						m_dFilter1KeyTrackIntensity = cookVSTGUIVariable(MIN_FILTER_KEYTRACK_INTENSITY, MAX_FILTER_KEYTRACK_INTENSITY, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_dFilter1KeyTrackIntensity, sampleOffset);
+						break;
+					}
+
+					case FILTER1_NLP: {
+						m_Filter1Params.uNLP = (UINT)cookVSTGUIVariable(MIN_ONOFF_SWITCH, MAX_ONOFF_SWITCH, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_Filter1Params.uNLP, sampleOffset);
+						break;
+					}
+
+					case FILTER1_SATURATION: {
+						m_Filter1Params.dSaturation = cookVSTGUIVariable(MIN_FILTER_SATURATION, MAX_FILTER_SATURATION, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_Filter1Params.dSaturation, sampleOffset);
+						break;
+					}
+
+					case EG1_ATTACK_TIME: {
+						m_EG1Params.dAttackTime_mSec = cookVSTGUIVariable(MIN_EG_ATTACK_TIME, MAX_EG_ATTACK_TIME, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_EG1Params.dAttackTime_mSec, sampleOffset);
+						break;
+					}
+
+					case EG1_DECAY_TIME: {
+						m_EG1Params.dDecayTime_mSec = cookVSTGUIVariable(MIN_EG_DECAY_TIME, MAX_EG_DECAY_TIME, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_EG1Params.dDecayTime_mSec, sampleOffset);
+						break;
+					}
+
+					case EG1_SUSTAIN_LEVEL: {
+						m_EG1Params.dSustainLevel = cookVSTGUIVariable(MIN_EG_SUSTAIN_LEVEL, MAX_EG_SUSTAIN_LEVEL, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_EG1Params.dSustainLevel, sampleOffset);
+						break;
+					}
+
+					case EG1_RELEASE_TIME: {
+						m_EG1Params.dReleaseTime_mSec = cookVSTGUIVariable(MIN_EG_RELEASE_TIME, MAX_EG_RELEASE_TIME, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_EG1Params.dReleaseTime_mSec, sampleOffset);
+						break;
+					}
+
+					case EG1_LEGATO_MODE: {
+						m_EG1Params.bLegatoMode = value > 0.5;
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, m_EG1Params.bLegatoMode ? 1.0f : 0.0f, sampleOffset);
+						break;
+					}
+
+					case EG1_RESET_TO_ZERO: {
+						m_EG1Params.bResetToZero = value > 0.5;
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, m_EG1Params.bResetToZero ? 1.0f : 0.0f, sampleOffset);
+						break;
+					}
+
+					case DCA_AMPLITUDE_DB: {
+						m_DCAParams.dAmplitude_dB = cookVSTGUIVariable(MIN_OUTPUT_AMPLITUDE_DB, MAX_OUTPUT_AMPLITUDE_DB, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_DCAParams.dAmplitude_dB, sampleOffset);
+						break;
+					}
+
+					case DCA_PAN: {
+						m_DCAParams.dPanControl = cookVSTGUIVariable(MIN_BIPOLAR, MAX_BIPOLAR, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_DCAParams.dPanControl, sampleOffset);
+						break;
+					}
+
+					case FILTER1_OVERSAMPLING: {
+						m_uFilter1Oversampling = (UINT)cookVSTGUIVariable(MIN_FILTER_OVERSAMPLING, MAX_FILTER_OVERSAMPLING, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uFilter1Oversampling, sampleOffset);
+						break;
+					}
+
+					case OVERSAMPLING_QUALITY: {
+						m_uOversamplingQuality = (UINT)cookVSTGUIVariable(MIN_OVERSAMPLING_QUALITY, MAX_OVERSAMPLING_QUALITY, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uOversamplingQuality, sampleOffset);
+						break;
+					}
+
+					case OVERSAMPLING_OFFLINE_QUALITY: {
+						m_uOversamplingOfflineQuality = (UINT)cookVSTGUIVariable(MIN_OVERSAMPLING_QUALITY, MAX_OVERSAMPLING_QUALITY, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uOversamplingOfflineQuality, sampleOffset);
+						break;
+					}
+
+					case VECTOR_MODE: {
+						m_uVectorMode = (UINT)cookVSTGUIVariable(MIN_ONOFF_SWITCH, MAX_ONOFF_SWITCH, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uVectorMode, sampleOffset);
+						break;
+					}
+
+					case VECTOR_A_WAVEFORM: {
+						m_uVectorWaveform[0] = (UINT)cookVSTGUIVariable(MIN_PITCHED_OSC_WAVEFORM, MAX_PITCHED_OSC_WAVEFORM, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uVectorWaveform[0], sampleOffset);
+						break;
+					}
+
+					case VECTOR_B_WAVEFORM: {
+						m_uVectorWaveform[1] = (UINT)cookVSTGUIVariable(MIN_PITCHED_OSC_WAVEFORM, MAX_PITCHED_OSC_WAVEFORM, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uVectorWaveform[1], sampleOffset);
+						break;
+					}
+
+					case VECTOR_C_WAVEFORM: {
+						m_uVectorWaveform[2] = (UINT)cookVSTGUIVariable(MIN_PITCHED_OSC_WAVEFORM, MAX_PITCHED_OSC_WAVEFORM, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uVectorWaveform[2], sampleOffset);
+						break;
+					}
+
+					case VECTOR_D_WAVEFORM: {
+						m_uVectorWaveform[3] = (UINT)cookVSTGUIVariable(MIN_PITCHED_OSC_WAVEFORM, MAX_PITCHED_OSC_WAVEFORM, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uVectorWaveform[3], sampleOffset);
+						break;
+					}
+
+					case VECTOR_JOYSTICK_X: {
+						m_VoiceParams.dAmplitude_ACmix = cookVSTGUIVariable(MIN_UNIPOLAR, MAX_UNIPOLAR, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_VoiceParams.dAmplitude_ACmix, sampleOffset);
+						break;
+					}
+
+					case VECTOR_JOYSTICK_Y: {
+						m_VoiceParams.dAmplitude_BDmix = cookVSTGUIVariable(MIN_UNIPOLAR, MAX_UNIPOLAR, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_VoiceParams.dAmplitude_BDmix, sampleOffset);
+						break;
+					}
+
+					case VECTOR_ORBIT_X: {
+						m_VoiceParams.dOrbitXAmp = cookVSTGUIVariable(MIN_UNIPOLAR, MAX_UNIPOLAR, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_VoiceParams.dOrbitXAmp, sampleOffset);
+						break;
+					}
+
+					case VECTOR_ORBIT_Y: {
+						m_VoiceParams.dOrbitYAmp = cookVSTGUIVariable(MIN_UNIPOLAR, MAX_UNIPOLAR, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_VoiceParams.dOrbitYAmp, sampleOffset);
+						break;
+					}
+
+					case VECTOR_PATH_MODE: {
+						m_VoiceParams.uVectorPathMode = (UINT)cookVSTGUIVariable(MIN_PATH_MODE, MAX_PATH_MODE, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_VoiceParams.uVectorPathMode, sampleOffset);
+						break;
+					}
+
+					case VECTOR_PATH_TIME: {
+						m_dVectorPathTime = cookVSTGUIVariable(MIN_VECTOR_PATH_TIME, MAX_VECTOR_PATH_TIME, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_dVectorPathTime, sampleOffset);
+						break;
+					}
+
+					case SAMPLE_MODE: {
+						m_uSampleMode = (UINT)cookVSTGUIVariable(MIN_ONOFF_SWITCH, MAX_ONOFF_SWITCH, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uSampleMode, sampleOffset);
+						break;
+					}
+
+					case SAMPLE_LOOP_MODE: {
+						m_SampleOscParams.uLoopMode = (UINT)cookVSTGUIVariable(MIN_LOOP_MODE, MAX_LOOP_MODE, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_SampleOscParams.uLoopMode, sampleOffset);
+						break;
+					}
+
+					case SAMPLE_QUALITY: {
+						m_uSampleQuality = (UINT)cookVSTGUIVariable(MIN_SAMPLE_QUALITY, MAX_SAMPLE_QUALITY, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uSampleQuality, sampleOffset);
+						break;
+					}
+
+					case MPE_MODE: {
+						m_uMPEMode = (UINT)cookVSTGUIVariable(MIN_ONOFF_SWITCH, MAX_ONOFF_SWITCH, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uMPEMode, sampleOffset);
+						break;
+					}
+
+					case UNISON_VOICES: {
+						m_uUnisonVoices = (UINT)(cookVSTGUIVariable(MIN_UNISON_VOICES, MAX_UNISON_VOICES, value) + 0.5);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uUnisonVoices, sampleOffset);
+						break;
+					}
+
+					case UNISON_DETUNE: {
+						m_dUnisonDetune = cookVSTGUIVariable(MIN_UNISON_DETUNE_CENTS, MAX_UNISON_DETUNE_CENTS, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_dUnisonDetune, sampleOffset);
+						break;
+					}
+
+					case UNISON_CURVE: {
+						m_dUnisonCurve = cookVSTGUIVariable(MIN_UNIPOLAR, MAX_UNIPOLAR, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_dUnisonCurve, sampleOffset);
+						break;
+					}
+
+					case UNISON_SPREAD: {
+						m_dUnisonSpread = cookVSTGUIVariable(MIN_UNIPOLAR, MAX_UNIPOLAR, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_dUnisonSpread, sampleOffset);
+						break;
+					}
+
+					case UNISON_PHASE: {
+						m_uUnisonPhase = (UINT)cookVSTGUIVariable(MIN_UNISON_PHASE, MAX_UNISON_PHASE, value);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_CONTROLS, TRACE_PARAM_CHANGE, pid, (float)m_uUnisonPhase, sampleOffset);
 						break;
 					}
 
@@ -251,65 +969,52 @@ bool NanoSynthProcessor::doControlUpdate(Steinberg::Vst::ProcessData& data)
 					//	want -1 to +1
 					case MIDI_PITCHBEND: {
 						m_dMIDIPitchBend = unipolarToBipolar(value);
-						#if(LOG_MIDI && _DEBUG)
-							FDebugPrint("Pitch Bend: %f\n", m_dMIDIPitchBend);
-						#endif
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_MIDI, TRACE_PARAM_CHANGE, pid, (float)m_dMIDIPitchBend, sampleOffset);
 						break;
 					}
 					//	want 0 to 127
 					case MIDI_MODWHEEL: {
 						m_uMIDIModWheel = unipolarToMIDI(value);
-						#if(LOG_MIDI && _DEBUG)
-							FDebugPrint("Mod Wheel: %d\n", m_uMIDIModWheel);
-						#endif
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_MIDI, TRACE_PARAM_CHANGE, pid, (float)m_uMIDIModWheel, sampleOffset);
 						break;
 					}
 					//	want 0 to 127
 					case MIDI_VOLUME_CC7: {
 						m_uMIDIVolumeCC7 = unipolarToMIDI(value);
-						#if(LOG_MIDI && _DEBUG)
-							FDebugPrint("Volume: %d\n", m_uMIDIVolumeCC7);
-						#endif
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_MIDI, TRACE_PARAM_CHANGE, pid, (float)m_uMIDIVolumeCC7, sampleOffset);
 						break;
 					}
 					//	want 0 to 127
 					case MIDI_PAN_CC10: {
 						m_uMIDIPanCC10 = unipolarToMIDI(value);
-						#if(LOG_MIDI && _DEBUG)
-							FDebugPrint("Pan: %d\n", m_uMIDIPanCC10);
-						#endif
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_MIDI, TRACE_PARAM_CHANGE, pid, (float)m_uMIDIPanCC10, sampleOffset);
 						break;
 					}
 					//	want 0 to 127
 					case MIDI_EXPRESSION_CC11: {
 						m_uMIDIExpressionCC11 = unipolarToMIDI(value);
-						#if(LOG_MIDI && _DEBUG)
-							FDebugPrint("Expression: %d\n", m_uMIDIExpressionCC11);
-						#endif
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_MIDI, TRACE_PARAM_CHANGE, pid, (float)m_uMIDIExpressionCC11, sampleOffset);
 						break;
 					}
 					case MIDI_CHANNEL_PRESSURE: {
-						#if(LOG_MIDI && _DEBUG)
-							FDebugPrint("Channel Pressure: %f\n", value);
-						#endif
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_MIDI, TRACE_PARAM_CHANGE, pid, (float)value, sampleOffset);
 						break;
 					}
 					// want 0 to 1
 					case MIDI_SUSTAIN_PEDAL: {
 						m_bSustainPedal = value > 0.5 ? true : false;
-						#if(LOG_MIDI && _DEBUG)
-							if (m_bSustainPedal) {
-								FDebugPrint("Sustain Pedal ON\n");
-							} else {
-								FDebugPrint("Sustain Pedal OFF\n");
-							}	
-						#endif
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_MIDI, TRACE_PARAM_CHANGE, pid, m_bSustainPedal ? 1.0f : 0.0f, sampleOffset);
 						break;
 					}
 					case MIDI_ALL_NOTES_OFF: {
-						#if(LOG_MIDI && _DEBUG)
-							FDebugPrint("All Notes OFF\n");
-						#endif
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_MIDI, TRACE_PARAM_CHANGE, pid, (float)value, sampleOffset);
+						break;
+					}
+					//	want 0 to 127; update() below picks up the new values
+					case MIDI_PROGRAM_CHANGE: {
+						m_uMIDIProgram = (UINT)(cookVSTGUIVariable(MIN_MIDI_PROGRAM, MAX_MIDI_PROGRAM, fmin(fmax(value, 0.0), 1.0)) + 0.5);
+						loadProgram(m_uMIDIProgram);
+						TRACE_PARAM(m_TraceLog, TRACE_CAT_PROGRAM, TRACE_PROGRAM_CHANGE, pid, (float)m_uMIDIProgram, sampleOffset);
 						break;
 					}
 				}
@@ -351,19 +1056,37 @@ bool NanoSynthProcessor::doProcessEvent(Vst::Event& vstEvent)
 				vstEvent.noteOn.noteId = uMIDINote;
 			}
 
-			#if(LOG_MIDI && _DEBUG)
-				FDebugPrint("Note ON: Channel: %d, Note: %d, Velocity: %d\n", uMIDIChannel, uMIDINote, uMIDIVelocity);
-			#endif
+			TRACE_NOTE(m_TraceLog, TRACE_CAT_NOTES, TRACE_NOTE_ON, uMIDIChannel, uMIDINote, uMIDIVelocity, vstEvent.noteOn.velocity, vstEvent.sampleOffset);
 
-			m_Osc1.m_dOscFo = midiFreqTable[uMIDINote];
-			m_Osc1.update();
+			//	a keymap note plays a voice per layer, maybe none
+			bool bKeymap = m_uSampleMode != 0 && m_Keymap.isLoaded();
+			UINT uRegions[KEYMAP_MAX_LAYERS];
+			int nLayers = bKeymap ? m_Keymap.getRegions(uMIDINote, uMIDIVelocity, uRegions, KEYMAP_MAX_LAYERS) : 1;
 
-			m_Osc2.m_dOscFo = midiFreqTable[uMIDINote];
-			m_Osc2.update();
+			for (int i = 0; i < nLayers; i++) {
+				UINT uVoice = getNoteOnVoice(uMIDIChannel, uMIDINote);
+				if (bKeymap) {
+					const KeymapRegion& region = m_Keymap.getRegion(uRegions[i]);
+					m_Voices[uVoice].m_SampleOsc.setSample(m_Keymap.getSample(region.uSample), region.dRootNote);
+				}
 
-			m_Osc1.startOscillator();
-			m_Osc2.startOscillator();
-			m_LFO1.startOscillator();
+				//	an idle voice's lanes may hold old samples from passes its
+				//	lane group skipped; a voice that is still sounding (a
+				//	retrigger or a steal) keeps its state, so it does not click
+				bool bIdle = !m_Voices[uVoice].isActive();
+				if (bIdle) {
+					m_Oversampler.flushDelays(uVoice);
+					m_Oversampler.flushDelays(uVoice + VOICE_RIGHT_LANE_OFFSET);
+					m_DCBlocker.flushDelays(uVoice);
+					m_DCBlocker.flushDelays(uVoice + VOICE_RIGHT_LANE_OFFSET);
+				}
+				m_Voices[uVoice].noteOn(uMIDIChannel, uMIDINote, uMIDIVelocity,
+					m_Tuning.getFrequency(uMIDINote), m_Tuning.getPhaseInc(uMIDINote), m_uNoteOnCount);
+				m_FilterBank.startVoice(uVoice, m_Tuning.getFrequency(uMIDINote), bIdle);
+				m_DCA.startVoice(uVoice, uMIDIVelocity);
+				m_Expression.startVoice(uVoice, vstEvent.noteOn.noteId, uMIDIChannel);
+			}
+			m_uNoteOnCount++;
 
 			break;
 		}
@@ -389,13 +1112,14 @@ bool NanoSynthProcessor::doProcessEvent(Vst::Event& vstEvent)
 				vstEvent.noteOff.noteId = uMIDINote;
 			}
 
-			#if(LOG_MIDI && _DEBUG)
-				FDebugPrint("Note OFF: Channel: %d, Note: %d, Velocity: %d\n", uMIDIChannel, uMIDINote, uMIDIVelocity);
-			#endif
+			TRACE_NOTE(m_TraceLog, TRACE_CAT_NOTES, TRACE_NOTE_OFF, uMIDIChannel, uMIDINote, uMIDIVelocity, vstEvent.noteOff.velocity, vstEvent.sampleOffset);
 
-			m_Osc1.stopOscillator();
-			m_Osc2.stopOscillator();
-			m_LFO1.stopOscillator();
+			for (UINT i = 0; i < MAX_VOICES; i++) {
+				SynthVoice& voice = m_Voices[i];
+				if (voice.isActive() && voice.m_uMIDINote == uMIDINote && voice.m_uMIDIChannel == uMIDIChannel) {
+					voice.noteOff();
+				}
+			}
 			break;
 		}
 
@@ -414,9 +1138,44 @@ bool NanoSynthProcessor::doProcessEvent(Vst::Event& vstEvent)
 			//	note event did not occurr
 			noteEvent = false;
 
-			#if(LOG_MIDI && _DEBUG)
-				FDebugPrint("Poly Pressure: Channel: %d, Note: %d, Pressure: %f\n", uMIDIChannel, uMIDINote, fPressure);
-			#endif
+			//	fix noteID as per SDK, the same as the note-on did
+			if (vstEvent.polyPressure.noteId == -1) {
+				vstEvent.polyPressure.noteId = uMIDINote;
+			}
+
+			TRACE_NOTE(m_TraceLog, TRACE_CAT_NOTES, TRACE_POLY_PRESSURE, uMIDIChannel, uMIDINote, 0, fPressure, vstEvent.sampleOffset);
+
+			m_Expression.setNoteValue(vstEvent.polyPressure.noteId, EXPRESSION_PRESSURE, fPressure);
+			break;
+		}
+
+		//	VST3 note expression; the value is 0 -> 1
+		case Vst::Event::kNoteExpressionValueEvent: {
+			int32 nNoteId = vstEvent.noteExpressionValue.noteId;
+			double dValue = vstEvent.noteExpressionValue.value;
+
+			switch (vstEvent.noteExpressionValue.typeId) {
+				case Vst::kTuningTypeID: {
+					m_Expression.setNoteValue(nNoteId, EXPRESSION_PITCH, unipolarToBipolar(dValue) * VOICE_EXPRESSION_TUNING_RANGE);
+					break;
+				}
+				case Vst::kBrightnessTypeID: {
+					m_Expression.setNoteValue(nNoteId, EXPRESSION_TIMBRE, dValue);
+					break;
+				}
+				case kPressureTypeID: {
+					m_Expression.setNoteValue(nNoteId, EXPRESSION_PRESSURE, dValue);
+					break;
+				}
+			}
+			break;
+		}
+
+		//	SysEx; MIDI Tuning Standard retunes the next note-on
+		case Vst::Event::kDataEvent: {
+			if (vstEvent.data.type == Vst::DataEvent::kMidiSysEx) {
+				m_Tuning.doMTSSysEx(vstEvent.data.bytes, (int)vstEvent.data.size);
+			}
 
 			break;
 		}
@@ -426,6 +1185,56 @@ bool NanoSynthProcessor::doProcessEvent(Vst::Event& vstEvent)
 	return noteEvent;
 }
 
+/*
+	Processor::getNoteOnVoice()
+	A repeated note restarts its own voice; otherwise the first free
+	voice, or the longest playing of the released voices, or the one
+	that has been playing longest. A stolen voice's EG restarts from
+	its current level.
+*/
+UINT NanoSynthProcessor::getNoteOnVoice(UINT uChannel, UINT uNote)
+{
+	UINT uFreeVoice = MAX_VOICES;
+	UINT uOldestVoice = MAX_VOICES;
+	UINT uOldestReleasing = MAX_VOICES;
+
+	for (UINT i = 0; i < MAX_VOICES; i++) {
+		SynthVoice& voice = m_Voices[i];
+		if (!voice.isActive()) {
+			if (uFreeVoice == MAX_VOICES) {
+				uFreeVoice = i;
+			}
+			continue;
+		}
+		if (voice.m_uTimestamp == m_uNoteOnCount) {
+			continue;
+		}
+		if (voice.m_uMIDINote == uNote && voice.m_uMIDIChannel == uChannel) {
+			return i;
+		}
+		//	wraps with the counter
+		if (uOldestVoice == MAX_VOICES ||
+			voice.m_uTimestamp - m_uNoteOnCount < m_Voices[uOldestVoice].m_uTimestamp - m_uNoteOnCount) {
+			uOldestVoice = i;
+		}
+		if (voice.isReleasing() && (uOldestReleasing == MAX_VOICES ||
+			voice.m_uTimestamp - m_uNoteOnCount < m_Voices[uOldestReleasing].m_uTimestamp - m_uNoteOnCount)) {
+			uOldestReleasing = i;
+		}
+	}
+
+	//	free, then released, then held voices
+	if (uFreeVoice < MAX_VOICES) {
+		return uFreeVoice;
+	}
+	if (uOldestReleasing < MAX_VOICES) {
+		return uOldestReleasing;
+	}
+
+	//	only when every voice is a layer of this note
+	return uOldestVoice < MAX_VOICES ? uOldestVoice : 0;
+}
+
 
 //------------------------------------------------------------------------
 /*
@@ -442,135 +1251,306 @@ tresult PLUGIN_API NanoSynthProcessor::process (Vst::ProcessData& data)
 		return kResultOk;
 	}
 
-	//	check for control chages and update synth if needed
-	doControlUpdate(data);
+	//	flush denormals for the whole block; the host's FPU mode comes back on return
+	DenormalGuard denormalGuard;
+
+	//	debug builds: assert that nothing below touches the heap; calls into
+	//	the host's queues go through REALTIME_HOST_CALL() and are not counted
+	RealtimeAllocGuard allocGuard;
 
-	//	flush mode
+	//	flush mode: parameter changes only; not a block for the profiler
 	if (data.numOutputs < 1) {
+		doControlUpdate(data);
 		return kResultTrue;
-	} else {
-		//	process 32 samples at a time; MIDI events are then accurate to 0.7 mSec
-		const int32 kBlockSize = SYNTH_PROC_BLOCKSIZE;
+	}
 
-		//	32-bit is float
-		//	if doing a 64-bit version, it is replaced with double*
-		//	initialize audio output buffers
-		float* buffers[OUTPUT_CHANNELS]; //	Precision is float - need to change this do DOUBLE if supporting 64 bit
+	PROFILER_BEGIN_BLOCK(m_Profiler, data.numSamples);
 
-		//	32-bit is float
-		//	if doing a 64-bit version, it is replaced with double* here too
-		for (int i = 0; i < OUTPUT_CHANNELS; i++) {
-			//	data.outputs[0] = BUS 0
-			buffers[i] = (float*)data.outputs[0].channelBuffers32[i];
-			memset(buffers[i], 0, data.numSamples * sizeof(float));
-		}
+	//	check for control chages and update synth if needed
+	doControlUpdate(data);
+	PROFILER_MARK(m_Profiler, PROFILER_STAGE_CONTROL);
 
-		//	total number of samples in the input Buffer
-		int32 numSamples = data.numSamples;
+	//	set when the meters have new values for the GUI
+	bool bMeterUpdate = false;
 
-		//	this is used when shoving an event into the next block 
-		int32 samplesProcessed = 0;
+	//	set for a channel when any sub-block of the buffer had audio on it
+	bool bSounding[OUTPUT_CHANNELS] = { false };
 
-		//	get list of events
-		Vst::IEventList* inputEvents = data.inputEvents;
-		Vst::Event e = { 0 };
-		Vst::Event* eventPtr = 0;
-		int32 eventIndex = 0;
+	//	process 32 samples at a time; MIDI events are then accurate to 0.7 mSec
+	const int32 kBlockSize = SYNTH_PROC_BLOCKSIZE;
 
-		//	count of events
-		int32 numEvents = inputEvents ? inputEvents->getEventCount() : 0;
+	//	32-bit is float
+	//	if doing a 64-bit version, it is replaced with double*
+	//	initialize audio output buffers
+	float* buffers[OUTPUT_CHANNELS]; //	Precision is float - need to change this do DOUBLE if supporting 64 bit
 
-		//	get the first event
-		if (numEvents)	{
-			inputEvents->getEvent(0, e);
-			eventPtr = &e;
-		}
+	//	32-bit is float
+	//	if doing a 64-bit version, it is replaced with double* here too
+	for (int i = 0; i < OUTPUT_CHANNELS; i++) {
+		//	data.outputs[0] = BUS 0
+		buffers[i] = (float*)data.outputs[0].channelBuffers32[i];
+		memset(buffers[i], 0, data.numSamples * sizeof(float));
+	}
 
-		while (numSamples > 0)	{
-			//	bound the samples to process to BLOCK SIZE (32)
-			int32 samplesToProcess = std::min<int32>(kBlockSize, numSamples);
+	//	total number of samples in the input Buffer
+	int32 numSamples = data.numSamples;
 
-			while (eventPtr != 0)	{
-				//	if the event is not in the current processing block 
-				//  then adapt offset for next block
-				if (e.sampleOffset > samplesToProcess)	{
-					e.sampleOffset -= samplesToProcess;
-					break;
-				}
+	//	this is used when shoving an event into the next block 
+	int32 samplesProcessed = 0;
 
-				//	find MIDI note-on/off and broadcast
-				doProcessEvent(e);
+	//	get list of events
+	Vst::IEventList* inputEvents = data.inputEvents;
+	Vst::Event e = { 0 };
+	Vst::Event* eventPtr = 0;
+	int32 eventIndex = 0;
 
-				//	get next event
-				eventIndex++;
-				if (eventIndex < numEvents) {
-					if (inputEvents->getEvent(eventIndex, e) == kResultTrue) {
-						e.sampleOffset -= samplesProcessed;
-					} else {
-						eventPtr = 0;
-					}
+	//	count of events
+	int32 numEvents = inputEvents ? REALTIME_HOST_CALL(inputEvents->getEventCount()) : 0;
+
+	//	get the first event
+	if (numEvents)	{
+		REALTIME_HOST_CALL(inputEvents->getEvent(0, e));
+		eventPtr = &e;
+	}
+
+	while (numSamples > 0)	{
+		//	bound the samples to process to BLOCK SIZE (32)
+		int32 samplesToProcess = std::min<int32>(kBlockSize, numSamples);
+
+		//	event offsets below are relative to this sub-block
+		TRACE_BLOCK_POSITION(m_TraceLog, samplesProcessed);
+
+		while (eventPtr != 0)	{
+			//	if the event is not in the current processing block 
+			//  then adapt offset for next block
+			if (e.sampleOffset > samplesToProcess)	{
+				e.sampleOffset -= samplesToProcess;
+				break;
+			}
+
+			//	find MIDI note-on/off and broadcast
+			doProcessEvent(e);
+
+			//	get next event
+			eventIndex++;
+			if (eventIndex < numEvents) {
+				if (REALTIME_HOST_CALL(inputEvents->getEvent(eventIndex, e)) == kResultTrue) {
+					e.sampleOffset -= samplesProcessed;
 				} else {
 					eventPtr = 0;
 				}
+			} else {
+				eventPtr = 0;
 			}
+		}
 
-			//	output "accumulator"
-			double dOut = 0.0;
+		//	this sub-block's note expression into the voices
+		updateExpression();
 
-			//	the loop - samplesToProcess is more like framesToProcess
-			for (int32 j = 0; j < samplesToProcess; j++) {
-				dOut = 0.0;
+		PROFILER_MARK(m_Profiler, PROFILER_STAGE_EVENTS);
 
-				if (m_Osc1.m_bNoteOn) {
-					//	ARTICULATION BLOCK
-					//	This is a mono synth so it's only necessary to 
-					//	calculate one output per sample period
-					//
-					//	render LFO output
-					double dLFO1Out = m_LFO1.doOscillate();
+		//	each sounding voice renders into its lane, and a stereo
+		//	(unison spread) voice its right side into a second one
+		memset(m_fVoiceBlock, 0, samplesToProcess * VOICE_FILTER_LANES * sizeof(float));
+		UINT uVoiceMask = 0;
+		UINT uStereoMask = 0;
+		for (UINT i = 0; i < MAX_VOICES; i++) {
+			if (!m_Voices[i].isActive()) {
+				continue;
+			}
+			uVoiceMask |= 1u << i;
+
+			float* pRight = 0;
+			if (m_Voices[i].isStereo()) {
+				UINT uRight = i + VOICE_RIGHT_LANE_OFFSET;
+				pRight = &m_fVoiceBlock[uRight];
+				uStereoMask |= 1u << i;
+
+				//	a right lane coming into use may hold old state
+				if (!(m_uStereoMask & (1u << i))) {
+					m_DCBlocker.flushDelays(uRight);
+					m_Oversampler.flushDelays(uRight);
+					m_FilterBank.flushLane(uRight);
+				}
+			}
+			m_Voices[i].render(&m_fVoiceBlock[i], VOICE_FILTER_LANES, samplesToProcess, pRight);
+		}
+		for (UINT i = 0; i < MAX_VOICES; i++) {
+			if ((uStereoMask ^ m_uStereoMask) & (1u << i)) {
+				m_DCA.setVoiceStereo(i, (uStereoMask & (1u << i)) != 0);
+			}
+		}
+		m_uStereoMask = uStereoMask;
+		UINT uLaneMask = uVoiceMask | (uStereoMask << VOICE_RIGHT_LANE_OFFSET);
+
+		//	filter them all in one pass; with the NLP on, above the
+		//	sample rate so the saturation harmonics do not alias
+		m_DCBlocker.process(m_fVoiceBlock, samplesToProcess, uLaneMask);
+		if (m_Oversampler.getFactor() > 1) {
+			m_Oversampler.upsample(m_fVoiceBlock, m_fOSBlock, samplesToProcess, uLaneMask);
+			m_FilterBank.process(m_fOSBlock, samplesToProcess * m_Oversampler.getFactor(), uLaneMask);
+			m_Oversampler.downsample(m_fOSBlock, m_fVoiceBlock, samplesToProcess, uLaneMask);
+		} else {
+			m_FilterBank.process(m_fVoiceBlock, samplesToProcess, uLaneMask);
+		}
 
-					//	apply to the Exp modulation inputs
-					m_Osc1.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
-					m_Osc2.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
+		//	EG1 -> amplitude, both sides of a stereo voice; a voice whose
+		//	release ends here is freed. A lane not in use that shares a
+		//	lane group with one that is was filtered too and its old
+		//	filter state rings on; silence it
+		for (UINT i = 0; i < MAX_VOICES; i++) {
+			if (uVoiceMask & (1u << i)) {
+				int nRightOffset = (uStereoMask & (1u << i)) ? VOICE_RIGHT_LANE_OFFSET : 0;
+				m_Voices[i].applyEG(&m_fVoiceBlock[i], VOICE_FILTER_LANES, samplesToProcess, nRightOffset);
+			}
+		}
+		for (UINT i = 0; i < VOICE_FILTER_LANES; i++) {
+			if (!(uLaneMask & (1u << i))) {
+				for (int n = 0; n < samplesToProcess; n++) {
+					m_fVoiceBlock[n * VOICE_FILTER_LANES + i] = 0.0f;
+				}
+			}
+		}
 
-					//	update 
-					m_Osc1.update();
-					m_Osc2.update();
+		//	level and pan each voice into the stereo output
+		m_DCA.process(m_fVoiceBlock, buffers[0], buffers[1], samplesToProcess, uLaneMask);
 
-					//	DIGITAL AUDIO ENGINE BLOCK
-					dOut = 0.5 * m_Osc1.doOscillate() + 0.5 * m_Osc2.doOscillate();
-				}
+		PROFILER_MARK(m_Profiler, PROFILER_STAGE_RENDER);
 
-				//	write to buffers
-				buffers[0][j] = dOut;	// left
-				buffers[1][j] = dOut;	// right
-			}
+		//	meter this block before moving on
+		if (m_OutputMeter.processBlock(buffers, OUTPUT_CHANNELS, samplesToProcess)) {
+			bMeterUpdate = true;
+		}
+		for (int i = 0; i < OUTPUT_CHANNELS; i++) {
+			bSounding[i] = bSounding[i] || !m_OutputMeter.m_bSilent[i];
+		}
 
-			//	update the counter
-			for (int i = 0; i < OUTPUT_CHANNELS; i++) {
-				buffers[i] += samplesToProcess;
-			}
+		//	and feed the scope
+		m_ScopeTap.processBlock(buffers, OUTPUT_CHANNELS, samplesToProcess);
 
-			//	update the samples processed/to process
-			numSamples -= samplesToProcess;
-			samplesProcessed += samplesToProcess;
+		//	update the counter
+		for (int i = 0; i < OUTPUT_CHANNELS; i++) {
+			buffers[i] += samplesToProcess;
+		}
 
-		} //	end while (numSamples > 0)
-	}
+		//	update the samples processed/to process
+		numSamples -= samplesToProcess;
+		samplesProcessed += samplesToProcess;
 
-	//	can write OUT to the GUI like this:
-	if (data.outputParameterChanges) {
+	} //	end while (numSamples > 0)
 
+	//	write the meters OUT to the GUI
+	if (data.outputParameterChanges && bMeterUpdate) {
+		doMeterUpdate(data);
 	}
-	//	set silence flags if no notes playing
+
+	//	set silence flags for channels that rendered nothing in the whole
+	//	buffer; the meter's flag only covers the last sub-block
 	if (data.numOutputs > 0) {
-		data.outputs[0].silenceFlags = 0x11; // left and right channel are silent
+		data.outputs[0].silenceFlags = 0;
+		for (int i = 0; i < OUTPUT_CHANNELS; i++) {
+			if (!bSounding[i]) {
+				data.outputs[0].silenceFlags |= (uint64)1 << i;
+			}
+		}
 	}
 
+	PROFILER_MARK(m_Profiler, PROFILER_STAGE_MIX);
+	PROFILER_END_BLOCK(m_Profiler);
+
 	return kResultOk;
 }
 
+/*
+	Processor::doMeterUpdate()
+	Writes the current meter values into the output parameter queues; the
+	host hands these to the Controller. One point per meter at the end of
+	the buffer is plenty at the meter update rate.
+*/
+void NanoSynthProcessor::doMeterUpdate(Vst::ProcessData& data)
+{
+#if DSP_PROFILER
+	//	load is 1.0 at the deadline
+	double dLoad = 0.0;
+	double dPeakLoad = 0.0;
+	unsigned int uOverruns = 0;
+	m_Profiler.getMeterValues(dLoad, dPeakLoad, uOverruns);
+#endif
+
+	UINT uUnderruns = m_SampleStreamer.getUnderruns();
+
+	Vst::ParamID meterIDs[] = { METER_PEAK_LEFT, METER_PEAK_RIGHT, METER_RMS_LEFT, METER_RMS_RIGHT, METER_ACTIVE_VOICES,
+		SAMPLE_STREAM_UNDERRUNS,
+#if DSP_PROFILER
+		PROFILER_LOAD, PROFILER_PEAK_LOAD, PROFILER_OVERRUNS
+#endif
+	};
+	Vst::ParamValue meterValues[] = {
+		m_OutputMeter.m_dPeak[0],
+		m_OutputMeter.m_dPeak[1],
+		m_OutputMeter.m_dRMS[0],
+		m_OutputMeter.m_dRMS[1],
+		convertToVSTGUIVariable(MIN_ACTIVE_VOICES, MAX_ACTIVE_VOICES, getActiveVoiceCount()),
+		convertToVSTGUIVariable(MIN_STREAM_UNDERRUNS, MAX_STREAM_UNDERRUNS, uUnderruns < MAX_STREAM_UNDERRUNS ? uUnderruns : MAX_STREAM_UNDERRUNS),
+#if DSP_PROFILER
+		fmin(convertToVSTGUIVariable(MIN_DSP_LOAD_PCT, MAX_DSP_LOAD_PCT, dLoad * 100.0), 1.0),
+		fmin(convertToVSTGUIVariable(MIN_DSP_LOAD_PCT, MAX_DSP_LOAD_PCT, dPeakLoad * 100.0), 1.0),
+		convertToVSTGUIVariable(MIN_DSP_OVERRUNS, MAX_DSP_OVERRUNS, uOverruns < MAX_DSP_OVERRUNS ? uOverruns : MAX_DSP_OVERRUNS)
+#endif
+	};
+
+	int32 sampleOffset = data.numSamples > 0 ? data.numSamples - 1 : 0;
+
+	for (int i = 0; i < (int)(sizeof(meterIDs) / sizeof(meterIDs[0])); i++) {
+		int32 queueIndex = 0;
+		Vst::IParamValueQueue* queue = REALTIME_HOST_CALL(data.outputParameterChanges->addParameterData(meterIDs[i], queueIndex));
+		if (queue) {
+			int32 pointIndex = 0;
+			REALTIME_HOST_CALL(queue->addPoint(sampleOffset, meterValues[i], pointIndex));
+		}
+	}
+}
+
+/*
+	Processor::getActiveVoiceCount()
+	Number of voices currently rendering.
+*/
+UINT NanoSynthProcessor::getActiveVoiceCount()
+{
+	UINT uCount = 0;
+	for (UINT i = 0; i < MAX_VOICES; i++) {
+		if (m_Voices[i].isActive()) {
+			uCount++;
+		}
+	}
+	return uCount;
+}
+
+//------------------------------------------------------------------------
+/*
+	Processor::getLatencySamples()
+	The oversampler's round trip; 0 unless the filter NLP is on. From
+	the controls rather than the running oversampler, since the host
+	asks right after a change the Controller flagged with kLatencyChanged
+*/
+uint32 PLUGIN_API NanoSynthProcessor::getLatencySamples ()
+{
+	return (uint32)m_Oversampler.calculateLatency(getOversamplingFactor(), getOversamplingQuality());
+}
+
 //------------------------------------------------------------------------
+/*
+	Processor::setupProcessing()
+	Nothing to size here. All engine state (voices, filter and DCA
+	lanes, the voice and oversampled blocks) is in this object, sized by
+	MAX_VOICES and SYNTH_PROC_BLOCKSIZE, and process() splits the host's
+	block into SYNTH_PROC_BLOCKSIZE pieces, so maxSamplesPerBlock does not
+	change what the engine needs. The only heap memory the audio thread
+	reads (the keymap and sample heads from initialize(), the resampler
+	tables from construction) is in place before processing starts;
+	debug builds check that process() keeps it that way with a
+	RealtimeAllocGuard.
+*/
 tresult PLUGIN_API NanoSynthProcessor::setupProcessing (Vst::ProcessSetup& newSetup)
 {
 	//--- called before any processing ----
@@ -598,57 +1578,23 @@ tresult PLUGIN_API NanoSynthProcessor::canProcessSampleSize (int32 symbolicSampl
 //------------------------------------------------------------------------
 /*
 	Processor::setState()
-	This is the READ part of the serialization process. We get the stream interface and use it
-	to read from the filestream.
-
-	NOTE: The datatypes/read order must EXACTLY match the getState() version or crashes may happen or variables
-		  not initialized properly.
+	This is the READ part of the serialization process. SynthState reads
+	the stream in one pass (any version) and we copy out the cooked values.
 */
 tresult PLUGIN_API NanoSynthProcessor::setState (IBStream* state)
 {
 	//	called when we load a preset, the model has to be reloaded
-	IBStreamer streamer (state, kLittleEndian);
-	uint64 version = 0;
-
-	//	needed to convert to UINT reads
-	uint32 udata = 0;
-	int32 data = 0;
-
-	//	read the version
-	if (!streamer.readInt64u(version)) {
+	SynthState synthState;
+	if (!synthState.read(state)) {
 		return kResultFalse;
 	}
 
-	//	read the current GUI parameters
-	//  NOTE: the reading and writting must happen in the same order
-	if (!streamer.readInt32u(udata)) {
-		return kResultFalse;
-	} else {
-		m_uOscWaveform = udata;
-	}
-	if (!streamer.readInt32u(udata)) {
-		return kResultFalse;
-	} else {
-		m_uLFO1Waveform = udata;
-	}
-	if (!streamer.readDouble(m_dLFO1Rate)) {
-		return kResultFalse;
-	}
-	if (!streamer.readDouble(m_dLFO1Amplitude)) {
-		return kResultFalse;
-	}
-	if (!streamer.readInt32u(udata)) {
-		return kResultFalse;
-	} else {
-		m_uLFO1Mode = udata;
+	//	GUI parameters
+	const SynthStateField* pSchema = SynthState::getSchema();
+	for (int i = 0; i < SynthState::getFieldCount(); i++) {
+		setCookedParameter(pSchema[i].uParamID, synthState.getValue(pSchema[i].uParamID));
 	}
 
-	//	do next version...
-	if (version >= 1)
-	{
-		// add v1 stuff here
-	}
-	
 	return kResultOk;
 }
 
@@ -658,35 +1604,108 @@ tresult PLUGIN_API NanoSynthProcessor::setState (IBStream* state)
 	This is the WRITE part of the serialization process. It gets the stream interface and uses it
 	to write to the filestream. This is important because it is how the Factory Default is set
 	at startup, as well as when writing presets.
+
+	The layout lives in SynthState; we only hand it the cooked values.
 */
 tresult PLUGIN_API NanoSynthProcessor::getState (IBStream* state)
 {
 	// here we need to save the model
-	IBStreamer streamer (state, kLittleEndian);
-
-	//	NanoSynthVersion - place this at top so versioning can be used during the READ operation
-	if (!streamer.writeInt64u(NanoSynthVersion)) {
-		return kResultFalse;
-	}
+	SynthState synthState;
 
 	//	save the current GUI control variables
-	if (!streamer.writeInt32u(m_uOscWaveform)) {
+	synthState.setValue(OSC_WAVEFORM, m_uOscWaveform);
+	synthState.setValue(LFO1_WAVEFORM, m_uLFO1Waveform);
+	synthState.setValue(LFO1_RATE, m_dLFO1Rate);
+	synthState.setValue(LFO1_AMPLITUDE, m_dLFO1Amplitude);
+	synthState.setValue(LFO1_MODE, m_uLFO1Mode);
+	synthState.setValue(FILTER1_FC, m_Filter1Params.dFcControl);
+	synthState.setValue(FILTER1_Q, m_Filter1Params.dQControl);
+	synthState.setValue(FILTER1_TYPE, m_Filter1Params.uFilterType);
+	synthState.setValue(FILTER1_KEYTRACK, m_uFilter1KeyTrack);
+	synthState.setValue(FILTER1_KEYTRACK_INTENSITY, m_dFilter1KeyTrackIntensity);
+	synthState.setValue(FILTER1_NLP, m_Filter1Params.uNLP);
+	synthState.setValue(FILTER1_SATURATION, m_Filter1Params.dSaturation);
+	synthState.setValue(EG1_ATTACK_TIME, m_EG1Params.dAttackTime_mSec);
+	synthState.setValue(EG1_DECAY_TIME, m_EG1Params.dDecayTime_mSec);
+	synthState.setValue(EG1_SUSTAIN_LEVEL, m_EG1Params.dSustainLevel);
+	synthState.setValue(EG1_RELEASE_TIME, m_EG1Params.dReleaseTime_mSec);
+	synthState.setValue(EG1_LEGATO_MODE, m_EG1Params.bLegatoMode ? 1.0 : 0.0);
+	synthState.setValue(EG1_RESET_TO_ZERO, m_EG1Params.bResetToZero ? 1.0 : 0.0);
+	synthState.setValue(DCA_AMPLITUDE_DB, m_DCAParams.dAmplitude_dB);
+	synthState.setValue(DCA_PAN, m_DCAParams.dPanControl);
+	synthState.setValue(FILTER1_OVERSAMPLING, m_uFilter1Oversampling);
+	synthState.setValue(OVERSAMPLING_QUALITY, m_uOversamplingQuality);
+	synthState.setValue(OVERSAMPLING_OFFLINE_QUALITY, m_uOversamplingOfflineQuality);
+	synthState.setValue(VECTOR_MODE, m_uVectorMode);
+	synthState.setValue(VECTOR_A_WAVEFORM, m_uVectorWaveform[0]);
+	synthState.setValue(VECTOR_B_WAVEFORM, m_uVectorWaveform[1]);
+	synthState.setValue(VECTOR_C_WAVEFORM, m_uVectorWaveform[2]);
+	synthState.setValue(VECTOR_D_WAVEFORM, m_uVectorWaveform[3]);
+	synthState.setValue(VECTOR_JOYSTICK_X, m_VoiceParams.dAmplitude_ACmix);
+	synthState.setValue(VECTOR_JOYSTICK_Y, m_VoiceParams.dAmplitude_BDmix);
+	synthState.setValue(VECTOR_ORBIT_X, m_VoiceParams.dOrbitXAmp);
+	synthState.setValue(VECTOR_ORBIT_Y, m_VoiceParams.dOrbitYAmp);
+	synthState.setValue(VECTOR_PATH_MODE, m_VoiceParams.uVectorPathMode);
+	synthState.setValue(VECTOR_PATH_TIME, m_dVectorPathTime);
+	synthState.setValue(SAMPLE_MODE, m_uSampleMode);
+	synthState.setValue(SAMPLE_LOOP_MODE, m_SampleOscParams.uLoopMode);
+	synthState.setValue(SAMPLE_QUALITY, m_uSampleQuality);
+	synthState.setValue(MPE_MODE, m_uMPEMode);
+	synthState.setValue(UNISON_VOICES, m_uUnisonVoices);
+	synthState.setValue(UNISON_DETUNE, m_dUnisonDetune);
+	synthState.setValue(UNISON_CURVE, m_dUnisonCurve);
+	synthState.setValue(UNISON_SPREAD, m_dUnisonSpread);
+	synthState.setValue(UNISON_PHASE, m_uUnisonPhase);
+
+	if (!synthState.write(state)) {
 		return kResultFalse;
 	}
-	if (!streamer.writeInt32u(m_uLFO1Waveform)) {
-		return kResultFalse;
+
+	return kResultOk;
+}
+
+/*
+	Processor::notify()
+	Messages from the Controller; these arrive on the message thread,
+	never the audio thread.
+*/
+tresult PLUGIN_API NanoSynthProcessor::notify (Vst::IMessage* message)
+{
+	if (!message) {
+		return kInvalidArgument;
 	}
-	if (!streamer.writeDouble(m_dLFO1Rate)) {
-		return kResultFalse;
+
+	//	the scope view polls at display rate
+	if (FIDStringsEqual(message->getMessageID(), SCOPE_REQUEST_MSG_ID)) {
+		sendScopeFrame();
+		return kResultOk;
 	}
-	if (!streamer.writeDouble(m_dLFO1Amplitude)) {
-		return kResultFalse;
+
+	return AudioEffect::notify(message);
+}
+
+/*
+	Processor::sendScopeFrame()
+	Drains the newest scope samples and sends them to the Controller.
+	Message thread only.
+*/
+void NanoSynthProcessor::sendScopeFrame()
+{
+	float fFrame[SCOPE_FRAME_SIZE];
+	unsigned int uCount = m_ScopeTap.readLatest(fFrame, SCOPE_FRAME_SIZE);
+	if (uCount == 0) {
+		return;
 	}
-	if (!streamer.writeInt32u(m_uLFO1Mode)) {
-		return kResultFalse;
+
+	IPtr<Vst::IMessage> message = owned(allocateMessage());
+	if (!message) {
+		return;
 	}
 
-	return kResultOk;
+	message->setMessageID(SCOPE_FRAME_MSG_ID);
+	message->getAttributes()->setBinary(SCOPE_ATTR_SAMPLES, fFrame, uCount * sizeof(float));
+	message->getAttributes()->setFloat(SCOPE_ATTR_SAMPLE_RATE, m_ScopeTap.getSampleRate());
+	sendMessage(message);
 }
 
 /*
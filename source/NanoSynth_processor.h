@@ -13,15 +13,35 @@
 #include "pluginterfaces/base/ustring.h"
 
 #include "synthfunctions.h"
+#include "SynthParamLimits.h"
 
-#define MAX_VOICES 16
 #define OUTPUT_CHANNELS 2 //	stereo only
 
+//	Synth Stuff
+#define SYNTH_PROC_BLOCKSIZE 32 // 32 samples per processing block = 0.7 mSec = OK for tactile response WP
+
+//	per voice DC blocker corner; takes out the offset of the square and DPW
+//	waveforms before the filter
+#define SYNTH_DC_BLOCK_FC 5.0
+
 
 //	synth objects
 #include "WTOscillator.h"
-#include "QBLimitedOscillator.h"
-#include "LFO.h"
+#include "SynthVoice.h"
+#include "BiQuadCascade.h"
+#include "VoiceFilterBank.h"
+#include "Oversampler.h"
+#include "VoiceDCA.h"
+#include "VoiceExpression.h"
+#include "Tuning.h"
+#include "OutputMeter.h"
+#include "PresetBank.h"
+#include "Keymap.h"
+#include "ScopeTap.h"
+#include "DSPProfiler.h"
+#include "TraceLog.h"
+#include "DenormalGuard.h"
+#include "RealtimeAllocGuard.h"
 
 namespace Quero {
 
@@ -58,6 +78,9 @@ public:
 	/** Asks if a given sample size is supported see SymbolicSampleSizes. */
 	Steinberg::tresult PLUGIN_API canProcessSampleSize (Steinberg::int32 symbolicSampleSize) SMTG_OVERRIDE;
 
+	/** Delay added by the oversampled filter stage */
+	Steinberg::uint32 PLUGIN_API getLatencySamples () SMTG_OVERRIDE;
+
 	/** Here we go...the process call */
 	Steinberg::tresult PLUGIN_API process (Steinberg::Vst::ProcessData& data) SMTG_OVERRIDE;
 		
@@ -65,6 +88,9 @@ public:
 	Steinberg::tresult PLUGIN_API setState (Steinberg::IBStream* state) SMTG_OVERRIDE;
 	Steinberg::tresult PLUGIN_API getState (Steinberg::IBStream* state) SMTG_OVERRIDE;
 
+	/** Messages from the Controller */
+	Steinberg::tresult PLUGIN_API notify (Steinberg::Vst::IMessage* message) SMTG_OVERRIDE;
+
 	//	Define the audio I/O we support
 	Steinberg::tresult PLUGIN_API setBusArrangements(Steinberg::Vst::SpeakerArrangement* inputs, Steinberg::int32 numIns, Steinberg::Vst::SpeakerArrangement* outputs, Steinberg::int32 numOuts);
 
@@ -72,12 +98,40 @@ public:
 protected:
 	//	NanoSynth Components
 
-	//	the two oscillators
-	QBLimitedOscillator m_Osc1;
-	QBLimitedOscillator m_Osc2;
+	//	the voices; two oscillators (four in vector mode) and an LFO each
+	SynthVoice m_Voices[MAX_VOICES];
+
+	//	DC blocker for all voices, one channel per voice lane
+	BiQuadCascade m_DCBlocker;
+
+	//	filter 1 for all voices, run on the whole voice block at once
+	VoiceFilterBank m_FilterBank;
+
+	//	runs the filter bank above the sample rate while its NLP is on;
+	//	m_fOSBlock is the voice block at the oversampled rate
+	Oversampler m_Oversampler;
+	float m_fOSBlock[SYNTH_PROC_BLOCKSIZE * OVERSAMPLER_MAX_FACTOR * VOICE_FILTER_LANES];
+
+	//	level, pan and MIDI volume/pan/expression for all voices; mixes
+	//	the voice block into the stereo output
+	VoiceDCA m_DCA;
 
-	//	one LFO
-	LFO m_LFO1;
+	//	per-note pitch, pressure and timbre, found by noteId or MPE channel;
+	//	smoothed per sub-block and handed to the voices, m_DCA and m_FilterBank
+	VoiceExpression m_Expression;
+	UINT m_uMPEMode;
+	void updateExpression();
+
+	//	one sub-block of voice output, interleaved by lane:
+	//	m_fVoiceBlock[sample * VOICE_FILTER_LANES + lane]. A voice's lane
+	//	is its index; a stereo voice's right side is VOICE_RIGHT_LANE_OFFSET on
+	float m_fVoiceBlock[SYNTH_PROC_BLOCKSIZE * VOICE_FILTER_LANES];
+
+	//	voices whose right lane was in use last sub-block
+	UINT m_uStereoMask;
+
+	//	note -> frequency/phase increment; 12-TET, Scala or MTS
+	Tuning m_Tuning;
 
 
 	//	updates all voices at once
@@ -90,12 +144,102 @@ protected:
 	double m_dLFO1Amplitude;
 	UINT m_uLFO1Mode;
 
+	//	filter controls
+	globalFilterParams m_Filter1Params;
+	UINT m_uFilter1KeyTrack;
+	double m_dFilter1KeyTrackIntensity;
+
+	//	EG1 controls
+	globalEGParams m_EG1Params;
+
+	//	DCA controls
+	globalDCAParams m_DCAParams;
+
+	//	oversampling controls
+	UINT m_uFilter1Oversampling;
+	UINT m_uOversamplingQuality;
+	UINT m_uOversamplingOfflineQuality;
+
+	//	vector controls; the joystick is in dAmplitude_ACmix/BDmix, the
+	//	orbit in dOrbitXAmp/YAmp and the JS_ mode in uVectorPathMode
+	globalVoiceParams m_VoiceParams;
+	UINT m_uVectorMode;
+	UINT m_uVectorWaveform[4];
+	double m_dVectorPathTime;
+
+	//	the path all voices follow, a CJoystickProgram table; built from
+	//	the orbit and path time in updateVectorPath()
+	float m_fVectorPathTable[MAX_JS_PROGRAM_STEPS * MAX_JS_PROGRAM_STEP_VARS];
+	void updateVectorPath();
+
+	//	sample controls; the loop mode is in uLoopMode
+	UINT m_uSampleMode;
+	globalOscillatorParams m_SampleOscParams;
+	UINT m_uSampleQuality;
+
+	//	unison controls; the copies, their detune, curve and spread, and
+	//	a UNISON_PHASE_ mode
+	UINT m_uUnisonVoices;
+	double m_dUnisonDetune;
+	double m_dUnisonCurve;
+	double m_dUnisonSpread;
+	UINT m_uUnisonPhase;
+
+	//	the sample mode sample, opened in initialize(), and the prefetch
+	//	thread that streams it into the voices while we are active
+	StreamedSample m_StreamedSample;
+	SampleStreamer m_SampleStreamer;
+
+	//	a multisample keymap replaces the single sample when there is one
+	Keymap m_Keymap;
+
+	//	oversampling factor and quality for the current controls and process mode
+	int getOversamplingFactor();
+	UINT getOversamplingQuality();
+
+	//	switch the oversampler (and the filter bank's rate) to the current
+	//	controls; bReset forces it, e.g. for a new sample rate
+	void updateOversampling(bool bReset);
+
+	//	set a GUI control variable from its cooked value
+	void setCookedParameter(Steinberg::Vst::ParamID uParamID, double dCookedValue);
+
 	//	functions to reduce size of process()
 	bool doControlUpdate(Steinberg::Vst::ProcessData& data);
 
+	//	programs; the bank is mapped in initialize()
+	PresetBank m_PresetBank;
+	UINT m_uMIDIProgram;
+	bool loadProgram(UINT uProgram);
+
 	//	for MIDI note-on/off
 	bool doProcessEvent(Steinberg::Vst::Event& vstEvent);
 
+	//	voice for a new note: the one already playing it, a free one,
+	//	the oldest released one or the oldest; never one this note-on
+	//	has already started (the other layers of a keymap)
+	UINT getNoteOnVoice(UINT uChannel, UINT uNote);
+	UINT m_uNoteOnCount;
+
+	//	output metering, written back as output parameters
+	OutputMeter m_OutputMeter;
+	void doMeterUpdate(Steinberg::Vst::ProcessData& data);
+	UINT getActiveVoiceCount();
+
+	//	scope feed; filled in process(), drained in notify()
+	ScopeTap m_ScopeTap;
+	void sendScopeFrame();
+
+#if DSP_PROFILER
+	//	block timing against the buffer deadline
+	DSPProfiler m_Profiler;
+#endif
+
+#if TRACE_LOG
+	//	MIDI/parameter trace, written to a file off the audio thread
+	TraceLog m_TraceLog;
+#endif
+
 	//	to load up the samples in new voices
 	//bool loadSamples();
 
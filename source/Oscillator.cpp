@@ -4,6 +4,7 @@
 Oscillator::Oscillator(void) {
 	//	initialize variables
 	m_dSampleRate = 44100;
+	m_dInvSampleRate = 1.0 / m_dSampleRate;
 	m_bNoteOn = false;
 	m_uMIDINoteNumber = 0;
 	m_dModulo = 0.0;
@@ -13,10 +14,11 @@ Oscillator::Oscillator(void) {
 	m_dPulseWidth = OSC_PULSEWIDTH_DEFAULT;
 	m_dPulseWidthControl = OSC_PULSEWIDTH_DEFAULT; //	GUI
 	m_dFo = OSC_FO_DEFAULT;
+	m_dOscInc = m_dOscFo * m_dInvSampleRate;
 
 	//	seed the random number generator for noise oscillators
-	srand(time(NULL));
-	m_uPNRegister = rand();
+	m_uNoiseSeed = 0;
+	seedNoise();
 
 	//	continue inits
 	m_nRSHCounter = -1; //	flag for reset condition
@@ -53,8 +55,7 @@ void Oscillator::reset() {
 	m_dDPW_z1 = 0.0;
 
 	//	for random stuff
-	srand(time(NULL));
-	m_uPNRegister = rand();
+	seedNoise();
 	m_nRSHCounter = -1; //	flag for reset condition
 	m_dRSHValue = 0.0;
 
@@ -66,3 +67,14 @@ void Oscillator::reset() {
 	m_dFoModLin = 0.0;
 	m_dPhaseMod = 0.0;
 }
+
+void Oscillator::seedNoise() {
+	if (m_uNoiseSeed == 0) {
+		srand(time(NULL));
+		m_uPNRegister = rand();
+		m_uNoiseRegister = rand();
+	} else {
+		m_uPNRegister = m_uNoiseSeed;
+		m_uNoiseRegister = m_uNoiseSeed;
+	}
+}
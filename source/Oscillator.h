@@ -24,7 +24,7 @@ public:
 	bool m_bNoteOn;
 
 	//	user controls or MIDI 
-	double m_dOscFo;		//	oscillator frequency from MIDI note number
+	double m_dOscFo;		//	oscillator frequency from MIDI note number; set with setOscFo()
 	double m_dFoRatio;	    //	FM Synth Modulator OR Hard Sync ratio 
 	double m_dAmplitude;	//	0->1 from GUI
 
@@ -54,17 +54,38 @@ public:
 	//	MIDI note that is being played
 	UINT m_uMIDINoteNumber;
 
+	//	base frequency; dInc is its phase increment, e.g. from a Tuning table
+	inline void setOscFo(double dFo) {
+		m_dOscFo = dFo;
+		m_dOscInc = dFo * m_dInvSampleRate;
+	}
+	inline void setOscFo(double dFo, double dInc) {
+		m_dOscFo = dFo;
+		m_dOscInc = dInc;
+	}
+
+	//	noise seed; 0 = different every note (default), anything else
+	//	makes NOISE/PNOISE/rsh/qrsh repeat exactly on every reset()
+	void setNoiseSeed(UINT uSeed) {
+		m_uNoiseSeed = uSeed;
+		seedNoise();
+	}
+
 protected:
 	//	PROTECTED: generally these are either basic calc variables
 	//	and modulation stuff
 	
 	//	calculation variables
 	double m_dSampleRate;	//	fs
+	double m_dInvSampleRate;	//	1/fs
+	double m_dOscInc;		//	m_dOscFo/fs
 	double m_dFo;			//	current (actual) frequency of oscillator	
 	double m_dPulseWidth;	//	pulse width in % for calculation
 
 	//	for noise and random sample/hold
 	UINT   m_uPNRegister;	//	for PN Noise sequence
+	UINT   m_uNoiseRegister;	//	for white noise
+	UINT   m_uNoiseSeed;		//	0 = seed from the clock
 	int    m_nRSHCounter;	//	random sample/hold counter
 	double m_dRSHValue;		//	currnet rsh output
 
@@ -156,11 +177,16 @@ public:
 	//	ABSTRACT: derived class overrides if needed
 	virtual void setSampleRate(double dFs) {
 		m_dSampleRate = dFs;
+		m_dInvSampleRate = 1.0 / dFs;
+		m_dOscInc = m_dOscFo * m_dInvSampleRate;
 	}
 
 	//	reset counters, and the others
 	virtual void reset();
 
+	//	load the noise registers from m_uNoiseSeed
+	void seedNoise();
+
 	//	INLINE FUNCTIONS: these are inlined because they will be 
 	//	called every sample period
 
@@ -173,26 +199,31 @@ public:
 		}
 
 		//	do the  complete frequency mod
-		m_dFo = m_dOscFo * m_dFoRatio * pitchShiftMultiplier(m_dFoMod +
+		double dRatio = m_dFoRatio * pitchShiftMultiplier(m_dFoMod +
 			m_dPitchBendMod +
 			m_nOctave * 12.0 +
 			m_nSemitones +
 			m_nCents / 100.0);
+		m_dFo = m_dOscFo * dRatio;
 
-		//	apply linear FM (not used in book projects)
-		m_dFo += m_dFoModLin;
+		//	calculate increment; scales with Fo, no divide
+		m_dInc = m_dOscInc * dRatio;
 
+		//	apply linear FM (not used in book projects)
 		//	bound Fo (can go outside for FM/PM mod)
 		//	+/- 20480 for FM/PM
-		if (m_dFo > OSC_FO_MAX) {
-			m_dFo = OSC_FO_MAX;
-		}
-		if (m_dFo < -OSC_FO_MAX) {
-			m_dFo = -OSC_FO_MAX;
-		}
+		if (m_dFoModLin != 0.0 || m_dFo > OSC_FO_MAX || m_dFo < -OSC_FO_MAX) {
+			m_dFo += m_dFoModLin;
+
+			if (m_dFo > OSC_FO_MAX) {
+				m_dFo = OSC_FO_MAX;
+			}
+			if (m_dFo < -OSC_FO_MAX) {
+				m_dFo = -OSC_FO_MAX;
+			}
 
-		//	calculate increment
-		m_dInc = m_dFo / m_dSampleRate;
+			m_dInc = m_dFo * m_dInvSampleRate;
+		}
 
 		//	Pulse Width Modulation
 		//	limits are 2% and 98%
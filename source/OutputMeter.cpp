@@ -0,0 +1,76 @@
+#include "OutputMeter.h"
+
+//	Clear the outputs; detectors get set up in setSampleRate()
+OutputMeter::OutputMeter(void) {
+	m_nSamplesPerUpdate = (int)(METER_UPDATE_INTERVAL_MSEC * 44100.0 / 1000.0);
+	m_nSampleCounter = 0;
+
+	for (int i = 0; i < METER_CHANNELS; i++) {
+		m_dPeak[i] = 0.0;
+		m_dRMS[i] = 0.0;
+		m_bSilent[i] = true;
+		m_fPeak_dB[i] = METER_MIN_DB;
+		m_fRMS_dB[i] = METER_MIN_DB;
+	}
+}
+
+OutputMeter::~OutputMeter(void) {
+}
+
+//	The detectors see one value per block, so their "sample rate" is the block rate
+void OutputMeter::setSampleRate(double dFs, int nBlockSize) {
+	float fBlockRate = (float)(dFs / (double)nBlockSize);
+
+	for (int i = 0; i < METER_CHANNELS; i++) {
+		m_PeakDetector[i].init(fBlockRate, METER_ATTACK_MSEC, METER_RELEASE_MSEC, false, DETECT_MODE_PEAK, true);
+		m_RMSDetector[i].init(fBlockRate, METER_ATTACK_MSEC, METER_RELEASE_MSEC, false, DETECT_MODE_RMS, true);
+	}
+
+	m_nSamplesPerUpdate = (int)(METER_UPDATE_INTERVAL_MSEC * dFs / 1000.0);
+	reset();
+}
+
+void OutputMeter::reset() {
+	for (int i = 0; i < METER_CHANNELS; i++) {
+		m_PeakDetector[i].prepareForPlay();
+		m_RMSDetector[i].prepareForPlay();
+		m_dPeak[i] = 0.0;
+		m_dRMS[i] = 0.0;
+		m_bSilent[i] = true;
+		m_fPeak_dB[i] = METER_MIN_DB;
+		m_fRMS_dB[i] = METER_MIN_DB;
+	}
+	m_nSampleCounter = 0;
+}
+
+bool OutputMeter::processBlock(float** ppBuffers, int nChannels, int nSamples) {
+	if (nSamples <= 0) {
+		return false;
+	}
+
+	for (int i = 0; i < nChannels && i < METER_CHANNELS; i++) {
+		float fPeak = 0.0;
+		float fMeanSquare = 0.0;
+		calcBlockPeakAndMeanSquare(ppBuffers[i], nSamples, fPeak, fMeanSquare);
+
+		m_bSilent[i] = fPeak == 0.0;
+
+		//	the RMS detector squares its input, so hand it the block RMS
+		m_fPeak_dB[i] = m_PeakDetector[i].detect(fPeak);
+		m_fRMS_dB[i] = m_RMSDetector[i].detect(sqrt(fMeanSquare));
+	}
+
+	//	decimate to the meter interval
+	m_nSampleCounter += nSamples;
+	if (m_nSampleCounter < m_nSamplesPerUpdate) {
+		return false;
+	}
+	m_nSampleCounter -= m_nSamplesPerUpdate;
+
+	for (int i = 0; i < METER_CHANNELS; i++) {
+		m_dPeak[i] = normalizeMeter_dB(m_fPeak_dB[i]);
+		m_dRMS[i] = normalizeMeter_dB(m_fRMS_dB[i]);
+	}
+
+	return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "pluginconstants.h"
+
+#if defined _M_X64 || defined _M_IX86 || defined __SSE2__
+#include <emmintrin.h>
+#define METER_USE_SSE2 1
+#endif
+
+#define METER_CHANNELS 2			//	stereo only
+#define METER_ATTACK_MSEC 10.0		//	same ballistics as the RAFX meters
+#define METER_RELEASE_MSEC 500.0
+
+/*
+	calcBlockPeakAndMeanSquare()
+	Finds the absolute peak and the mean square of a block of samples,
+	four samples at a time when SSE2 is available.
+
+	pBuffer - the block
+	nSamples - length of the block
+	fPeak, fMeanSquare - returned by reference
+*/
+inline void calcBlockPeakAndMeanSquare(const float* pBuffer, int nSamples, float& fPeak, float& fMeanSquare)
+{
+	float fMax = 0.0;
+	float fSum = 0.0;
+	int i = 0;
+
+#if METER_USE_SSE2
+	//	clear the sign bit for abs()
+	const __m128 vAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	__m128 vMax = _mm_setzero_ps();
+	__m128 vSum = _mm_setzero_ps();
+
+	for (; i + 4 <= nSamples; i += 4) {
+		__m128 vIn = _mm_loadu_ps(pBuffer + i);
+		vMax = _mm_max_ps(vMax, _mm_and_ps(vIn, vAbsMask));
+		vSum = _mm_add_ps(vSum, _mm_mul_ps(vIn, vIn));
+	}
+
+	//	fold the four lanes
+	float fLanes[4];
+	_mm_storeu_ps(fLanes, vMax);
+	fMax = fmax(fmax(fLanes[0], fLanes[1]), fmax(fLanes[2], fLanes[3]));
+	_mm_storeu_ps(fLanes, vSum);
+	fSum = (fLanes[0] + fLanes[1]) + (fLanes[2] + fLanes[3]);
+#endif
+
+	//	leftovers (or everything, without SSE2)
+	for (; i < nSamples; i++) {
+		fMax = fmax(fMax, (float)fabs(pBuffer[i]));
+		fSum += pBuffer[i] * pBuffer[i];
+	}
+
+	fPeak = fMax;
+	fMeanSquare = nSamples > 0 ? fSum / (float)nSamples : 0.0;
+}
+
+/*
+	OutputMeter
+	Block rate peak and RMS metering of the synth output.
+
+	Each processing block is reduced to one peak and one RMS value, and those
+	are run through CEnvelopeDetectors clocked at the block rate, so the
+	ballistics cost nothing per sample. The values are published every
+	METER_UPDATE_INTERVAL_MSEC, normalized over METER_MIN_DB -> 0dB.
+*/
+class OutputMeter {
+public:
+	OutputMeter(void);
+	~OutputMeter(void);
+
+	//	the detectors run once per block, so they need the block size as well
+	void setSampleRate(double dFs, int nBlockSize);
+
+	//	flush the detectors and the update counter
+	void reset();
+
+	//	meter one block; returns true if the meter interval has elapsed
+	//	and the outputs below were refreshed
+	bool processBlock(float** ppBuffers, int nChannels, int nSamples);
+
+	//	meter outputs, 0->1 over METER_MIN_DB -> 0dB
+	double m_dPeak[METER_CHANNELS];
+	double m_dRMS[METER_CHANNELS];
+
+	//	true if the last block on this channel was digital silence
+	bool m_bSilent[METER_CHANNELS];
+
+protected:
+	//	one of each per channel
+	CEnvelopeDetector m_PeakDetector[METER_CHANNELS];
+	CEnvelopeDetector m_RMSDetector[METER_CHANNELS];
+
+	//	latest detector outputs in dB
+	float m_fPeak_dB[METER_CHANNELS];
+	float m_fRMS_dB[METER_CHANNELS];
+
+	//	decimation to the meter interval
+	int m_nSamplesPerUpdate;
+	int m_nSampleCounter;
+
+	//	dB to 0->1
+	inline double normalizeMeter_dB(float fMeter_dB) {
+		double dNorm = (fMeter_dB - METER_MIN_DB) / (0.0 - METER_MIN_DB);
+		return fmin(fmax(dNorm, 0.0), 1.0);
+	}
+};
@@ -0,0 +1,645 @@
+#include "Oversampler.h"
+#include "BatchMath.h"
+#include <math.h>
+#include <string.h>
+
+//	the project builds with /fp:fast; the kernels must not be contracted
+//	or reassociated, or the paths stop matching
+#if defined _MSC_VER
+#pragma float_control(precise, on, push)
+#endif
+
+/*
+	half-band FIR, K coefficients c1..cK on the odd taps around the 0.5
+	centre tap, delay D = 2K - 1 samples at the high rate
+
+	up (zero stuffed, gain 2), per input x[m]
+		y[2m]     = 2 sum ci (x[m - K + 1 - i] + x[m - K + i])
+		y[2m + 1] = x[m - K + 1]
+	down, even input samples E, odd O, keep the even outputs
+		y[m] = sum ci (E[m - K + 1 - i] + E[m - K + i]) + 0.5 O[m - K]
+
+	The sums are the kernels; the centre tap is a copy (up) or one
+	multiply-add (down) done for all channels in upStage()/downStage().
+	pLine holds 2K - 1 samples of history before the new ones, so for
+	output m the pair for ci is pLine[m + K - i] and pLine[m + K - 1 + i].
+*/
+
+//------------------------------------------------------------------------
+//	scalar reference, one channel per call
+//------------------------------------------------------------------------
+static void firScalar(const float* pLine, const float* pCoeff, int nCoeffs, float fGain, float* pOut, int nOutStride, int nChannels, int nLane, int nSamples) {
+	for (int m = 0; m < nSamples; m++) {
+		const float* p = pLine + (m + nCoeffs - 1) * nChannels + nLane;
+		float fAcc = 0.0f;
+		for (int i = 1; i <= nCoeffs; i++) {
+			fAcc += pCoeff[i - 1] * (p[(1 - i) * nChannels] + p[i * nChannels]);
+		}
+		pOut[m * nOutStride + nLane] = fAcc * fGain;
+	}
+}
+
+/*
+	polyphase IIR (two allpass chains in z^2), each section
+		t = (a - y) c + x,  x = a,  y = t,  a = t
+	up: both chains take the input, chain 0 gives the even output and
+	chain 1 the odd one. down: chain 0 takes the odd input, chain 1 the
+	even one, the output is their average
+*/
+static void iirUpScalar(OversamplerStage& stage, const float* pIn, float* pOut, int nChannels, int nLane, int nSamples) {
+	float x[OVERSAMPLER_MAX_COEFFS], y[OVERSAMPLER_MAX_COEFFS];
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		x[i] = stage.fUpX[i][nLane];
+		y[i] = stage.fUpY[i][nLane];
+	}
+
+	for (int m = 0; m < nSamples; m++) {
+		float a = pIn[m * nChannels + nLane];
+		float b = a;
+		for (int i = 0; i < stage.nCoeffs; i += 2) {
+			float t = (a - y[i]) * stage.fCoeff[i] + x[i];
+			x[i] = a;
+			y[i] = t;
+			a = t;
+			if (i + 1 < stage.nCoeffs) {
+				t = (b - y[i + 1]) * stage.fCoeff[i + 1] + x[i + 1];
+				x[i + 1] = b;
+				y[i + 1] = t;
+				b = t;
+			}
+		}
+		pOut[(2 * m) * nChannels + nLane] = a;
+		pOut[(2 * m + 1) * nChannels + nLane] = b;
+	}
+
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		stage.fUpX[i][nLane] = x[i];
+		stage.fUpY[i][nLane] = y[i];
+	}
+}
+
+static void iirDownScalar(OversamplerStage& stage, const float* pIn, float* pOut, int nChannels, int nLane, int nSamples) {
+	float x[OVERSAMPLER_MAX_COEFFS], y[OVERSAMPLER_MAX_COEFFS];
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		x[i] = stage.fDownX[i][nLane];
+		y[i] = stage.fDownY[i][nLane];
+	}
+
+	for (int m = 0; m < nSamples; m++) {
+		float a = pIn[(2 * m + 1) * nChannels + nLane];
+		float b = pIn[(2 * m) * nChannels + nLane];
+		for (int i = 0; i < stage.nCoeffs; i += 2) {
+			float t = (a - y[i]) * stage.fCoeff[i] + x[i];
+			x[i] = a;
+			y[i] = t;
+			a = t;
+			if (i + 1 < stage.nCoeffs) {
+				t = (b - y[i + 1]) * stage.fCoeff[i + 1] + x[i + 1];
+				x[i + 1] = b;
+				y[i + 1] = t;
+				b = t;
+			}
+		}
+		pOut[m * nChannels + nLane] = (a + b) * 0.5f;
+	}
+
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		stage.fDownX[i][nLane] = x[i];
+		stage.fDownY[i][nLane] = y[i];
+	}
+}
+
+#if BATCH_MATH_X86
+//------------------------------------------------------------------------
+//	SSE2, 4 channels per pass
+//------------------------------------------------------------------------
+BATCH_TARGET_SSE2 static void firSSE2(const float* pLine, const float* pCoeff, int nCoeffs, float fGain, float* pOut, int nOutStride, int nChannels, int nLane, int nSamples) {
+	const __m128 gain = _mm_set1_ps(fGain);
+	for (int m = 0; m < nSamples; m++) {
+		const float* p = pLine + (m + nCoeffs - 1) * nChannels + nLane;
+		__m128 acc = _mm_setzero_ps();
+		for (int i = 1; i <= nCoeffs; i++) {
+			__m128 pair = _mm_add_ps(_mm_loadu_ps(p + (1 - i) * nChannels), _mm_loadu_ps(p + i * nChannels));
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(pCoeff[i - 1]), pair));
+		}
+		_mm_storeu_ps(pOut + m * nOutStride + nLane, _mm_mul_ps(acc, gain));
+	}
+}
+
+BATCH_TARGET_SSE2 static void iirUpSSE2(OversamplerStage& stage, const float* pIn, float* pOut, int nChannels, int nLane, int nSamples) {
+	__m128 x[OVERSAMPLER_MAX_COEFFS], y[OVERSAMPLER_MAX_COEFFS], c[OVERSAMPLER_MAX_COEFFS];
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		x[i] = _mm_loadu_ps(&stage.fUpX[i][nLane]);
+		y[i] = _mm_loadu_ps(&stage.fUpY[i][nLane]);
+		c[i] = _mm_set1_ps(stage.fCoeff[i]);
+	}
+
+	for (int m = 0; m < nSamples; m++) {
+		__m128 a = _mm_loadu_ps(pIn + m * nChannels + nLane);
+		__m128 b = a;
+		for (int i = 0; i < stage.nCoeffs; i += 2) {
+			__m128 t = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(a, y[i]), c[i]), x[i]);
+			x[i] = a;
+			y[i] = t;
+			a = t;
+			if (i + 1 < stage.nCoeffs) {
+				t = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(b, y[i + 1]), c[i + 1]), x[i + 1]);
+				x[i + 1] = b;
+				y[i + 1] = t;
+				b = t;
+			}
+		}
+		_mm_storeu_ps(pOut + (2 * m) * nChannels + nLane, a);
+		_mm_storeu_ps(pOut + (2 * m + 1) * nChannels + nLane, b);
+	}
+
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		_mm_storeu_ps(&stage.fUpX[i][nLane], x[i]);
+		_mm_storeu_ps(&stage.fUpY[i][nLane], y[i]);
+	}
+}
+
+BATCH_TARGET_SSE2 static void iirDownSSE2(OversamplerStage& stage, const float* pIn, float* pOut, int nChannels, int nLane, int nSamples) {
+	__m128 x[OVERSAMPLER_MAX_COEFFS], y[OVERSAMPLER_MAX_COEFFS], c[OVERSAMPLER_MAX_COEFFS];
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		x[i] = _mm_loadu_ps(&stage.fDownX[i][nLane]);
+		y[i] = _mm_loadu_ps(&stage.fDownY[i][nLane]);
+		c[i] = _mm_set1_ps(stage.fCoeff[i]);
+	}
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	for (int m = 0; m < nSamples; m++) {
+		__m128 a = _mm_loadu_ps(pIn + (2 * m + 1) * nChannels + nLane);
+		__m128 b = _mm_loadu_ps(pIn + (2 * m) * nChannels + nLane);
+		for (int i = 0; i < stage.nCoeffs; i += 2) {
+			__m128 t = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(a, y[i]), c[i]), x[i]);
+			x[i] = a;
+			y[i] = t;
+			a = t;
+			if (i + 1 < stage.nCoeffs) {
+				t = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(b, y[i + 1]), c[i + 1]), x[i + 1]);
+				x[i + 1] = b;
+				y[i + 1] = t;
+				b = t;
+			}
+		}
+		_mm_storeu_ps(pOut + m * nChannels + nLane, _mm_mul_ps(_mm_add_ps(a, b), half));
+	}
+
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		_mm_storeu_ps(&stage.fDownX[i][nLane], x[i]);
+		_mm_storeu_ps(&stage.fDownY[i][nLane], y[i]);
+	}
+}
+
+//------------------------------------------------------------------------
+//	AVX2, 8 channels per pass
+//------------------------------------------------------------------------
+BATCH_TARGET_AVX2 static void firAVX2(const float* pLine, const float* pCoeff, int nCoeffs, float fGain, float* pOut, int nOutStride, int nChannels, int nLane, int nSamples) {
+	const __m256 gain = _mm256_set1_ps(fGain);
+	for (int m = 0; m < nSamples; m++) {
+		const float* p = pLine + (m + nCoeffs - 1) * nChannels + nLane;
+		__m256 acc = _mm256_setzero_ps();
+		for (int i = 1; i <= nCoeffs; i++) {
+			__m256 pair = _mm256_add_ps(_mm256_loadu_ps(p + (1 - i) * nChannels), _mm256_loadu_ps(p + i * nChannels));
+			acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(pCoeff[i - 1]), pair));
+		}
+		_mm256_storeu_ps(pOut + m * nOutStride + nLane, _mm256_mul_ps(acc, gain));
+	}
+}
+
+BATCH_TARGET_AVX2 static void iirUpAVX2(OversamplerStage& stage, const float* pIn, float* pOut, int nChannels, int nLane, int nSamples) {
+	__m256 x[OVERSAMPLER_MAX_COEFFS], y[OVERSAMPLER_MAX_COEFFS], c[OVERSAMPLER_MAX_COEFFS];
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		x[i] = _mm256_loadu_ps(&stage.fUpX[i][nLane]);
+		y[i] = _mm256_loadu_ps(&stage.fUpY[i][nLane]);
+		c[i] = _mm256_set1_ps(stage.fCoeff[i]);
+	}
+
+	for (int m = 0; m < nSamples; m++) {
+		__m256 a = _mm256_loadu_ps(pIn + m * nChannels + nLane);
+		__m256 b = a;
+		for (int i = 0; i < stage.nCoeffs; i += 2) {
+			__m256 t = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(a, y[i]), c[i]), x[i]);
+			x[i] = a;
+			y[i] = t;
+			a = t;
+			if (i + 1 < stage.nCoeffs) {
+				t = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(b, y[i + 1]), c[i + 1]), x[i + 1]);
+				x[i + 1] = b;
+				y[i + 1] = t;
+				b = t;
+			}
+		}
+		_mm256_storeu_ps(pOut + (2 * m) * nChannels + nLane, a);
+		_mm256_storeu_ps(pOut + (2 * m + 1) * nChannels + nLane, b);
+	}
+
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		_mm256_storeu_ps(&stage.fUpX[i][nLane], x[i]);
+		_mm256_storeu_ps(&stage.fUpY[i][nLane], y[i]);
+	}
+}
+
+BATCH_TARGET_AVX2 static void iirDownAVX2(OversamplerStage& stage, const float* pIn, float* pOut, int nChannels, int nLane, int nSamples) {
+	__m256 x[OVERSAMPLER_MAX_COEFFS], y[OVERSAMPLER_MAX_COEFFS], c[OVERSAMPLER_MAX_COEFFS];
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		x[i] = _mm256_loadu_ps(&stage.fDownX[i][nLane]);
+		y[i] = _mm256_loadu_ps(&stage.fDownY[i][nLane]);
+		c[i] = _mm256_set1_ps(stage.fCoeff[i]);
+	}
+	const __m256 half = _mm256_set1_ps(0.5f);
+
+	for (int m = 0; m < nSamples; m++) {
+		__m256 a = _mm256_loadu_ps(pIn + (2 * m + 1) * nChannels + nLane);
+		__m256 b = _mm256_loadu_ps(pIn + (2 * m) * nChannels + nLane);
+		for (int i = 0; i < stage.nCoeffs; i += 2) {
+			__m256 t = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(a, y[i]), c[i]), x[i]);
+			x[i] = a;
+			y[i] = t;
+			a = t;
+			if (i + 1 < stage.nCoeffs) {
+				t = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(b, y[i + 1]), c[i + 1]), x[i + 1]);
+				x[i + 1] = b;
+				y[i + 1] = t;
+				b = t;
+			}
+		}
+		_mm256_storeu_ps(pOut + m * nChannels + nLane, _mm256_mul_ps(_mm256_add_ps(a, b), half));
+	}
+
+	for (int i = 0; i < stage.nCoeffs; i++) {
+		_mm256_storeu_ps(&stage.fDownX[i][nLane], x[i]);
+		_mm256_storeu_ps(&stage.fDownY[i][nLane], y[i]);
+	}
+}
+#endif // BATCH_MATH_X86
+
+#if defined _MSC_VER
+#pragma float_control(pop)
+#endif
+
+//------------------------------------------------------------------------
+//	dispatch; indexed by getBatchMathISA()
+//------------------------------------------------------------------------
+typedef void (*OversamplerFIRKernel)(const float*, const float*, int, float, float*, int, int, int, int);
+typedef void (*OversamplerIIRKernel)(OversamplerStage&, const float*, float*, int, int, int);
+
+struct OversamplerKernels {
+	int nLanes;		//	channels per call
+	OversamplerFIRKernel fir;
+	OversamplerIIRKernel iirUp;
+	OversamplerIIRKernel iirDown;
+};
+
+static const OversamplerKernels oversamplerKernels[] = {
+	{ 1, firScalar, iirUpScalar, iirDownScalar },
+#if BATCH_MATH_X86
+	{ 4, firSSE2, iirUpSSE2, iirDownSSE2 },
+	{ 8, firAVX2, iirUpAVX2, iirDownAVX2 },
+#endif
+};
+
+//------------------------------------------------------------------------
+//	designs
+//------------------------------------------------------------------------
+struct OversamplerSpec {
+	bool bFIR;
+	int nCoeffs;
+	double dShape;	//	IIR: transition band, fraction of the stage's high rate; FIR: Kaiser beta
+};
+
+//	the first stage has its passband edge right at the top of the audio
+//	band; each later one only has to clear what the stage before passed,
+//	so it gets a wide transition and few coefficients
+static const OversamplerSpec oversamplerSpecs[OVERSAMPLER_QUALITIES][OVERSAMPLER_MAX_STAGES] = {
+	{ { false, 4, 0.06 }, { false, 2, 0.25 }, { false, 2, 0.35 } },	//	eco
+	{ { false, 8, 0.04 }, { false, 4, 0.25 }, { false, 3, 0.35 } },	//	normal
+	{ { true, 32, 9.0 }, { true, 8, 10.0 }, { true, 6, 10.0 } },	//	high, linear phase
+};
+
+static double oversamplerIPow(double dX, int n) {
+	double dResult = 1.0;
+	while (n-- > 0) {
+		dResult *= dX;
+	}
+	return dResult;
+}
+
+/*
+	polyphase allpass half-band (elliptic), after Valenzuela and
+	Constantinides: the transition band sets the elliptic modulus k and
+	nome q, coefficient i then comes from two quickly converging series
+*/
+static void designHalfBandIIR(float* pCoeff, int nCoeffs, double dTransition) {
+	double k = tan((1.0 - dTransition * 2.0) * pi / 4.0);
+	k *= k;
+	double kk = pow(1.0 - k * k, 0.25);
+	double e = 0.5 * (1.0 - kk) / (1.0 + kk);
+	double e4 = e * e * e * e;
+	double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+	int nOrder = nCoeffs * 2 + 1;
+	for (int c = 1; c <= nCoeffs; c++) {
+		double dNum = 0.0;
+		double dTerm = 0.0;
+		int nSign = 1;
+		int i = 0;
+		do {
+			dTerm = oversamplerIPow(q, i * (i + 1)) * sin((i * 2 + 1) * c * pi / nOrder) * nSign;
+			dNum += dTerm;
+			nSign = -nSign;
+			i++;
+		} while (fabs(dTerm) > 1e-100);
+
+		double dDen = 0.0;
+		nSign = -1;
+		i = 1;
+		do {
+			dTerm = oversamplerIPow(q, i * i) * cos(i * 2 * c * pi / nOrder) * nSign;
+			dDen += dTerm;
+			nSign = -nSign;
+			i++;
+		} while (fabs(dTerm) > 1e-100);
+
+		double ww = dNum * pow(q, 0.25) / (dDen + 0.5);
+		double ww2 = ww * ww;
+		double x = sqrt((1.0 - ww2 * k) * (1.0 - ww2 / k)) / (1.0 + ww2);
+		pCoeff[c - 1] = (float)((1.0 - x) / (1.0 + x));
+	}
+}
+
+//	zeroth order modified Bessel function, for the Kaiser window
+static double oversamplerBessel0(double dX) {
+	double dSum = 1.0;
+	double dTerm = 1.0;
+	for (int k = 1; k < 64; k++) {
+		dTerm *= (dX / (2.0 * k)) * (dX / (2.0 * k));
+		dSum += dTerm;
+		if (dTerm < 1e-12 * dSum) {
+			break;
+		}
+	}
+	return dSum;
+}
+
+/*
+	Kaiser windowed sinc half-band; the odd taps only (the even ones
+	are 0), normalized so the DC gain is exactly 1: 0.5 + 2 sum ci = 1
+*/
+static void designHalfBandFIR(float* pCoeff, int nCoeffs, double dBeta) {
+	double dCoeff[OVERSAMPLER_MAX_COEFFS];
+	double dSum = 0.0;
+	double dHalfLength = 2.0 * nCoeffs;
+	for (int i = 1; i <= nCoeffs; i++) {
+		double m = 2.0 * i - 1.0;
+		double dRatio = m / dHalfLength;
+		double dWindow = oversamplerBessel0(dBeta * sqrt(1.0 - dRatio * dRatio)) / oversamplerBessel0(dBeta);
+		dCoeff[i - 1] = sin(pi * m / 2.0) / (pi * m) * dWindow;
+		dSum += dCoeff[i - 1];
+	}
+	for (int i = 0; i < nCoeffs; i++) {
+		pCoeff[i] = (float)(dCoeff[i] * 0.25 / dSum);
+	}
+}
+
+//------------------------------------------------------------------------
+//	Oversampler
+//------------------------------------------------------------------------
+Oversampler::Oversampler(void) {
+	memset(m_fDesign, 0, sizeof(m_fDesign));
+	for (int q = 0; q < OVERSAMPLER_QUALITIES; q++) {
+		for (int s = 0; s < OVERSAMPLER_MAX_STAGES; s++) {
+			const OversamplerSpec& spec = oversamplerSpecs[q][s];
+			if (spec.bFIR) {
+				designHalfBandFIR(m_fDesign[q][s], spec.nCoeffs, spec.dShape);
+			} else {
+				designHalfBandIIR(m_fDesign[q][s], spec.nCoeffs, spec.dShape);
+			}
+		}
+	}
+
+	init(1, 1, OVERSAMPLER_NORMAL);
+}
+
+Oversampler::~Oversampler(void) {
+}
+
+int Oversampler::factorToStages(int nFactor) {
+	int nStages = 0;
+	while (nStages < OVERSAMPLER_MAX_STAGES && (2 << nStages) <= nFactor) {
+		nStages++;
+	}
+	return nStages;
+}
+
+/*
+	Oversampler::calculateLatency()
+	A FIR stage delays by 2K - 1 samples at its high rate each way; an
+	IIR stage by about sum((1 - c)/(1 + c)) per chain (in z^2) plus half
+	a sample. Stage s runs at 2^(s + 1) times the base rate.
+*/
+int Oversampler::calculateLatency(int nFactor, UINT uQuality) {
+	if (uQuality >= OVERSAMPLER_QUALITIES) {
+		uQuality = OVERSAMPLER_NORMAL;
+	}
+
+	double dLatency = 0.0;
+	int nStages = factorToStages(nFactor);
+	for (int s = 0; s < nStages; s++) {
+		const OversamplerSpec& spec = oversamplerSpecs[uQuality][s];
+		double dStageDelay = 0.0;
+		if (spec.bFIR) {
+			dStageDelay = 2.0 * (2 * spec.nCoeffs - 1);
+		} else {
+			for (int i = 0; i < spec.nCoeffs; i++) {
+				float fCoeff = m_fDesign[uQuality][s][i];
+				dStageDelay += 2.0 * (1.0 - fCoeff) / (1.0 + fCoeff);
+			}
+			dStageDelay += 1.0;
+		}
+		dLatency += dStageDelay / (double)(2 << s);
+	}
+	return (int)(dLatency + 0.5);
+}
+
+void Oversampler::init(int nChannels, int nFactor, UINT uQuality) {
+	m_nChannels = nChannels < 1 ? 1 : (nChannels > OVERSAMPLER_MAX_CHANNELS ? OVERSAMPLER_MAX_CHANNELS : nChannels);
+	m_uQuality = uQuality < OVERSAMPLER_QUALITIES ? uQuality : (UINT)OVERSAMPLER_NORMAL;
+	m_nStages = factorToStages(nFactor);
+	m_nLatency = calculateLatency(nFactor, m_uQuality);
+
+	for (int s = 0; s < OVERSAMPLER_MAX_STAGES; s++) {
+		OversamplerStage& stage = m_Stages[s];
+		const OversamplerSpec& spec = oversamplerSpecs[m_uQuality][s];
+		stage.bFIR = spec.bFIR;
+		stage.nCoeffs = spec.nCoeffs;
+		memcpy(stage.fCoeff, m_fDesign[m_uQuality][s], sizeof(stage.fCoeff));
+	}
+
+	flushDelays();
+	memset(m_fScratch, 0, sizeof(m_fScratch));
+}
+
+void Oversampler::flushDelays() {
+	for (int s = 0; s < OVERSAMPLER_MAX_STAGES; s++) {
+		OversamplerStage& stage = m_Stages[s];
+		memset(stage.fUpX, 0, sizeof(stage.fUpX));
+		memset(stage.fUpY, 0, sizeof(stage.fUpY));
+		memset(stage.fDownX, 0, sizeof(stage.fDownX));
+		memset(stage.fDownY, 0, sizeof(stage.fDownY));
+		memset(stage.fUpLine, 0, sizeof(stage.fUpLine));
+		memset(stage.fDownEven, 0, sizeof(stage.fDownEven));
+		memset(stage.fDownOdd, 0, sizeof(stage.fDownOdd));
+	}
+}
+
+void Oversampler::flushDelays(int nChannel) {
+	if (nChannel < 0 || nChannel >= m_nChannels) {
+		return;
+	}
+
+	for (int s = 0; s < OVERSAMPLER_MAX_STAGES; s++) {
+		OversamplerStage& stage = m_Stages[s];
+		for (int i = 0; i < OVERSAMPLER_MAX_COEFFS; i++) {
+			stage.fUpX[i][nChannel] = 0.0f;
+			stage.fUpY[i][nChannel] = 0.0f;
+			stage.fDownX[i][nChannel] = 0.0f;
+			stage.fDownY[i][nChannel] = 0.0f;
+		}
+		for (int n = 0; n < OVERSAMPLER_FIR_LINE; n++) {
+			stage.fUpLine[n * m_nChannels + nChannel] = 0.0f;
+			stage.fDownEven[n * m_nChannels + nChannel] = 0.0f;
+			stage.fDownOdd[n * m_nChannels + nChannel] = 0.0f;
+		}
+	}
+}
+
+/*
+	Oversampler::upStage()
+	nSamples in, 2 nSamples out. Channel groups go widest kernel first,
+	as in BiQuadCascade::process(); the FIR line moves on for all
+	channels so skipped ones stay in step.
+*/
+void Oversampler::upStage(OversamplerStage& stage, const float* pIn, float* pOut, int nSamples, UINT uChannelMask) {
+	const int nChannels = m_nChannels;
+	const int nHistory = 2 * stage.nCoeffs - 1;
+
+	if (stage.bFIR) {
+		memcpy(stage.fUpLine + nHistory * nChannels, pIn, nSamples * nChannels * sizeof(float));
+	}
+
+	int nLane = 0;
+	for (int nISA = getBatchMathISA(); nISA >= 0; nISA--) {
+		const OversamplerKernels& kernels = oversamplerKernels[nISA];
+		UINT uGroupMask = (1u << kernels.nLanes) - 1;
+
+		for (; nLane + kernels.nLanes <= nChannels; nLane += kernels.nLanes) {
+			if (uChannelMask & (uGroupMask << nLane)) {
+				if (stage.bFIR) {
+					kernels.fir(stage.fUpLine, stage.fCoeff, stage.nCoeffs, 2.0f, pOut, 2 * nChannels, nChannels, nLane, nSamples);
+				} else {
+					kernels.iirUp(stage, pIn, pOut, nChannels, nLane, nSamples);
+				}
+			}
+		}
+	}
+
+	if (stage.bFIR) {
+		//	odd outputs: the centre tap
+		for (int m = 0; m < nSamples; m++) {
+			memcpy(pOut + (2 * m + 1) * nChannels, stage.fUpLine + (m + stage.nCoeffs) * nChannels, nChannels * sizeof(float));
+		}
+		memmove(stage.fUpLine, stage.fUpLine + nSamples * nChannels, nHistory * nChannels * sizeof(float));
+	}
+}
+
+//	2 nSamples in, nSamples out
+void Oversampler::downStage(OversamplerStage& stage, const float* pIn, float* pOut, int nSamples, UINT uChannelMask) {
+	const int nChannels = m_nChannels;
+	const int nHistory = 2 * stage.nCoeffs - 1;
+
+	if (stage.bFIR) {
+		for (int m = 0; m < nSamples; m++) {
+			memcpy(stage.fDownEven + (nHistory + m) * nChannels, pIn + (2 * m) * nChannels, nChannels * sizeof(float));
+			memcpy(stage.fDownOdd + (nHistory + m) * nChannels, pIn + (2 * m + 1) * nChannels, nChannels * sizeof(float));
+		}
+	}
+
+	int nLane = 0;
+	for (int nISA = getBatchMathISA(); nISA >= 0; nISA--) {
+		const OversamplerKernels& kernels = oversamplerKernels[nISA];
+		UINT uGroupMask = (1u << kernels.nLanes) - 1;
+
+		for (; nLane + kernels.nLanes <= nChannels; nLane += kernels.nLanes) {
+			if (uChannelMask & (uGroupMask << nLane)) {
+				if (stage.bFIR) {
+					kernels.fir(stage.fDownEven, stage.fCoeff, stage.nCoeffs, 1.0f, pOut, nChannels, nChannels, nLane, nSamples);
+				} else {
+					kernels.iirDown(stage, pIn, pOut, nChannels, nLane, nSamples);
+				}
+			}
+		}
+	}
+
+	if (stage.bFIR) {
+		//	plus the centre tap
+		for (int m = 0; m < nSamples; m++) {
+			const float* pOdd = stage.fDownOdd + (m + stage.nCoeffs - 1) * nChannels;
+			float* p = pOut + m * nChannels;
+			for (int i = 0; i < nChannels; i++) {
+				p[i] += 0.5f * pOdd[i];
+			}
+		}
+		memmove(stage.fDownEven, stage.fDownEven + nSamples * nChannels, nHistory * nChannels * sizeof(float));
+		memmove(stage.fDownOdd, stage.fDownOdd + nSamples * nChannels, nHistory * nChannels * sizeof(float));
+	}
+}
+
+void Oversampler::upsample(const float* pIn, float* pOut, int nSamples, UINT uChannelMask) {
+	if (m_nStages == 0) {
+		if (pOut != pIn) {
+			memmove(pOut, pIn, nSamples * m_nChannels * sizeof(float));
+		}
+		return;
+	}
+
+	while (nSamples > 0) {
+		int nBlock = nSamples < OVERSAMPLER_MAX_BLOCK ? nSamples : OVERSAMPLER_MAX_BLOCK;
+
+		const float* pStageIn = pIn;
+		for (int s = 0; s < m_nStages; s++) {
+			float* pStageOut = s == m_nStages - 1 ? pOut : m_fScratch[s];
+			upStage(m_Stages[s], pStageIn, pStageOut, nBlock << s, uChannelMask);
+			pStageIn = pStageOut;
+		}
+
+		pIn += nBlock * m_nChannels;
+		pOut += (nBlock << m_nStages) * m_nChannels;
+		nSamples -= nBlock;
+	}
+}
+
+void Oversampler::downsample(const float* pIn, float* pOut, int nSamples, UINT uChannelMask) {
+	if (m_nStages == 0) {
+		if (pOut != pIn) {
+			memmove(pOut, pIn, nSamples * m_nChannels * sizeof(float));
+		}
+		return;
+	}
+
+	while (nSamples > 0) {
+		int nBlock = nSamples < OVERSAMPLER_MAX_BLOCK ? nSamples : OVERSAMPLER_MAX_BLOCK;
+
+		const float* pStageIn = pIn;
+		for (int s = m_nStages - 1; s >= 0; s--) {
+			float* pStageOut = s == 0 ? pOut : m_fScratch[s - 1];
+			downStage(m_Stages[s], pStageIn, pStageOut, nBlock << s, uChannelMask);
+			pStageIn = pStageOut;
+		}
+
+		pIn += (nBlock << m_nStages) * m_nChannels;
+		pOut += nBlock * m_nChannels;
+		nSamples -= nBlock;
+	}
+}
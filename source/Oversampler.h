@@ -0,0 +1,124 @@
+#pragma once
+#include "pluginconstants.h"
+
+//	most channels (or voices) one oversampler runs; a multiple of 8 so the
+//	channels split evenly into SIMD groups, and at most 32 for the UINT
+//	channel masks; 32 is both lanes of every voice
+#define OVERSAMPLER_MAX_CHANNELS 32
+
+//	2x stages in series: 1 = 2x, 2 = 4x, 3 = 8x
+#define OVERSAMPLER_MAX_STAGES 3
+#define OVERSAMPLER_MAX_FACTOR (1 << OVERSAMPLER_MAX_STAGES)
+
+//	base rate samples per internal pass; longer calls are split up
+#define OVERSAMPLER_MAX_BLOCK 32
+
+//	longest half-band per stage: allpass coefficients (IIR) or
+//	coefficients on one side of the centre tap (FIR)
+#define OVERSAMPLER_MAX_COEFFS 32
+
+//	FIR delay line: history plus the most samples a stage takes per pass
+#define OVERSAMPLER_FIR_HISTORY (2 * OVERSAMPLER_MAX_COEFFS - 1)
+#define OVERSAMPLER_FIR_LINE (OVERSAMPLER_FIR_HISTORY + (OVERSAMPLER_MAX_BLOCK << (OVERSAMPLER_MAX_STAGES - 1)))
+
+//	quality tiers; same order as the Oversampling Quality controls
+enum {
+	OVERSAMPLER_ECO,		//	polyphase IIR, short
+	OVERSAMPLER_NORMAL,		//	polyphase IIR, about 95dB image/alias rejection
+	OVERSAMPLER_HIGH,		//	linear phase FIR, about 90dB, flat to 20kHz at 44.1kHz
+	OVERSAMPLER_QUALITIES
+};
+
+//	one 2x half-band stage, both directions; state is one float per
+//	channel (structure of arrays), so a group of channels is one SIMD load
+struct OversamplerStage {
+	bool bFIR;
+	int nCoeffs;
+	float fCoeff[OVERSAMPLER_MAX_COEFFS];
+
+	//	IIR: allpass sections, even ones on path 0, odd ones on path 1
+	float fUpX[OVERSAMPLER_MAX_COEFFS][OVERSAMPLER_MAX_CHANNELS];
+	float fUpY[OVERSAMPLER_MAX_COEFFS][OVERSAMPLER_MAX_CHANNELS];
+	float fDownX[OVERSAMPLER_MAX_COEFFS][OVERSAMPLER_MAX_CHANNELS];
+	float fDownY[OVERSAMPLER_MAX_COEFFS][OVERSAMPLER_MAX_CHANNELS];
+
+	//	FIR: input line for upsampling; even and odd input samples for downsampling
+	float fUpLine[OVERSAMPLER_FIR_LINE * OVERSAMPLER_MAX_CHANNELS];
+	float fDownEven[OVERSAMPLER_FIR_LINE * OVERSAMPLER_MAX_CHANNELS];
+	float fDownOdd[OVERSAMPLER_FIR_LINE * OVERSAMPLER_MAX_CHANNELS];
+};
+
+/*
+	Oversampler
+	2x, 4x or 8x up and down sampling of up to OVERSAMPLER_MAX_CHANNELS
+	channels, for running a nonlinear stage (saturating filter, shaper)
+	above the base rate so the harmonics it makes fold back less.
+
+	Each factor of 2 is a polyphase half-band stage: either a pair of
+	allpass chains (IIR, very cheap, not linear phase) or a half-band
+	FIR (linear phase; every other tap is zero so only one side of the
+	odd taps is stored). The first stage carries the audio band edge and
+	is the steep one; the later stages only have to reject what lies
+	above the band the first one passed, so they are much shorter.
+
+	Blocks are interleaved by channel, pBlock[sample * nChannels + channel],
+	like the BiQuadCascade and the VoiceFilterBank, and the channels are
+	the SIMD lanes: 8 (AVX2) or 4 (SSE2) per pass, channels left over run
+	on the scalar kernel. All paths give bit-identical output.
+
+	init() picks the factor and quality and clears the state; the designs
+	are worked out once in the constructor, so nothing is allocated
+	later. upsample() and downsample() run on the audio thread.
+*/
+class Oversampler {
+public:
+	Oversampler(void);
+	~Oversampler(void);
+
+	//	channel count, 1/2/4/8 and an OVERSAMPLER_ quality; clears the state
+	void init(int nChannels, int nFactor, UINT uQuality);
+
+	int getChannels() { return m_nChannels; }
+	int getFactor() { return 1 << m_nStages; }
+	UINT getQuality() { return m_uQuality; }
+
+	//	round trip (up then down) delay in base rate samples, rounded;
+	//	for the IIR tiers it is the group delay at DC
+	int getLatencySamples() { return m_nLatency; }
+
+	//	the same for any factor and quality, without init()
+	int calculateLatency(int nFactor, UINT uQuality);
+
+	//	clear the state of all channels or of one
+	void flushDelays();
+	void flushDelays(int nChannel);
+
+	//	nSamples base rate frames of pIn -> nSamples * getFactor() frames
+	//	of pOut, both interleaved by channel. Only SIMD groups with a
+	//	channel in uChannelMask are processed
+	void upsample(const float* pIn, float* pOut, int nSamples, UINT uChannelMask = 0xFFFFFFFF);
+
+	//	nSamples * getFactor() frames of pIn -> nSamples frames of pOut
+	void downsample(const float* pIn, float* pOut, int nSamples, UINT uChannelMask = 0xFFFFFFFF);
+
+protected:
+	int m_nChannels;
+	int m_nStages;
+	UINT m_uQuality;
+	int m_nLatency;
+
+	//	1/2/4/8 -> stages
+	static int factorToStages(int nFactor);
+
+	//	[quality][stage] designs, from the constructor
+	float m_fDesign[OVERSAMPLER_QUALITIES][OVERSAMPLER_MAX_STAGES][OVERSAMPLER_MAX_COEFFS];
+
+	//	stage 0 runs base <-> 2x
+	OversamplerStage m_Stages[OVERSAMPLER_MAX_STAGES];
+
+	//	between stages; stage s upsamples into [s], downsamples into [s - 1]
+	float m_fScratch[OVERSAMPLER_MAX_STAGES - 1][(OVERSAMPLER_MAX_BLOCK << (OVERSAMPLER_MAX_STAGES - 1)) * OVERSAMPLER_MAX_CHANNELS];
+
+	void upStage(OversamplerStage& stage, const float* pIn, float* pOut, int nSamples, UINT uChannelMask);
+	void downStage(OversamplerStage& stage, const float* pIn, float* pOut, int nSamples, UINT uChannelMask);
+};
@@ -0,0 +1,326 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2022 quero.
+//------------------------------------------------------------------------
+
+#include "PresetBank.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Steinberg;
+
+namespace Quero {
+
+//	page size for pre-faulting; 4K is the smallest we run on
+#define PRESET_BANK_PAGE_SIZE 4096
+
+PresetBank::PresetBank(void) {
+	m_pMapping = 0;
+	m_uMappingSize = 0;
+#if defined _WIN32
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_hMapping = 0;
+#endif
+	m_pHeader = 0;
+	m_pFieldIDs = 0;
+	m_pHashTable = 0;
+	m_pRecords = 0;
+	m_uRecordStride = 0;
+}
+
+PresetBank::~PresetBank(void) {
+	close();
+}
+
+/*
+	PresetBank::open()
+	Maps the file read-only, validates it and touches every page.
+*/
+bool PresetBank::open(const char* pPath) {
+	close();
+
+#if defined _WIN32
+	m_hFile = CreateFileA(pPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_hFile == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_hFile, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(PresetBankHeader)) {
+		close();
+		return false;
+	}
+	m_uMappingSize = (uint64)fileSize.QuadPart;
+
+	m_hMapping = CreateFileMappingA(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!m_hMapping) {
+		close();
+		return false;
+	}
+
+	m_pMapping = MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_pMapping) {
+		close();
+		return false;
+	}
+#else
+	int nFile = ::open(pPath, O_RDONLY);
+	if (nFile < 0) {
+		return false;
+	}
+
+	struct stat fileInfo;
+	if (fstat(nFile, &fileInfo) != 0 || fileInfo.st_size < (off_t)sizeof(PresetBankHeader)) {
+		::close(nFile);
+		return false;
+	}
+	m_uMappingSize = (uint64)fileInfo.st_size;
+
+	void* pMapping = mmap(NULL, (size_t)m_uMappingSize, PROT_READ, MAP_PRIVATE, nFile, 0);
+
+	//	the mapping holds its own reference to the file
+	::close(nFile);
+
+	if (pMapping == MAP_FAILED) {
+		m_uMappingSize = 0;
+		return false;
+	}
+	m_pMapping = pMapping;
+#endif
+
+	if (!validate()) {
+		close();
+		return false;
+	}
+
+	//	fault the pages in now, not on the first program change
+	volatile unsigned char uTouch = 0;
+	const unsigned char* pBytes = (const unsigned char*)m_pMapping;
+	for (uint64 i = 0; i < m_uMappingSize; i += PRESET_BANK_PAGE_SIZE) {
+		uTouch += pBytes[i];
+	}
+
+	return true;
+}
+
+void PresetBank::close() {
+	m_pHeader = 0;
+	m_pFieldIDs = 0;
+	m_pHashTable = 0;
+	m_pRecords = 0;
+	m_uRecordStride = 0;
+
+#if defined _WIN32
+	if (m_pMapping) {
+		UnmapViewOfFile(m_pMapping);
+	}
+	if (m_hMapping) {
+		CloseHandle(m_hMapping);
+	}
+	if (m_hFile != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_hFile);
+	}
+	m_hMapping = 0;
+	m_hFile = INVALID_HANDLE_VALUE;
+#else
+	if (m_pMapping) {
+		munmap(m_pMapping, (size_t)m_uMappingSize);
+	}
+#endif
+
+	m_pMapping = 0;
+	m_uMappingSize = 0;
+}
+
+//	nothing in the file is trusted until it has been checked against the file size
+bool PresetBank::validate() {
+	const PresetBankHeader* pHeader = (const PresetBankHeader*)m_pMapping;
+
+	if (pHeader->uMagic != PRESET_BANK_MAGIC || pHeader->uVersion != PRESET_BANK_VERSION) {
+		return false;
+	}
+	if (pHeader->uProgramCount > PRESET_BANK_MAX_PROGRAMS || pHeader->uFieldCount > PRESET_BANK_MAX_FIELDS) {
+		return false;
+	}
+
+	uint32 uStride = sizeof(PresetBankRecord) + pHeader->uFieldCount * sizeof(double);
+	uint64 uSize = sizeof(PresetBankHeader)
+		+ getFieldTableSize(pHeader->uFieldCount)
+		+ (uint64)pHeader->uProgramCount * sizeof(PresetBankHashEntry)
+		+ (uint64)pHeader->uProgramCount * uStride;
+	if (uSize > m_uMappingSize) {
+		return false;
+	}
+
+	for (int i = 0; i < PRESET_BANK_MAX_PROGRAMS; i++) {
+		if (pHeader->nProgramIndex[i] >= (int32)pHeader->uProgramCount) {
+			return false;
+		}
+	}
+
+	const uint32* pFieldIDs = (const uint32*)(pHeader + 1);
+	const PresetBankHashEntry* pHashTable = (const PresetBankHashEntry*)((const unsigned char*)pFieldIDs + getFieldTableSize(pHeader->uFieldCount));
+	for (uint32 i = 0; i < pHeader->uProgramCount; i++) {
+		if (pHashTable[i].uRecord >= pHeader->uProgramCount) {
+			return false;
+		}
+	}
+
+	m_pHeader = pHeader;
+	m_pFieldIDs = pFieldIDs;
+	m_pHashTable = pHashTable;
+	m_pRecords = (const unsigned char*)(pHashTable + pHeader->uProgramCount);
+	m_uRecordStride = uStride;
+	return true;
+}
+
+uint32 PresetBank::hashName(const char* pName) {
+	uint32 uHash = 2166136261u;
+	while (*pName) {
+		uHash ^= (unsigned char)*pName++;
+		uHash *= 16777619u;
+	}
+	return uHash;
+}
+
+//	binary search of the sorted hash table, then confirm the name
+const PresetBankRecord* PresetBank::findProgram(const char* pName) {
+	if (!m_pHeader) {
+		return 0;
+	}
+
+	uint32 uHash = hashName(pName);
+	int32 nLow = 0;
+	int32 nHigh = (int32)m_pHeader->uProgramCount - 1;
+
+	while (nLow <= nHigh) {
+		int32 nMid = (nLow + nHigh) / 2;
+		if (m_pHashTable[nMid].uNameHash < uHash) {
+			nLow = nMid + 1;
+		}
+		else {
+			nHigh = nMid - 1;
+		}
+	}
+
+	//	nLow is the first entry with this hash; step over any collisions
+	for (; nLow < (int32)m_pHeader->uProgramCount && m_pHashTable[nLow].uNameHash == uHash; nLow++) {
+		const PresetBankRecord* pRecord = getRecord(m_pHashTable[nLow].uRecord);
+		if (strncmp(pRecord->szName, pName, PRESET_BANK_NAME_LENGTH) == 0) {
+			return pRecord;
+		}
+	}
+	return 0;
+}
+
+bool PresetBank::getDefaultPath(char* pPath, int nMaxLength) {
+	return getDataPath(pPath, nMaxLength, PRESET_BANK_FILE_NAME);
+}
+
+/*
+	PresetBank::getDataPath()
+	%APPDATA%\NanoSynth\<file> on Windows,
+	~/Library/Application Support/NanoSynth/<file> on macOS,
+	~/.NanoSynth/<file> elsewhere.
+*/
+bool PresetBank::getDataPath(char* pPath, int nMaxLength, const char* pFileName) {
+#if defined _WIN32
+	const char* pBase = getenv("APPDATA");
+	const char* pFormat = "%s\\NanoSynth\\%s";
+#elif defined __APPLE__
+	const char* pBase = getenv("HOME");
+	const char* pFormat = "%s/Library/Application Support/NanoSynth/%s";
+#else
+	const char* pBase = getenv("HOME");
+	const char* pFormat = "%s/.NanoSynth/%s";
+#endif
+	if (!pBase) {
+		return false;
+	}
+
+	int nLength = snprintf(pPath, nMaxLength, pFormat, pBase, pFileName);
+	return nLength > 0 && nLength < nMaxLength;
+}
+
+/*
+	PresetBank::writeBankFile()
+	Lays out a bank from a set of SynthStates; the columns are the
+	SynthState schema. Written in the host byte order, which is the
+	little endian order open() expects on all our targets.
+*/
+bool PresetBank::writeBankFile(const char* pPath, const SynthState* pPrograms, const char* const* ppNames,
+	const UINT* pProgramNumbers, int nCount) {
+	int nFieldCount = SynthState::getFieldCount();
+	if (nCount < 0 || nCount > PRESET_BANK_MAX_PROGRAMS || nFieldCount > PRESET_BANK_MAX_FIELDS) {
+		return false;
+	}
+
+	uint32 uStride = sizeof(PresetBankRecord) + nFieldCount * sizeof(double);
+	uint64 uSize = sizeof(PresetBankHeader) + getFieldTableSize(nFieldCount)
+		+ nCount * sizeof(PresetBankHashEntry) + (uint64)nCount * uStride;
+
+	//	doubles keep the buffer aligned for the values
+	double* pBuffer = new double[(size_t)(uSize / sizeof(double))];
+	memset(pBuffer, 0, (size_t)uSize);
+
+	PresetBankHeader* pHeader = (PresetBankHeader*)pBuffer;
+	uint32* pFieldIDs = (uint32*)(pHeader + 1);
+	PresetBankHashEntry* pHashTable = (PresetBankHashEntry*)((unsigned char*)pFieldIDs + getFieldTableSize(nFieldCount));
+	unsigned char* pRecords = (unsigned char*)(pHashTable + nCount);
+
+	pHeader->uMagic = PRESET_BANK_MAGIC;
+	pHeader->uVersion = PRESET_BANK_VERSION;
+	pHeader->uProgramCount = nCount;
+	pHeader->uFieldCount = nFieldCount;
+	for (int i = 0; i < nFieldCount; i++) {
+		pFieldIDs[i] = SynthState::getSchema()[i].uParamID;
+	}
+	for (int i = 0; i < PRESET_BANK_MAX_PROGRAMS; i++) {
+		pHeader->nProgramIndex[i] = -1;
+	}
+
+	for (int i = 0; i < nCount; i++) {
+		PresetBankRecord* pRecord = (PresetBankRecord*)(pRecords + (uint64)i * uStride);
+		strncpy(pRecord->szName, ppNames[i], PRESET_BANK_NAME_LENGTH - 1);
+		pRecord->uNameHash = hashName(pRecord->szName);
+
+		double* pValues = (double*)(pRecord + 1);
+		for (int j = 0; j < nFieldCount; j++) {
+			pValues[j] = pPrograms[i].getValue(pFieldIDs[j]);
+		}
+
+		if (pProgramNumbers[i] < PRESET_BANK_MAX_PROGRAMS) {
+			pHeader->nProgramIndex[pProgramNumbers[i]] = i;
+		}
+
+		//	insertion sort by hash; 128 entries at most
+		int j = i;
+		while (j > 0 && pHashTable[j - 1].uNameHash > pRecord->uNameHash) {
+			pHashTable[j] = pHashTable[j - 1];
+			j--;
+		}
+		pHashTable[j].uNameHash = pRecord->uNameHash;
+		pHashTable[j].uRecord = i;
+	}
+
+	bool bSuccess = false;
+	FILE* pFile = fopen(pPath, "wb");
+	if (pFile) {
+		bSuccess = fwrite(pBuffer, 1, (size_t)uSize, pFile) == (size_t)uSize;
+		bSuccess = fclose(pFile) == 0 && bSuccess;
+	}
+
+	delete[] pBuffer;
+	return bSuccess;
+}
+
+} // namespace Quero
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2022 quero.
+//------------------------------------------------------------------------
+#pragma once
+
+#include "pluginterfaces/base/ftypes.h"
+#include "SynthState.h"
+
+namespace Quero {
+
+//	bank file: 'NSPB', little endian, read in place from the mapped file
+//	1: a fixed 32 entry field ID table (too small for the schema)
+//	2: a field ID table of uFieldCount entries after the header
+#define PRESET_BANK_MAGIC 0x4250534E
+#define PRESET_BANK_VERSION 2
+#define PRESET_BANK_FILE_NAME "NanoSynth.nspb"
+
+#define PRESET_BANK_MAX_PROGRAMS 128	//	MIDI program numbers
+#define PRESET_BANK_MAX_FIELDS 4096		//	sanity limit on a file's columns
+#define PRESET_BANK_NAME_LENGTH 32		//	including the terminator
+
+/*
+	File layout
+	PresetBankHeader
+	uint32 uFieldIDs[uFieldCount], param ID of each value column,
+		zero padded to an even count
+	PresetBankHashEntry[uProgramCount], sorted by name hash
+	PresetBankRecord[uProgramCount], each followed by uFieldCount doubles
+
+	Every section is a multiple of 8 bytes so the doubles stay aligned.
+*/
+struct PresetBankHeader {
+	Steinberg::uint32 uMagic;
+	Steinberg::uint32 uVersion;
+	Steinberg::uint32 uProgramCount;
+	Steinberg::uint32 uFieldCount;
+
+	//	program number -> record, -1 = empty slot
+	Steinberg::int32 nProgramIndex[PRESET_BANK_MAX_PROGRAMS];
+};
+
+struct PresetBankHashEntry {
+	Steinberg::uint32 uNameHash;
+	Steinberg::uint32 uRecord;
+};
+
+struct PresetBankRecord {
+	char szName[PRESET_BANK_NAME_LENGTH];
+	Steinberg::uint32 uNameHash;
+	Steinberg::uint32 uReserved;
+	//	followed by double dValues[uFieldCount], already cooked
+};
+
+/*
+	PresetBank
+	A read-only, memory-mapped bank of up to 128 programs.
+
+	The values are stored cooked (the same values cookVSTGUIVariable()
+	would produce), so a program change only needs two lookups and a
+	copy; no parsing or allocation, safe for the audio thread. The pages
+	are touched in open() so the first program change does not fault.
+
+	open() and close() must NOT be called while process() may run.
+*/
+class PresetBank {
+public:
+	PresetBank(void);
+	~PresetBank(void);
+
+	//	map a bank file; false if missing or corrupt
+	bool open(const char* pPath);
+	void close();
+
+	//	the per-user bank location
+	static bool getDefaultPath(char* pPath, int nMaxLength);
+
+	//	a file in the per-user NanoSynth folder (bank, tunings)
+	static bool getDataPath(char* pPath, int nMaxLength, const char* pFileName);
+
+	bool isOpen() { return m_pHeader != 0; }
+
+	//	columns
+	int getFieldCount() { return m_pHeader ? (int)m_pHeader->uFieldCount : 0; }
+	Steinberg::uint32 getFieldID(int nField) { return m_pFieldIDs[nField]; }
+
+	//	cooked values for a MIDI program number, or NULL for an empty slot
+	inline const double* getProgramValues(UINT uProgram) {
+		const PresetBankRecord* pRecord = getProgramRecord(uProgram);
+		return pRecord ? (const double*)(pRecord + 1) : 0;
+	}
+
+	inline const PresetBankRecord* getProgramRecord(UINT uProgram) {
+		if (!m_pHeader || uProgram >= PRESET_BANK_MAX_PROGRAMS || m_pHeader->nProgramIndex[uProgram] < 0) {
+			return 0;
+		}
+		return getRecord(m_pHeader->nProgramIndex[uProgram]);
+	}
+
+	//	lookup by name; NULL if not found
+	const PresetBankRecord* findProgram(const char* pName);
+
+	//	FNV-1a, the hash stored in the file
+	static Steinberg::uint32 hashName(const char* pName);
+
+	//	build a bank file from SynthStates (not realtime)
+	//	pProgramNumbers - MIDI program number for each entry
+	static bool writeBankFile(const char* pPath, const SynthState* pPrograms, const char* const* ppNames,
+		const UINT* pProgramNumbers, int nCount);
+
+protected:
+	//	the mapping
+	void* m_pMapping;
+	Steinberg::uint64 m_uMappingSize;
+#if defined _WIN32
+	void* m_hFile;
+	void* m_hMapping;
+#endif
+
+	//	views into the mapping
+	const PresetBankHeader* m_pHeader;
+	const Steinberg::uint32* m_pFieldIDs;
+	const PresetBankHashEntry* m_pHashTable;
+	const unsigned char* m_pRecords;
+	Steinberg::uint32 m_uRecordStride;
+
+	inline const PresetBankRecord* getRecord(Steinberg::int32 nRecord) {
+		return (const PresetBankRecord*)(m_pRecords + (Steinberg::uint64)nRecord * m_uRecordStride);
+	}
+
+	//	check the header and tables against the file size
+	bool validate();
+
+	//	bytes of the field ID table, padded to keep the next section aligned
+	static Steinberg::uint32 getFieldTableSize(Steinberg::uint32 uFieldCount) {
+		return ((uFieldCount + 1) & ~1u) * sizeof(Steinberg::uint32);
+	}
+};
+
+} // namespace Quero
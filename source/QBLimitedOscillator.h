@@ -1,5 +1,5 @@
 #pragma once
-#include "oscillator.h"
+#include "Oscillator.h"
 
 class QBLimitedOscillator : public Oscillator {
 public:
@@ -183,7 +183,7 @@ public:
 
 			case NOISE: {
 				//	use helper function
-				dOut = doWhiteNoise();
+				dOut = doWhiteNoise(m_uNoiseRegister);
 
 				break;
 			}
@@ -0,0 +1,225 @@
+#include "RealtimeAllocGuard.h"
+
+#if REALTIME_ALLOC_CHECK
+
+#include <assert.h>
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+#if defined _WIN32
+#include <malloc.h>
+#endif
+#if defined _MSC_VER && defined _DEBUG
+#include <crtdbg.h>
+#define REALTIME_ALLOC_CRT_HOOK 1
+#else
+#define REALTIME_ALLOC_CRT_HOOK 0
+#endif
+
+//	guards open on this thread, and heap calls made under them
+static thread_local int s_nGuardDepth = 0;
+static thread_local unsigned int s_uHeapCalls = 0;
+
+//	RealtimeAllocSuspends open on this thread
+static thread_local int s_nSuspendDepth = 0;
+
+static std::atomic<unsigned int> s_uViolations(0);
+
+static inline void countHeapCall() {
+	if (s_nGuardDepth > 0 && s_nSuspendDepth == 0) {
+		s_uHeapCalls++;
+	}
+}
+
+#if REALTIME_ALLOC_CRT_HOOK
+//------------------------------------------------------------------------
+//	MSVC debug CRT: every heap call goes through the hook
+//------------------------------------------------------------------------
+static _CRT_ALLOC_HOOK s_pPreviousHook = 0;
+
+static int __cdecl realtimeAllocHook(int nAllocType, void* pData, size_t uSize, int nBlockUse,
+	long lRequest, const unsigned char* pFileName, int nLine) {
+	//	the CRT's own bookkeeping is not ours
+	if (nBlockUse != _CRT_BLOCK) {
+		countHeapCall();
+	}
+	return s_pPreviousHook ? s_pPreviousHook(nAllocType, pData, uSize, nBlockUse, lRequest, pFileName, nLine) : TRUE;
+}
+
+//	installed when the module loads
+static struct RealtimeAllocHookInstaller {
+	RealtimeAllocHookInstaller() {
+		s_pPreviousHook = _CrtSetAllocHook(realtimeAllocHook);
+	}
+} s_HookInstaller;
+
+#else
+//------------------------------------------------------------------------
+//	elsewhere: the global operator new/delete. Every replaceable form is
+//	defined here rather than left to the library, whose defaults do not
+//	all come through the plain ones (the aligned forms, for one)
+//------------------------------------------------------------------------
+static inline void* allocate(std::size_t uSize) {
+	countHeapCall();
+	return malloc(uSize ? uSize : 1);
+}
+
+static inline void release(void* p) {
+	if (p) {
+		countHeapCall();
+		free(p);
+	}
+}
+
+static inline void* allocateAligned(std::size_t uSize, std::align_val_t alignment) {
+	countHeapCall();
+	std::size_t uAlignment = (std::size_t)alignment;
+	if (uAlignment < sizeof(void*)) {
+		uAlignment = sizeof(void*);
+	}
+#if defined _WIN32
+	return _aligned_malloc(uSize ? uSize : 1, uAlignment);
+#else
+	void* p = 0;
+	return posix_memalign(&p, uAlignment, uSize ? uSize : 1) == 0 ? p : 0;
+#endif
+}
+
+static inline void releaseAligned(void* p) {
+	if (p) {
+		countHeapCall();
+#if defined _WIN32
+		_aligned_free(p);
+#else
+		free(p);
+#endif
+	}
+}
+
+void* operator new(std::size_t uSize) {
+	void* p = allocate(uSize);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](std::size_t uSize) {
+	return operator new(uSize);
+}
+
+void* operator new(std::size_t uSize, const std::nothrow_t&) noexcept {
+	return allocate(uSize);
+}
+
+void* operator new[](std::size_t uSize, const std::nothrow_t&) noexcept {
+	return allocate(uSize);
+}
+
+void* operator new(std::size_t uSize, std::align_val_t alignment) {
+	void* p = allocateAligned(uSize, alignment);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](std::size_t uSize, std::align_val_t alignment) {
+	return operator new(uSize, alignment);
+}
+
+void* operator new(std::size_t uSize, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return allocateAligned(uSize, alignment);
+}
+
+void* operator new[](std::size_t uSize, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return allocateAligned(uSize, alignment);
+}
+
+void operator delete(void* p) noexcept {
+	release(p);
+}
+
+void operator delete[](void* p) noexcept {
+	release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+	release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+	release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+	release(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+	releaseAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+	releaseAligned(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+	releaseAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+	releaseAligned(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+	releaseAligned(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+	releaseAligned(p);
+}
+#endif // REALTIME_ALLOC_CRT_HOOK
+
+//------------------------------------------------------------------------
+//	RealtimeAllocGuard
+//------------------------------------------------------------------------
+RealtimeAllocGuard::RealtimeAllocGuard(void) {
+	if (s_nGuardDepth++ == 0) {
+		s_uHeapCalls = 0;
+	}
+}
+
+RealtimeAllocGuard::~RealtimeAllocGuard(void) {
+	if (--s_nGuardDepth > 0) {
+		return;
+	}
+
+	unsigned int uHeapCalls = s_uHeapCalls;
+	s_uHeapCalls = 0;
+	if (uHeapCalls) {
+		s_uViolations.fetch_add(uHeapCalls, std::memory_order_relaxed);
+	}
+	assert(uHeapCalls == 0 && "heap allocation on the audio thread");
+}
+
+unsigned int RealtimeAllocGuard::getViolations() {
+	return s_uViolations.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------
+//	RealtimeAllocSuspend
+//------------------------------------------------------------------------
+RealtimeAllocSuspend::RealtimeAllocSuspend(void) {
+	s_nSuspendDepth++;
+}
+
+RealtimeAllocSuspend::~RealtimeAllocSuspend(void) {
+	s_nSuspendDepth--;
+}
+
+#endif // REALTIME_ALLOC_CHECK
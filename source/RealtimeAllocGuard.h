@@ -0,0 +1,77 @@
+#pragma once
+
+//	compiled into debug builds; define NANOSYNTH_ALLOC_CHECK to get it in a QA release build
+#if defined _DEBUG || defined NANOSYNTH_ALLOC_CHECK
+#define REALTIME_ALLOC_CHECK 1
+#else
+#define REALTIME_ALLOC_CHECK 0
+#endif
+
+/*
+	RealtimeAllocGuard
+	Marks the calling thread as the audio thread for the life of the
+	object and checks that nothing on it touched the heap meanwhile. One
+	at the top of process() covers everything below it; nested guards
+	are fine.
+
+	With the MSVC debug CRT an allocation hook sees every heap call
+	(malloc, realloc, free, new, delete). Elsewhere every form of the
+	global operator new and delete is replaced (plain, array, nothrow,
+	sized, aligned), so plain malloc/free go unseen.
+
+	Calls into the host (parameter and event queues) are the host's
+	business, and a host may allocate in them; make them through
+	REALTIME_HOST_CALL() so they are not counted.
+
+	The hook only counts, since it must not call back into the CRT. The
+	guard asserts when it goes out of scope, and adds to
+	getViolations() for builds without asserts.
+
+	Nothing but an empty object in release builds.
+*/
+class RealtimeAllocGuard {
+public:
+#if REALTIME_ALLOC_CHECK
+	RealtimeAllocGuard(void);
+	~RealtimeAllocGuard(void);
+
+	//	heap calls made under a guard since the module loaded, all threads
+	static unsigned int getViolations();
+#else
+	RealtimeAllocGuard(void) {}
+	~RealtimeAllocGuard(void) {}
+
+	static unsigned int getViolations() { return 0; }
+#endif
+
+	RealtimeAllocGuard(const RealtimeAllocGuard&) = delete;
+	RealtimeAllocGuard& operator=(const RealtimeAllocGuard&) = delete;
+};
+
+/*
+	RealtimeAllocSuspend
+	Heap calls on this thread are not counted for the life of the
+	object; for calls out of the engine, into code it does not own.
+	Nests, with guards and with itself.
+*/
+class RealtimeAllocSuspend {
+public:
+#if REALTIME_ALLOC_CHECK
+	RealtimeAllocSuspend(void);
+	~RealtimeAllocSuspend(void);
+#else
+	RealtimeAllocSuspend(void) {}
+	~RealtimeAllocSuspend(void) {}
+#endif
+
+	RealtimeAllocSuspend(const RealtimeAllocSuspend&) = delete;
+	RealtimeAllocSuspend& operator=(const RealtimeAllocSuspend&) = delete;
+};
+
+//	one call into the host, with the guard suspended until the end of
+//	the statement; the call's own value is the result
+#if REALTIME_ALLOC_CHECK
+#define REALTIME_HOST_CALL(call) (RealtimeAllocSuspend(), (call))
+#else
+#define REALTIME_HOST_CALL(call) (call)
+#endif
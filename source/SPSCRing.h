@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <string.h>
+
+/*
+	SPSCRing
+	Wait-free single producer/single consumer ring buffer.
+
+	One thread may write() and one (other) thread may read(); neither
+	ever blocks or allocates. The producer never overwrites unread data,
+	it writes what fits and reports the count, so a stalled consumer
+	only costs dropped samples.
+
+	T - the element type (must be trivially copyable)
+	N - the capacity; MUST be a power of 2
+*/
+template <typename T, unsigned int N>
+class SPSCRing {
+public:
+	SPSCRing(void) {
+		m_uWriteIndex.store(0);
+		m_uReadIndex.store(0);
+	}
+	~SPSCRing(void) {}
+
+	//	only when neither side is running
+	void reset() {
+		m_uWriteIndex.store(0);
+		m_uReadIndex.store(0);
+	}
+
+	//	elements the consumer can read
+	inline unsigned int getReadSpace() {
+		return m_uWriteIndex.load(std::memory_order_acquire) - m_uReadIndex.load(std::memory_order_relaxed);
+	}
+
+	//	elements the producer can write
+	inline unsigned int getWriteSpace() {
+		return N - (m_uWriteIndex.load(std::memory_order_relaxed) - m_uReadIndex.load(std::memory_order_acquire));
+	}
+
+	/*
+		write() - producer only
+		returns the number of elements written
+	*/
+	unsigned int write(const T* pData, unsigned int uCount) {
+		unsigned int uWrite = m_uWriteIndex.load(std::memory_order_relaxed);
+		unsigned int uSpace = N - (uWrite - m_uReadIndex.load(std::memory_order_acquire));
+		if (uCount > uSpace) {
+			uCount = uSpace;
+		}
+
+		//	at most two copies around the wrap
+		unsigned int uStart = uWrite & (N - 1);
+		unsigned int uFirst = N - uStart < uCount ? N - uStart : uCount;
+		memcpy(m_Buffer + uStart, pData, uFirst * sizeof(T));
+		memcpy(m_Buffer, pData + uFirst, (uCount - uFirst) * sizeof(T));
+
+		m_uWriteIndex.store(uWrite + uCount, std::memory_order_release);
+		return uCount;
+	}
+
+	/*
+		read() - consumer only
+		returns the number of elements read
+	*/
+	unsigned int read(T* pData, unsigned int uCount) {
+		unsigned int uRead = m_uReadIndex.load(std::memory_order_relaxed);
+		unsigned int uAvailable = m_uWriteIndex.load(std::memory_order_acquire) - uRead;
+		if (uCount > uAvailable) {
+			uCount = uAvailable;
+		}
+
+		unsigned int uStart = uRead & (N - 1);
+		unsigned int uFirst = N - uStart < uCount ? N - uStart : uCount;
+		memcpy(pData, m_Buffer + uStart, uFirst * sizeof(T));
+		memcpy(pData + uFirst, m_Buffer, (uCount - uFirst) * sizeof(T));
+
+		m_uReadIndex.store(uRead + uCount, std::memory_order_release);
+		return uCount;
+	}
+
+	//	consumer only; drop the oldest elements
+	void skip(unsigned int uCount) {
+		unsigned int uRead = m_uReadIndex.load(std::memory_order_relaxed);
+		unsigned int uAvailable = m_uWriteIndex.load(std::memory_order_acquire) - uRead;
+		if (uCount > uAvailable) {
+			uCount = uAvailable;
+		}
+		m_uReadIndex.store(uRead + uCount, std::memory_order_release);
+	}
+
+protected:
+	static_assert((N & (N - 1)) == 0, "SPSCRing capacity must be a power of 2");
+
+	T m_Buffer[N];
+
+	//	free running; the difference is the fill level
+	//	(kept on separate cache lines so the two threads do not fight over them)
+	alignas(64) std::atomic<unsigned int> m_uWriteIndex;
+	alignas(64) std::atomic<unsigned int> m_uReadIndex;
+};
@@ -0,0 +1,119 @@
+#include "SampleOscillator.h"
+#include <string.h>
+
+SampleOscillator::SampleOscillator(void) {
+	m_uLoopMode = SAMPLE_LOOP;
+	m_pSample = 0;
+	m_dFramesPerCycle = 0.0;
+	m_dReadInc = 0.0;
+	m_uBufferFrames = 0;
+	m_uSkipFrames = 0;
+	m_dReadIndex = 0.0;
+	m_uEndPadFrames = 0;
+}
+
+SampleOscillator::~SampleOscillator(void) {
+}
+
+/*
+	SampleOscillator::setSample()
+	The root note's period in file frames sets the pitch scale; the
+	sample rate of the file is folded in here. No allocation, so a
+	keymap can switch samples per note on the audio thread.
+*/
+void SampleOscillator::setSample(StreamedSample* pSample, double dRootNote) {
+	m_pSample = pSample;
+	m_dFramesPerCycle = 0.0;
+	if (pSample && pSample->isOpen()) {
+		if (dRootNote < 0.0) {
+			dRootNote = pSample->m_dRootNote;
+		}
+		double dRootFo = 440.0 * pitchShiftMultiplier(dRootNote - 69.0);
+		m_dFramesPerCycle = (double)pSample->m_uSampleRate / dRootFo;
+	}
+}
+
+void SampleOscillator::noteOff() {
+	m_Stream.release();
+}
+
+void SampleOscillator::reset() {
+	Oscillator::reset();
+
+	//	the history of the first frame is silence
+	memset(m_fBuffer, 0, SINC_RESAMPLER_HISTORY * sizeof(float));
+	m_uBufferFrames = SINC_RESAMPLER_HISTORY;
+	m_uSkipFrames = 0;
+	m_dReadIndex = SINC_RESAMPLER_HISTORY;
+	m_uEndPadFrames = 0;
+}
+
+//	restarts the stream from the top of the sample
+void SampleOscillator::startOscillator() {
+	reset();
+	if (!m_pSample || !m_pSample->isOpen()) {
+		m_Stream.stop();
+		m_bNoteOn = false;
+		return;
+	}
+
+	m_Stream.start(m_pSample, m_uLoopMode);
+	m_bNoteOn = true;
+}
+
+void SampleOscillator::stopOscillator() {
+	m_Stream.stop();
+	m_bNoteOn = false;
+}
+
+/*
+	SampleOscillator::refill()
+	Drops the frames more than the resampler's history behind the read
+	position and tops the buffer up from the stream. At the end of the
+	sample silent frames are added for the resampler to look ahead into,
+	and once the position is past the last real frame the oscillator
+	stops.
+*/
+bool SampleOscillator::refill() {
+	UINT uIndex = (UINT)m_dReadIndex;
+	if (uIndex > SINC_RESAMPLER_HISTORY) {
+		UINT uDrop = uIndex - SINC_RESAMPLER_HISTORY;
+		m_dReadIndex -= (double)uDrop;
+
+		if (uDrop > m_uBufferFrames) {
+			m_uSkipFrames += uDrop - m_uBufferFrames;
+			uDrop = m_uBufferFrames;
+		}
+		m_uBufferFrames -= uDrop;
+		memmove(m_fBuffer, m_fBuffer + uDrop, m_uBufferFrames * sizeof(float));
+	}
+
+	//	the buffer is empty while there are frames to skip
+	while (m_uSkipFrames > 0) {
+		UINT uCount = m_uSkipFrames < SAMPLE_OSC_BUFFER_FRAMES ? m_uSkipFrames : SAMPLE_OSC_BUFFER_FRAMES;
+		uCount = m_Stream.read(m_fBuffer, uCount);
+		if (uCount == 0) {
+			break;
+		}
+		m_uSkipFrames -= uCount;
+	}
+
+	if (m_uSkipFrames == 0) {
+		m_uBufferFrames += m_Stream.read(m_fBuffer + m_uBufferFrames, SAMPLE_OSC_BUFFER_FRAMES - m_uBufferFrames);
+	}
+
+	uIndex = (UINT)m_dReadIndex;
+	if (m_Stream.isFinished()) {
+		while (m_uSkipFrames == 0 && m_uEndPadFrames < SINC_RESAMPLER_LOOKAHEAD && m_uBufferFrames < SAMPLE_OSC_BUFFER_FRAMES) {
+			m_fBuffer[m_uBufferFrames++] = 0.0f;
+			m_uEndPadFrames++;
+		}
+
+		if (m_uSkipFrames > 0 || (m_uEndPadFrames == SINC_RESAMPLER_LOOKAHEAD && uIndex + SINC_RESAMPLER_LOOKAHEAD >= m_uBufferFrames)) {
+			stopOscillator();
+			return false;
+		}
+	}
+
+	return uIndex + SINC_RESAMPLER_LOOKAHEAD < m_uBufferFrames;
+}
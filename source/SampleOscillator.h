@@ -0,0 +1,103 @@
+#pragma once
+#include "Oscillator.h"
+#include "SampleStream.h"
+#include "SincResampler.h"
+
+//	frames pulled from the stream at a time, with the resampler's
+//	history and lookahead around the read position
+#define SAMPLE_OSC_BUFFER_FRAMES 512
+
+/*
+	SampleOscillator
+	Plays a StreamedSample through the voice's SampleStream, so only the
+	head of the sample is ever in RAM. The pitch is the note against
+	the sample's root note, with the usual Oscillator pitch mods, and
+	the frames are interpolated by a SincResampler at the chosen quality.
+
+	The frames come from the stream in small runs into m_fBuffer; when
+	the stream has nothing (an underrun) the output is silent and the
+	position holds until it catches up.
+*/
+class SampleOscillator : public Oscillator {
+public:
+	SampleOscillator(void);
+	~SampleOscillator(void);
+
+	//	the Processor hands this to the SampleStreamer
+	SampleStream m_Stream;
+
+	//	SAMPLE_LOOP, SAMPLE_SUSTAIN or SAMPLE_ONESHOT; globalOscillatorParams::uLoopMode
+	UINT m_uLoopMode;
+
+	//	dRootNote < 0 takes the sample's own; set it just before the
+	//	startOscillator() that is to play it
+	void setSample(StreamedSample* pSample, double dRootNote = -1.0);
+
+	//	lets a SAMPLE_SUSTAIN loop play out
+	void noteOff();
+
+	//	a SAMPLE_QUALITY_ tier; any time, it takes effect on the next sample
+	void setQuality(UINT uQuality) { m_Resampler.setQuality(uQuality); }
+
+	//	virtual overrides
+	virtual void reset();
+	virtual void startOscillator();
+	virtual void stopOscillator();
+
+	inline virtual void update() {
+		Oscillator::update();
+
+		//	m_dInc is cycles per sample
+		m_dReadInc = m_dInc * m_dFramesPerCycle;
+		m_Resampler.setReadIncrement(m_dReadInc);
+	}
+
+	virtual inline double doOscillate(double* pAuxOutput = NULL) {
+		if (!m_bNoteOn) {
+			return 0.0;
+		}
+
+		UINT uIndex = (UINT)m_dReadIndex;
+		if (uIndex + SINC_RESAMPLER_LOOKAHEAD >= m_uBufferFrames) {
+			if (!refill()) {
+				return 0.0;
+			}
+			uIndex = (UINT)m_dReadIndex;
+		}
+
+		double dFrac = m_dReadIndex - (double)uIndex;
+		double dOut = m_Resampler.interpolate(m_fBuffer + uIndex, dFrac);
+		m_dReadIndex += m_dReadInc;
+
+		if (pAuxOutput) {
+			*pAuxOutput = dOut * m_dAmplitude * m_dAmpMod;
+		}
+
+		return dOut * m_dAmplitude * m_dAmpMod;
+	}
+
+protected:
+	StreamedSample* m_pSample;
+
+	//	file frames per cycle of the root note
+	double m_dFramesPerCycle;
+	double m_dReadInc;
+
+	SincResampler m_Resampler;
+
+	//	m_fBuffer[0] is SINC_RESAMPLER_HISTORY frames before the one at
+	//	the integer part of m_dReadIndex, or m_uSkipFrames before that
+	//	when the pitch has run past the buffer; the start of the sample
+	//	has silence before it
+	float m_fBuffer[SAMPLE_OSC_BUFFER_FRAMES];
+	UINT m_uBufferFrames;
+	UINT m_uSkipFrames;
+	double m_dReadIndex;
+
+	//	silent frames after the last, to interpolate into; up to
+	//	SINC_RESAMPLER_LOOKAHEAD of them
+	UINT m_uEndPadFrames;
+
+	//	false on an underrun or at the end of the sample
+	bool refill();
+};
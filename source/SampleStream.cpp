@@ -0,0 +1,406 @@
+#include "SampleStream.h"
+#include <chrono>
+#include <string.h>
+
+StreamedSample::StreamedSample(void) {
+	m_uSampleRate = 0;
+	m_uFrameCount = 0;
+	m_uLoopStartFrame = 0;
+	m_uLoopEndFrame = 0;
+	m_uLoopType = 0;
+	m_dRootNote = 60.0;
+	m_pHead = 0;
+	m_uHeadFrames = 0;
+}
+
+StreamedSample::~StreamedSample(void) {
+	close();
+}
+
+/*
+	StreamedSample::open()
+	Maps the file and converts the head; the rest stays on disk. A loop
+	that is missing or out of range becomes the whole file.
+*/
+bool StreamedSample::open(const char* pPath) {
+	close();
+
+	if (!m_WaveFile.open(pPath)) {
+		return false;
+	}
+	if (m_WaveFile.getChannels() > SAMPLE_STREAM_MAX_CHANNELS || m_WaveFile.getFrameCount() == 0) {
+		m_WaveFile.close();
+		return false;
+	}
+
+	m_uSampleRate = m_WaveFile.getSampleRate();
+	m_uFrameCount = m_WaveFile.getFrameCount();
+
+	//	the smpl end is the last frame played
+	m_uLoopStartFrame = 0;
+	m_uLoopEndFrame = m_uFrameCount;
+	m_uLoopType = 0;
+	if (m_WaveFile.m_uLoopCount > 0 && m_WaveFile.m_uLoopStartFrame <= m_WaveFile.m_uLoopEndFrame &&
+		m_WaveFile.m_uLoopEndFrame < m_uFrameCount) {
+		m_uLoopStartFrame = m_WaveFile.m_uLoopStartFrame;
+		m_uLoopEndFrame = m_WaveFile.m_uLoopEndFrame + 1;
+		m_uLoopType = m_WaveFile.m_uLoopType;
+	}
+
+	//	the pitch fraction is in 1/2^32 semitones
+	m_dRootNote = 60.0;
+	if (m_WaveFile.m_bHasSampleChunk && m_WaveFile.m_uMIDINote < 128) {
+		m_dRootNote = (double)m_WaveFile.m_uMIDINote + (double)m_WaveFile.m_uMIDIPitchFraction / 4294967296.0;
+	}
+
+	m_uHeadFrames = m_uFrameCount < SAMPLE_STREAM_HEAD_FRAMES ? m_uFrameCount : SAMPLE_STREAM_HEAD_FRAMES;
+	m_pHead = new float[m_uHeadFrames];
+	m_uHeadFrames = readFrames(0, m_uHeadFrames, m_pHead);
+
+	return true;
+}
+
+void StreamedSample::close() {
+	if (m_pHead) {
+		delete[] m_pHead;
+	}
+	m_pHead = 0;
+	m_uHeadFrames = 0;
+	m_uSampleRate = 0;
+	m_uFrameCount = 0;
+	m_uLoopStartFrame = 0;
+	m_uLoopEndFrame = 0;
+	m_uLoopType = 0;
+	m_dRootNote = 60.0;
+
+	m_WaveFile.close();
+}
+
+/*
+	StreamedSample::getHeadEnd()
+	A loop that ends inside the head is streamed from its end on, so
+	the head and the stream stay one run of frames.
+*/
+UINT StreamedSample::getHeadEnd(UINT uLoopMode) {
+	UINT uEnd = uLoopMode == SAMPLE_ONESHOT ? m_uFrameCount : m_uLoopEndFrame;
+	return uEnd < m_uHeadFrames ? uEnd : m_uHeadFrames;
+}
+
+/*
+	StreamedSample::readFrames()
+	Converts a block at a time through the scratch buffer and averages
+	the channels; this is where the pages of the mapping come in.
+*/
+UINT StreamedSample::readFrames(UINT uStartFrame, UINT uFrames, float* pOutput) {
+	UINT uChannels = m_WaveFile.getChannels();
+	UINT uDone = 0;
+
+	while (uDone < uFrames) {
+		UINT uCount = uFrames - uDone < SAMPLE_STREAM_BLOCK_FRAMES ? uFrames - uDone : SAMPLE_STREAM_BLOCK_FRAMES;
+		uCount = m_WaveFile.readFrames(uStartFrame + uDone, uCount, uChannels == 1 ? pOutput + uDone : m_fScratch);
+		if (uCount == 0) {
+			break;
+		}
+
+		if (uChannels > 1) {
+			float fScale = 1.0f / (float)uChannels;
+			for (UINT i = 0; i < uCount; i++) {
+				const float* pFrame = &m_fScratch[i * uChannels];
+				float fSum = pFrame[0];
+				for (UINT j = 1; j < uChannels; j++) {
+					fSum += pFrame[j];
+				}
+				pOutput[uDone + i] = fSum * fScale;
+			}
+		}
+		uDone += uCount;
+	}
+
+	return uDone;
+}
+
+//------------------------------------------------------------------------
+//	SampleStream
+//------------------------------------------------------------------------
+SampleStream::SampleStream(void) {
+	m_pRequestSample.store(0);
+	m_uRequestLoopMode.store(SAMPLE_ONESHOT);
+	m_uRequestGeneration.store(0);
+	m_uReleaseGeneration.store(0);
+	m_uUnderruns.store(0);
+
+	m_pSample = 0;
+	m_uGeneration = 0;
+	m_uHeadFrame = 0;
+	m_uHeadEnd = 0;
+	m_Block.uGeneration = 0;
+	m_Block.uFrames = 0;
+	m_Block.bEnd = false;
+	m_uBlockFrame = 0;
+	m_bInHead = false;
+	m_bFinished = true;
+	m_bUnderrun = false;
+
+	m_pStreamSample = 0;
+	m_uStreamLoopMode = SAMPLE_ONESHOT;
+	m_uStreamGeneration = 0;
+	m_uStreamFrame = 0;
+	m_bStreamEnd = true;
+}
+
+SampleStream::~SampleStream(void) {
+}
+
+/*
+	SampleStream::start()
+	Plays pSample from the top (NULL stops). The ring is emptied here;
+	a block the prefetch thread is writing for the last note may still
+	land, and read() skips it by its generation.
+*/
+void SampleStream::start(StreamedSample* pSample, UINT uLoopMode) {
+	//	0 is never a note, so a release before the first start matches nothing
+	m_uGeneration++;
+	if (m_uGeneration == 0) {
+		m_uGeneration = 1;
+	}
+
+	m_pSample = pSample;
+	m_uHeadFrame = 0;
+	m_uHeadEnd = pSample ? pSample->getHeadEnd(uLoopMode) : 0;
+	m_Block.uFrames = 0;
+	m_Block.bEnd = false;
+	m_uBlockFrame = 0;
+	m_bInHead = true;
+	m_bFinished = pSample == 0;
+	m_bUnderrun = false;
+
+	m_Ring.skip(m_Ring.getReadSpace());
+
+	m_pRequestSample.store(pSample, std::memory_order_relaxed);
+	m_uRequestLoopMode.store(uLoopMode, std::memory_order_relaxed);
+	m_uRequestGeneration.store(m_uGeneration, std::memory_order_release);
+}
+
+//	a SAMPLE_SUSTAIN loop plays out from the next time the prefetch
+//	thread gets to its end, which is up to a ring ahead of the output
+void SampleStream::release() {
+	m_uReleaseGeneration.store(m_uGeneration, std::memory_order_release);
+}
+
+void SampleStream::stop() {
+	start(0, SAMPLE_ONESHOT);
+}
+
+/*
+	SampleStream::read()
+	Up to uFrames from the head, then the ring; fewer at the end or
+	when the prefetch thread has fallen behind.
+*/
+UINT SampleStream::read(float* pOutput, UINT uFrames) {
+	if (m_bFinished || uFrames == 0) {
+		return 0;
+	}
+
+	UINT uRead = 0;
+
+	if (m_bInHead) {
+		UINT uCount = m_uHeadEnd - m_uHeadFrame;
+		if (uCount > uFrames) {
+			uCount = uFrames;
+		}
+		memcpy(pOutput, m_pSample->m_pHead + m_uHeadFrame, uCount * sizeof(float));
+		m_uHeadFrame += uCount;
+		uRead = uCount;
+
+		if (m_uHeadFrame >= m_uHeadEnd) {
+			m_bInHead = false;
+		}
+	}
+
+	while (uRead < uFrames) {
+		if (m_uBlockFrame >= m_Block.uFrames) {
+			if (m_Block.bEnd) {
+				m_bFinished = true;
+				break;
+			}
+
+			//	the next block of this note; anything older is dropped
+			bool bBlock = false;
+			while (m_Ring.read(&m_Block, 1) == 1) {
+				if (m_Block.uGeneration == m_uGeneration) {
+					bBlock = true;
+					break;
+				}
+			}
+			m_uBlockFrame = 0;
+			if (!bBlock) {
+				m_Block.uFrames = 0;
+				m_Block.bEnd = false;
+				break;
+			}
+			continue;
+		}
+
+		UINT uCount = m_Block.uFrames - m_uBlockFrame;
+		if (uCount > uFrames - uRead) {
+			uCount = uFrames - uRead;
+		}
+		memcpy(pOutput + uRead, &m_Block.fFrames[m_uBlockFrame], uCount * sizeof(float));
+		m_uBlockFrame += uCount;
+		uRead += uCount;
+	}
+
+	//	one count per gap
+	if (uRead == 0 && !m_bFinished) {
+		if (!m_bUnderrun) {
+			m_bUnderrun = true;
+			m_uUnderruns.fetch_add(1, std::memory_order_relaxed);
+		}
+	} else {
+		m_bUnderrun = false;
+	}
+
+	return uRead;
+}
+
+/*
+	SampleStream::service()
+	Picks up a new note, then writes blocks until the ring is full, the
+	sample has ended or another note has come in. The params of a
+	request may belong to a newer one than its generation; the blocks
+	are then tagged for a note that is already over and never played.
+*/
+bool SampleStream::service() {
+	UINT uGeneration = m_uRequestGeneration.load(std::memory_order_acquire);
+	if (uGeneration != m_uStreamGeneration) {
+		m_uStreamGeneration = uGeneration;
+		m_pStreamSample = m_pRequestSample.load(std::memory_order_relaxed);
+		m_uStreamLoopMode = m_uRequestLoopMode.load(std::memory_order_relaxed);
+		m_bStreamEnd = m_pStreamSample == 0;
+
+		//	one pass over the ring's worth of pages rather than a fault per page
+		if (m_pStreamSample) {
+			m_uStreamFrame = m_pStreamSample->getHeadEnd(m_uStreamLoopMode);
+			m_pStreamSample->prefetch(m_uStreamFrame, SAMPLE_STREAM_BLOCK_FRAMES * SAMPLE_STREAM_RING_BLOCKS);
+		}
+	}
+
+	bool bWrote = false;
+	while (!m_bStreamEnd && m_Ring.getWriteSpace() > 0) {
+		if (m_uRequestGeneration.load(std::memory_order_acquire) != m_uStreamGeneration) {
+			break;
+		}
+		fillBlock();
+		bWrote = true;
+	}
+
+	return bWrote;
+}
+
+/*
+	SampleStream::fillBlock()
+	One block from the stream position, wrapping at the loop end while
+	the loop mode (and, for SAMPLE_SUSTAIN, the note) says so.
+*/
+void SampleStream::fillBlock() {
+	StreamedSample* pSample = m_pStreamSample;
+	bool bLoop = m_uStreamLoopMode == SAMPLE_LOOP ||
+		(m_uStreamLoopMode == SAMPLE_SUSTAIN && m_uReleaseGeneration.load(std::memory_order_acquire) != m_uStreamGeneration);
+	UINT uEnd = bLoop ? pSample->m_uLoopEndFrame : pSample->m_uFrameCount;
+
+	UINT uFrames = 0;
+	while (uFrames < SAMPLE_STREAM_BLOCK_FRAMES) {
+		if (m_uStreamFrame >= uEnd) {
+			if (!bLoop) {
+				m_bStreamEnd = true;
+				break;
+			}
+			m_uStreamFrame = pSample->m_uLoopStartFrame;
+		}
+
+		UINT uCount = uEnd - m_uStreamFrame;
+		if (uCount > SAMPLE_STREAM_BLOCK_FRAMES - uFrames) {
+			uCount = SAMPLE_STREAM_BLOCK_FRAMES - uFrames;
+		}
+		UINT uRead = pSample->readFrames(m_uStreamFrame, uCount, &m_StreamBlock.fFrames[uFrames]);
+		uFrames += uRead;
+		m_uStreamFrame += uRead;
+
+		//	the data is shorter than the header said
+		if (uRead < uCount) {
+			m_bStreamEnd = true;
+			break;
+		}
+	}
+
+	m_StreamBlock.uGeneration = m_uStreamGeneration;
+	m_StreamBlock.uFrames = uFrames;
+	m_StreamBlock.bEnd = m_bStreamEnd;
+	m_Ring.write(&m_StreamBlock, 1);
+}
+
+//------------------------------------------------------------------------
+//	SampleStreamer
+//------------------------------------------------------------------------
+SampleStreamer::SampleStreamer(void) {
+	m_nStreamCount = 0;
+	m_bStop = false;
+}
+
+SampleStreamer::~SampleStreamer(void) {
+	stop();
+}
+
+/*
+	SampleStreamer::start()
+	Starts the prefetch thread on a fixed set of streams.
+*/
+bool SampleStreamer::start(SampleStream** ppStreams, int nCount) {
+	stop();
+
+	if (nCount < 0 || nCount > SAMPLE_STREAMER_MAX_STREAMS) {
+		return false;
+	}
+	for (int i = 0; i < nCount; i++) {
+		m_pStreams[i] = ppStreams[i];
+	}
+	m_nStreamCount = nCount;
+	m_bStop = false;
+
+	m_Thread = std::thread([this]() {
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		while (!m_bStop) {
+			bool bWrote = false;
+			for (int i = 0; i < m_nStreamCount; i++) {
+				bWrote |= m_pStreams[i]->service();
+			}
+
+			//	straight round again while there is work, so one voice's
+			//	new note does not wait behind the others' refills
+			if (!bWrote) {
+				m_Condition.wait_for(lock, std::chrono::milliseconds(SAMPLE_STREAM_POLL_MSEC), [this]() { return m_bStop; });
+			}
+		}
+	});
+
+	return true;
+}
+
+void SampleStreamer::stop() {
+	if (m_Thread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_bStop = true;
+		}
+		m_Condition.notify_all();
+		m_Thread.join();
+	}
+}
+
+UINT SampleStreamer::getUnderruns() {
+	UINT uUnderruns = 0;
+	for (int i = 0; i < m_nStreamCount; i++) {
+		uUnderruns += m_pStreams[i]->getUnderruns();
+	}
+	return uUnderruns;
+}
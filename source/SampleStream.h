@@ -0,0 +1,192 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "pluginconstants.h"
+#include "WaveFile.h"
+#include "SPSCRing.h"
+
+//	frames of every sample kept in RAM; the stream takes over after these
+#define SAMPLE_STREAM_HEAD_FRAMES 16384
+
+//	frames per ring block, and blocks per voice (must be a power of 2);
+//	8192 frames ahead is 170 mSec at 48kHz, two octaves up
+#define SAMPLE_STREAM_BLOCK_FRAMES 512
+#define SAMPLE_STREAM_RING_BLOCKS 16
+
+//	wider files are rejected
+#define SAMPLE_STREAM_MAX_CHANNELS 8
+
+//	how often the prefetch thread looks for free ring space
+#define SAMPLE_STREAM_POLL_MSEC 2
+
+#define SAMPLE_STREAMER_MAX_STREAMS 16
+
+//	the sample SAMPLE_MODE plays, next to the preset bank
+#define SAMPLE_STREAM_FILE_NAME "NanoSynth.wav"
+
+//	uLoopMode of the sample oscillator
+enum {
+	SAMPLE_LOOP,		//	loops until the voice stops
+	SAMPLE_SUSTAIN,		//	loops until the note-off, then plays out
+	SAMPLE_ONESHOT		//	plays through once, ignores the loop
+};
+
+/*
+	StreamedSample
+	A WAV file that is played from disk. Only the first
+	SAMPLE_STREAM_HEAD_FRAMES are converted and kept in RAM, so a note
+	can start at once; the rest is read from the mapping by the
+	SampleStreamer as voices get to it.
+
+	Mixed to mono on the way in (the voice lanes are mono), so the head
+	and the rings cost one float per frame whatever the file is.
+
+	The loop is the smpl chunk's first loop, as in CWaveData; without
+	one, loop modes loop the whole file. Frames, not interleaved
+	indexes, and the end is exclusive.
+
+	open()/close() are not realtime and may not be called while a
+	stream is playing the sample.
+*/
+class StreamedSample {
+public:
+	StreamedSample(void);
+	~StreamedSample(void);
+
+	bool open(const char* pPath);
+	void close();
+
+	bool isOpen() { return m_pHead != 0; }
+
+	UINT m_uSampleRate;
+	UINT m_uFrameCount;
+	UINT m_uLoopStartFrame;
+	UINT m_uLoopEndFrame;
+	UINT m_uLoopType;
+
+	//	the pitch it plays at on its root note: MIDI note + fraction
+	double m_dRootNote;
+
+	//	mono, m_uHeadFrames of them
+	float* m_pHead;
+	UINT m_uHeadFrames;
+
+	//	where a stream with uLoopMode takes over from the head
+	UINT getHeadEnd(UINT uLoopMode);
+
+	//	prefetch thread only; mono frames from the mapping, returns the count
+	UINT readFrames(UINT uStartFrame, UINT uFrames, float* pOutput);
+	void prefetch(UINT uStartFrame, UINT uFrames) { m_WaveFile.prefetch(uStartFrame, uFrames); }
+
+protected:
+	WaveFile m_WaveFile;
+
+	//	interleaved frames for the mono mix; there is one prefetch thread,
+	//	and open() never runs alongside it
+	float m_fScratch[SAMPLE_STREAM_BLOCK_FRAMES * SAMPLE_STREAM_MAX_CHANNELS];
+};
+
+//	one ring entry; tagged so blocks from an earlier note can be thrown away
+struct SampleStreamBlock {
+	UINT uGeneration;
+	UINT uFrames;
+	bool bEnd;			//	the last block of the sample
+	float fFrames[SAMPLE_STREAM_BLOCK_FRAMES];
+};
+
+/*
+	SampleStream
+	One voice's view of a StreamedSample: the head from RAM, then the
+	ring the prefetch thread fills from the file, as one run of frames
+	with the loop already unrolled.
+
+	The audio thread start()s, release()s and stop()s it and read()s
+	the frames; the prefetch thread service()s it. Each start() bumps
+	the generation, and blocks tagged with an older one are skipped, so
+	neither side ever has to wait for the other.
+
+	A read() that gets nothing before the end is an underrun; each one
+	is counted once, however long the gap lasts.
+*/
+class SampleStream {
+public:
+	SampleStream(void);
+	~SampleStream(void);
+
+	//	audio thread
+	void start(StreamedSample* pSample, UINT uLoopMode);
+	void release();
+	void stop();
+	UINT read(float* pOutput, UINT uFrames);
+
+	//	read() has handed out the last frame
+	inline bool isFinished() { return m_bFinished; }
+
+	//	any thread
+	UINT getUnderruns() { return m_uUnderruns.load(std::memory_order_relaxed); }
+
+	//	prefetch thread; fills what ring space there is, true if it wrote
+	bool service();
+
+protected:
+	SPSCRing<SampleStreamBlock, SAMPLE_STREAM_RING_BLOCKS> m_Ring;
+
+	//	the request; written by the audio thread before the generation
+	std::atomic<StreamedSample*> m_pRequestSample;
+	std::atomic<UINT> m_uRequestLoopMode;
+	std::atomic<UINT> m_uRequestGeneration;
+	std::atomic<UINT> m_uReleaseGeneration;
+	std::atomic<UINT> m_uUnderruns;
+
+	//	audio thread
+	StreamedSample* m_pSample;
+	UINT m_uGeneration;
+	UINT m_uHeadFrame;
+	UINT m_uHeadEnd;
+	SampleStreamBlock m_Block;
+	UINT m_uBlockFrame;
+	bool m_bInHead;
+	bool m_bFinished;
+	bool m_bUnderrun;
+
+	//	prefetch thread
+	StreamedSample* m_pStreamSample;
+	UINT m_uStreamLoopMode;
+	UINT m_uStreamGeneration;
+	UINT m_uStreamFrame;
+	bool m_bStreamEnd;
+	SampleStreamBlock m_StreamBlock;
+
+	void fillBlock();
+};
+
+/*
+	SampleStreamer
+	The prefetch thread: keeps the rings of all voices topped up from
+	their files. It polls every SAMPLE_STREAM_POLL_MSEC rather than being
+	woken, so the audio thread makes no OS calls; the head preload covers
+	a note-on until the first blocks are in.
+*/
+class SampleStreamer {
+public:
+	SampleStreamer(void);
+	~SampleStreamer(void);
+
+	//	not from the audio thread
+	bool start(SampleStream** ppStreams, int nCount);
+	void stop();
+
+	//	all streams, any thread
+	UINT getUnderruns();
+
+protected:
+	SampleStream* m_pStreams[SAMPLE_STREAMER_MAX_STREAMS];
+	int m_nStreamCount;
+
+	std::thread m_Thread;
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	bool m_bStop;
+};
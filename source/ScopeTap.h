@@ -0,0 +1,88 @@
+#pragma once
+#include "SPSCRing.h"
+
+//	Processor <-> Controller messages for the scope
+#define SCOPE_REQUEST_MSG_ID "ScopeRequest"	//	Controller asks for new samples
+#define SCOPE_FRAME_MSG_ID "ScopeFrame"		//	Processor answers with them
+#define SCOPE_ATTR_SAMPLES "Samples"			//	binary, float[]
+#define SCOPE_ATTR_SAMPLE_RATE "SampleRate"		//	float, the decimated rate
+
+#define SCOPE_DECIMATION 2		//	22.05kHz at 44.1kHz is plenty for the display
+#define SCOPE_RING_SIZE 8192	//	~370mSec at 22.05kHz; must be a power of 2
+#define SCOPE_FRAME_SIZE 1024	//	most samples sent per request (and the FFT size)
+
+/*
+	ScopeTap
+	Feeds the scope from the audio thread: mixes the output to mono,
+	decimates by SCOPE_DECIMATION (box average) and pushes it into a
+	wait-free ring that the message thread drains.
+
+	processBlock() - audio thread only
+	readLatest() - message thread only
+*/
+class ScopeTap {
+public:
+	ScopeTap(void) {
+		m_fAccumulator = 0.0;
+		m_nDecimationCount = 0;
+		m_dSampleRate = 44100.0 / SCOPE_DECIMATION;
+	}
+	~ScopeTap(void) {}
+
+	//	not while processing
+	void setSampleRate(double dFs) {
+		m_dSampleRate = dFs / SCOPE_DECIMATION;
+		m_fAccumulator = 0.0;
+		m_nDecimationCount = 0;
+		m_Ring.reset();
+	}
+
+	//	the rate the samples come out at
+	double getSampleRate() { return m_dSampleRate; }
+
+	//	push one processing block
+	inline void processBlock(float** ppBuffers, int nChannels, int nSamples) {
+		float fBlock[64];
+		unsigned int uCount = 0;
+		float fScale = 1.0f / (float)(nChannels * SCOPE_DECIMATION);
+
+		for (int i = 0; i < nSamples; i++) {
+			for (int j = 0; j < nChannels; j++) {
+				m_fAccumulator += ppBuffers[j][i];
+			}
+
+			if (++m_nDecimationCount == SCOPE_DECIMATION) {
+				fBlock[uCount++] = m_fAccumulator * fScale;
+				m_fAccumulator = 0.0;
+				m_nDecimationCount = 0;
+
+				if (uCount == 64) {
+					m_Ring.write(fBlock, uCount);
+					uCount = 0;
+				}
+			}
+		}
+
+		//	a full ring just drops samples; nobody is looking
+		if (uCount > 0) {
+			m_Ring.write(fBlock, uCount);
+		}
+	}
+
+	//	read the newest samples, dropping anything older than
+	//	uMaxCount; returns the number read
+	unsigned int readLatest(float* pData, unsigned int uMaxCount) {
+		unsigned int uAvailable = m_Ring.getReadSpace();
+		if (uAvailable > uMaxCount) {
+			m_Ring.skip(uAvailable - uMaxCount);
+		}
+		return m_Ring.read(pData, uMaxCount);
+	}
+
+protected:
+	SPSCRing<float, SCOPE_RING_SIZE> m_Ring;
+
+	float m_fAccumulator;
+	int m_nDecimationCount;
+	double m_dSampleRate;
+};
@@ -0,0 +1,211 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2022 quero.
+//------------------------------------------------------------------------
+
+#include "ScopeView.h"
+#include <math.h>
+#include <string.h>
+
+using namespace VSTGUI;
+
+#define SCOPE_PI 3.14159265358979323846
+#define SCOPE_MIN_FREQ 20.0
+
+//	Window and twiddles are made here; the history starts silent
+ScopeAnalyzer::ScopeAnalyzer(void) {
+	m_dSampleRate = 44100.0 / SCOPE_DECIMATION;
+
+	for (int i = 0; i < SCOPE_FFT_SIZE; i++) {
+		m_fWindow[i] = (float)(0.5 - 0.5 * cos(2.0 * SCOPE_PI * i / (double)SCOPE_FFT_SIZE));
+		m_fHistory[i] = 0.0;
+	}
+	for (int i = 0; i < SCOPE_FFT_SIZE / 2; i++) {
+		m_fCos[i] = (float)cos(2.0 * SCOPE_PI * i / (double)SCOPE_FFT_SIZE);
+		m_fSin[i] = (float)-sin(2.0 * SCOPE_PI * i / (double)SCOPE_FFT_SIZE);
+	}
+	for (int i = 0; i < SCOPE_FFT_BINS; i++) {
+		m_fSpectrum_dB[i] = SCOPE_MIN_DB;
+	}
+}
+
+ScopeAnalyzer::~ScopeAnalyzer(void) {
+}
+
+void ScopeAnalyzer::pushSamples(const float* pSamples, unsigned int uCount, double dSampleRate) {
+	m_dSampleRate = dSampleRate;
+
+	//	keep the newest SCOPE_FFT_SIZE samples
+	if (uCount >= SCOPE_FFT_SIZE) {
+		memcpy(m_fHistory, pSamples + (uCount - SCOPE_FFT_SIZE), SCOPE_FFT_SIZE * sizeof(float));
+	}
+	else {
+		memmove(m_fHistory, m_fHistory + uCount, (SCOPE_FFT_SIZE - uCount) * sizeof(float));
+		memcpy(m_fHistory + (SCOPE_FFT_SIZE - uCount), pSamples, uCount * sizeof(float));
+	}
+
+	doSpectrum();
+}
+
+unsigned int ScopeAnalyzer::findTrigger() {
+	for (unsigned int i = 1; i < SCOPE_FFT_SIZE / 2; i++) {
+		if (m_fHistory[i - 1] < 0.0 && m_fHistory[i] >= 0.0) {
+			return i;
+		}
+	}
+	return 0;
+}
+
+void ScopeAnalyzer::doSpectrum() {
+	for (int i = 0; i < SCOPE_FFT_SIZE; i++) {
+		m_fReal[i] = m_fHistory[i] * m_fWindow[i];
+		m_fImag[i] = 0.0;
+	}
+
+	doFFT();
+
+	//	the Hann window halves the amplitude of a bin-centred sine
+	const float fScale = 4.0f / (float)SCOPE_FFT_SIZE;
+	for (int i = 0; i < SCOPE_FFT_BINS; i++) {
+		float fMag = fScale * sqrtf(m_fReal[i] * m_fReal[i] + m_fImag[i] * m_fImag[i]);
+		float fMag_dB = fMag > 0.0 ? 20.0f * log10f(fMag) : SCOPE_MIN_DB;
+		m_fSpectrum_dB[i] = fMag_dB < SCOPE_MIN_DB ? SCOPE_MIN_DB : fMag_dB;
+	}
+}
+
+//	iterative decimation in time
+void ScopeAnalyzer::doFFT() {
+	//	bit reverse
+	for (int i = 1, j = 0; i < SCOPE_FFT_SIZE; i++) {
+		int nBit = SCOPE_FFT_SIZE >> 1;
+		for (; j & nBit; nBit >>= 1) {
+			j ^= nBit;
+		}
+		j ^= nBit;
+
+		if (i < j) {
+			float fTemp = m_fReal[i]; m_fReal[i] = m_fReal[j]; m_fReal[j] = fTemp;
+			fTemp = m_fImag[i]; m_fImag[i] = m_fImag[j]; m_fImag[j] = fTemp;
+		}
+	}
+
+	//	butterflies
+	for (int nLength = 2; nLength <= SCOPE_FFT_SIZE; nLength <<= 1) {
+		int nHalf = nLength >> 1;
+		int nStride = SCOPE_FFT_SIZE / nLength;
+
+		for (int i = 0; i < SCOPE_FFT_SIZE; i += nLength) {
+			for (int j = 0; j < nHalf; j++) {
+				float fWr = m_fCos[j * nStride];
+				float fWi = m_fSin[j * nStride];
+				int a = i + j;
+				int b = a + nHalf;
+
+				float fTr = m_fReal[b] * fWr - m_fImag[b] * fWi;
+				float fTi = m_fReal[b] * fWi + m_fImag[b] * fWr;
+
+				m_fReal[b] = m_fReal[a] - fTr;
+				m_fImag[b] = m_fImag[a] - fTi;
+				m_fReal[a] += fTr;
+				m_fImag[a] += fTi;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+//	ScopeView
+//------------------------------------------------------------------------
+ScopeView::ScopeView(const CRect& size, IScopeDataSource* pDataSource)
+	: CView(size) {
+	m_pDataSource = pDataSource;
+
+	//	poll while we are alive; the answer arrives before the next tick
+	m_pTimer = makeOwned<CVSTGUITimer>([this](CVSTGUITimer*) {
+		if (m_pDataSource) {
+			m_pDataSource->requestScopeFrame();
+		}
+		invalid();
+	}, SCOPE_REFRESH_MSEC, true);
+}
+
+ScopeView::~ScopeView(void) {
+	if (m_pTimer) {
+		m_pTimer->stop();
+	}
+}
+
+void ScopeView::draw(CDrawContext* pContext) {
+	const CRect& rect = getViewSize();
+
+	pContext->setDrawMode(kAntiAliasing);
+	pContext->setFillColor(CColor(0, 0, 0, 255));
+	pContext->drawRect(rect, kDrawFilled);
+
+	//	top half waveform, bottom half spectrum
+	double dMid = rect.top + rect.getHeight() / 2.0;
+	drawWaveform(pContext, CRect(rect.left, rect.top, rect.right, dMid));
+	drawSpectrum(pContext, CRect(rect.left, dMid, rect.right, rect.bottom));
+
+	setDirty(false);
+}
+
+void ScopeView::drawWaveform(CDrawContext* pContext, const CRect& rect) {
+	ScopeAnalyzer* pAnalyzer = m_pDataSource ? m_pDataSource->getScopeAnalyzer() : 0;
+	if (!pAnalyzer) {
+		return;
+	}
+
+	//	half the history from the trigger point
+	unsigned int uStart = pAnalyzer->findTrigger();
+	unsigned int uLength = SCOPE_FFT_SIZE / 2;
+	double dCenter = rect.top + rect.getHeight() / 2.0;
+	double dHalfHeight = rect.getHeight() / 2.0;
+	double dStep = rect.getWidth() / (double)(uLength - 1);
+
+	pContext->setFrameColor(CColor(255, 0, 0, 255));
+	pContext->setLineWidth(1);
+
+	CPoint last(rect.left, dCenter - dHalfHeight * pAnalyzer->m_fHistory[uStart]);
+	for (unsigned int i = 1; i < uLength; i++) {
+		float fSample = pAnalyzer->m_fHistory[uStart + i];
+		fSample = fSample > 1.0 ? 1.0 : (fSample < -1.0 ? -1.0 : fSample);
+
+		CPoint next(rect.left + i * dStep, dCenter - dHalfHeight * fSample);
+		pContext->drawLine(last, next);
+		last = next;
+	}
+}
+
+void ScopeView::drawSpectrum(CDrawContext* pContext, const CRect& rect) {
+	ScopeAnalyzer* pAnalyzer = m_pDataSource ? m_pDataSource->getScopeAnalyzer() : 0;
+	if (!pAnalyzer) {
+		return;
+	}
+
+	//	log frequency, SCOPE_MIN_FREQ to Nyquist
+	double dNyquist = pAnalyzer->m_dSampleRate / 2.0;
+	double dLogRange = log(dNyquist / SCOPE_MIN_FREQ);
+	double dBinWidth = pAnalyzer->m_dSampleRate / (double)SCOPE_FFT_SIZE;
+
+	pContext->setFrameColor(CColor(255, 255, 255, 255));
+	pContext->setLineWidth(1);
+
+	bool bFirst = true;
+	CPoint last;
+	for (int i = 1; i < SCOPE_FFT_BINS; i++) {
+		double dFreq = i * dBinWidth;
+		if (dFreq < SCOPE_MIN_FREQ) {
+			continue;
+		}
+
+		double dX = rect.left + rect.getWidth() * log(dFreq / SCOPE_MIN_FREQ) / dLogRange;
+		double dY = rect.top + rect.getHeight() * (pAnalyzer->m_fSpectrum_dB[i] / SCOPE_MIN_DB);
+		CPoint next(dX, dY);
+
+		if (!bFirst) {
+			pContext->drawLine(last, next);
+		}
+		last = next;
+		bFirst = false;
+	}
+}
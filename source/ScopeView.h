@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2022 quero.
+//------------------------------------------------------------------------
+#pragma once
+
+#include "vstgui/vstgui.h"
+#include "ScopeTap.h"
+
+#define SCOPE_FFT_SIZE SCOPE_FRAME_SIZE		//	power of 2
+#define SCOPE_FFT_BINS (SCOPE_FFT_SIZE / 2 + 1)
+#define SCOPE_MIN_DB -90.0
+#define SCOPE_REFRESH_MSEC 33				//	~30 frames/sec
+
+/*
+	ScopeAnalyzer
+	Holds the last SCOPE_FFT_SIZE samples from the Processor and their
+	magnitude spectrum. Runs on the UI thread only; all storage is fixed.
+*/
+class ScopeAnalyzer {
+public:
+	ScopeAnalyzer(void);
+	~ScopeAnalyzer(void);
+
+	//	add new samples and redo the FFT
+	void pushSamples(const float* pSamples, unsigned int uCount, double dSampleRate);
+
+	//	oldest first
+	float m_fHistory[SCOPE_FFT_SIZE];
+
+	//	magnitude in dB, DC to Nyquist
+	float m_fSpectrum_dB[SCOPE_FFT_BINS];
+
+	//	of the samples in m_fHistory
+	double m_dSampleRate;
+
+	//	first rising zero crossing in the first half of the history, for a stable trace
+	unsigned int findTrigger();
+
+protected:
+	//	Hann window and twiddles, made once
+	float m_fWindow[SCOPE_FFT_SIZE];
+	float m_fCos[SCOPE_FFT_SIZE / 2];
+	float m_fSin[SCOPE_FFT_SIZE / 2];
+
+	//	work buffers
+	float m_fReal[SCOPE_FFT_SIZE];
+	float m_fImag[SCOPE_FFT_SIZE];
+
+	//	in place radix-2 complex FFT of m_fReal/m_fImag
+	void doFFT();
+	void doSpectrum();
+};
+
+//	implemented by the Controller
+class IScopeDataSource {
+public:
+	virtual ~IScopeDataSource() {}
+
+	//	ask the Processor for new samples; the answer lands in the analyzer
+	virtual void requestScopeFrame() = 0;
+	virtual ScopeAnalyzer* getScopeAnalyzer() = 0;
+};
+
+/*
+	ScopeView
+	Custom view for the editor: waveform on top, spectrum below.
+	Polls the Controller for new samples every SCOPE_REFRESH_MSEC
+	while it is open.
+*/
+class ScopeView : public VSTGUI::CView {
+public:
+	ScopeView(const VSTGUI::CRect& size, IScopeDataSource* pDataSource);
+	~ScopeView(void);
+
+	void draw(VSTGUI::CDrawContext* pContext) override;
+
+protected:
+	IScopeDataSource* m_pDataSource;
+	VSTGUI::SharedPointer<VSTGUI::CVSTGUITimer> m_pTimer;
+
+	void drawWaveform(VSTGUI::CDrawContext* pContext, const VSTGUI::CRect& rect);
+	void drawSpectrum(VSTGUI::CDrawContext* pContext, const VSTGUI::CRect& rect);
+};
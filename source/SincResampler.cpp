@@ -0,0 +1,276 @@
+#include "SincResampler.h"
+#include "BatchMath.h"
+#include <math.h>
+
+//	the project builds with /fp:fast; the kernels must not be contracted
+//	or reassociated, or the paths stop matching
+#if defined _MSC_VER
+#pragma float_control(precise, on, push)
+#endif
+
+//------------------------------------------------------------------------
+//	scalar reference; 8 running sums, as the taps fall in the AVX2 lanes,
+//	folded 8 -> 4 -> 2 -> 1 the way the SIMD kernels fold them
+//------------------------------------------------------------------------
+static inline float foldLanesRef(const float* pLane) {
+	float fLane[4];
+	for (int j = 0; j < 4; j++) {
+		fLane[j] = pLane[j] + pLane[j + 4];
+	}
+	return (fLane[0] + fLane[2]) + (fLane[1] + fLane[3]);
+}
+
+static float dotPhasesScalar(const float* pX, const float* pRow, int nTaps, float fFrac) {
+	const float* pNext = pRow + nTaps;
+	float fSum0[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+	float fSum1[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+	for (int i = 0; i < nTaps; i++) {
+		fSum0[i & 7] = fSum0[i & 7] + pX[i] * pRow[i];
+		fSum1[i & 7] = fSum1[i & 7] + pX[i] * pNext[i];
+	}
+
+	float fDot0 = foldLanesRef(fSum0);
+	float fDot1 = foldLanesRef(fSum1);
+	return fDot0 + fFrac * (fDot1 - fDot0);
+}
+
+#if BATCH_MATH_X86
+BATCH_TARGET_SSE2 static inline float foldLanesSSE2(__m128 vLow, __m128 vHigh) {
+	__m128 v = _mm_add_ps(vLow, vHigh);
+	v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+	v = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(v);
+}
+
+//	the taps come in 4s; a 4 tap kernel leaves the high lanes at 0
+BATCH_TARGET_SSE2 static float dotPhasesSSE2(const float* pX, const float* pRow, int nTaps, float fFrac) {
+	const float* pNext = pRow + nTaps;
+	__m128 vSum0Low = _mm_setzero_ps();
+	__m128 vSum0High = _mm_setzero_ps();
+	__m128 vSum1Low = _mm_setzero_ps();
+	__m128 vSum1High = _mm_setzero_ps();
+
+	for (int i = 0; i < nTaps; i += 8) {
+		__m128 x = _mm_loadu_ps(pX + i);
+		vSum0Low = _mm_add_ps(vSum0Low, _mm_mul_ps(x, _mm_loadu_ps(pRow + i)));
+		vSum1Low = _mm_add_ps(vSum1Low, _mm_mul_ps(x, _mm_loadu_ps(pNext + i)));
+		if (i + 4 < nTaps) {
+			x = _mm_loadu_ps(pX + i + 4);
+			vSum0High = _mm_add_ps(vSum0High, _mm_mul_ps(x, _mm_loadu_ps(pRow + i + 4)));
+			vSum1High = _mm_add_ps(vSum1High, _mm_mul_ps(x, _mm_loadu_ps(pNext + i + 4)));
+		}
+	}
+
+	float fDot0 = foldLanesSSE2(vSum0Low, vSum0High);
+	float fDot1 = foldLanesSSE2(vSum1Low, vSum1High);
+	return fDot0 + fFrac * (fDot1 - fDot0);
+}
+
+BATCH_TARGET_AVX2 static float dotPhasesAVX2(const float* pX, const float* pRow, int nTaps, float fFrac) {
+	if (nTaps & 7) {
+		return dotPhasesSSE2(pX, pRow, nTaps, fFrac);
+	}
+
+	const float* pNext = pRow + nTaps;
+	__m256 vSum0 = _mm256_setzero_ps();
+	__m256 vSum1 = _mm256_setzero_ps();
+
+	for (int i = 0; i < nTaps; i += 8) {
+		__m256 x = _mm256_loadu_ps(pX + i);
+		vSum0 = _mm256_add_ps(vSum0, _mm256_mul_ps(x, _mm256_loadu_ps(pRow + i)));
+		vSum1 = _mm256_add_ps(vSum1, _mm256_mul_ps(x, _mm256_loadu_ps(pNext + i)));
+	}
+
+	float fDot0 = foldLanesSSE2(_mm256_castps256_ps128(vSum0), _mm256_extractf128_ps(vSum0, 1));
+	float fDot1 = foldLanesSSE2(_mm256_castps256_ps128(vSum1), _mm256_extractf128_ps(vSum1, 1));
+	return fDot0 + fFrac * (fDot1 - fDot0);
+}
+#endif // BATCH_MATH_X86
+
+#if defined _MSC_VER
+#pragma float_control(pop)
+#endif
+
+typedef float (*SincDotKernel)(const float*, const float*, int, float);
+
+static const SincDotKernel sincDotKernels[] = {
+	dotPhasesScalar,
+#if BATCH_MATH_X86
+	dotPhasesSSE2,
+	dotPhasesAVX2,
+#endif
+};
+
+//------------------------------------------------------------------------
+//	the banks
+//------------------------------------------------------------------------
+//	taps, bands and Kaiser beta per tier; LINEAR has no bank
+struct SincResamplerSpec {
+	int nTaps;
+	int nBands;
+	double dBeta;
+};
+
+static const SincResamplerSpec sincResamplerSpecs[SAMPLE_QUALITIES] = {
+	{ 0,	0,						0.0 },
+	{ 4,	1,						0.0 },
+	{ 16,	SINC_RESAMPLER_BANDS,	6.0 },
+	{ 64,	SINC_RESAMPLER_BANDS,	9.0 },
+};
+
+//	the largest read step each band but the last is for: 2^(b/2)
+static const double sincBandEdges[SINC_RESAMPLER_BANDS - 1] = { 1.0, 1.4142135623730951, 2.0, 2.8284271247461903 };
+
+//	zeroth order modified Bessel function, for the Kaiser window
+static double sincBessel0(double dX) {
+	double dSum = 1.0;
+	double dTerm = 1.0;
+	for (int k = 1; k < 64; k++) {
+		dTerm *= (dX / (2.0 * k)) * (dX / (2.0 * k));
+		dSum += dTerm;
+		if (dTerm < 1e-12 * dSum) {
+			break;
+		}
+	}
+	return dSum;
+}
+
+//	Catmull-Rom weights of the frames at -1, 0, 1, 2 for a point dFrac past 0
+static void designCubicRow(float* pRow, double dFrac) {
+	double f = dFrac;
+	double f2 = f * f;
+	double f3 = f2 * f;
+	pRow[0] = (float)(0.5 * (-f3 + 2.0 * f2 - f));
+	pRow[1] = (float)(0.5 * (3.0 * f3 - 5.0 * f2 + 2.0));
+	pRow[2] = (float)(0.5 * (-3.0 * f3 + 4.0 * f2 + f));
+	pRow[3] = (float)(0.5 * (f3 - f2));
+}
+
+/*
+	Kaiser windowed sinc cut off at dCutoff of Nyquist, for a point dFrac
+	past tap nTaps / 2 - 1; normalized so the DC gain is exactly 1. At
+	a cutoff of 1 and a whole frame it is a unit impulse
+*/
+static void designSincRow(float* pRow, int nTaps, double dCutoff, double dBeta, double dFrac) {
+	double dCoeff[SINC_RESAMPLER_MAX_TAPS];
+	double dSum = 0.0;
+	double dHalfLength = nTaps / 2;
+	for (int k = 0; k < nTaps; k++) {
+		double t = (double)(k - (nTaps / 2 - 1)) - dFrac;
+		double dRatio = t / dHalfLength;
+		double dWindow = dRatio * dRatio < 1.0 ? sincBessel0(dBeta * sqrt(1.0 - dRatio * dRatio)) / sincBessel0(dBeta) : 0.0;
+		double x = pi * dCutoff * t;
+		dCoeff[k] = (fabs(x) < 1e-12 ? dCutoff : dCutoff * sin(x) / x) * dWindow;
+		dSum += dCoeff[k];
+	}
+	for (int k = 0; k < nTaps; k++) {
+		pRow[k] = (float)(dCoeff[k] / dSum);
+	}
+}
+
+//	built once, on first use, and freed at unload
+struct SincResamplerBanks {
+	SincResamplerBank bank[SAMPLE_QUALITIES];
+
+	SincResamplerBanks() {
+		for (int q = 0; q < SAMPLE_QUALITIES; q++) {
+			const SincResamplerSpec& spec = sincResamplerSpecs[q];
+			SincResamplerBank& b = bank[q];
+			b.nTaps = spec.nTaps;
+			b.nBands = spec.nBands;
+			b.pCoeff = 0;
+			if (spec.nTaps == 0) {
+				continue;
+			}
+
+			int nRows = SINC_RESAMPLER_PHASES + 1;
+			b.pCoeff = new float[spec.nBands * nRows * spec.nTaps];
+			for (int nBand = 0; nBand < spec.nBands; nBand++) {
+				double dCutoff = pow(2.0, -0.5 * nBand);
+				for (int p = 0; p < nRows; p++) {
+					float* pRow = b.pCoeff + (nBand * nRows + p) * spec.nTaps;
+					double dFrac = (double)p / SINC_RESAMPLER_PHASES;
+					if (q == SAMPLE_QUALITY_4POINT) {
+						designCubicRow(pRow, dFrac);
+					} else {
+						designSincRow(pRow, spec.nTaps, dCutoff, spec.dBeta, dFrac);
+					}
+				}
+			}
+		}
+	}
+
+	~SincResamplerBanks() {
+		for (int q = 0; q < SAMPLE_QUALITIES; q++) {
+			if (bank[q].pCoeff) {
+				delete[] bank[q].pCoeff;
+			}
+		}
+	}
+};
+
+const SincResamplerBank& SincResampler::getBank(UINT uQuality) {
+	static SincResamplerBanks banks;
+	return banks.bank[uQuality < SAMPLE_QUALITIES ? uQuality : (UINT)SAMPLE_QUALITY_LINEAR];
+}
+
+//------------------------------------------------------------------------
+//	SincResampler
+//------------------------------------------------------------------------
+SincResampler::SincResampler(void) {
+	m_uQuality = SAMPLE_QUALITY_LINEAR;
+	m_nTaps = 2;
+	m_nBands = 1;
+	m_nBand = 0;
+	m_pBand = 0;
+
+	//	builds the banks
+	getBank(SAMPLE_QUALITY_LINEAR);
+}
+
+SincResampler::~SincResampler(void) {
+}
+
+void SincResampler::setQuality(UINT uQuality) {
+	if (uQuality >= SAMPLE_QUALITIES) {
+		uQuality = SAMPLE_QUALITY_LINEAR;
+	}
+	if (uQuality == m_uQuality) {
+		return;
+	}
+
+	m_uQuality = uQuality;
+	if (uQuality == SAMPLE_QUALITY_LINEAR) {
+		m_nTaps = 2;
+		m_nBands = 1;
+		m_nBand = 0;
+		m_pBand = 0;
+		return;
+	}
+
+	const SincResamplerBank& bank = getBank(uQuality);
+	m_nTaps = bank.nTaps;
+	m_nBands = bank.nBands;
+	m_nBand = m_nBand < m_nBands ? m_nBand : m_nBands - 1;
+	m_pBand = bank.pCoeff + m_nBand * (SINC_RESAMPLER_PHASES + 1) * m_nTaps;
+}
+
+void SincResampler::setReadIncrement(double dReadInc) {
+	int nBand = 0;
+	//	a hair over the edge, so a step of 1 off by rounding stays in band 0
+	while (nBand < m_nBands - 1 && dReadInc > sincBandEdges[nBand] + 1e-9) {
+		nBand++;
+	}
+	if (nBand == m_nBand || m_uQuality == SAMPLE_QUALITY_LINEAR) {
+		m_nBand = nBand;
+		return;
+	}
+
+	m_nBand = nBand;
+	m_pBand = getBank(m_uQuality).pCoeff + nBand * (SINC_RESAMPLER_PHASES + 1) * m_nTaps;
+}
+
+float SincResampler::dotPhases(const float* pX, const float* pRow, int nTaps, float fFrac) {
+	return sincDotKernels[getBatchMathISA()](pX, pRow, nTaps, fFrac);
+}
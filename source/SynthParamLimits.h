@@ -2,6 +2,10 @@
 #define __synthparamlimits__
 
 
+//	MPE lower zone member channels, 2 -> 16; each has its own pitch bend,
+//	timbre and pressure parameters
+#define MPE_MEMBER_CHANNELS 15
+
 //-----------------------------------------------------------------------------
 // NanoSynth Parameters
 //-----------------------------------------------------------------------------
@@ -21,6 +25,88 @@ enum {
 	MIDI_CHANNEL_PRESSURE,
 	MIDI_ALL_NOTES_OFF,
 
+	//	output meters; written by the Processor, read-only
+	METER_PEAK_LEFT,
+	METER_PEAK_RIGHT,
+	METER_RMS_LEFT,
+	METER_RMS_RIGHT,
+	METER_ACTIVE_VOICES,
+
+	//	DSP load; written by the Processor, read-only (debug and profiling builds)
+	PROFILER_LOAD,
+	PROFILER_PEAK_LOAD,
+	PROFILER_OVERRUNS,
+
+	//	filter 1, one per voice
+	FILTER1_FC,
+	FILTER1_Q,
+	FILTER1_TYPE,
+	FILTER1_KEYTRACK,
+	FILTER1_KEYTRACK_INTENSITY,
+	FILTER1_NLP,
+	FILTER1_SATURATION,
+
+	//	EG1, one per voice; drives the voice amplitude
+	EG1_ATTACK_TIME,
+	EG1_DECAY_TIME,
+	EG1_SUSTAIN_LEVEL,
+	EG1_RELEASE_TIME,
+	EG1_LEGATO_MODE,
+	EG1_RESET_TO_ZERO,
+
+	//	DCA, one per voice
+	DCA_AMPLITUDE_DB,
+	DCA_PAN,
+
+	//	oversampling of the filter 1 stage while its NLP is on
+	FILTER1_OVERSAMPLING,
+	OVERSAMPLING_QUALITY,
+	OVERSAMPLING_OFFLINE_QUALITY,
+
+	//	vector voice: four oscillators (A-D) mixed by a joystick path
+	VECTOR_MODE,
+	VECTOR_A_WAVEFORM,
+	VECTOR_B_WAVEFORM,
+	VECTOR_C_WAVEFORM,
+	VECTOR_D_WAVEFORM,
+	VECTOR_JOYSTICK_X,
+	VECTOR_JOYSTICK_Y,
+	VECTOR_ORBIT_X,
+	VECTOR_ORBIT_Y,
+	VECTOR_PATH_MODE,
+	VECTOR_PATH_TIME,
+
+	//	sample voice: one sample, streamed from disk
+	SAMPLE_MODE,
+	SAMPLE_LOOP_MODE,
+
+	//	sample stream underruns; written by the Processor, read-only
+	SAMPLE_STREAM_UNDERRUNS,
+
+	//	sample voice interpolation
+	SAMPLE_QUALITY,
+
+	//	MPE member channels drive their notes' pitch, pressure and timbre
+	MPE_MODE,
+
+	//	MPE member channel pitch bend, timbre (CC74) and channel pressure;
+	//	MPE_MEMBER_CHANNELS of each, from member channel 2. MIDI mapped,
+	//	not saved
+	MPE_PITCHBEND,
+	MPE_TIMBRE = MPE_PITCHBEND + MPE_MEMBER_CHANNELS,
+	MPE_PRESSURE = MPE_TIMBRE + MPE_MEMBER_CHANNELS,
+
+	//	unison: detuned copies of Osc1 in place of the Osc1/Osc2 pair
+	UNISON_VOICES = MPE_PRESSURE + MPE_MEMBER_CHANNELS,
+	UNISON_DETUNE,
+	UNISON_CURVE,
+	UNISON_SPREAD,
+	UNISON_PHASE,
+
+	//	MIDI program change, looked up in the PresetBank; appended so
+	//	the IDs above keep their values
+	MIDI_PROGRAM_CHANGE,
+
 	NUMBER_OF_SYNTH_PARAMETERS //	always last
 };
 
@@ -38,11 +124,42 @@ enum {
 #define MAX_LOOP_MODE 2
 #define DEFAULT_LOOP_MODE 0
 
+//	SincResampler tiers: LINEAR, 4 POINT, 16 POINT, 64 POINT
+#define MIN_SAMPLE_QUALITY 0
+#define MAX_SAMPLE_QUALITY 3
+#define DEFAULT_SAMPLE_QUALITY 2
+
+//	unison copies per voice; 1 is the plain Osc1/Osc2 pair
+#define MIN_UNISON_VOICES 1
+#define MAX_UNISON_VOICES 16
+#define DEFAULT_UNISON_VOICES 1
+
+//	cents, outermost copy
+#define MIN_UNISON_DETUNE_CENTS 0.0
+#define MAX_UNISON_DETUNE_CENTS 100.0
+#define DEFAULT_UNISON_DETUNE_CENTS 25.0
+
+//	start phases: RANDOM, LOCKED
+#define MIN_UNISON_PHASE 0
+#define MAX_UNISON_PHASE 1
+#define DEFAULT_UNISON_PHASE 0
+
 //	VS
 #define MIN_PATH_MODE 0
 #define MAX_PATH_MODE 3
 #define DEFAULT_PATH_MODE 0
 
+//	vector sources; saw, square, tri, sine around the joystick
+#define DEFAULT_VECTOR_A_WAVEFORM 1
+#define DEFAULT_VECTOR_B_WAVEFORM 5
+#define DEFAULT_VECTOR_C_WAVEFORM 4
+#define DEFAULT_VECTOR_D_WAVEFORM 0
+
+//	mSec per leg of the vector path
+#define MIN_VECTOR_PATH_TIME 10.0
+#define MAX_VECTOR_PATH_TIME 10000.0
+#define DEFAULT_VECTOR_PATH_TIME 1000.0
+
 #define MIN_OCTAVE -4
 #define MAX_OCTAVE +4
 #define DEFAULT_OCTAVE 0
@@ -87,6 +204,26 @@ enum {
 #define MAX_FILTER_Q 10.0
 #define DEFAULT_FILTER_Q 1.0
 
+//	SVF LP/HP/BP/BS, ladder 2/4 pole
+#define MIN_FILTER_TYPE 0
+#define MAX_FILTER_TYPE 5
+#define DEFAULT_FILTER_TYPE 0
+
+#define MIN_FILTER_SATURATION 1.0
+#define MAX_FILTER_SATURATION 10.0
+#define DEFAULT_FILTER_SATURATION 1.0
+
+//	off, 2x, 4x, 8x (the factor is 1 << value)
+#define MIN_FILTER_OVERSAMPLING 0
+#define MAX_FILTER_OVERSAMPLING 3
+#define DEFAULT_FILTER_OVERSAMPLING 1
+
+//	eco, normal, high; same order as the Oversampler tiers
+#define MIN_OVERSAMPLING_QUALITY 0
+#define MAX_OVERSAMPLING_QUALITY 2
+#define DEFAULT_OVERSAMPLING_QUALITY 1
+#define DEFAULT_OVERSAMPLING_OFFLINE_QUALITY 2
+
 //	sync, one shot, free
 #define MIN_LFO_MODE 0
 #define MAX_LFO_MODE 2
@@ -124,6 +261,9 @@ enum {
 #define MAX_EG_RELEASE_TIME 10000.0
 #define DEFAULT_EG_RELEASE_TIME 2000.0	
 
+//	fade out of a voice being retriggered with reset to zero
+#define DEFAULT_EG_SHUTDOWN_TIME 10.0
+
 #define MIN_OUTPUT_AMPLITUDE_DB -96.0
 #define MAX_OUTPUT_AMPLITUDE_DB 24.0
 #define DEFAULT_OUTPUT_AMPLITUDE_DB 0.0	
@@ -142,6 +282,39 @@ enum {
 #define MAX_FILTER_KEYTRACK_INTENSITY 2.0
 #define DEFAULT_FILTER_KEYTRACK_INTENSITY 0.5
 
+//	output meters (MIN_METER_DB matches METER_MIN_DB)
+#define MIN_METER_DB -60.0
+#define MAX_METER_DB 0.0
+#define MIN_ACTIVE_VOICES 0
+#define MAX_ACTIVE_VOICES 16
+
+//	polyphony; the Processor's voices and every per voice lane array below
+#define MAX_VOICES 16
+
+//	the voice block: a lane per voice, then a second set for the right
+//	side of the voices that render in stereo (unison spread)
+#define VOICE_BLOCK_LANES (2 * MAX_VOICES)
+#define VOICE_RIGHT_LANE_OFFSET MAX_VOICES
+
+static_assert(MAX_ACTIVE_VOICES == MAX_VOICES, "the active voice meter must show the whole polyphony");
+static_assert(VOICE_BLOCK_LANES <= 32, "lane masks are 32 bit UINTs");
+static_assert(VOICE_BLOCK_LANES % 8 == 0, "lanes split into whole SIMD groups of 8");
+
+//	DSP load, % of the buffer deadline
+#define MIN_DSP_LOAD_PCT 0.0
+#define MAX_DSP_LOAD_PCT 200.0
+#define MIN_DSP_OVERRUNS 0
+#define MAX_DSP_OVERRUNS 9999
+
+//	sample stream underruns, all voices
+#define MIN_STREAM_UNDERRUNS 0
+#define MAX_STREAM_UNDERRUNS 9999
+
+//	MIDI program change, looked up in the PresetBank
+#define MIN_MIDI_PROGRAM 0
+#define MAX_MIDI_PROGRAM 127
+#define DEFAULT_MIDI_PROGRAM 0
+
 #define MIN_MIDI_VALUE 0
 #define MAX_MIDI_VALUE 127
 #define DEFAULT_MIDI_VALUE 64
@@ -155,7 +328,7 @@ enum {
 #define DEFAULT_MIDI_MODWHEEL 0
 #define DEFAULT_MIDI_VOLUME 127
 #define DEFAULT_MIDI_PAN 64
-#define DEFAULT_MIDI_EXPRESSION 0
+#define DEFAULT_MIDI_EXPRESSION 127
 
 #endif
 
@@ -0,0 +1,308 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2022 quero.
+//------------------------------------------------------------------------
+
+#include "SynthState.h"
+#include "base/source/fstreamer.h"
+#include "logscale.h"
+#include <string.h>
+
+using namespace Steinberg;
+
+namespace Quero {
+
+//	largest params chunk we will buffer; anything past this is skipped
+#define SYNTH_STATE_MAX_PARAMS_CHUNK (4 + SYNTH_STATE_PARAM_RECORD_SIZE * 256)
+
+/*
+	The schema
+	One row per persisted parameter. Version 0 rows MUST stay first and
+	in this order since the version 0 stream has no IDs.
+	Add new parameters at the end with bVersion0 = false.
+*/
+static const SynthStateField synthStateSchema[] = {
+	//	ID							type		min								max								default								v0		log
+	{ OSC_WAVEFORM,					UINTData,	MIN_PITCHED_OSC_WAVEFORM,		MAX_PITCHED_OSC_WAVEFORM,		DEFAULT_PITCHED_OSC_WAVEFORM,		true,	false },
+	{ LFO1_WAVEFORM,				UINTData,	MIN_LFO_WAVEFORM,				MAX_LFO_WAVEFORM,				DEFAULT_LFO_WAVEFORM,				true,	false },
+	{ LFO1_RATE,					doubleData,	MIN_LFO_RATE,					MAX_LFO_RATE,					DEFAULT_LFO_RATE,					true,	false },
+	{ LFO1_AMPLITUDE,				doubleData,	MIN_UNIPOLAR,					MAX_UNIPOLAR,					DEFAULT_UNIPOLAR,					true,	false },
+	{ LFO1_MODE,					UINTData,	MIN_LFO_MODE,					MAX_LFO_MODE,					DEFAULT_LFO_MODE,					true,	false },
+	{ FILTER1_FC,					doubleData,	MIN_FILTER_FC,					MAX_FILTER_FC,					DEFAULT_FILTER_FC,					false,	true },
+	{ FILTER1_Q,					doubleData,	MIN_FILTER_Q,					MAX_FILTER_Q,					DEFAULT_FILTER_Q,					false,	false },
+	{ FILTER1_TYPE,					UINTData,	MIN_FILTER_TYPE,				MAX_FILTER_TYPE,				DEFAULT_FILTER_TYPE,				false,	false },
+	{ FILTER1_KEYTRACK,				UINTData,	MIN_ONOFF_SWITCH,				MAX_ONOFF_SWITCH,				DEFAULT_FILTER_KEYTRACK,			false,	false },
+	{ FILTER1_KEYTRACK_INTENSITY,	doubleData,	MIN_FILTER_KEYTRACK_INTENSITY,	MAX_FILTER_KEYTRACK_INTENSITY,	DEFAULT_FILTER_KEYTRACK_INTENSITY,	false,	false },
+	{ FILTER1_NLP,					UINTData,	MIN_ONOFF_SWITCH,				MAX_ONOFF_SWITCH,				DEFAULT_ONOFF_SWITCH,				false,	false },
+	{ FILTER1_SATURATION,			doubleData,	MIN_FILTER_SATURATION,			MAX_FILTER_SATURATION,			DEFAULT_FILTER_SATURATION,			false,	false },
+	{ EG1_ATTACK_TIME,				doubleData,	MIN_EG_ATTACK_TIME,				MAX_EG_ATTACK_TIME,				DEFAULT_EG_ATTACK_TIME,				false,	false },
+	{ EG1_DECAY_TIME,				doubleData,	MIN_EG_DECAY_TIME,				MAX_EG_DECAY_TIME,				DEFAULT_EG_DECAY_TIME,				false,	false },
+	{ EG1_SUSTAIN_LEVEL,			doubleData,	MIN_EG_SUSTAIN_LEVEL,			MAX_EG_SUSTAIN_LEVEL,			DEFAULT_EG_SUSTAIN_LEVEL,			false,	false },
+	{ EG1_RELEASE_TIME,				doubleData,	MIN_EG_RELEASE_TIME,			MAX_EG_RELEASE_TIME,			DEFAULT_EG_RELEASE_TIME,			false,	false },
+	{ EG1_LEGATO_MODE,				UINTData,	MIN_ONOFF_SWITCH,				MAX_ONOFF_SWITCH,				DEFAULT_LEGATO_MODE,				false,	false },
+	{ EG1_RESET_TO_ZERO,			UINTData,	MIN_ONOFF_SWITCH,				MAX_ONOFF_SWITCH,				DEFAULT_RESET_TO_ZERO,				false,	false },
+	{ DCA_AMPLITUDE_DB,				doubleData,	MIN_OUTPUT_AMPLITUDE_DB,		MAX_OUTPUT_AMPLITUDE_DB,		DEFAULT_OUTPUT_AMPLITUDE_DB,		false,	false },
+	{ DCA_PAN,						doubleData,	MIN_BIPOLAR,					MAX_BIPOLAR,					DEFAULT_BIPOLAR,					false,	false },
+	{ FILTER1_OVERSAMPLING,			UINTData,	MIN_FILTER_OVERSAMPLING,		MAX_FILTER_OVERSAMPLING,		DEFAULT_FILTER_OVERSAMPLING,		false,	false },
+	{ OVERSAMPLING_QUALITY,			UINTData,	MIN_OVERSAMPLING_QUALITY,		MAX_OVERSAMPLING_QUALITY,		DEFAULT_OVERSAMPLING_QUALITY,		false,	false },
+	{ OVERSAMPLING_OFFLINE_QUALITY,	UINTData,	MIN_OVERSAMPLING_QUALITY,		MAX_OVERSAMPLING_QUALITY,		DEFAULT_OVERSAMPLING_OFFLINE_QUALITY,	false,	false },
+	{ VECTOR_MODE,					UINTData,	MIN_ONOFF_SWITCH,				MAX_ONOFF_SWITCH,				DEFAULT_ONOFF_SWITCH,				false,	false },
+	{ VECTOR_A_WAVEFORM,			UINTData,	MIN_PITCHED_OSC_WAVEFORM,		MAX_PITCHED_OSC_WAVEFORM,		DEFAULT_VECTOR_A_WAVEFORM,			false,	false },
+	{ VECTOR_B_WAVEFORM,			UINTData,	MIN_PITCHED_OSC_WAVEFORM,		MAX_PITCHED_OSC_WAVEFORM,		DEFAULT_VECTOR_B_WAVEFORM,			false,	false },
+	{ VECTOR_C_WAVEFORM,			UINTData,	MIN_PITCHED_OSC_WAVEFORM,		MAX_PITCHED_OSC_WAVEFORM,		DEFAULT_VECTOR_C_WAVEFORM,			false,	false },
+	{ VECTOR_D_WAVEFORM,			UINTData,	MIN_PITCHED_OSC_WAVEFORM,		MAX_PITCHED_OSC_WAVEFORM,		DEFAULT_VECTOR_D_WAVEFORM,			false,	false },
+	{ VECTOR_JOYSTICK_X,			doubleData,	MIN_UNIPOLAR,					MAX_UNIPOLAR,					DEFAULT_UNIPOLAR_HALF,				false,	false },
+	{ VECTOR_JOYSTICK_Y,			doubleData,	MIN_UNIPOLAR,					MAX_UNIPOLAR,					DEFAULT_UNIPOLAR_HALF,				false,	false },
+	{ VECTOR_ORBIT_X,				doubleData,	MIN_UNIPOLAR,					MAX_UNIPOLAR,					DEFAULT_UNIPOLAR,					false,	false },
+	{ VECTOR_ORBIT_Y,				doubleData,	MIN_UNIPOLAR,					MAX_UNIPOLAR,					DEFAULT_UNIPOLAR,					false,	false },
+	{ VECTOR_PATH_MODE,				UINTData,	MIN_PATH_MODE,					MAX_PATH_MODE,					DEFAULT_PATH_MODE,					false,	false },
+	{ VECTOR_PATH_TIME,				doubleData,	MIN_VECTOR_PATH_TIME,			MAX_VECTOR_PATH_TIME,			DEFAULT_VECTOR_PATH_TIME,			false,	false },
+	{ SAMPLE_MODE,					UINTData,	MIN_ONOFF_SWITCH,				MAX_ONOFF_SWITCH,				DEFAULT_ONOFF_SWITCH,				false,	false },
+	{ SAMPLE_LOOP_MODE,				UINTData,	MIN_LOOP_MODE,					MAX_LOOP_MODE,					DEFAULT_LOOP_MODE,					false,	false },
+	{ SAMPLE_QUALITY,				UINTData,	MIN_SAMPLE_QUALITY,				MAX_SAMPLE_QUALITY,				DEFAULT_SAMPLE_QUALITY,				false,	false },
+	{ MPE_MODE,						UINTData,	MIN_ONOFF_SWITCH,				MAX_ONOFF_SWITCH,				DEFAULT_ONOFF_SWITCH,				false,	false },
+	{ UNISON_VOICES,				UINTData,	MIN_UNISON_VOICES,				MAX_UNISON_VOICES,				DEFAULT_UNISON_VOICES,				false,	false },
+	{ UNISON_DETUNE,				doubleData,	MIN_UNISON_DETUNE_CENTS,		MAX_UNISON_DETUNE_CENTS,		DEFAULT_UNISON_DETUNE_CENTS,		false,	false },
+	{ UNISON_CURVE,					doubleData,	MIN_UNIPOLAR,					MAX_UNIPOLAR,					DEFAULT_UNIPOLAR,					false,	false },
+	{ UNISON_SPREAD,				doubleData,	MIN_UNIPOLAR,					MAX_UNIPOLAR,					DEFAULT_UNIPOLAR_HALF,				false,	false },
+	{ UNISON_PHASE,					UINTData,	MIN_UNISON_PHASE,				MAX_UNISON_PHASE,				DEFAULT_UNISON_PHASE,				false,	false },
+};
+
+static const int synthStateFieldCount = sizeof(synthStateSchema) / sizeof(SynthStateField);
+
+//	parameter ID -> schema row (-1 = not persisted); the IDs are dense,
+//	so findField() is one load. Filled when the module loads
+static int synthStateFieldIndex[NUMBER_OF_SYNTH_PARAMETERS];
+
+static struct SynthStateFieldIndexBuilder {
+	SynthStateFieldIndexBuilder() {
+		for (int i = 0; i < NUMBER_OF_SYNTH_PARAMETERS; i++) {
+			synthStateFieldIndex[i] = -1;
+		}
+		for (int i = 0; i < synthStateFieldCount; i++) {
+			synthStateFieldIndex[synthStateSchema[i].uParamID] = i;
+		}
+	}
+} synthStateFieldIndexBuilder;
+
+//	the Controller's filterLogScale; the Fc Parameter is normalized on this curve
+static const Vst::LogScale<Vst::ParamValue> synthStateFcScale(MIN_UNIPOLAR, MAX_UNIPOLAR,
+	MIN_FILTER_FC, MAX_FILTER_FC, FILTER_RAW_MAP, FILTER_COOKED_MAP);
+
+//	the chunk payloads are always little endian
+static inline void writeLE32(unsigned char* p, uint32 u) {
+	p[0] = (unsigned char)(u);
+	p[1] = (unsigned char)(u >> 8);
+	p[2] = (unsigned char)(u >> 16);
+	p[3] = (unsigned char)(u >> 24);
+}
+
+static inline uint32 readLE32(const unsigned char* p) {
+	return (uint32)p[0] | ((uint32)p[1] << 8) | ((uint32)p[2] << 16) | ((uint32)p[3] << 24);
+}
+
+static inline void writeLEDouble(unsigned char* p, double d) {
+	uint64 u = 0;
+	memcpy(&u, &d, sizeof(double));
+	writeLE32(p, (uint32)u);
+	writeLE32(p + 4, (uint32)(u >> 32));
+}
+
+static inline double readLEDouble(const unsigned char* p) {
+	uint64 u = (uint64)readLE32(p) | ((uint64)readLE32(p + 4) << 32);
+	double d = 0.0;
+	memcpy(&d, &u, sizeof(double));
+	return d;
+}
+
+//	start with the defaults
+SynthState::SynthState(void) {
+	m_uVersion = SYNTH_STATE_VERSION;
+	for (int i = 0; i < NUMBER_OF_SYNTH_PARAMETERS; i++) {
+		m_dValues[i] = 0.0;
+	}
+	for (int i = 0; i < synthStateFieldCount; i++) {
+		m_dValues[i] = synthStateSchema[i].dDefault;
+	}
+}
+
+SynthState::~SynthState(void) {
+}
+
+const SynthStateField* SynthState::getSchema() {
+	return synthStateSchema;
+}
+
+int SynthState::getFieldCount() {
+	return synthStateFieldCount;
+}
+
+int SynthState::findField(Vst::ParamID uParamID) {
+	return uParamID < NUMBER_OF_SYNTH_PARAMETERS ? synthStateFieldIndex[uParamID] : -1;
+}
+
+double SynthState::getValue(Vst::ParamID uParamID) const {
+	int nField = findField(uParamID);
+	return nField < 0 ? 0.0 : m_dValues[nField];
+}
+
+void SynthState::setValue(Vst::ParamID uParamID, double dValue) {
+	int nField = findField(uParamID);
+	if (nField >= 0) {
+		m_dValues[nField] = clampToField(nField, dValue);
+	}
+}
+
+double SynthState::getNormalized(int nField) const {
+	return normalizeValue(nField, m_dValues[nField]);
+}
+
+double SynthState::normalizeValue(int nField, double dValue) {
+	const SynthStateField& field = synthStateSchema[nField];
+	if (field.dMax <= field.dMin) {
+		return 0.0;
+	}
+	if (field.bLogScale) {
+		return fmin(fmax(synthStateFcScale.invscaleCheck(dValue), 0.0), 1.0);
+	}
+	return fmin(fmax((dValue - field.dMin) / (field.dMax - field.dMin), 0.0), 1.0);
+}
+
+double SynthState::clampToField(int nField, double dValue) {
+	const SynthStateField& field = synthStateSchema[nField];
+
+	//	a corrupt double is no better than a missing one
+	if (dValue != dValue) {
+		return field.dDefault;
+	}
+
+	//	clamp first; a negative or huge value must not reach an integer conversion
+	dValue = fmin(fmax(dValue, field.dMin), field.dMax);
+	if (field.uDataType == UINTData) {
+		dValue = floor(dValue + 0.5);
+	}
+	return dValue;
+}
+
+/*
+	SynthState::read()
+	Reads the version, then either the version 0 fixed stream
+	or the chunks. Returns false on a short or corrupt stream.
+*/
+bool SynthState::read(IBStream* state) {
+	IBStreamer streamer(state, kLittleEndian);
+
+	if (!streamer.readInt64u(m_uVersion)) {
+		return false;
+	}
+
+	if (m_uVersion == 0) {
+		return readVersion0(state);
+	}
+	return readChunks(state);
+}
+
+//	the original order: each field in its own type, no IDs
+bool SynthState::readVersion0(IBStream* state) {
+	IBStreamer streamer(state, kLittleEndian);
+	uint32 udata = 0;
+	double ddata = 0.0;
+
+	for (int i = 0; i < synthStateFieldCount; i++) {
+		if (!synthStateSchema[i].bVersion0) {
+			continue;
+		}
+		if (synthStateSchema[i].uDataType == UINTData) {
+			if (!streamer.readInt32u(udata)) {
+				return false;
+			}
+			m_dValues[i] = clampToField(i, (double)udata);
+		}
+		else {
+			if (!streamer.readDouble(ddata)) {
+				return false;
+			}
+			m_dValues[i] = clampToField(i, ddata);
+		}
+	}
+	return true;
+}
+
+//	walk the chunks to the end of the stream
+bool SynthState::readChunks(IBStream* state) {
+	IBStreamer streamer(state, kLittleEndian);
+	unsigned char header[SYNTH_STATE_CHUNK_HEADER_SIZE];
+	unsigned char payload[SYNTH_STATE_MAX_PARAMS_CHUNK];
+	bool bFoundParams = false;
+
+	while (streamer.readRaw(header, SYNTH_STATE_CHUNK_HEADER_SIZE) == SYNTH_STATE_CHUNK_HEADER_SIZE) {
+		uint32 uChunkID = readLE32(header);
+		uint32 uChunkSize = readLE32(header + 4);
+		uint32 uSkip = uChunkSize;
+
+		if (uChunkID == SYNTH_STATE_CHUNK_PARAMS) {
+			uint32 uRead = uChunkSize < SYNTH_STATE_MAX_PARAMS_CHUNK ? uChunkSize : SYNTH_STATE_MAX_PARAMS_CHUNK;
+			if (streamer.readRaw(payload, uRead) != (TSize)uRead) {
+				return false;
+			}
+			parseParamsChunk(payload, uRead);
+			bFoundParams = true;
+			uSkip -= uRead;
+		}
+
+		//	unknown chunk or oversized params chunk from a newer version
+		if (uSkip > 0) {
+			streamer.seek(uSkip, kSeekCurrent);
+		}
+	}
+
+	return bFoundParams;
+}
+
+//	count, then (ID, cooked value) records
+void SynthState::parseParamsChunk(const unsigned char* pData, uint32 uSize) {
+	if (uSize < 4) {
+		return;
+	}
+
+	uint32 uCount = readLE32(pData);
+	const unsigned char* pRecord = pData + 4;
+	const unsigned char* pEnd = pData + uSize;
+
+	for (uint32 i = 0; i < uCount && pRecord + SYNTH_STATE_PARAM_RECORD_SIZE <= pEnd; i++) {
+		int nField = findField(readLE32(pRecord));
+		if (nField >= 0) {
+			m_dValues[nField] = clampToField(nField, readLEDouble(pRecord + 4));
+		}
+		pRecord += SYNTH_STATE_PARAM_RECORD_SIZE;
+	}
+}
+
+/*
+	SynthState::write()
+	Version first, then the params chunk as one block.
+*/
+bool SynthState::write(IBStream* state) const {
+	IBStreamer streamer(state, kLittleEndian);
+	unsigned char chunk[SYNTH_STATE_CHUNK_HEADER_SIZE + 4 + SYNTH_STATE_PARAM_RECORD_SIZE * NUMBER_OF_SYNTH_PARAMETERS];
+
+	uint32 uPayloadSize = 4 + SYNTH_STATE_PARAM_RECORD_SIZE * synthStateFieldCount;
+	writeLE32(chunk, SYNTH_STATE_CHUNK_PARAMS);
+	writeLE32(chunk + 4, uPayloadSize);
+	writeLE32(chunk + 8, synthStateFieldCount);
+
+	unsigned char* pRecord = chunk + SYNTH_STATE_CHUNK_HEADER_SIZE + 4;
+	for (int i = 0; i < synthStateFieldCount; i++) {
+		writeLE32(pRecord, synthStateSchema[i].uParamID);
+		writeLEDouble(pRecord + 4, m_dValues[i]);
+		pRecord += SYNTH_STATE_PARAM_RECORD_SIZE;
+	}
+
+	if (!streamer.writeInt64u(SYNTH_STATE_VERSION)) {
+		return false;
+	}
+
+	TSize nChunkSize = SYNTH_STATE_CHUNK_HEADER_SIZE + uPayloadSize;
+	return streamer.writeRaw(chunk, nChunkSize) == nChunkSize;
+}
+
+} // namespace Quero
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------
+// Copyright(c) 2022 quero.
+//------------------------------------------------------------------------
+#pragma once
+
+#include "pluginterfaces/base/ibstream.h"
+#include "pluginterfaces/vst/vsttypes.h"
+#include "pluginconstants.h"
+#include "SynthParamLimits.h"
+
+namespace Quero {
+
+//	for versioning in serialization
+//	0: the original fixed order stream (5 fields, no chunks)
+//	1: chunked; each parameter is stored with its ID
+#define SYNTH_STATE_VERSION 1
+
+//	chunk IDs ('NSPM' = the persisted GUI parameters)
+#define SYNTH_STATE_CHUNK_PARAMS 0x4D50534E
+
+//	chunk header = ID + payload size; param record = ID + cooked value
+#define SYNTH_STATE_CHUNK_HEADER_SIZE 8
+#define SYNTH_STATE_PARAM_RECORD_SIZE 12
+
+/*
+	SynthStateField
+	One row of the state schema: a persisted parameter, its
+	cooked type and range. The range is the same one the
+	Controller uses to build the Parameter, so the normalized
+	value can be made without going through the Parameter object.
+*/
+struct SynthStateField {
+	Steinberg::Vst::ParamID uParamID;
+	UINT uDataType;		//	UINTData or doubleData
+	double dMin;
+	double dMax;
+	double dDefault;
+	bool bVersion0;		//	part of the original fixed order stream
+	bool bLogScale;		//	normalized on the filter Fc log taper, not linearly
+};
+
+/*
+	SynthState
+	The persisted state of the synth as one array of cooked values,
+	one per schema row. The Processor fills it from its members and
+	writes it; the Processor and Controller both read it in one pass.
+
+	The stream is written with one writeRaw() and each chunk is read
+	with one readRaw(), so loading does not pay one stream call per
+	parameter. Unknown chunks and parameter IDs are skipped and missing
+	ones keep their defaults, so old and new presets both load.
+*/
+class SynthState {
+public:
+	SynthState(void);
+	~SynthState(void);
+
+	//	the schema
+	static const SynthStateField* getSchema();
+	static int getFieldCount();
+
+	//	schema row for a parameter or -1 if it is not persisted
+	static int findField(Steinberg::Vst::ParamID uParamID);
+
+	//	cooked values by parameter ID
+	double getValue(Steinberg::Vst::ParamID uParamID) const;
+	void setValue(Steinberg::Vst::ParamID uParamID, double dValue);
+
+	//	a cooked value clamped to a schema row's range, UINTs rounded;
+	//	NaN gives the default
+	static double clampToField(int nField, double dValue);
+
+	//	0->1 value for a schema row, for EditController::setParamNormalized()
+	double getNormalized(int nField) const;
+	static double normalizeValue(int nField, double dValue);
+
+	//	serialization
+	bool read(Steinberg::IBStream* state);
+	bool write(Steinberg::IBStream* state) const;
+
+	//	the version of the last stream read
+	Steinberg::uint64 m_uVersion;
+
+protected:
+	//	cooked values, one per schema row
+	double m_dValues[NUMBER_OF_SYNTH_PARAMETERS];
+
+	//	version 0 fixed order stream
+	bool readVersion0(Steinberg::IBStream* state);
+
+	//	version 1+ chunks
+	bool readChunks(Steinberg::IBStream* state);
+	void parseParamsChunk(const unsigned char* pData, Steinberg::uint32 uSize);
+};
+
+} // namespace Quero
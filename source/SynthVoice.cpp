@@ -0,0 +1,260 @@
+#include "SynthVoice.h"
+
+SynthVoice::SynthVoice(void) : m_JSProgram(NULL, JS_ONESHOT) {
+	m_uMIDIChannel = 0;
+	m_uMIDINote = 0;
+	m_uMIDIVelocity = 0;
+	m_uTimestamp = 0;
+
+	//	detune
+	m_Osc2.m_nCents = 2.5; // +2.5 cents detuned
+
+	m_bSampleMode = false;
+
+	m_bVectorMode = false;
+	m_dJoystickX = 0.5;
+	m_dJoystickY = 0.5;
+	m_uVectorPathMode = JS_ONESHOT;
+	for (int i = 0; i < 4; i++) {
+		m_fVectorWeights[i] = 0.25f;
+	}
+}
+
+SynthVoice::~SynthVoice(void) {
+}
+
+void SynthVoice::setSampleRate(double dFs) {
+	m_Osc1.setSampleRate(dFs);
+	m_Osc2.setSampleRate(dFs);
+	m_Osc3.setSampleRate(dFs);
+	m_Osc4.setSampleRate(dFs);
+	m_SampleOsc.setSampleRate(dFs);
+	m_LFO1.setSampleRate(dFs);
+	m_EG1.setSampleRate(dFs);
+	m_JSProgram.setSampleRate((int)dFs);
+}
+
+void SynthVoice::setNoiseSeed(UINT uSeed) {
+	m_Osc1.setNoiseSeed(uSeed);
+	m_Osc2.setNoiseSeed(uSeed + 1);
+	m_LFO1.setNoiseSeed(uSeed + 2);
+
+	//	vector sources; well clear of the seeds the other voices get
+	m_Osc3.setNoiseSeed(uSeed + 0x8000);
+	m_Osc4.setNoiseSeed(uSeed + 0x8001);
+	m_Unison.setNoiseSeed(uSeed + 0x8002);
+}
+
+void SynthVoice::setVectorPath(float* pJSProgramTable) {
+	m_JSProgram.m_pJSProgramTable = pJSProgramTable;
+}
+
+void SynthVoice::setVectorPathMode(UINT uMode) {
+	if (uMode != m_uVectorPathMode) {
+		m_uVectorPathMode = uMode;
+		m_JSProgram.setJSMode(uMode);
+	}
+}
+
+void SynthVoice::noteOn(UINT uChannel, UINT uNote, UINT uVelocity, double dFo, double dInc, UINT uTimestamp) {
+	m_uMIDIChannel = uChannel;
+	m_uMIDINote = uNote;
+	m_uMIDIVelocity = uVelocity;
+	m_uTimestamp = uTimestamp;
+
+	m_Osc1.setOscFo(dFo, dInc);
+	m_Osc1.update();
+
+	m_Osc2.setOscFo(dFo, dInc);
+	m_Osc2.update();
+
+	m_Osc3.setOscFo(dFo, dInc);
+	m_Osc3.update();
+
+	m_Osc4.setOscFo(dFo, dInc);
+	m_Osc4.update();
+
+	m_SampleOsc.setOscFo(dFo, dInc);
+	m_SampleOsc.update();
+
+	//	a sounding voice (retrigger or steal) keeps its oscillator phase
+	//	so the EG can carry on from its level without a click
+	bool bWasActive = isActive();
+	if (!bWasActive) {
+		m_Osc1.startOscillator();
+		m_Osc2.startOscillator();
+		m_Osc3.startOscillator();
+		m_Osc4.startOscillator();
+		m_Unison.startOscillator();
+	}
+
+	//	legato: only the pitch changes
+	if (!(m_EG1.m_bLegatoMode && m_EG1.isHeld())) {
+		m_LFO1.startOscillator();
+
+		//	a sample always plays from the top
+		if (m_bSampleMode) {
+			m_SampleOsc.startOscillator();
+		}
+
+		//	the path starts over; a sounding voice ramps to its start
+		m_JSProgram.reset();
+		m_JSProgram.startProgram();
+		m_JSProgram.calculateCurrentVectorMix();
+		if (!bWasActive) {
+			getVectorWeights(m_fVectorWeights);
+		}
+	}
+
+	m_EG1.startEG();
+}
+
+void SynthVoice::noteOff() {
+	m_EG1.noteOff();
+	m_SampleOsc.noteOff();
+
+	//	a sustain path waits at its last point for the release
+	if (m_uVectorPathMode == JS_SUSTAIN) {
+		m_JSProgram.resumeProgram();
+	}
+}
+
+void SynthVoice::stopVoice() {
+	m_EG1.stopEG();
+	m_Osc1.stopOscillator();
+	m_Osc2.stopOscillator();
+	m_Osc3.stopOscillator();
+	m_Osc4.stopOscillator();
+	m_Unison.stopOscillator();
+	m_SampleOsc.stopOscillator();
+	m_LFO1.stopOscillator();
+	m_JSProgram.reset();
+}
+
+void SynthVoice::setExpressionPitch(double dSemitones) {
+	m_Osc1.setPitchBendMod(dSemitones);
+	m_Osc2.setPitchBendMod(dSemitones);
+	m_Osc3.setPitchBendMod(dSemitones);
+	m_Osc4.setPitchBendMod(dSemitones);
+	m_SampleOsc.setPitchBendMod(dSemitones);
+}
+
+void SynthVoice::update() {
+	m_Osc1.update();
+	m_Osc2.update();
+	m_Osc3.update();
+	m_Osc4.update();
+	m_SampleOsc.update();
+	m_LFO1.update();
+	m_EG1.update();
+}
+
+/*
+	SynthVoice::getVectorWeights()
+	The path's AC/BD mixes are its offset from the joystick; the VS
+	equations turn the point into the A-D weights (they sum to 1).
+	Once per block, so the double math does not matter.
+*/
+void SynthVoice::getVectorWeights(float* pWeights) {
+	float fOffsetX = 0.0f;
+	float fOffsetY = 0.0f;
+	m_JSProgram.getVectorACBDMixes(fOffsetX, fOffsetY);
+
+	double dX = m_dJoystickX + fOffsetX;
+	double dY = m_dJoystickY + fOffsetY;
+	dX = dX < 0.0 ? 0.0 : (dX > 1.0 ? 1.0 : dX);
+	dY = dY < 0.0 ? 0.0 : (dY > 1.0 ? 1.0 : dY);
+
+	double dA, dB, dC, dD, dACMix, dBDMix;
+	calculateVectorJoystickValues(dX, dY, dA, dB, dC, dD, dACMix, dBDMix);
+
+	pWeights[0] = (float)dA;
+	pWeights[1] = (float)dB;
+	pWeights[2] = (float)dC;
+	pWeights[3] = (float)dD;
+}
+
+/*
+	SynthVoice::renderVector()
+	Renders the four sources for a block, moves the path on by the
+	block and mixes with the weights ramping from the last block's end
+	to this one's; one 4-way SIMD multiply-add per sample.
+*/
+void SynthVoice::renderVector(float* pOutput, int nStride, int nSamples) {
+	while (nSamples > 0) {
+		int nBlock = nSamples < VECTOR_MIX_BLOCK ? nSamples : VECTOR_MIX_BLOCK;
+
+		for (int i = 0; i < nBlock; i++) {
+			//	ARTICULATION BLOCK
+			double dLFO1Out = m_LFO1.doOscillate();
+			m_Osc1.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
+			m_Osc2.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
+			m_Osc3.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
+			m_Osc4.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
+
+			m_Osc1.update();
+			m_Osc2.update();
+			m_Osc3.update();
+			m_Osc4.update();
+
+			//	DIGITAL AUDIO ENGINE BLOCK
+			float* pSource = &m_fVectorSources[i * 4];
+			pSource[0] = (float)m_Osc1.doOscillate();
+			pSource[1] = (float)m_Osc2.doOscillate();
+			pSource[2] = (float)m_Osc3.doOscillate();
+			pSource[3] = (float)m_Osc4.doOscillate();
+		}
+
+		//	the path moves once per block
+		m_JSProgram.incTimer((UINT)nBlock);
+
+		float fEndWeights[4];
+		float fDeltas[4];
+		getVectorWeights(fEndWeights);
+		for (int i = 0; i < 4; i++) {
+			fDeltas[i] = (fEndWeights[i] - m_fVectorWeights[i]) / (float)nBlock;
+		}
+
+		vectorMix(m_fVectorSources, m_fVectorWeights, fDeltas, pOutput, nStride, nBlock);
+
+		//	snap to the target; the ramp can be off by rounding
+		for (int i = 0; i < 4; i++) {
+			m_fVectorWeights[i] = fEndWeights[i];
+		}
+
+		pOutput += nBlock * nStride;
+		nSamples -= nBlock;
+	}
+}
+
+/*
+	SynthVoice::renderUnison()
+	Osc1 still runs the pitch (LFO, bend, note expression) but does not
+	play; its phase increment drives the copies, a block at a time.
+*/
+void SynthVoice::renderUnison(float* pLeft, float* pRight, int nStride, int nSamples) {
+	m_Unison.m_uWaveform = m_Osc1.m_uWaveform;
+	m_Unison.m_dPulseWidth = m_Osc1.m_dPulseWidthControl;
+	m_Unison.m_dAmplitude = m_Osc1.m_dAmplitude;
+
+	while (nSamples > 0) {
+		int nBlock = nSamples < UNISON_BLOCK ? nSamples : UNISON_BLOCK;
+
+		for (int i = 0; i < nBlock; i++) {
+			//	ARTICULATION BLOCK
+			double dLFO1Out = m_LFO1.doOscillate();
+			m_Osc1.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
+			m_Osc1.update();
+			m_fUnisonInc[i] = (float)m_Osc1.m_dInc;
+		}
+
+		//	DIGITAL AUDIO ENGINE BLOCK
+		m_Unison.render(m_fUnisonInc, pLeft, pRight, nStride, nBlock);
+
+		pLeft += nBlock * nStride;
+		if (pRight) {
+			pRight += nBlock * nStride;
+		}
+		nSamples -= nBlock;
+	}
+}
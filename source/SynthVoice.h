@@ -0,0 +1,193 @@
+#pragma once
+#include "pluginconstants.h"
+#include "synthfunctions.h"
+#include "QBLimitedOscillator.h"
+#include "LFO.h"
+#include "SampleOscillator.h"
+#include "UnisonOscillator.h"
+#include "EnvelopeGenerator.h"
+#include "BatchMath.h"
+
+//	vector sources are mixed this many samples at a time
+#define VECTOR_MIX_BLOCK 32
+
+/*
+	SynthVoice
+	One note: the two oscillators, the LFO that bends their pitch and
+	the EG that shapes the amplitude.
+
+	In vector mode all four oscillators play, as sources A-D at the
+	corners of the joystick, and are mixed by its position. The path
+	(CJoystickProgram) moves the position around the joystick setting;
+	it is advanced once per block, and the mix weights ramp linearly
+	across the block from where it was to where it is now.
+
+	In sample mode the voice plays the SampleOscillator instead, which
+	streams its sample from disk; it takes over from vector mode.
+
+	Otherwise, with more than one unison voice and a waveform it can
+	play, the UnisonOscillator's detuned copies of Osc1 stand in for the
+	Osc1/Osc2 pair. Spread copies are rendered in stereo, the right side
+	into a second lane of the shared block.
+
+	The Processor owns MAX_VOICES of these, sets their GUI variables in
+	update() and hands each note to one of them. Everything after the
+	oscillators (the filter) runs across all voices at once, so a voice
+	renders its raw oscillator mix into its own lane of a shared block,
+	and applyEG() is run on the lane once it has been filtered.
+
+	A voice sounds until its EG has finished the release, not until the
+	note-off; then it stops its oscillators and is free again.
+*/
+class SynthVoice {
+public:
+	SynthVoice(void);
+	~SynthVoice(void);
+
+	//	voice components; GUI variables are set by the Processor
+	QBLimitedOscillator m_Osc1;
+	QBLimitedOscillator m_Osc2;
+
+	//	vector sources C and D; m_Osc1 and m_Osc2 are A and B
+	QBLimitedOscillator m_Osc3;
+	QBLimitedOscillator m_Osc4;
+
+	//	sample mode; its stream is serviced by the Processor's SampleStreamer
+	SampleOscillator m_SampleOsc;
+
+	//	unison; plays Osc1's waveform at Osc1's pitch
+	UnisonOscillator m_Unison;
+
+	LFO m_LFO1;
+	EnvelopeGenerator m_EG1;
+
+	//	the note being played
+	UINT m_uMIDIChannel;
+	UINT m_uMIDINote;
+	UINT m_uMIDIVelocity;
+
+	//	note-on order; the oldest voice is stolen first
+	UINT m_uTimestamp;
+
+	//	sample mode, set by the Processor
+	bool m_bSampleMode;
+
+	//	vector controls, set by the Processor; the joystick is 0 -> 1 on
+	//	both axes, 0.5/0.5 is an equal mix
+	bool m_bVectorMode;
+	double m_dJoystickX;
+	double m_dJoystickY;
+
+	//	the Processor's path table: positions relative to the joystick
+	//	in the AC/BD columns
+	void setVectorPath(float* pJSProgramTable);
+
+	//	a JS_ mode; only resets the program when it changes
+	void setVectorPathMode(UINT uMode);
+
+	void setSampleRate(double dFs);
+
+	//	reference renders; see Oscillator::setNoiseSeed()
+	void setNoiseSeed(UINT uSeed);
+
+	//	dFo/dInc come from the Tuning table
+	void noteOn(UINT uChannel, UINT uNote, UINT uVelocity, double dFo, double dInc, UINT uTimestamp);
+	void noteOff();
+
+	//	GUI changes
+	void update();
+
+	//	per-note pitch (note expression/MPE), semitones; the oscillators
+	//	pick it up on their next update()
+	void setExpressionPitch(double dSemitones);
+
+	inline bool isActive() {
+		return m_EG1.isActive();
+	}
+
+	//	note-off received; the first to go when a voice is stolen
+	inline bool isReleasing() {
+		return m_EG1.isActive() && !m_EG1.isHeld();
+	}
+
+	//	the unison copies are playing instead of Osc1/Osc2
+	inline bool isUnison() {
+		return !m_bSampleMode && !m_bVectorMode && m_Unison.getVoices() > 1 &&
+			UnisonOscillator::hasWaveform(m_Osc1.m_uWaveform);
+	}
+
+	//	render() needs a right output
+	inline bool isStereo() {
+		return isUnison() && m_Unison.isStereo();
+	}
+
+	//	nSamples of output into pOutput[0], pOutput[nStride], ... and, for
+	//	a stereo voice, the right side into pRightOutput the same way
+	inline void render(float* pOutput, int nStride, int nSamples, float* pRightOutput = 0) {
+		if (m_bSampleMode) {
+			for (int i = 0; i < nSamples; i++) {
+				double dLFO1Out = m_LFO1.doOscillate();
+				m_SampleOsc.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
+				m_SampleOsc.update();
+
+				pOutput[i * nStride] = (float)m_SampleOsc.doOscillate();
+			}
+			return;
+		}
+
+		if (m_bVectorMode) {
+			renderVector(pOutput, nStride, nSamples);
+			return;
+		}
+
+		if (isUnison()) {
+			renderUnison(pOutput, pRightOutput, nStride, nSamples);
+			return;
+		}
+
+		for (int i = 0; i < nSamples; i++) {
+			//	ARTICULATION BLOCK
+			//	render LFO output and apply to the Exp modulation inputs
+			double dLFO1Out = m_LFO1.doOscillate();
+			m_Osc1.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
+			m_Osc2.setFoModExp(dLFO1Out * OSC_FO_MOD_RANGE);
+
+			//	update
+			m_Osc1.update();
+			m_Osc2.update();
+
+			//	DIGITAL AUDIO ENGINE BLOCK
+			pOutput[i * nStride] = (float)(0.5 * m_Osc1.doOscillate() + 0.5 * m_Osc2.doOscillate());
+		}
+	}
+
+	//	EG1 -> amplitude, on the rendered (and filtered) output, and the
+	//	right side nRightOffset on if there is one; frees the voice when
+	//	the envelope has finished
+	inline void applyEG(float* pOutput, int nStride, int nSamples, int nRightOffset = 0) {
+		if (!m_EG1.process(pOutput, nStride, nSamples, nRightOffset)) {
+			stopVoice();
+		}
+	}
+
+	//	silence now, no release
+	void stopVoice();
+
+protected:
+	//	the vector path and the A-D weights at the end of the last block
+	CJoystickProgram m_JSProgram;
+	UINT m_uVectorPathMode;
+	float m_fVectorWeights[4];
+
+	//	one block of the four sources, m_fVectorSources[sample * 4 + source]
+	float m_fVectorSources[VECTOR_MIX_BLOCK * 4];
+
+	//	one block of Osc1's phase increments, for the unison copies
+	float m_fUnisonInc[UNISON_BLOCK];
+
+	//	A-D weights for the path's current position
+	void getVectorWeights(float* pWeights);
+
+	void renderVector(float* pOutput, int nStride, int nSamples);
+	void renderUnison(float* pLeft, float* pRight, int nStride, int nSamples);
+};
@@ -0,0 +1,177 @@
+#include "TraceLog.h"
+
+#if TRACE_LOG
+
+#include <stdlib.h>
+#include "SynthParamLimits.h"
+
+//	names for the parameters we trace
+static const char* getTraceParamName(unsigned int uParamID) {
+	if (uParamID >= MPE_PITCHBEND && uParamID < MPE_PRESSURE + MPE_MEMBER_CHANNELS) {
+		return uParamID < MPE_TIMBRE ? "MPE Pitch Bend" : uParamID < MPE_PRESSURE ? "MPE Timbre" : "MPE Pressure";
+	}
+	switch (uParamID) {
+		case OSC_WAVEFORM: return "Osc Waveform";
+		case LFO1_WAVEFORM: return "LFO1 Waveform";
+		case LFO1_RATE: return "LFO1 Rate";
+		case LFO1_AMPLITUDE: return "LFO1 Amplitude";
+		case LFO1_MODE: return "LFO1 Mode";
+		case MIDI_PITCHBEND: return "Pitch Bend";
+		case MIDI_MODWHEEL: return "Mod Wheel";
+		case MIDI_VOLUME_CC7: return "Volume";
+		case MIDI_PAN_CC10: return "Pan";
+		case MIDI_EXPRESSION_CC11: return "Expression";
+		case MIDI_SUSTAIN_PEDAL: return "Sustain Pedal";
+		case MIDI_CHANNEL_PRESSURE: return "Channel Pressure";
+		case MIDI_ALL_NOTES_OFF: return "All Notes Off";
+		case MIDI_PROGRAM_CHANGE: return "Program";
+	}
+	return "Param";
+}
+
+TraceLog::TraceLog(void) {
+	m_uMask.store(TRACE_CAT_ALL);
+	m_uDropped.store(0);
+	m_StartTime = std::chrono::steady_clock::now();
+	m_nBlockPosition = 0;
+	m_pFile = 0;
+	m_bStopFlush = false;
+}
+
+TraceLog::~TraceLog(void) {
+	close();
+}
+
+/*
+	TraceLog::open()
+	Opens (truncates) the file and starts the flush thread. The
+	NANOSYNTH_TRACE_MASK environment variable, if set, replaces the mask.
+*/
+bool TraceLog::open(const char* pPath) {
+	close();
+
+	m_pFile = fopen(pPath, "w");
+	if (!m_pFile) {
+		return false;
+	}
+
+	const char* pMask = getenv(TRACE_MASK_ENV_VAR);
+	if (pMask) {
+		setMask((unsigned int)strtoul(pMask, 0, 16));
+	}
+
+	m_Ring.reset();
+	m_uDropped.store(0);
+	m_StartTime = std::chrono::steady_clock::now();
+	m_bStopFlush = false;
+
+	fprintf(m_pFile, "NanoSynth trace, mask 0x%02X\n", getMask());
+	fprintf(m_pFile, "time(mSec)   offset  event\n");
+
+	m_FlushThread = std::thread([this]() {
+		std::unique_lock<std::mutex> lock(m_FlushMutex);
+		bool bStop = false;
+
+		//	drain whatever is left on the way out
+		while (!bStop) {
+			bStop = m_FlushCondition.wait_for(lock, std::chrono::milliseconds(TRACE_FLUSH_INTERVAL_MSEC), [this]() { return m_bStopFlush; });
+			flush();
+		}
+	});
+
+	return true;
+}
+
+void TraceLog::close() {
+	if (m_FlushThread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(m_FlushMutex);
+			m_bStopFlush = true;
+		}
+		m_FlushCondition.notify_all();
+		m_FlushThread.join();
+	}
+
+	if (m_pFile) {
+		fclose(m_pFile);
+		m_pFile = 0;
+	}
+}
+
+//	drain the ring into the file
+void TraceLog::flush() {
+	TraceRecord records[64];
+	char szLine[256];
+	unsigned int uCount = 0;
+
+	while ((uCount = m_Ring.read(records, 64)) > 0) {
+		for (unsigned int i = 0; i < uCount; i++) {
+			formatRecord(records[i], szLine, sizeof(szLine));
+			fputs(szLine, m_pFile);
+		}
+	}
+
+	unsigned int uDropped = m_uDropped.exchange(0);
+	if (uDropped > 0) {
+		fprintf(m_pFile, "*** %u records dropped ***\n", uDropped);
+	}
+
+	fflush(m_pFile);
+}
+
+void TraceLog::formatRecord(const TraceRecord& record, char* pLine, int nMaxLength) {
+	double dTime_mSec = record.uTimestamp_nSec / 1.0e6;
+
+	switch (record.uType) {
+		case TRACE_NOTE_ON: {
+			snprintf(pLine, nMaxLength, "%12.3f %7d  Note ON: Channel: %d, Note: %d, Velocity: %d\n",
+				dTime_mSec, record.nSampleOffset, record.uChannel, record.uNote, record.uVelocity);
+			break;
+		}
+		case TRACE_NOTE_OFF: {
+			snprintf(pLine, nMaxLength, "%12.3f %7d  Note OFF: Channel: %d, Note: %d, Velocity: %d\n",
+				dTime_mSec, record.nSampleOffset, record.uChannel, record.uNote, record.uVelocity);
+			break;
+		}
+		case TRACE_POLY_PRESSURE: {
+			snprintf(pLine, nMaxLength, "%12.3f %7d  Poly Pressure: Channel: %d, Note: %d, Pressure: %f\n",
+				dTime_mSec, record.nSampleOffset, record.uChannel, record.uNote, record.fValue);
+			break;
+		}
+		case TRACE_PROGRAM_CHANGE: {
+			snprintf(pLine, nMaxLength, "%12.3f %7d  Program Change: %d\n",
+				dTime_mSec, record.nSampleOffset, (int)record.fValue);
+			break;
+		}
+		default: {
+			snprintf(pLine, nMaxLength, "%12.3f %7d  %s (%u): %f\n",
+				dTime_mSec, record.nSampleOffset, getTraceParamName(record.uParamID), record.uParamID, record.fValue);
+			break;
+		}
+	}
+}
+
+/*
+	TraceLog::getDefaultPath()
+	Next to the DSP load report, one file per instance.
+*/
+bool TraceLog::getDefaultPath(char* pPath, int nMaxLength, const void* pInstance) {
+#if defined _WIN32
+	const char* pBase = getenv("TEMP");
+	const char* pFormat = "%s\\NanoSynth_trace_%p.txt";
+#else
+	const char* pBase = getenv("TMPDIR");
+	const char* pFormat = "%s/NanoSynth_trace_%p.txt";
+	if (!pBase) {
+		pBase = "/tmp";
+	}
+#endif
+	if (!pBase) {
+		return false;
+	}
+
+	int nLength = snprintf(pPath, nMaxLength, pFormat, pBase, pInstance);
+	return nLength > 0 && nLength < nMaxLength;
+}
+
+#endif // TRACE_LOG
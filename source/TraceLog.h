@@ -0,0 +1,164 @@
+#pragma once
+
+//	compiled into debug builds; define NANOSYNTH_TRACE to get it in a QA release build
+#if defined _DEBUG || defined NANOSYNTH_TRACE
+#define TRACE_LOG 1
+#else
+#define TRACE_LOG 0
+#endif
+
+//	categories, for the runtime mask
+#define TRACE_CAT_NOTES		0x01	//	note on/off, poly pressure
+#define TRACE_CAT_CONTROLS	0x02	//	GUI parameters
+#define TRACE_CAT_MIDI		0x04	//	mapped MIDI controllers
+#define TRACE_CAT_PROGRAM	0x08	//	program changes
+#define TRACE_CAT_ALL		0xFF
+
+//	record types
+enum {
+	TRACE_NOTE_ON,
+	TRACE_NOTE_OFF,
+	TRACE_POLY_PRESSURE,
+	TRACE_PARAM_CHANGE,
+	TRACE_PROGRAM_CHANGE
+};
+
+#if TRACE_LOG
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <stdio.h>
+#include "SPSCRing.h"
+
+#define TRACE_RING_SIZE 4096			//	records; must be a power of 2
+#define TRACE_FLUSH_INTERVAL_MSEC 100
+#define TRACE_MASK_ENV_VAR "NANOSYNTH_TRACE_MASK"	//	hex, overrides the default mask
+
+/*
+	TraceRecord
+	One fixed-size entry; the audio thread fills it and nothing else.
+*/
+struct TraceRecord {
+	unsigned long long uTimestamp_nSec;	//	since open()
+	unsigned int uType;
+	unsigned int uParamID;				//	TRACE_PARAM_CHANGE
+	int nSampleOffset;					//	in the host buffer
+	unsigned char uChannel;
+	unsigned char uNote;
+	unsigned char uVelocity;
+	unsigned char uReserved;
+	float fValue;						//	pressure, normalized parameter value, program number
+};
+
+/*
+	TraceLog
+	Realtime-safe event trace. The audio thread writes fixed-size
+	records into a wait-free ring; a background thread formats them
+	and appends them to a text file every TRACE_FLUSH_INTERVAL_MSEC.
+	No formatting, locks, allocation or OS calls on the audio thread.
+
+	If the flush thread falls behind, records are dropped and counted,
+	and the count shows up in the file.
+*/
+class TraceLog {
+public:
+	TraceLog(void);
+	~TraceLog(void);
+
+	//	start/stop the flush thread; not from the audio thread
+	bool open(const char* pPath);
+	void close();
+
+	//	per category enable, any thread
+	void setMask(unsigned int uMask) { m_uMask.store(uMask, std::memory_order_relaxed); }
+	unsigned int getMask() { return m_uMask.load(std::memory_order_relaxed); }
+	inline bool isEnabled(unsigned int uCategory) { return (m_uMask.load(std::memory_order_relaxed) & uCategory) != 0; }
+
+	//	audio thread; the offset of the current sub-block in the host buffer
+	inline void setBlockPosition(int nSamplesProcessed) { m_nBlockPosition = nSamplesProcessed; }
+
+	//	audio thread
+	inline void traceNote(unsigned int uCategory, unsigned int uType, unsigned int uChannel, unsigned int uNote,
+		unsigned int uVelocity, float fValue, int nSampleOffset) {
+		if (!isEnabled(uCategory)) {
+			return;
+		}
+
+		TraceRecord record;
+		record.uTimestamp_nSec = getTimestamp();
+		record.uType = uType;
+		record.uParamID = 0;
+		record.nSampleOffset = m_nBlockPosition + nSampleOffset;
+		record.uChannel = (unsigned char)uChannel;
+		record.uNote = (unsigned char)uNote;
+		record.uVelocity = (unsigned char)uVelocity;
+		record.uReserved = 0;
+		record.fValue = fValue;
+		push(record);
+	}
+
+	inline void traceParam(unsigned int uCategory, unsigned int uType, unsigned int uParamID, float fValue, int nSampleOffset) {
+		if (!isEnabled(uCategory)) {
+			return;
+		}
+
+		TraceRecord record;
+		record.uTimestamp_nSec = getTimestamp();
+		record.uType = uType;
+		record.uParamID = uParamID;
+		record.nSampleOffset = nSampleOffset;
+		record.uChannel = 0;
+		record.uNote = 0;
+		record.uVelocity = 0;
+		record.uReserved = 0;
+		record.fValue = fValue;
+		push(record);
+	}
+
+	//	the per-instance trace location
+	static bool getDefaultPath(char* pPath, int nMaxLength, const void* pInstance);
+
+protected:
+	SPSCRing<TraceRecord, TRACE_RING_SIZE> m_Ring;
+	std::atomic<unsigned int> m_uMask;
+	std::atomic<unsigned int> m_uDropped;
+	std::chrono::steady_clock::time_point m_StartTime;
+	int m_nBlockPosition;
+
+	//	flush thread
+	FILE* m_pFile;
+	std::thread m_FlushThread;
+	std::mutex m_FlushMutex;
+	std::condition_variable m_FlushCondition;
+	bool m_bStopFlush;
+
+	inline unsigned long long getTimestamp() {
+		return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_StartTime).count();
+	}
+
+	inline void push(const TraceRecord& record) {
+		if (m_Ring.write(&record, 1) == 0) {
+			m_uDropped.store(m_uDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+	}
+
+	//	flush thread only
+	void flush();
+	void formatRecord(const TraceRecord& record, char* pLine, int nMaxLength);
+};
+
+//	audio thread tracing; these vanish when TRACE_LOG is off
+#define TRACE_BLOCK_POSITION(trace, position) (trace).setBlockPosition(position)
+#define TRACE_NOTE(trace, category, type, channel, note, velocity, value, offset) (trace).traceNote(category, type, channel, note, velocity, value, offset)
+#define TRACE_PARAM(trace, category, type, id, value, offset) (trace).traceParam(category, type, id, value, offset)
+
+#else
+
+#define TRACE_BLOCK_POSITION(trace, position)
+#define TRACE_NOTE(trace, category, type, channel, note, velocity, value, offset)
+#define TRACE_PARAM(trace, category, type, id, value, offset)
+
+#endif // TRACE_LOG
@@ -0,0 +1,274 @@
+#include "Tuning.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define TUNING_LINE_LENGTH 256
+
+//	.scl/.kbm reader: next line that is not a comment ('!'), trimmed
+static bool readScalaLine(FILE* pFile, char* pLine, int nMaxLength) {
+	while (fgets(pLine, nMaxLength, pFile)) {
+		if (pLine[0] == '!') {
+			continue;
+		}
+
+		//	trim both ends
+		char* pStart = pLine;
+		while (*pStart && isspace((unsigned char)*pStart)) {
+			pStart++;
+		}
+		char* pEnd = pStart + strlen(pStart);
+		while (pEnd > pStart && isspace((unsigned char)pEnd[-1])) {
+			pEnd--;
+		}
+		*pEnd = 0;
+		memmove(pLine, pStart, pEnd - pStart + 1);
+		return true;
+	}
+	return false;
+}
+
+//	.scl pitch: cents if there is a '.', otherwise a ratio "n/d" or "n"
+static bool parseScalaPitch(const char* pText, double& dCents) {
+	if (strchr(pText, '.')) {
+		dCents = atof(pText);
+		return true;
+	}
+
+	char* pEnd = 0;
+	double dNumerator = (double)strtoul(pText, &pEnd, 10);
+	double dDenominator = 1.0;
+	if (pEnd == pText) {
+		return false;
+	}
+	if (*pEnd == '/') {
+		dDenominator = (double)strtoul(pEnd + 1, 0, 10);
+	}
+	if (dNumerator <= 0.0 || dDenominator <= 0.0) {
+		return false;
+	}
+
+	dCents = 1200.0 * log2Pitch(dNumerator / dDenominator);
+	return true;
+}
+
+Tuning::Tuning(void) {
+	m_dSampleRate = 44100.0;
+	setEqualTemperament();
+}
+
+Tuning::~Tuning(void) {
+}
+
+void Tuning::setSampleRate(double dFs) {
+	m_dSampleRate = dFs;
+
+	for (UINT i = 0; i < TUNING_NOTES; i++) {
+		updatePhaseInc(i);
+	}
+}
+
+void Tuning::setEqualTemperament(double dA4) {
+	for (UINT i = 0; i < TUNING_NOTES; i++) {
+		m_dFrequency[i] = dA4 * exp2Pitch(((double)i - 69.0) / 12.0);
+		updatePhaseInc(i);
+	}
+}
+
+/*
+	Tuning::loadScala()
+	Scala semantics: scale degree 0 is 0 cents (unison, not listed in the
+	file) and the last listed degree is the period, usually 2/1. The
+	mapping places degree 0 on the middle note and pins the reference
+	note to the reference frequency.
+
+	Keys the mapping leaves out ('x' or outside first/last) keep their
+	12-TET pitch; there is nothing in NanoSynth to silence a key.
+*/
+bool Tuning::loadScala(const char* pSclPath, const char* pKbmPath) {
+	char szLine[TUNING_LINE_LENGTH];
+
+	//	scale; degree 0 is implied
+	FILE* pFile = fopen(pSclPath, "r");
+	if (!pFile) {
+		return false;
+	}
+
+	double dDegreeCents[TUNING_MAX_SCALE_SIZE + 1];
+	dDegreeCents[0] = 0.0;
+	int nScaleSize = 0;
+
+	bool bOK = readScalaLine(pFile, szLine, sizeof(szLine)) &&	//	description
+		readScalaLine(pFile, szLine, sizeof(szLine));			//	count
+	if (bOK) {
+		nScaleSize = atoi(szLine);
+		bOK = nScaleSize > 0 && nScaleSize <= TUNING_MAX_SCALE_SIZE;
+	}
+	for (int i = 1; bOK && i <= nScaleSize; i++) {
+		bOK = readScalaLine(pFile, szLine, sizeof(szLine)) && parseScalaPitch(szLine, dDegreeCents[i]);
+	}
+	fclose(pFile);
+
+	if (!bOK) {
+		return false;
+	}
+	double dPeriodCents = dDegreeCents[nScaleSize];
+
+	//	keyboard mapping; defaults are a linear map with 60 on degree 0
+	int nMapSize = 0;
+	int nFirstNote = 0;
+	int nLastNote = TUNING_NOTES - 1;
+	int nMiddleNote = 60;
+	int nReferenceNote = 69;
+	double dReferenceFrequency = TUNING_DEFAULT_A4;
+	int nOctaveDegree = nScaleSize;
+	int nMap[TUNING_NOTES];
+
+	if (pKbmPath) {
+		pFile = fopen(pKbmPath, "r");
+		if (!pFile) {
+			return false;
+		}
+
+		int* pHeader[] = { &nMapSize, &nFirstNote, &nLastNote, &nMiddleNote, &nReferenceNote };
+		for (int i = 0; bOK && i < 5; i++) {
+			bOK = readScalaLine(pFile, szLine, sizeof(szLine));
+			*pHeader[i] = atoi(szLine);
+		}
+		if (bOK && (bOK = readScalaLine(pFile, szLine, sizeof(szLine)))) {
+			dReferenceFrequency = atof(szLine);
+		}
+		if (bOK && (bOK = readScalaLine(pFile, szLine, sizeof(szLine)))) {
+			nOctaveDegree = atoi(szLine);
+		}
+
+		bOK = bOK && nMapSize >= 0 && nMapSize <= TUNING_NOTES && dReferenceFrequency > 0.0;
+
+		//	'x' = unmapped; missing entries at the end are unmapped too
+		for (int i = 0; bOK && i < nMapSize; i++) {
+			nMap[i] = readScalaLine(pFile, szLine, sizeof(szLine)) && szLine[0] != 'x' ? atoi(szLine) : -1;
+		}
+		fclose(pFile);
+
+		if (!bOK) {
+			return false;
+		}
+	}
+
+	//	note -> cents above the middle note, or false if unmapped
+	auto getNoteCents = [&](int nNote, double& dCents) -> bool {
+		if (nNote < nFirstNote || nNote > nLastNote) {
+			return false;
+		}
+
+		int nDegree = nNote - nMiddleNote;
+		if (nMapSize > 0) {
+			int nMapOctave = (int)floor((double)nDegree / nMapSize);
+			int nMapEntry = nMap[nDegree - nMapOctave * nMapSize];
+			if (nMapEntry < 0) {
+				return false;
+			}
+			nDegree = nMapOctave * nOctaveDegree + nMapEntry;
+		}
+
+		int nPeriod = (int)floor((double)nDegree / nScaleSize);
+		dCents = nPeriod * dPeriodCents + dDegreeCents[nDegree - nPeriod * nScaleSize];
+		return true;
+	};
+
+	double dReferenceCents = 0.0;
+	if (!getNoteCents(nReferenceNote, dReferenceCents)) {
+		return false;
+	}
+
+	for (int i = 0; i < TUNING_NOTES; i++) {
+		double dCents = 0.0;
+		if (getNoteCents(i, dCents)) {
+			m_dFrequency[i] = dReferenceFrequency * exp2Pitch((dCents - dReferenceCents) / 1200.0);
+		} else {
+			m_dFrequency[i] = TUNING_DEFAULT_A4 * exp2Pitch(((double)i - 69.0) / 12.0);
+		}
+		updatePhaseInc(i);
+	}
+
+	return true;
+}
+
+/*
+	Tuning::doMTSSysEx()
+	Handles, ignoring device ID, program and bank (we have one tuning):
+		F0 7E dd 08 01 pp <name:16> [xx yy zz]*128 cs F7	bulk dump
+		F0 7F dd 08 02 pp ll [kk xx yy zz]*ll F7			single note
+		F0 7E/7F dd 08 07 bb pp ll [kk xx yy zz]*ll F7		single note, with bank
+		F0 7E/7F dd 08 08 ff gg hh [ss]*12 F7				scale/octave, 1 byte
+		F0 7E/7F dd 08 09 ff gg hh [ss tt]*12 F7			scale/octave, 2 byte
+	7F 7F 7F in a frequency word means "leave this note alone".
+	The channel mask of the scale/octave forms is ignored.
+*/
+bool Tuning::doMTSSysEx(const unsigned char* pData, int nLength) {
+	if (nLength < 6 || pData[0] != 0xF0 || (pData[1] != 0x7E && pData[1] != 0x7F) || pData[3] != 0x08) {
+		return false;
+	}
+
+	unsigned char uFormat = pData[4];
+	const unsigned char* pEnd = pData + nLength;
+
+	//	one frequency word per note
+	auto setNote = [&](UINT uNote, const unsigned char* pWord) {
+		if (pWord[0] == 0x7F && pWord[1] == 0x7F && pWord[2] == 0x7F) {
+			return;
+		}
+		m_dFrequency[uNote & 0x7F] = getMTSFrequency(pWord[0], pWord[1], pWord[2]);
+		updatePhaseInc(uNote & 0x7F);
+	};
+
+	switch (uFormat) {
+		case 0x01: {
+			//	6 header bytes, name, 128 words
+			const unsigned char* pWord = pData + 6 + 16;
+			if (pWord + TUNING_NOTES * 3 > pEnd) {
+				return false;
+			}
+			for (UINT i = 0; i < TUNING_NOTES; i++, pWord += 3) {
+				setNote(i, pWord);
+			}
+			return true;
+		}
+
+		case 0x02:
+		case 0x07: {
+			const unsigned char* pCount = pData + (uFormat == 0x02 ? 6 : 7);
+			if (pCount >= pEnd) {
+				return false;
+			}
+			const unsigned char* pChange = pCount + 1;
+			for (UINT i = 0; i < *pCount && pChange + 4 <= pEnd; i++, pChange += 4) {
+				setNote(pChange[0], pChange + 1);
+			}
+			return true;
+		}
+
+		case 0x08:
+		case 0x09: {
+			//	cents per pitch class, relative to 12-TET
+			int nBytes = uFormat == 0x08 ? 1 : 2;
+			const unsigned char* pOffset = pData + 8;
+			if (pOffset + 12 * nBytes > pEnd) {
+				return false;
+			}
+
+			double dCents[12];
+			for (int i = 0; i < 12; i++, pOffset += nBytes) {
+				dCents[i] = nBytes == 1 ? (double)pOffset[0] - 64.0 : (((pOffset[0] << 7) | pOffset[1]) - 8192) * (100.0 / 8192.0);
+			}
+			for (UINT i = 0; i < TUNING_NOTES; i++) {
+				m_dFrequency[i] = TUNING_DEFAULT_A4 * exp2Pitch(((double)i - 69.0 + dCents[i % 12] / 100.0) / 12.0);
+				updatePhaseInc(i);
+			}
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "pluginconstants.h"
+#include "synthfunctions.h"
+
+#define TUNING_NOTES 128				//	MIDI notes
+#define TUNING_MAX_SCALE_SIZE 128		//	degrees in a .scl file
+#define TUNING_DEFAULT_A4 440.0
+#define TUNING_SCALA_FILE_NAME "NanoSynth.scl"
+#define TUNING_KBM_FILE_NAME "NanoSynth.kbm"
+
+/*
+	Tuning
+	Note -> frequency and note -> phase increment tables.
+
+	The frequencies come from 12-TET, a Scala .scl scale with an optional
+	.kbm keyboard mapping, or MIDI Tuning Standard sysex. The increments
+	(frequency / fs) are rebuilt once per sample rate so an oscillator
+	only has to multiply them by its modulation ratio.
+
+	loadScala() reads files; call it outside process(). setSampleRate()
+	and doMTSSysEx() do no allocation or I/O and may run on the audio
+	thread.
+*/
+class Tuning {
+public:
+	Tuning(void);
+	~Tuning(void);
+
+	//	rebuild the increments
+	void setSampleRate(double dFs);
+
+	//	standard tuning, A4 = dA4
+	void setEqualTemperament(double dA4 = TUNING_DEFAULT_A4);
+
+	//	Scala scale and keyboard mapping; pKbmPath may be NULL for the
+	//	default mapping (middle C = degree 0, A4 = 440Hz). Tuning is
+	//	unchanged if the files can't be read or parsed
+	bool loadScala(const char* pSclPath, const char* pKbmPath = NULL);
+
+	//	MTS bulk dump, single note and scale/octave messages; false if the
+	//	message is not MTS. pData starts at 0xF0, the 0xF7 is optional
+	bool doMTSSysEx(const unsigned char* pData, int nLength);
+
+	inline double getFrequency(UINT uNote) {
+		return m_dFrequency[uNote & 0x7F];
+	}
+
+	inline double getPhaseInc(UINT uNote) {
+		return m_dPhaseInc[uNote & 0x7F];
+	}
+
+protected:
+	double m_dSampleRate;
+	double m_dFrequency[TUNING_NOTES];
+	double m_dPhaseInc[TUNING_NOTES];
+
+	void updatePhaseInc(UINT uNote) {
+		m_dPhaseInc[uNote] = m_dFrequency[uNote] / m_dSampleRate;
+	}
+
+	//	MTS frequency word: semitone, then a 14 bit fraction of a semitone
+	static double getMTSFrequency(unsigned char uSemitone, unsigned char uMSB, unsigned char uLSB) {
+		double dSemitones = uSemitone + ((uMSB << 7) | uLSB) / 16384.0;
+		return TUNING_DEFAULT_A4 * exp2Pitch((dSemitones - 69.0) / 12.0);
+	}
+};
@@ -0,0 +1,363 @@
+#include "UnisonOscillator.h"
+#include "BatchMath.h"
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+/*
+	each sample, for every copy k
+		dt = inc * ratio(k)
+		x = saw(phase(k), dt), or saw(phase(k)) - saw(phase(k) + pw) for the pulse
+		left(k & 7) += x gL(k), right(k & 7) += x gR(k)
+		phase(k) += dt, less 1 past the end
+	then the 8 sums are folded 8 -> 4 -> 2 -> 1, the same on every path
+*/
+
+//	the project builds with /fp:fast; the kernels must not be contracted
+//	or reassociated, or the paths stop matching
+#if defined _MSC_VER
+#pragma float_control(precise, on, push)
+#endif
+
+//------------------------------------------------------------------------
+//	scalar reference
+//------------------------------------------------------------------------
+//	2 point PolyBLEP ramp, -1 -> +1 with the edge falling at phase 0
+static inline float polyBLEPSaw(float t, float dt) {
+	float b = 0.0f;
+	if (t < dt) {
+		float x = t / dt;
+		b = ((x + x) - x * x) - 1.0f;
+	} else if (t > 1.0f - dt) {
+		float x = (t - 1.0f) / dt;
+		b = (x * x + (x + x)) + 1.0f;
+	}
+	return ((t + t) - 1.0f) - b;
+}
+
+static inline float foldLanesRef(const float* pLane) {
+	float fLane[4];
+	for (int j = 0; j < 4; j++) {
+		fLane[j] = pLane[j] + pLane[j + 4];
+	}
+	return (fLane[0] + fLane[2]) + (fLane[1] + fLane[3]);
+}
+
+static void unisonScalar(UnisonLanes& lanes, int nLanes, const float* pInc, float fPulseWidth, float* pLeft, float* pRight, int nSamples) {
+	for (int n = 0; n < nSamples; n++) {
+		float fSumL[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		float fSumR[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int k = 0; k < nLanes; k++) {
+			float t = lanes.fPhase[k];
+			float dt = pInc[n] * lanes.fRatio[k];
+
+			float x = polyBLEPSaw(t, dt);
+			if (fPulseWidth > 0.0f) {
+				float t2 = t + fPulseWidth;
+				if (t2 >= 1.0f) {
+					t2 -= 1.0f;
+				}
+				x = x - polyBLEPSaw(t2, dt);
+			}
+
+			fSumL[k & 7] = fSumL[k & 7] + x * lanes.fGainL[k];
+			if (pRight) {
+				fSumR[k & 7] = fSumR[k & 7] + x * lanes.fGainR[k];
+			}
+
+			t = t + dt;
+			if (t >= 1.0f) {
+				t -= 1.0f;
+			}
+			lanes.fPhase[k] = t;
+		}
+
+		pLeft[n] = foldLanesRef(fSumL);
+		if (pRight) {
+			pRight[n] = foldLanesRef(fSumR);
+		}
+	}
+}
+
+#if BATCH_MATH_X86
+//------------------------------------------------------------------------
+//	SSE2, 4 copies per step; each group of 8 is a low and a high half
+//------------------------------------------------------------------------
+BATCH_TARGET_SSE2 static inline __m128 polyBLEPSawSSE2(__m128 t, __m128 dt) {
+	const __m128 one = _mm_set1_ps(1.0f);
+	__m128 x0 = _mm_div_ps(t, dt);
+	__m128 b0 = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(x0, x0), _mm_mul_ps(x0, x0)), one);
+	__m128 x1 = _mm_div_ps(_mm_sub_ps(t, one), dt);
+	__m128 b1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, x1), _mm_add_ps(x1, x1)), one);
+
+	//	the first test wins, as in the scalar if/else
+	__m128 m0 = _mm_cmplt_ps(t, dt);
+	__m128 m1 = _mm_andnot_ps(m0, _mm_cmpgt_ps(t, _mm_sub_ps(one, dt)));
+	__m128 b = _mm_or_ps(_mm_and_ps(m0, b0), _mm_and_ps(m1, b1));
+	return _mm_sub_ps(_mm_sub_ps(_mm_add_ps(t, t), one), b);
+}
+
+BATCH_TARGET_SSE2 static inline float foldLanesSSE2(__m128 vLow, __m128 vHigh) {
+	__m128 v = _mm_add_ps(vLow, vHigh);
+	v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+	v = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(v);
+}
+
+BATCH_TARGET_SSE2 static void unisonSSE2(UnisonLanes& lanes, int nLanes, const float* pInc, float fPulseWidth, float* pLeft, float* pRight, int nSamples) {
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 pw = _mm_set1_ps(fPulseWidth);
+	bool bPulse = fPulseWidth > 0.0f;
+
+	for (int n = 0; n < nSamples; n++) {
+		__m128 inc = _mm_set1_ps(pInc[n]);
+		__m128 sumL[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 sumR[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+
+		for (int k = 0; k < nLanes; k += 4) {
+			__m128 t = _mm_loadu_ps(&lanes.fPhase[k]);
+			__m128 dt = _mm_mul_ps(inc, _mm_loadu_ps(&lanes.fRatio[k]));
+
+			__m128 x = polyBLEPSawSSE2(t, dt);
+			if (bPulse) {
+				__m128 t2 = _mm_add_ps(t, pw);
+				t2 = _mm_sub_ps(t2, _mm_and_ps(_mm_cmpge_ps(t2, one), one));
+				x = _mm_sub_ps(x, polyBLEPSawSSE2(t2, dt));
+			}
+
+			int h = (k >> 2) & 1;
+			sumL[h] = _mm_add_ps(sumL[h], _mm_mul_ps(x, _mm_loadu_ps(&lanes.fGainL[k])));
+			if (pRight) {
+				sumR[h] = _mm_add_ps(sumR[h], _mm_mul_ps(x, _mm_loadu_ps(&lanes.fGainR[k])));
+			}
+
+			t = _mm_add_ps(t, dt);
+			t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpge_ps(t, one), one));
+			_mm_storeu_ps(&lanes.fPhase[k], t);
+		}
+
+		pLeft[n] = foldLanesSSE2(sumL[0], sumL[1]);
+		if (pRight) {
+			pRight[n] = foldLanesSSE2(sumR[0], sumR[1]);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+//	AVX2, 8 copies per step
+//------------------------------------------------------------------------
+BATCH_TARGET_AVX2 static inline __m256 polyBLEPSawAVX2(__m256 t, __m256 dt) {
+	const __m256 one = _mm256_set1_ps(1.0f);
+	__m256 x0 = _mm256_div_ps(t, dt);
+	__m256 b0 = _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(x0, x0), _mm256_mul_ps(x0, x0)), one);
+	__m256 x1 = _mm256_div_ps(_mm256_sub_ps(t, one), dt);
+	__m256 b1 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x1, x1), _mm256_add_ps(x1, x1)), one);
+
+	__m256 m0 = _mm256_cmp_ps(t, dt, _CMP_LT_OQ);
+	__m256 m1 = _mm256_andnot_ps(m0, _mm256_cmp_ps(t, _mm256_sub_ps(one, dt), _CMP_GT_OQ));
+	__m256 b = _mm256_or_ps(_mm256_and_ps(m0, b0), _mm256_and_ps(m1, b1));
+	return _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(t, t), one), b);
+}
+
+BATCH_TARGET_AVX2 static void unisonAVX2(UnisonLanes& lanes, int nLanes, const float* pInc, float fPulseWidth, float* pLeft, float* pRight, int nSamples) {
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 pw = _mm256_set1_ps(fPulseWidth);
+	bool bPulse = fPulseWidth > 0.0f;
+
+	for (int n = 0; n < nSamples; n++) {
+		__m256 inc = _mm256_set1_ps(pInc[n]);
+		__m256 sumL = _mm256_setzero_ps();
+		__m256 sumR = _mm256_setzero_ps();
+
+		for (int k = 0; k < nLanes; k += 8) {
+			__m256 t = _mm256_loadu_ps(&lanes.fPhase[k]);
+			__m256 dt = _mm256_mul_ps(inc, _mm256_loadu_ps(&lanes.fRatio[k]));
+
+			__m256 x = polyBLEPSawAVX2(t, dt);
+			if (bPulse) {
+				__m256 t2 = _mm256_add_ps(t, pw);
+				t2 = _mm256_sub_ps(t2, _mm256_and_ps(_mm256_cmp_ps(t2, one, _CMP_GE_OQ), one));
+				x = _mm256_sub_ps(x, polyBLEPSawAVX2(t2, dt));
+			}
+
+			sumL = _mm256_add_ps(sumL, _mm256_mul_ps(x, _mm256_loadu_ps(&lanes.fGainL[k])));
+			if (pRight) {
+				sumR = _mm256_add_ps(sumR, _mm256_mul_ps(x, _mm256_loadu_ps(&lanes.fGainR[k])));
+			}
+
+			t = _mm256_add_ps(t, dt);
+			t = _mm256_sub_ps(t, _mm256_and_ps(_mm256_cmp_ps(t, one, _CMP_GE_OQ), one));
+			_mm256_storeu_ps(&lanes.fPhase[k], t);
+		}
+
+		pLeft[n] = foldLanesSSE2(_mm256_castps256_ps128(sumL), _mm256_extractf128_ps(sumL, 1));
+		if (pRight) {
+			pRight[n] = foldLanesSSE2(_mm256_castps256_ps128(sumR), _mm256_extractf128_ps(sumR, 1));
+		}
+	}
+}
+#endif // BATCH_MATH_X86
+
+#if defined _MSC_VER
+#pragma float_control(pop)
+#endif
+
+//------------------------------------------------------------------------
+//	dispatch; indexed by getBatchMathISA()
+//------------------------------------------------------------------------
+typedef void (*UnisonKernel)(UnisonLanes&, int, const float*, float, float*, float*, int);
+
+static const UnisonKernel unisonKernels[] = {
+	unisonScalar,
+#if BATCH_MATH_X86
+	unisonSSE2,
+	unisonAVX2,
+#endif
+};
+
+//------------------------------------------------------------------------
+//	UnisonOscillator
+//------------------------------------------------------------------------
+UnisonOscillator::UnisonOscillator(void) {
+	m_uWaveform = Oscillator::SAW1;
+	m_dPulseWidth = OSC_PULSEWIDTH_DEFAULT;
+	m_dAmplitude = 1.0;
+
+	m_uVoices = 1;
+	m_dDetune = 0.0;
+	m_dCurve = 0.0;
+	m_dSpread = 0.0;
+	m_uPhaseMode = UNISON_PHASE_RANDOM;
+	m_bNoteOn = false;
+	m_nLanes = 8;
+
+	m_uSeed = 0;
+	m_uRandom = (UINT)rand();
+
+	memset(&m_Lanes, 0, sizeof(m_Lanes));
+	memset(m_fMixL, 0, sizeof(m_fMixL));
+	memset(m_fMixR, 0, sizeof(m_fMixR));
+	updateLanes();
+}
+
+UnisonOscillator::~UnisonOscillator(void) {
+}
+
+void UnisonOscillator::setUnison(UINT uVoices, double dDetune, double dCurve, double dSpread) {
+	uVoices = uVoices < 1 ? 1 : (uVoices > UNISON_MAX_VOICES ? UNISON_MAX_VOICES : uVoices);
+	if (uVoices == m_uVoices && dDetune == m_dDetune && dCurve == m_dCurve && dSpread == m_dSpread) {
+		return;
+	}
+
+	m_uVoices = uVoices;
+	m_dDetune = dDetune;
+	m_dCurve = dCurve;
+	m_dSpread = dSpread;
+	updateLanes();
+}
+
+void UnisonOscillator::setNoiseSeed(UINT uSeed) {
+	m_uSeed = uSeed;
+	if (uSeed) {
+		m_uRandom = uSeed;
+	}
+}
+
+void UnisonOscillator::startOscillator() {
+	if (m_uSeed) {
+		m_uRandom = m_uSeed;
+	}
+
+	for (int k = 0; k < UNISON_MAX_VOICES; k++) {
+		if (m_uPhaseMode == UNISON_PHASE_LOCKED) {
+			m_Lanes.fPhase[k] = 0.0f;
+		} else {
+			//	LCG; the top 24 bits are a float's worth
+			m_uRandom = m_uRandom * 1664525u + 1013904223u;
+			m_Lanes.fPhase[k] = (float)(m_uRandom >> 8) * (1.0f / 16777216.0f);
+		}
+	}
+	m_bNoteOn = true;
+}
+
+void UnisonOscillator::stopOscillator() {
+	m_bNoteOn = false;
+	for (int k = 0; k < UNISON_MAX_VOICES; k++) {
+		m_Lanes.fPhase[k] = 0.0f;
+	}
+}
+
+/*
+	UnisonOscillator::updateLanes()
+	Detune ratios and gains for the copies; copy k and copy N - 1 - k
+	mirror each other in detune and go to opposite sides.
+*/
+void UnisonOscillator::updateLanes() {
+	m_nLanes = ((int)m_uVoices + 7) & ~7;
+
+	double dLevel = 1.0 / sqrt((double)m_uVoices);
+	for (int k = 0; k < UNISON_MAX_VOICES; k++) {
+		if (k >= (int)m_uVoices) {
+			m_Lanes.fRatio[k] = 1.0f;
+			m_Lanes.fGainL[k] = 0.0f;
+			m_Lanes.fGainR[k] = 0.0f;
+			continue;
+		}
+
+		double x = m_uVoices > 1 ? -1.0 + 2.0 * k / (m_uVoices - 1) : 0.0;
+		double dShaped = (x < 0.0 ? -1.0 : 1.0) * pow(fabs(x), 1.0 + 2.0 * m_dCurve);
+		m_Lanes.fRatio[k] = (float)pitchShiftMultiplier(m_dDetune * dShaped / 100.0);
+
+		int nMirror = (int)m_uVoices - 1 - k;
+		int nLower = k < nMirror ? k : nMirror;
+		double dSide = (nLower & 1) ? -1.0 : 1.0;
+		if (k > nMirror) {
+			dSide = -dSide;
+		}
+
+		double dPanL = 0.0;
+		double dPanR = 0.0;
+		calculatePanValues(m_dSpread * dSide * fabs(x), dPanL, dPanR);
+		m_Lanes.fGainL[k] = (float)(dLevel * sqrt(2.0) * dPanL);
+		m_Lanes.fGainR[k] = (float)(dLevel * sqrt(2.0) * dPanR);
+	}
+}
+
+void UnisonOscillator::render(const float* pInc, float* pLeft, float* pRight, int nStride, int nSamples) {
+	if (nSamples <= 0) {
+		return;
+	}
+
+	bool bStereo = isStereo() && pRight;
+	if (!m_bNoteOn) {
+		for (int n = 0; n < nSamples; n++) {
+			pLeft[n * nStride] = 0.0f;
+		}
+		if (bStereo) {
+			for (int n = 0; n < nSamples; n++) {
+				pRight[n * nStride] = 0.0f;
+			}
+		}
+		return;
+	}
+
+	float fPulseWidth = 0.0f;
+	float fLevel = (float)m_dAmplitude;
+	if (m_uWaveform == Oscillator::SQUARE) {
+		//	the same DC correction as QBLimitedOscillator::doSquare()
+		double dWidth = m_dPulseWidth / 100.0;
+		fPulseWidth = (float)dWidth;
+		fLevel *= (float)(0.5 / (dWidth < 0.5 ? 1.0 - dWidth : dWidth));
+	}
+
+	unisonKernels[getBatchMathISA()](m_Lanes, m_nLanes, pInc, fPulseWidth, m_fMixL, bStereo ? m_fMixR : 0, nSamples);
+
+	for (int n = 0; n < nSamples; n++) {
+		pLeft[n * nStride] = m_fMixL[n] * fLevel;
+	}
+	if (bStereo) {
+		for (int n = 0; n < nSamples; n++) {
+			pRight[n * nStride] = m_fMixR[n] * fLevel;
+		}
+	}
+}
@@ -0,0 +1,285 @@
+#include "VoiceDCA.h"
+#include "BatchMath.h"
+#include <string.h>
+
+//	the project builds with /fp:fast; the kernels must not be contracted
+//	or reassociated, or the paths stop matching
+#if defined _MSC_VER
+#pragma float_control(precise, on, push)
+#endif
+
+/*
+	each sample, for every lane v in use
+		gL(v) += dL(v), gR(v) += dR(v)	(ramping blocks only)
+		sL(v % 8) += x(v) gL(v), sR(v % 8) += x(v) gR(v)
+	then each side's 8 partial sums are added in one fixed tree
+		((s0 + s4) + (s2 + s6)) + ((s1 + s5) + (s3 + s7))
+	which is an AVX2 register's lanes, or two SSE2 registers', as they
+	fall. Every path adds in this order, so all give bit-identical
+	output. A skipped lane is silent and only ever adds zero.
+*/
+#define VOICE_DCA_PARTIALS 8
+
+//------------------------------------------------------------------------
+//	scalar reference
+//------------------------------------------------------------------------
+static inline float dcaReduce(const float* pPartials) {
+	float fSum[4];
+	for (int i = 0; i < 4; i++) {
+		fSum[i] = pPartials[i] + pPartials[i + 4];
+	}
+	return (fSum[0] + fSum[2]) + (fSum[1] + fSum[3]);
+}
+
+static void dcaScalar(VoiceDCALanes& lanes, const float* pBlock, float* pLeft, float* pRight, int nSamples, bool bRamp, UINT uLaneMask) {
+	for (int n = 0; n < nSamples; n++) {
+		const float* p = pBlock + n * VOICE_DCA_LANES;
+		float fLeft[VOICE_DCA_PARTIALS] = { 0.0f };
+		float fRight[VOICE_DCA_PARTIALS] = { 0.0f };
+		for (int v = 0; v < VOICE_DCA_LANES; v++) {
+			if (!(uLaneMask & (1u << v))) {
+				continue;
+			}
+			if (bRamp) {
+				lanes.fGainL[v] += lanes.fDeltaL[v];
+				lanes.fGainR[v] += lanes.fDeltaR[v];
+			}
+			fLeft[v % VOICE_DCA_PARTIALS] += p[v] * lanes.fGainL[v];
+			fRight[v % VOICE_DCA_PARTIALS] += p[v] * lanes.fGainR[v];
+		}
+		pLeft[n] += dcaReduce(fLeft);
+		pRight[n] += dcaReduce(fRight);
+	}
+}
+
+#if BATCH_MATH_X86
+//------------------------------------------------------------------------
+//	SSE2, 4 voices per step
+//------------------------------------------------------------------------
+#define VOICE_DCA_SSE2_GROUPS (VOICE_DCA_LANES / 4)
+
+//	partials 0-3 in l/r, 4-7 in l/r + 1 -> left + right
+BATCH_TARGET_SSE2 static inline void dcaReduceSSE2(const __m128* l, const __m128* r, float& fLeft, float& fRight) {
+	__m128 l4 = _mm_add_ps(l[0], l[1]);
+	__m128 r4 = _mm_add_ps(r[0], r[1]);
+
+	//	[l0+l2, l1+l3, r0+r2, r1+r3], then [left, -, right, -]
+	__m128 s = _mm_add_ps(_mm_movelh_ps(l4, r4), _mm_movehl_ps(r4, l4));
+	s = _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 3, 0, 1)));
+	fLeft += _mm_cvtss_f32(s);
+	fRight += _mm_cvtss_f32(_mm_movehl_ps(s, s));
+}
+
+BATCH_TARGET_SSE2 static void dcaSSE2(VoiceDCALanes& lanes, const float* pBlock, float* pLeft, float* pRight, int nSamples, bool bRamp, UINT uLaneMask) {
+	//	the groups in use
+	int nGroup[VOICE_DCA_SSE2_GROUPS];
+	int nGroups = 0;
+	for (int g = 0; g < VOICE_DCA_SSE2_GROUPS; g++) {
+		if (uLaneMask & (0xFu << (g * 4))) {
+			nGroup[nGroups++] = g;
+		}
+	}
+
+	__m128 gL[VOICE_DCA_SSE2_GROUPS], gR[VOICE_DCA_SSE2_GROUPS];
+	__m128 dL[VOICE_DCA_SSE2_GROUPS], dR[VOICE_DCA_SSE2_GROUPS];
+	for (int g = 0; g < VOICE_DCA_SSE2_GROUPS; g++) {
+		gL[g] = _mm_loadu_ps(&lanes.fGainL[g * 4]);
+		gR[g] = _mm_loadu_ps(&lanes.fGainR[g * 4]);
+		dL[g] = _mm_loadu_ps(&lanes.fDeltaL[g * 4]);
+		dR[g] = _mm_loadu_ps(&lanes.fDeltaR[g * 4]);
+	}
+
+	for (int n = 0; n < nSamples; n++) {
+		const float* p = pBlock + n * VOICE_DCA_LANES;
+
+		//	an even group holds partials 0-3, an odd one 4-7
+		__m128 l[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 r[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		for (int i = 0; i < nGroups; i++) {
+			int g = nGroup[i];
+			if (bRamp) {
+				gL[g] = _mm_add_ps(gL[g], dL[g]);
+				gR[g] = _mm_add_ps(gR[g], dR[g]);
+			}
+			__m128 x = _mm_loadu_ps(p + g * 4);
+			l[g & 1] = _mm_add_ps(l[g & 1], _mm_mul_ps(x, gL[g]));
+			r[g & 1] = _mm_add_ps(r[g & 1], _mm_mul_ps(x, gR[g]));
+		}
+		dcaReduceSSE2(l, r, pLeft[n], pRight[n]);
+	}
+
+	for (int g = 0; g < VOICE_DCA_SSE2_GROUPS; g++) {
+		_mm_storeu_ps(&lanes.fGainL[g * 4], gL[g]);
+		_mm_storeu_ps(&lanes.fGainR[g * 4], gR[g]);
+	}
+}
+
+//------------------------------------------------------------------------
+//	AVX2, 8 voices per step
+//------------------------------------------------------------------------
+#define VOICE_DCA_AVX2_GROUPS (VOICE_DCA_LANES / 8)
+
+BATCH_TARGET_AVX2 static void dcaAVX2(VoiceDCALanes& lanes, const float* pBlock, float* pLeft, float* pRight, int nSamples, bool bRamp, UINT uLaneMask) {
+	int nGroup[VOICE_DCA_AVX2_GROUPS];
+	int nGroups = 0;
+	for (int g = 0; g < VOICE_DCA_AVX2_GROUPS; g++) {
+		if (uLaneMask & (0xFFu << (g * 8))) {
+			nGroup[nGroups++] = g;
+		}
+	}
+
+	__m256 gL[VOICE_DCA_AVX2_GROUPS], gR[VOICE_DCA_AVX2_GROUPS];
+	__m256 dL[VOICE_DCA_AVX2_GROUPS], dR[VOICE_DCA_AVX2_GROUPS];
+	for (int g = 0; g < VOICE_DCA_AVX2_GROUPS; g++) {
+		gL[g] = _mm256_loadu_ps(&lanes.fGainL[g * 8]);
+		gR[g] = _mm256_loadu_ps(&lanes.fGainR[g * 8]);
+		dL[g] = _mm256_loadu_ps(&lanes.fDeltaL[g * 8]);
+		dR[g] = _mm256_loadu_ps(&lanes.fDeltaR[g * 8]);
+	}
+
+	for (int n = 0; n < nSamples; n++) {
+		const float* p = pBlock + n * VOICE_DCA_LANES;
+		__m256 l = _mm256_setzero_ps();
+		__m256 r = _mm256_setzero_ps();
+		for (int i = 0; i < nGroups; i++) {
+			int g = nGroup[i];
+			if (bRamp) {
+				gL[g] = _mm256_add_ps(gL[g], dL[g]);
+				gR[g] = _mm256_add_ps(gR[g], dR[g]);
+			}
+			__m256 x = _mm256_loadu_ps(p + g * 8);
+			l = _mm256_add_ps(l, _mm256_mul_ps(x, gL[g]));
+			r = _mm256_add_ps(r, _mm256_mul_ps(x, gR[g]));
+		}
+
+		//	the halves are the SSE2 path's two registers; same tree from here
+		__m128 lHalves[2] = { _mm256_castps256_ps128(l), _mm256_extractf128_ps(l, 1) };
+		__m128 rHalves[2] = { _mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1) };
+		dcaReduceSSE2(lHalves, rHalves, pLeft[n], pRight[n]);
+	}
+
+	for (int g = 0; g < VOICE_DCA_AVX2_GROUPS; g++) {
+		_mm256_storeu_ps(&lanes.fGainL[g * 8], gL[g]);
+		_mm256_storeu_ps(&lanes.fGainR[g * 8], gR[g]);
+	}
+}
+#endif // BATCH_MATH_X86
+
+#if defined _MSC_VER
+#pragma float_control(pop)
+#endif
+
+//------------------------------------------------------------------------
+//	dispatch; indexed by getBatchMathISA()
+//------------------------------------------------------------------------
+typedef void (*VoiceDCAKernel)(VoiceDCALanes&, const float*, float*, float*, int, bool, UINT);
+
+static const VoiceDCAKernel voiceDCAKernels[] = {
+	dcaScalar,
+#if BATCH_MATH_X86
+	dcaSSE2,
+	dcaAVX2,
+#endif
+};
+
+//------------------------------------------------------------------------
+//	VoiceDCA
+//------------------------------------------------------------------------
+VoiceDCA::VoiceDCA(void) {
+	m_dAmplitude_dB = DEFAULT_OUTPUT_AMPLITUDE_DB;
+	m_dPanControl = DEFAULT_BIPOLAR;
+	m_uMIDIVolumeCC7 = DEFAULT_MIDI_VOLUME;
+	m_uMIDIPanCC10 = DEFAULT_MIDI_PAN;
+	m_uMIDIExpressionCC11 = DEFAULT_MIDI_EXPRESSION;
+
+	memset(&m_Lanes, 0, sizeof(m_Lanes));
+	for (UINT i = 0; i < MAX_VOICES; i++) {
+		m_dVelocityGain[i] = 0.0;
+		m_dExpressionGain[i] = 1.0;
+		m_bStereo[i] = false;
+	}
+
+	update();
+}
+
+VoiceDCA::~VoiceDCA(void) {
+}
+
+/*
+	VoiceDCA::update()
+	gain = amplitude * CC7 * CC11 attenuation (MMA DLS curves), split by
+	the pan law over GUI pan + CC10
+*/
+void VoiceDCA::update() {
+	double dGain = pow(10.0, m_dAmplitude_dB / 20.0);
+	dGain *= mmaMIDItoAtten(m_uMIDIVolumeCC7);
+	dGain *= mmaMIDItoAtten(m_uMIDIExpressionCC11);
+
+	double dPan = m_dPanControl + midiToPanValue(m_uMIDIPanCC10);
+	dPan = fmin(fmax(dPan, -1.0), 1.0);
+
+	double dPanL = 0.0;
+	double dPanR = 0.0;
+	calculatePanValues(dPan, dPanL, dPanR);
+	m_dGainL = dGain * dPanL;
+	m_dGainR = dGain * dPanR;
+
+	for (UINT i = 0; i < MAX_VOICES; i++) {
+		setVoiceTarget(i);
+	}
+}
+
+void VoiceDCA::startVoice(UINT uVoice, UINT uVelocity) {
+	m_dVelocityGain[uVoice] = mmaMIDItoAtten(uVelocity);
+	m_dExpressionGain[uVoice] = 1.0;
+	setVoiceTarget(uVoice);
+}
+
+void VoiceDCA::setVoiceExpression(UINT uVoice, double dGain) {
+	m_dExpressionGain[uVoice] = dGain;
+	setVoiceTarget(uVoice);
+}
+
+void VoiceDCA::setVoiceStereo(UINT uVoice, bool bStereo) {
+	if (m_bStereo[uVoice] != bStereo) {
+		m_bStereo[uVoice] = bStereo;
+		setVoiceTarget(uVoice);
+	}
+}
+
+void VoiceDCA::setVoiceTarget(UINT uVoice) {
+	double dVoiceGain = m_dVelocityGain[uVoice] * m_dExpressionGain[uVoice];
+	float fGainL = (float)(m_dGainL * dVoiceGain);
+	float fGainR = (float)(m_dGainR * dVoiceGain);
+	UINT uRight = uVoice + VOICE_RIGHT_LANE_OFFSET;
+
+	m_Lanes.fTargetL[uVoice] = fGainL;
+	m_Lanes.fTargetR[uVoice] = m_bStereo[uVoice] ? 0.0f : fGainR;
+	m_Lanes.fTargetL[uRight] = 0.0f;
+	m_Lanes.fTargetR[uRight] = m_bStereo[uVoice] ? fGainR : 0.0f;
+	m_bRampPending = true;
+}
+
+void VoiceDCA::process(const float* pBlock, float* pLeft, float* pRight, int nSamples, UINT uLaneMask) {
+	if (nSamples <= 0) {
+		return;
+	}
+
+	bool bRamp = m_bRampPending;
+	if (bRamp) {
+		float fInvSamples = 1.0f / (float)nSamples;
+		for (int i = 0; i < VOICE_DCA_LANES; i++) {
+			m_Lanes.fDeltaL[i] = (m_Lanes.fTargetL[i] - m_Lanes.fGainL[i]) * fInvSamples;
+			m_Lanes.fDeltaR[i] = (m_Lanes.fTargetR[i] - m_Lanes.fGainR[i]) * fInvSamples;
+		}
+	}
+
+	voiceDCAKernels[getBatchMathISA()](m_Lanes, pBlock, pLeft, pRight, nSamples, bRamp, uLaneMask);
+
+	//	land exactly on the targets
+	if (bRamp) {
+		memcpy(m_Lanes.fGainL, m_Lanes.fTargetL, sizeof(m_Lanes.fGainL));
+		memcpy(m_Lanes.fGainR, m_Lanes.fTargetR, sizeof(m_Lanes.fGainR));
+		m_bRampPending = false;
+	}
+}
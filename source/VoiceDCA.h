@@ -0,0 +1,86 @@
+#pragma once
+#include "pluginconstants.h"
+#include "synthfunctions.h"
+#include "SynthParamLimits.h"
+
+//	the voice block's lanes, same layout as the VoiceFilterBank block
+#define VOICE_DCA_LANES VOICE_BLOCK_LANES
+
+//	per lane left/right gains, one float per lane (structure of arrays)
+struct VoiceDCALanes {
+	float fGainL[VOICE_DCA_LANES];		//	in use
+	float fGainR[VOICE_DCA_LANES];
+	float fTargetL[VOICE_DCA_LANES];	//	reached at the end of the next block
+	float fTargetR[VOICE_DCA_LANES];
+	float fDeltaL[VOICE_DCA_LANES];		//	per sample step towards the target
+	float fDeltaR[VOICE_DCA_LANES];
+};
+
+/*
+	VoiceDCA
+	The amplifier for every voice: output level (dB), pan, MIDI volume
+	(CC7), pan (CC10), expression (CC11), note velocity and per-note
+	pressure, folded into one left and one right gain per voice at
+	control rate.
+
+	A mono voice's lane is split by the pan law. A stereo voice (unison
+	spread) has been kept as two lanes, its own and one
+	VOICE_RIGHT_LANE_OFFSET on; the first goes to the left output only and
+	the second to the right, both at the gain the pan law gives that side.
+
+	process() mixes the voice block (interleaved by voice, as the
+	VoiceFilterBank leaves it) straight into the stereo output, each
+	sample one multiply-add per voice and side. A gain change is ramped
+	linearly over the next block, so volume, pan and controller moves do
+	not zipper. 4 (SSE2) or 8 (AVX2) lanes per SIMD step, picked through
+	getBatchMathISA(); lane groups with nothing in them are skipped. All
+	paths sum the voices in the same fixed order (VoiceDCA.cpp), so they
+	give bit-identical output.
+
+	No allocation or locks; process() runs on the audio thread.
+*/
+class VoiceDCA {
+public:
+	VoiceDCA(void);
+	~VoiceDCA(void);
+
+	//	user controls and MIDI; call update() after changing them
+	double m_dAmplitude_dB;
+	double m_dPanControl;			//	-1 -> +1
+	UINT m_uMIDIVolumeCC7;
+	UINT m_uMIDIPanCC10;
+	UINT m_uMIDIExpressionCC11;
+
+	//	new gains for all voices, ramped to over the next block
+	void update();
+
+	//	a voice's velocity; its gain ramps from where the lane was
+	void startVoice(UINT uVoice, UINT uVelocity);
+
+	//	a voice's note expression gain (pressure); ramped like the rest
+	void setVoiceExpression(UINT uVoice, double dGain);
+
+	//	a voice's right lane carries its right side; ramped like the rest
+	void setVoiceStereo(UINT uVoice, bool bStereo);
+
+	//	mix nSamples of pBlock[n * VOICE_DCA_LANES + lane] into (+=) pLeft/pRight;
+	//	lanes outside uLaneMask must be silent, and may be skipped
+	void process(const float* pBlock, float* pLeft, float* pRight, int nSamples, UINT uLaneMask = 0xFFFFFFFF);
+
+protected:
+	//	shared part of the gain, from update()
+	double m_dGainL;
+	double m_dGainR;
+
+	//	per voice velocity and note expression gains, and left/right split
+	double m_dVelocityGain[MAX_VOICES];
+	double m_dExpressionGain[MAX_VOICES];
+	bool m_bStereo[MAX_VOICES];
+
+	//	a target changed and has not been ramped to yet
+	bool m_bRampPending;
+
+	VoiceDCALanes m_Lanes;
+
+	void setVoiceTarget(UINT uVoice);
+};
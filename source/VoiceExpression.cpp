@@ -0,0 +1,215 @@
+#include "VoiceExpression.h"
+#include <math.h>
+
+//	below this a value has reached its target
+#define VOICE_EXPRESSION_SETTLED 1e-6
+
+VoiceExpression::VoiceExpression(void) {
+	m_bMPE = false;
+	m_dSmoothing = 1.0;
+	reset();
+}
+
+VoiceExpression::~VoiceExpression(void) {
+}
+
+double VoiceExpression::getNeutralValue(UINT uExpression) {
+	return uExpression == EXPRESSION_TIMBRE ? 0.5 : 0.0;
+}
+
+void VoiceExpression::setSampleRate(double dFs, int nBlockSize) {
+	m_dSmoothing = 1.0 - exp(-(double)nBlockSize / (VOICE_EXPRESSION_SMOOTHING_MSEC * 0.001 * dFs));
+}
+
+void VoiceExpression::reset() {
+	for (UINT e = 0; e < EXPRESSIONS; e++) {
+		for (UINT i = 0; i < VOICE_EXPRESSION_LANES; i++) {
+			m_dValue[e][i] = getNeutralValue(e);
+			m_dTarget[e][i] = getNeutralValue(e);
+		}
+		for (UINT c = 0; c < VOICE_EXPRESSION_CHANNELS; c++) {
+			m_dChannelValue[e][c] = getNeutralValue(e);
+		}
+	}
+	m_uMovingMask = 0;
+	m_uStartedMask = 0;
+
+	for (UINT s = 0; s < VOICE_EXPRESSION_SLOTS; s++) {
+		m_nSlotNoteId[s] = 0;
+		m_uSlotVoice[s] = VOICE_EXPRESSION_NO_VOICE;
+	}
+	for (UINT i = 0; i < VOICE_EXPRESSION_LANES; i++) {
+		m_bFiled[i] = false;
+		m_nNoteId[i] = 0;
+		m_uChannel[i] = 0;
+		m_uNoteNext[i] = VOICE_EXPRESSION_NO_VOICE;
+		m_uNotePrev[i] = VOICE_EXPRESSION_NO_VOICE;
+		m_uChannelNext[i] = VOICE_EXPRESSION_NO_VOICE;
+		m_uChannelPrev[i] = VOICE_EXPRESSION_NO_VOICE;
+	}
+	for (UINT c = 0; c < VOICE_EXPRESSION_CHANNELS; c++) {
+		m_uChannelFirst[c] = VOICE_EXPRESSION_NO_VOICE;
+	}
+}
+
+/*
+	VoiceExpression::removeSlot()
+	Linear probing delete: the entries after the hole move back into it
+	unless that would put them before their own home slot, so every
+	entry stays reachable from its home without tombstones.
+*/
+void VoiceExpression::removeSlot(UINT uSlot) {
+	const UINT uMask = VOICE_EXPRESSION_SLOTS - 1;
+	UINT uHole = uSlot;
+	UINT uNext = uSlot;
+	while (true) {
+		uNext = (uNext + 1) & uMask;
+		if (m_uSlotVoice[uNext] == VOICE_EXPRESSION_NO_VOICE) {
+			break;
+		}
+
+		//	its distance from home against the hole's
+		UINT uHome = hashNoteId(m_nSlotNoteId[uNext]);
+		if (((uNext - uHome) & uMask) >= ((uNext - uHole) & uMask)) {
+			m_nSlotNoteId[uHole] = m_nSlotNoteId[uNext];
+			m_uSlotVoice[uHole] = m_uSlotVoice[uNext];
+			uHole = uNext;
+		}
+	}
+	m_uSlotVoice[uHole] = VOICE_EXPRESSION_NO_VOICE;
+}
+
+//	out of its noteId's and its channel's lists
+void VoiceExpression::unfileVoice(UINT uVoice) {
+	if (!m_bFiled[uVoice]) {
+		return;
+	}
+	m_bFiled[uVoice] = false;
+
+	UINT uNext = m_uNoteNext[uVoice];
+	UINT uPrev = m_uNotePrev[uVoice];
+	if (uNext != VOICE_EXPRESSION_NO_VOICE) {
+		m_uNotePrev[uNext] = uPrev;
+	}
+	if (uPrev != VOICE_EXPRESSION_NO_VOICE) {
+		m_uNoteNext[uPrev] = uNext;
+	} else {
+		//	the first of its noteId; the slot moves on or goes
+		UINT uSlot = findSlot(m_nNoteId[uVoice]);
+		if (uNext != VOICE_EXPRESSION_NO_VOICE) {
+			m_uSlotVoice[uSlot] = uNext;
+		} else {
+			removeSlot(uSlot);
+		}
+	}
+
+	uNext = m_uChannelNext[uVoice];
+	uPrev = m_uChannelPrev[uVoice];
+	if (uNext != VOICE_EXPRESSION_NO_VOICE) {
+		m_uChannelPrev[uNext] = uPrev;
+	}
+	if (uPrev != VOICE_EXPRESSION_NO_VOICE) {
+		m_uChannelNext[uPrev] = uNext;
+	} else {
+		m_uChannelFirst[m_uChannel[uVoice]] = uNext;
+	}
+}
+
+void VoiceExpression::startVoice(UINT uVoice, int nNoteId, UINT uChannel) {
+	if (uVoice >= VOICE_EXPRESSION_LANES) {
+		return;
+	}
+	uChannel &= VOICE_EXPRESSION_CHANNELS - 1;
+	unfileVoice(uVoice);
+
+	//	first in its noteId's list
+	UINT uSlot = findSlot(nNoteId);
+	UINT uNext = m_uSlotVoice[uSlot];
+	m_nSlotNoteId[uSlot] = nNoteId;
+	m_uSlotVoice[uSlot] = uVoice;
+	m_uNoteNext[uVoice] = uNext;
+	m_uNotePrev[uVoice] = VOICE_EXPRESSION_NO_VOICE;
+	if (uNext != VOICE_EXPRESSION_NO_VOICE) {
+		m_uNotePrev[uNext] = uVoice;
+	}
+
+	//	and in its channel's
+	uNext = m_uChannelFirst[uChannel];
+	m_uChannelFirst[uChannel] = uVoice;
+	m_uChannelNext[uVoice] = uNext;
+	m_uChannelPrev[uVoice] = VOICE_EXPRESSION_NO_VOICE;
+	if (uNext != VOICE_EXPRESSION_NO_VOICE) {
+		m_uChannelPrev[uNext] = uVoice;
+	}
+
+	m_bFiled[uVoice] = true;
+	m_nNoteId[uVoice] = nNoteId;
+	m_uChannel[uVoice] = uChannel;
+
+	//	a new note starts at its values, not gliding from the last one's
+	for (UINT e = 0; e < EXPRESSIONS; e++) {
+		double dValue = m_bMPE ? m_dChannelValue[e][uChannel] : getNeutralValue(e);
+		m_dTarget[e][uVoice] = dValue;
+		m_dValue[e][uVoice] = dValue;
+	}
+	m_uMovingMask &= ~(1u << uVoice);
+	m_uStartedMask |= 1u << uVoice;
+}
+
+void VoiceExpression::setVoiceTarget(UINT uVoice, UINT uExpression, double dValue) {
+	m_dTarget[uExpression][uVoice] = dValue;
+	m_uMovingMask |= 1u << uVoice;
+}
+
+void VoiceExpression::setNoteValue(int nNoteId, UINT uExpression, double dValue) {
+	if (uExpression >= EXPRESSIONS) {
+		return;
+	}
+
+	UINT uSlot = findSlot(nNoteId);
+	for (UINT i = m_uSlotVoice[uSlot]; i != VOICE_EXPRESSION_NO_VOICE; i = m_uNoteNext[i]) {
+		setVoiceTarget(i, uExpression, dValue);
+	}
+}
+
+void VoiceExpression::setChannelValue(UINT uChannel, UINT uExpression, double dValue) {
+	if (uExpression >= EXPRESSIONS) {
+		return;
+	}
+	uChannel &= VOICE_EXPRESSION_CHANNELS - 1;
+	m_dChannelValue[uExpression][uChannel] = dValue;
+	if (!m_bMPE) {
+		return;
+	}
+
+	for (UINT i = m_uChannelFirst[uChannel]; i != VOICE_EXPRESSION_NO_VOICE; i = m_uChannelNext[i]) {
+		setVoiceTarget(i, uExpression, dValue);
+	}
+}
+
+UINT VoiceExpression::update() {
+	UINT uMoved = m_uStartedMask | m_uMovingMask;
+	m_uStartedMask = 0;
+
+	for (UINT i = 0; i < VOICE_EXPRESSION_LANES; i++) {
+		if (!(m_uMovingMask & (1u << i))) {
+			continue;
+		}
+
+		bool bSettled = true;
+		for (UINT e = 0; e < EXPRESSIONS; e++) {
+			double dError = m_dTarget[e][i] - m_dValue[e][i];
+			if (fabs(dError) < VOICE_EXPRESSION_SETTLED) {
+				m_dValue[e][i] = m_dTarget[e][i];
+			} else {
+				m_dValue[e][i] += m_dSmoothing * dError;
+				bSettled = false;
+			}
+		}
+		if (bSettled) {
+			m_uMovingMask &= ~(1u << i);
+		}
+	}
+
+	return uMoved;
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include "pluginconstants.h"
+#include "synthfunctions.h"
+#include "SynthParamLimits.h"
+
+//	one lane per voice, same layout as the VoiceDCA and VoiceFilterBank
+#define VOICE_EXPRESSION_LANES MAX_VOICES
+
+//	no voice; ends a voice list
+#define VOICE_EXPRESSION_NO_VOICE VOICE_EXPRESSION_LANES
+
+//	noteId hash table; a power of 2, and at most a quarter full so a
+//	lookup is one or two probes
+#define VOICE_EXPRESSION_SLOT_BITS 6
+#define VOICE_EXPRESSION_SLOTS (1 << VOICE_EXPRESSION_SLOT_BITS)
+
+//	MIDI channels; MPE member channels are 1 -> 15 (2 -> 16 on the wire)
+#define VOICE_EXPRESSION_CHANNELS 16
+
+//	block rate smoothing time constant
+#define VOICE_EXPRESSION_SMOOTHING_MSEC 5.0
+
+//	VST3 tuning expression: 0 -> 1 is -120 -> +120 semitones
+#define VOICE_EXPRESSION_TUNING_RANGE 120.0
+
+//	MPE member channel pitch bend range, semitones (the MPE default)
+#define VOICE_EXPRESSION_MPE_BEND_RANGE 48.0
+
+//	full pressure raises the voice by this much
+#define VOICE_EXPRESSION_PRESSURE_DB 6.0
+
+//	timbre 0 -> 1 moves the filter Fc this far down/up (0.5 leaves it)
+#define VOICE_EXPRESSION_TIMBRE_OCTAVES 2.0
+
+//	the note expression dimensions
+enum {
+	EXPRESSION_PITCH,		//	semitones
+	EXPRESSION_PRESSURE,	//	0 -> 1
+	EXPRESSION_TIMBRE,		//	0 -> 1, 0.5 = none
+	EXPRESSIONS
+};
+
+/*
+	VoiceExpression
+	Per-note pitch, pressure and timbre for every voice, from VST3 note
+	expression, polyphonic pressure or MPE member channels.
+
+	A note expression event names its note by noteId. startVoice() files
+	the voice under its noteId in a small open addressed hash table, and
+	the voices of one noteId (the layers of a keymap note) are linked
+	from there, so an event finds its voices without looking at any
+	others. MPE member channel events find the voices on the channel
+	the same way, from a list per channel. With MPE on, a new voice
+	starts from its channel's last values, since an MPE controller sends
+	them just before the note-on.
+
+	Events set a target per voice; the latest one wins, whichever route
+	it came in on. update() moves each voice's value a block's worth of
+	one-pole smoothing toward its target and reports the voices that
+	moved, for the Processor to pass on to the oscillators (pitch), the
+	VoiceDCA (pressure) and the VoiceFilterBank (timbre).
+
+	A voice stays filed under its noteId until it starts another note,
+	so an event for a note whose voice has gone quiet is harmless.
+
+	No allocation or locks; everything runs on the audio thread.
+*/
+class VoiceExpression {
+public:
+	VoiceExpression(void);
+	~VoiceExpression(void);
+
+	//	MPE member channels drive their voices; set by the Processor
+	bool m_bMPE;
+
+	//	update() runs once per block of nBlockSize samples
+	void setSampleRate(double dFs, int nBlockSize);
+
+	//	every voice back to no expression and out of the tables
+	void reset();
+
+	//	a note-on; the voice leaves whatever note it had
+	void startVoice(UINT uVoice, int nNoteId, UINT uChannel);
+
+	//	an EXPRESSION_ value for the voices of a noteId
+	void setNoteValue(int nNoteId, UINT uExpression, double dValue);
+
+	//	an EXPRESSION_ value for an MPE member channel and its voices
+	void setChannelValue(UINT uChannel, UINT uExpression, double dValue);
+
+	//	one block of smoothing; returns the mask of voices whose values moved
+	UINT update();
+
+	inline double getValue(UINT uVoice, UINT uExpression) {
+		return m_dValue[uExpression][uVoice];
+	}
+
+protected:
+	//	smoothing coefficient per block
+	double m_dSmoothing;
+
+	double m_dValue[EXPRESSIONS][VOICE_EXPRESSION_LANES];
+	double m_dTarget[EXPRESSIONS][VOICE_EXPRESSION_LANES];
+
+	//	voices whose value is not at its target
+	UINT m_uMovingMask;
+
+	//	voices started since the last update()
+	UINT m_uStartedMask;
+
+	//	each MPE member channel's last values
+	double m_dChannelValue[EXPRESSIONS][VOICE_EXPRESSION_CHANNELS];
+
+	//	noteId -> first voice; VOICE_EXPRESSION_NO_VOICE marks an empty slot
+	int m_nSlotNoteId[VOICE_EXPRESSION_SLOTS];
+	UINT m_uSlotVoice[VOICE_EXPRESSION_SLOTS];
+
+	//	per voice: its noteId and channel, and the next/previous voice on each
+	bool m_bFiled[VOICE_EXPRESSION_LANES];
+	int m_nNoteId[VOICE_EXPRESSION_LANES];
+	UINT m_uChannel[VOICE_EXPRESSION_LANES];
+	UINT m_uNoteNext[VOICE_EXPRESSION_LANES];
+	UINT m_uNotePrev[VOICE_EXPRESSION_LANES];
+	UINT m_uChannelNext[VOICE_EXPRESSION_LANES];
+	UINT m_uChannelPrev[VOICE_EXPRESSION_LANES];
+
+	//	channel -> first voice
+	UINT m_uChannelFirst[VOICE_EXPRESSION_CHANNELS];
+
+	//	the slot holding nNoteId, or the empty one it would go in
+	inline UINT findSlot(int nNoteId) {
+		UINT uSlot = hashNoteId(nNoteId);
+		while (m_uSlotVoice[uSlot] != VOICE_EXPRESSION_NO_VOICE && m_nSlotNoteId[uSlot] != nNoteId) {
+			uSlot = (uSlot + 1) & (VOICE_EXPRESSION_SLOTS - 1);
+		}
+		return uSlot;
+	}
+
+	static inline UINT hashNoteId(int nNoteId) {
+		return ((unsigned int)nNoteId * 2654435761u) >> (32 - VOICE_EXPRESSION_SLOT_BITS);
+	}
+
+	void removeSlot(UINT uSlot);
+	void unfileVoice(UINT uVoice);
+	void setVoiceTarget(UINT uVoice, UINT uExpression, double dValue);
+
+	//	no expression: no bend or pressure, timbre in the middle
+	static double getNeutralValue(UINT uExpression);
+};
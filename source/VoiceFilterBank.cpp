@@ -0,0 +1,473 @@
+#include "VoiceFilterBank.h"
+#include "BatchMath.h"
+#include <string.h>
+
+//	the project builds with /fp:fast; the kernels must not be contracted
+//	or reassociated, or the paths stop matching
+#if defined _MSC_VER
+#pragma float_control(precise, on, push)
+#endif
+
+//	NLP: tanh(x) as a (3,2) Pade approximant, exact at the +/-3 clamp;
+//	within 2.5% of tanh, no exp() and no branches
+#define VOICE_FILTER_CLIP_LIMIT 3.0f
+
+//------------------------------------------------------------------------
+//	scalar reference, one lane per call
+//------------------------------------------------------------------------
+static inline float softClipRef(float x) {
+	x = x > -VOICE_FILTER_CLIP_LIMIT ? x : -VOICE_FILTER_CLIP_LIMIT;
+	x = x < VOICE_FILTER_CLIP_LIMIT ? x : VOICE_FILTER_CLIP_LIMIT;
+	float x2 = x * x;
+	return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+}
+
+/*
+	ZDF SVF (Zavalishin/Simper)
+		hp = (x - (2R + g)s1 - s2) / (1 + 2Rg + g^2)
+		bp = g hp + s1, lp = g bp + s2
+	each integrator's state moves on by 2 v
+*/
+static void svfScalar(VoiceFilterLanes& lanes, const VoiceFilterMix& mix, float* pBlock, int nLane, int nSamples) {
+	float s1 = lanes.fState[0][nLane];
+	float s2 = lanes.fState[1][nLane];
+	float g = lanes.fG[nLane];
+	float a = lanes.fA[nLane];
+	float d = lanes.fD[nLane];
+	bool bNLP = mix.fSaturation > 0.0f;
+	float fInvSaturation = bNLP ? 1.0f / mix.fSaturation : 0.0f;
+
+	for (int n = 0; n < nSamples; n++) {
+		float* p = pBlock + n * VOICE_FILTER_LANES + nLane;
+		float hp = (*p - a * s1 - s2) * d;
+		float v1 = g * hp;
+		float bp = v1 + s1;
+		if (bNLP) {
+			bp = softClipRef(bp * mix.fSaturation) * fInvSaturation;
+		}
+		s1 = bp + v1;
+		float v2 = g * bp;
+		float lp = v2 + s2;
+		s2 = lp + v2;
+		*p = mix.fLP * lp + mix.fBP * bp + mix.fHP * hp;
+	}
+
+	lanes.fState[0][nLane] = s1;
+	lanes.fState[1][nLane] = s2;
+}
+
+/*
+	ZDF ladder: 4 TPT one-poles in a loop, solved for the loop input
+		u = (x - k sigma) / (1 + kG^4)
+	sigma = G^3 S1 + G^2 S2 + G S3 + S4 with S = s/(1 + g) = s(1 - G)
+*/
+static void ladderScalar(VoiceFilterLanes& lanes, const VoiceFilterMix& mix, float* pBlock, int nLane, int nSamples) {
+	float s1 = lanes.fState[0][nLane];
+	float s2 = lanes.fState[1][nLane];
+	float s3 = lanes.fState[2][nLane];
+	float s4 = lanes.fState[3][nLane];
+	float G = lanes.fG[nLane];
+	float G2 = G * G;
+	float G3 = G2 * G;
+	float fOneMinusG = 1.0f - G;
+	float a = lanes.fA[nLane];
+	bool bNLP = mix.fSaturation > 0.0f;
+	float fInvSaturation = bNLP ? 1.0f / mix.fSaturation : 0.0f;
+
+	for (int n = 0; n < nSamples; n++) {
+		float* p = pBlock + n * VOICE_FILTER_LANES + nLane;
+		float sigma = (G3 * s1 + G2 * s2 + G * s3 + s4) * fOneMinusG;
+		float u = (*p - mix.fK * sigma) * a;
+		if (bNLP) {
+			u = softClipRef(u * mix.fSaturation) * fInvSaturation;
+		}
+
+		float v = (u - s1) * G;
+		float y1 = v + s1;
+		s1 = y1 + v;
+		v = (y1 - s2) * G;
+		float y2 = v + s2;
+		s2 = y2 + v;
+		v = (y2 - s3) * G;
+		float y3 = v + s3;
+		s3 = y3 + v;
+		v = (y3 - s4) * G;
+		float y4 = v + s4;
+		s4 = y4 + v;
+
+		*p = mix.fLP2 * y2 + mix.fLP4 * y4;
+	}
+
+	lanes.fState[0][nLane] = s1;
+	lanes.fState[1][nLane] = s2;
+	lanes.fState[2][nLane] = s3;
+	lanes.fState[3][nLane] = s4;
+}
+
+#if BATCH_MATH_X86
+//------------------------------------------------------------------------
+//	SSE2, 4 voices per pass
+//------------------------------------------------------------------------
+BATCH_TARGET_SSE2 static inline __m128 softClipSSE2(__m128 x) {
+	x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-VOICE_FILTER_CLIP_LIMIT)), _mm_set1_ps(VOICE_FILTER_CLIP_LIMIT));
+	__m128 x2 = _mm_mul_ps(x, x);
+	return _mm_div_ps(_mm_mul_ps(x, _mm_add_ps(_mm_set1_ps(27.0f), x2)),
+		_mm_add_ps(_mm_set1_ps(27.0f), _mm_mul_ps(_mm_set1_ps(9.0f), x2)));
+}
+
+BATCH_TARGET_SSE2 static void svfSSE2(VoiceFilterLanes& lanes, const VoiceFilterMix& mix, float* pBlock, int nLane, int nSamples) {
+	__m128 s1 = _mm_loadu_ps(&lanes.fState[0][nLane]);
+	__m128 s2 = _mm_loadu_ps(&lanes.fState[1][nLane]);
+	const __m128 g = _mm_loadu_ps(&lanes.fG[nLane]);
+	const __m128 a = _mm_loadu_ps(&lanes.fA[nLane]);
+	const __m128 d = _mm_loadu_ps(&lanes.fD[nLane]);
+	const __m128 vLP = _mm_set1_ps(mix.fLP);
+	const __m128 vBP = _mm_set1_ps(mix.fBP);
+	const __m128 vHP = _mm_set1_ps(mix.fHP);
+	bool bNLP = mix.fSaturation > 0.0f;
+	const __m128 vSaturation = _mm_set1_ps(mix.fSaturation);
+	const __m128 vInvSaturation = _mm_set1_ps(bNLP ? 1.0f / mix.fSaturation : 0.0f);
+
+	for (int n = 0; n < nSamples; n++) {
+		float* p = pBlock + n * VOICE_FILTER_LANES + nLane;
+		__m128 hp = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(p), _mm_mul_ps(a, s1)), s2), d);
+		__m128 v1 = _mm_mul_ps(g, hp);
+		__m128 bp = _mm_add_ps(v1, s1);
+		if (bNLP) {
+			bp = _mm_mul_ps(softClipSSE2(_mm_mul_ps(bp, vSaturation)), vInvSaturation);
+		}
+		s1 = _mm_add_ps(bp, v1);
+		__m128 v2 = _mm_mul_ps(g, bp);
+		__m128 lp = _mm_add_ps(v2, s2);
+		s2 = _mm_add_ps(lp, v2);
+		_mm_storeu_ps(p, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vLP, lp), _mm_mul_ps(vBP, bp)), _mm_mul_ps(vHP, hp)));
+	}
+
+	_mm_storeu_ps(&lanes.fState[0][nLane], s1);
+	_mm_storeu_ps(&lanes.fState[1][nLane], s2);
+}
+
+//	one TPT one-pole; returns y, moves s on
+BATCH_TARGET_SSE2 static inline __m128 onePoleSSE2(__m128 x, __m128& s, __m128 G) {
+	__m128 v = _mm_mul_ps(_mm_sub_ps(x, s), G);
+	__m128 y = _mm_add_ps(v, s);
+	s = _mm_add_ps(y, v);
+	return y;
+}
+
+BATCH_TARGET_SSE2 static void ladderSSE2(VoiceFilterLanes& lanes, const VoiceFilterMix& mix, float* pBlock, int nLane, int nSamples) {
+	__m128 s1 = _mm_loadu_ps(&lanes.fState[0][nLane]);
+	__m128 s2 = _mm_loadu_ps(&lanes.fState[1][nLane]);
+	__m128 s3 = _mm_loadu_ps(&lanes.fState[2][nLane]);
+	__m128 s4 = _mm_loadu_ps(&lanes.fState[3][nLane]);
+	const __m128 G = _mm_loadu_ps(&lanes.fG[nLane]);
+	const __m128 G2 = _mm_mul_ps(G, G);
+	const __m128 G3 = _mm_mul_ps(G2, G);
+	const __m128 vOneMinusG = _mm_sub_ps(_mm_set1_ps(1.0f), G);
+	const __m128 a = _mm_loadu_ps(&lanes.fA[nLane]);
+	const __m128 k = _mm_set1_ps(mix.fK);
+	const __m128 vLP2 = _mm_set1_ps(mix.fLP2);
+	const __m128 vLP4 = _mm_set1_ps(mix.fLP4);
+	bool bNLP = mix.fSaturation > 0.0f;
+	const __m128 vSaturation = _mm_set1_ps(mix.fSaturation);
+	const __m128 vInvSaturation = _mm_set1_ps(bNLP ? 1.0f / mix.fSaturation : 0.0f);
+
+	for (int n = 0; n < nSamples; n++) {
+		float* p = pBlock + n * VOICE_FILTER_LANES + nLane;
+		__m128 sigma = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(G3, s1), _mm_mul_ps(G2, s2)), _mm_mul_ps(G, s3)), s4);
+		sigma = _mm_mul_ps(sigma, vOneMinusG);
+		__m128 u = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p), _mm_mul_ps(k, sigma)), a);
+		if (bNLP) {
+			u = _mm_mul_ps(softClipSSE2(_mm_mul_ps(u, vSaturation)), vInvSaturation);
+		}
+
+		__m128 y1 = onePoleSSE2(u, s1, G);
+		__m128 y2 = onePoleSSE2(y1, s2, G);
+		__m128 y3 = onePoleSSE2(y2, s3, G);
+		__m128 y4 = onePoleSSE2(y3, s4, G);
+		_mm_storeu_ps(p, _mm_add_ps(_mm_mul_ps(vLP2, y2), _mm_mul_ps(vLP4, y4)));
+	}
+
+	_mm_storeu_ps(&lanes.fState[0][nLane], s1);
+	_mm_storeu_ps(&lanes.fState[1][nLane], s2);
+	_mm_storeu_ps(&lanes.fState[2][nLane], s3);
+	_mm_storeu_ps(&lanes.fState[3][nLane], s4);
+}
+
+//------------------------------------------------------------------------
+//	AVX2, 8 voices per pass
+//------------------------------------------------------------------------
+BATCH_TARGET_AVX2 static inline __m256 softClipAVX2(__m256 x) {
+	x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-VOICE_FILTER_CLIP_LIMIT)), _mm256_set1_ps(VOICE_FILTER_CLIP_LIMIT));
+	__m256 x2 = _mm256_mul_ps(x, x);
+	return _mm256_div_ps(_mm256_mul_ps(x, _mm256_add_ps(_mm256_set1_ps(27.0f), x2)),
+		_mm256_add_ps(_mm256_set1_ps(27.0f), _mm256_mul_ps(_mm256_set1_ps(9.0f), x2)));
+}
+
+BATCH_TARGET_AVX2 static void svfAVX2(VoiceFilterLanes& lanes, const VoiceFilterMix& mix, float* pBlock, int nLane, int nSamples) {
+	__m256 s1 = _mm256_loadu_ps(&lanes.fState[0][nLane]);
+	__m256 s2 = _mm256_loadu_ps(&lanes.fState[1][nLane]);
+	const __m256 g = _mm256_loadu_ps(&lanes.fG[nLane]);
+	const __m256 a = _mm256_loadu_ps(&lanes.fA[nLane]);
+	const __m256 d = _mm256_loadu_ps(&lanes.fD[nLane]);
+	const __m256 vLP = _mm256_set1_ps(mix.fLP);
+	const __m256 vBP = _mm256_set1_ps(mix.fBP);
+	const __m256 vHP = _mm256_set1_ps(mix.fHP);
+	bool bNLP = mix.fSaturation > 0.0f;
+	const __m256 vSaturation = _mm256_set1_ps(mix.fSaturation);
+	const __m256 vInvSaturation = _mm256_set1_ps(bNLP ? 1.0f / mix.fSaturation : 0.0f);
+
+	for (int n = 0; n < nSamples; n++) {
+		float* p = pBlock + n * VOICE_FILTER_LANES + nLane;
+		__m256 hp = _mm256_mul_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_loadu_ps(p), _mm256_mul_ps(a, s1)), s2), d);
+		__m256 v1 = _mm256_mul_ps(g, hp);
+		__m256 bp = _mm256_add_ps(v1, s1);
+		if (bNLP) {
+			bp = _mm256_mul_ps(softClipAVX2(_mm256_mul_ps(bp, vSaturation)), vInvSaturation);
+		}
+		s1 = _mm256_add_ps(bp, v1);
+		__m256 v2 = _mm256_mul_ps(g, bp);
+		__m256 lp = _mm256_add_ps(v2, s2);
+		s2 = _mm256_add_ps(lp, v2);
+		_mm256_storeu_ps(p, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vLP, lp), _mm256_mul_ps(vBP, bp)), _mm256_mul_ps(vHP, hp)));
+	}
+
+	_mm256_storeu_ps(&lanes.fState[0][nLane], s1);
+	_mm256_storeu_ps(&lanes.fState[1][nLane], s2);
+}
+
+BATCH_TARGET_AVX2 static inline __m256 onePoleAVX2(__m256 x, __m256& s, __m256 G) {
+	__m256 v = _mm256_mul_ps(_mm256_sub_ps(x, s), G);
+	__m256 y = _mm256_add_ps(v, s);
+	s = _mm256_add_ps(y, v);
+	return y;
+}
+
+BATCH_TARGET_AVX2 static void ladderAVX2(VoiceFilterLanes& lanes, const VoiceFilterMix& mix, float* pBlock, int nLane, int nSamples) {
+	__m256 s1 = _mm256_loadu_ps(&lanes.fState[0][nLane]);
+	__m256 s2 = _mm256_loadu_ps(&lanes.fState[1][nLane]);
+	__m256 s3 = _mm256_loadu_ps(&lanes.fState[2][nLane]);
+	__m256 s4 = _mm256_loadu_ps(&lanes.fState[3][nLane]);
+	const __m256 G = _mm256_loadu_ps(&lanes.fG[nLane]);
+	const __m256 G2 = _mm256_mul_ps(G, G);
+	const __m256 G3 = _mm256_mul_ps(G2, G);
+	const __m256 vOneMinusG = _mm256_sub_ps(_mm256_set1_ps(1.0f), G);
+	const __m256 a = _mm256_loadu_ps(&lanes.fA[nLane]);
+	const __m256 k = _mm256_set1_ps(mix.fK);
+	const __m256 vLP2 = _mm256_set1_ps(mix.fLP2);
+	const __m256 vLP4 = _mm256_set1_ps(mix.fLP4);
+	bool bNLP = mix.fSaturation > 0.0f;
+	const __m256 vSaturation = _mm256_set1_ps(mix.fSaturation);
+	const __m256 vInvSaturation = _mm256_set1_ps(bNLP ? 1.0f / mix.fSaturation : 0.0f);
+
+	for (int n = 0; n < nSamples; n++) {
+		float* p = pBlock + n * VOICE_FILTER_LANES + nLane;
+		__m256 sigma = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(G3, s1), _mm256_mul_ps(G2, s2)), _mm256_mul_ps(G, s3)), s4);
+		sigma = _mm256_mul_ps(sigma, vOneMinusG);
+		__m256 u = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(p), _mm256_mul_ps(k, sigma)), a);
+		if (bNLP) {
+			u = _mm256_mul_ps(softClipAVX2(_mm256_mul_ps(u, vSaturation)), vInvSaturation);
+		}
+
+		__m256 y1 = onePoleAVX2(u, s1, G);
+		__m256 y2 = onePoleAVX2(y1, s2, G);
+		__m256 y3 = onePoleAVX2(y2, s3, G);
+		__m256 y4 = onePoleAVX2(y3, s4, G);
+		_mm256_storeu_ps(p, _mm256_add_ps(_mm256_mul_ps(vLP2, y2), _mm256_mul_ps(vLP4, y4)));
+	}
+
+	_mm256_storeu_ps(&lanes.fState[0][nLane], s1);
+	_mm256_storeu_ps(&lanes.fState[1][nLane], s2);
+	_mm256_storeu_ps(&lanes.fState[2][nLane], s3);
+	_mm256_storeu_ps(&lanes.fState[3][nLane], s4);
+}
+#endif // BATCH_MATH_X86
+
+#if defined _MSC_VER
+#pragma float_control(pop)
+#endif
+
+//------------------------------------------------------------------------
+//	dispatch; indexed by getBatchMathISA()
+//------------------------------------------------------------------------
+typedef void (*VoiceFilterKernel)(VoiceFilterLanes&, const VoiceFilterMix&, float*, int, int);
+
+struct VoiceFilterKernels {
+	int nLanes;		//	voices per call
+	VoiceFilterKernel svf;
+	VoiceFilterKernel ladder;
+};
+
+static const VoiceFilterKernels voiceFilterKernels[] = {
+	{ 1, svfScalar, ladderScalar },
+#if BATCH_MATH_X86
+	{ 4, svfSSE2, ladderSSE2 },
+	{ 8, svfAVX2, ladderAVX2 },
+#endif
+};
+
+//------------------------------------------------------------------------
+//	VoiceFilterBank
+//------------------------------------------------------------------------
+VoiceFilterBank::VoiceFilterBank(void) {
+	m_dSampleRate = 44100.0;
+	m_dFcControl = DEFAULT_FILTER_FC;
+	m_dQControl = DEFAULT_FILTER_Q;
+	m_uFilterType = DEFAULT_FILTER_TYPE;
+	m_uNLP = DEFAULT_ONOFF_SWITCH;
+	m_dSaturation = DEFAULT_FILTER_SATURATION;
+	m_uKeyTrack = DEFAULT_FILTER_KEYTRACK;
+	m_dKeyTrackIntensity = DEFAULT_FILTER_KEYTRACK_INTENSITY;
+
+	memset(&m_Lanes, 0, sizeof(m_Lanes));
+	memset(&m_Mix, 0, sizeof(m_Mix));
+	for (UINT i = 0; i < VOICE_FILTER_LANES; i++) {
+		m_dNoteFrequency[i] = VOICE_FILTER_KEYTRACK_FREQUENCY;
+		m_dFcMod[i] = 0.0;
+	}
+
+	update();
+	updateCoefficients(m_uDirtyMask);
+	m_uDirtyMask = 0;
+}
+
+VoiceFilterBank::~VoiceFilterBank(void) {
+}
+
+void VoiceFilterBank::setSampleRate(double dFs) {
+	m_dSampleRate = dFs;
+	memset(&m_Lanes.fState, 0, sizeof(m_Lanes.fState));
+	update();
+}
+
+/*
+	VoiceFilterBank::update()
+	The parts of the coefficients every voice shares; the per voice
+	parts are rebuilt on the next process().
+*/
+void VoiceFilterBank::update() {
+	double dQ = (m_dQControl - MIN_FILTER_Q) / (MAX_FILTER_Q - MIN_FILTER_Q);
+	m_dSVFDamping = 1.0 / (VOICE_FILTER_SVF_MIN_Q + dQ * (VOICE_FILTER_SVF_MAX_Q - VOICE_FILTER_SVF_MIN_Q));
+	m_dLadderK = VOICE_FILTER_LADDER_MAX_K * dQ;
+
+	//	the two structures keep different things in the state
+	bool bWasLadder = m_Mix.fLP2 != 0.0f || m_Mix.fLP4 != 0.0f;
+	bool bLadder = m_uFilterType == LADDER_LPF2 || m_uFilterType == LADDER_LPF4;
+	if (bWasLadder != bLadder) {
+		memset(&m_Lanes.fState, 0, sizeof(m_Lanes.fState));
+	}
+
+	memset(&m_Mix, 0, sizeof(m_Mix));
+	switch (m_uFilterType) {
+		case SVF_LPF:
+			m_Mix.fLP = 1.0f;
+			break;
+		case SVF_HPF:
+			m_Mix.fHP = 1.0f;
+			break;
+		case SVF_BPF:
+			//	unity gain at Fc
+			m_Mix.fBP = (float)m_dSVFDamping;
+			break;
+		case SVF_BSF:
+			//	x - 2R bp
+			m_Mix.fLP = 1.0f;
+			m_Mix.fHP = 1.0f;
+			break;
+		case LADDER_LPF2:
+			m_Mix.fLP2 = 1.0f;
+			break;
+		case LADDER_LPF4:
+		default:
+			m_Mix.fLP4 = 1.0f;
+			break;
+	}
+	m_Mix.fK = (float)m_dLadderK;
+	m_Mix.fSaturation = m_uNLP ? (float)m_dSaturation : 0.0f;
+
+	m_uDirtyMask = ~0u >> (32 - VOICE_FILTER_LANES);
+}
+
+void VoiceFilterBank::startVoice(UINT uVoice, double dNoteFrequency, bool bIdle) {
+	UINT uRight = uVoice + VOICE_RIGHT_LANE_OFFSET;
+	if (bIdle) {
+		flushLane(uVoice);
+		flushLane(uRight);
+	}
+	m_dNoteFrequency[uVoice] = m_dNoteFrequency[uRight] = dNoteFrequency;
+	m_dFcMod[uVoice] = m_dFcMod[uRight] = 0.0;
+	m_uDirtyMask |= (1u << uVoice) | (1u << uRight);
+}
+
+void VoiceFilterBank::flushLane(UINT uLane) {
+	for (int i = 0; i < 4; i++) {
+		m_Lanes.fState[i][uLane] = 0.0f;
+	}
+}
+
+void VoiceFilterBank::setVoiceFcMod(UINT uVoice, double dOctaves) {
+	UINT uRight = uVoice + VOICE_RIGHT_LANE_OFFSET;
+	m_dFcMod[uVoice] = m_dFcMod[uRight] = dOctaves;
+	m_uDirtyMask |= (1u << uVoice) | (1u << uRight);
+}
+
+//	Fc with keytracking and note expression, bounded, then the lane's coefficients
+void VoiceFilterBank::updateCoefficients(UINT uVoiceMask) {
+	bool bLadder = m_uFilterType == LADDER_LPF2 || m_uFilterType == LADDER_LPF4;
+	double dMaxFc = fmin(MAX_FILTER_FC, VOICE_FILTER_MAX_FC_RATIO * m_dSampleRate);
+
+	for (UINT i = 0; i < VOICE_FILTER_LANES; i++) {
+		if (!(uVoiceMask & (1u << i))) {
+			continue;
+		}
+
+		double dFc = m_dFcControl;
+		if (m_uKeyTrack) {
+			dFc *= exp2Pitch(m_dKeyTrackIntensity * log2Pitch(m_dNoteFrequency[i] / VOICE_FILTER_KEYTRACK_FREQUENCY));
+		}
+		if (m_dFcMod[i] != 0.0) {
+			dFc *= exp2Pitch(m_dFcMod[i]);
+		}
+		dFc = fmin(fmax(dFc, MIN_FILTER_FC), dMaxFc);
+
+		double g = tan(pi * dFc / m_dSampleRate);
+		if (bLadder) {
+			double G = g / (1.0 + g);
+			m_Lanes.fG[i] = (float)G;
+			m_Lanes.fA[i] = (float)(1.0 / (1.0 + m_dLadderK * G * G * G * G));
+			m_Lanes.fD[i] = 0.0f;
+		} else {
+			m_Lanes.fG[i] = (float)g;
+			m_Lanes.fA[i] = (float)(m_dSVFDamping + g);
+			m_Lanes.fD[i] = (float)(1.0 / (1.0 + m_dSVFDamping * g + g * g));
+		}
+	}
+}
+
+/*
+	VoiceFilterBank::process()
+	Rebuilds the stale coefficients of the lanes in use, then runs each
+	lane group that has one of them in it. A silent lane inside a busy
+	group is filtered too; its input is zero and it is cleared again
+	by startVoice() when the voice next starts idle, or by flushLane().
+*/
+void VoiceFilterBank::process(float* pBlock, int nSamples, UINT uLaneMask) {
+	if (!uLaneMask) {
+		return;
+	}
+
+	if (m_uDirtyMask & uLaneMask) {
+		updateCoefficients(m_uDirtyMask & uLaneMask);
+		m_uDirtyMask &= ~uLaneMask;
+	}
+
+	const VoiceFilterKernels& kernels = voiceFilterKernels[getBatchMathISA()];
+	VoiceFilterKernel kernel = (m_uFilterType == LADDER_LPF2 || m_uFilterType == LADDER_LPF4) ? kernels.ladder : kernels.svf;
+	UINT uGroupMask = (1u << kernels.nLanes) - 1;
+
+	for (int nLane = 0; nLane < VOICE_FILTER_LANES; nLane += kernels.nLanes) {
+		if (uLaneMask & (uGroupMask << nLane)) {
+			kernel(m_Lanes, m_Mix, pBlock, nLane, nSamples);
+		}
+	}
+}
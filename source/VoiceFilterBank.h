@@ -0,0 +1,112 @@
+#pragma once
+#include "pluginconstants.h"
+#include "synthfunctions.h"
+#include "SynthParamLimits.h"
+
+//	a lane per voice, and one for the right side of a stereo voice; a
+//	multiple of 8 so the lanes split evenly into SIMD groups
+#define VOICE_FILTER_LANES VOICE_BLOCK_LANES
+
+//	keytrack is relative to middle C; a note there leaves Fc alone
+#define VOICE_FILTER_KEYTRACK_FREQUENCY 261.6255653
+
+//	Q control -> SVF Q and ladder feedback; k = 4 self-oscillates
+#define VOICE_FILTER_SVF_MIN_Q 0.5
+#define VOICE_FILTER_SVF_MAX_Q 25.0
+#define VOICE_FILTER_LADDER_MAX_K 4.0
+
+//	highest Fc as a fraction of fs; tan() blows up at Nyquist
+#define VOICE_FILTER_MAX_FC_RATIO 0.45
+
+//	per voice filter state and coefficients, one float per voice
+//	(structure of arrays), so a group of lanes is one SIMD load
+struct VoiceFilterLanes {
+	float fState[4][VOICE_FILTER_LANES];	//	SVF: 2 integrators, ladder: 4
+	float fG[VOICE_FILTER_LANES];			//	SVF g = tan(pi fc/fs), ladder G = g/(1+g)
+	float fA[VOICE_FILTER_LANES];			//	SVF 2R + g, ladder 1/(1 + kG^4)
+	float fD[VOICE_FILTER_LANES];			//	SVF 1/(1 + 2Rg + g^2), unused in the ladder
+};
+
+//	shared by all voices; picks the output and sets the nonlinearity
+struct VoiceFilterMix {
+	float fLP, fBP, fHP;	//	SVF outputs
+	float fLP2, fLP4;		//	ladder taps
+	float fK;				//	ladder feedback
+	float fSaturation;		//	NLP drive; 0 = linear
+};
+
+/*
+	VoiceFilterBank
+	Filter 1 for every voice: a ZDF (TPT) state variable filter or a
+	ZDF Moog style 4 pole ladder.
+
+	The voices are not filtered one at a time. Their state lives in one
+	structure of arrays and the block is interleaved by voice, so each
+	SIMD pass runs 4 (SSE2) or 8 (AVX2) lanes together; the path comes
+	from getBatchMathISA(). Lane groups with no sounding voice are
+	skipped. A stereo (unison spread) voice has a second lane,
+	VOICE_RIGHT_LANE_OFFSET on, filtered with the same coefficients.
+
+	Coefficients are control rate: they are rebuilt for a voice when it
+	starts or when update() is called, never per sample. Fc can track the
+	voice's note frequency, and moves with the voice's note expression.
+
+	No allocation or locks; process() runs on the audio thread.
+*/
+class VoiceFilterBank {
+public:
+	VoiceFilterBank(void);
+	~VoiceFilterBank(void);
+
+	//	filter types; same order as the Filter Type control
+	enum { SVF_LPF, SVF_HPF, SVF_BPF, SVF_BSF, LADDER_LPF2, LADDER_LPF4 };
+
+	//	user controls; call update() after changing them
+	double m_dFcControl;			//	Hz
+	double m_dQControl;				//	MIN_FILTER_Q -> MAX_FILTER_Q
+	UINT m_uFilterType;
+	UINT m_uNLP;					//	on/off
+	double m_dSaturation;			//	NLP drive
+	UINT m_uKeyTrack;				//	on/off
+	double m_dKeyTrackIntensity;	//	1.0 = Fc follows the note exactly
+
+	void setSampleRate(double dFs);
+
+	//	GUI changes
+	void update();
+
+	//	set the note frequency a voice's Fc tracks; bIdle clears its state
+	//	(both its lanes) first. A voice that is still sounding keeps its
+	//	state, so a retrigger or steal does not click
+	void startVoice(UINT uVoice, double dNoteFrequency, bool bIdle);
+
+	//	clear one lane's state, e.g. a right lane coming into use mid-note
+	void flushLane(UINT uLane);
+
+	//	a voice's note expression (timbre) Fc offset, octaves; control rate
+	void setVoiceFcMod(UINT uVoice, double dOctaves);
+
+	//	filter in place; pBlock[n * VOICE_FILTER_LANES + lane]. Only lane
+	//	groups with a lane in uLaneMask are processed
+	void process(float* pBlock, int nSamples, UINT uLaneMask);
+
+protected:
+	double m_dSampleRate;
+
+	//	per lane note frequency, for keytracking, and Fc offset; a right
+	//	lane copies its voice's
+	double m_dNoteFrequency[VOICE_FILTER_LANES];
+	double m_dFcMod[VOICE_FILTER_LANES];
+
+	//	lanes whose coefficients need rebuilding
+	UINT m_uDirtyMask;
+
+	VoiceFilterLanes m_Lanes;
+	VoiceFilterMix m_Mix;
+
+	//	shared part of the coefficients, from update()
+	double m_dSVFDamping;	//	2R = 1/Q
+	double m_dLadderK;
+
+	void updateCoefficients(UINT uVoiceMask);
+};
@@ -3,8 +3,8 @@
 //	Initialize or clear variables
 WTOscillator::WTOscillator(void) {
 	//	clear out arrays
-	memset(m_pSawTables, 0, NUM_TABLES * sizeof(double*));
-	memset(m_pTriangleTables, 0, NUM_TABLES * sizeof(double*));
+	memset(m_dSawTables, 0, sizeof(m_dSawTables));
+	memset(m_dTriangleTables, 0, sizeof(m_dTriangleTables));
 
 	//	init variables
 	m_dReadIndex = 0.0;
@@ -27,7 +27,6 @@ WTOscillator::WTOscillator(void) {
 }
 
 WTOscillator::~WTOscillator(void) {
-	destroyWaveTables();
 }
 
 //	Call the base class method for base reset
@@ -65,8 +64,6 @@ void WTOscillator::setSampleRate(double dFs) {
 
 	//	recrate the tables only if sample rate has changed
 	if (bNewSR) {
-		//	then recrate
-		destroyWaveTables();
 		createWaveTables();
 	}
 }
@@ -85,10 +82,10 @@ void WTOscillator::createWaveTables() {
 	//	SAW, TRIANGLE: need 10 tables
 	double dSeedFreq = 27.5; //	Note A0, lowest piano note
 	for (int j = 0; j < NUM_TABLES; j++) {
-		double* pSawTable = new double[WT_LENGTH];
+		double* pSawTable = m_dSawTables[j];
 		memset(pSawTable, 0, WT_LENGTH * sizeof(double));
 
-		double* pTriTable = new double[WT_LENGTH];
+		double* pTriTable = m_dTriangleTables[j];
 		memset(pTriTable, 0, WT_LENGTH * sizeof(double));
 
 		int nHarms = (int)((m_dSampleRate / 2.0 / dSeedFreq) - 1.0);
@@ -142,31 +139,10 @@ void WTOscillator::createWaveTables() {
 			pTriTable[i] /= dMaxTri;
 		}
 
-		//	store
-		m_pSawTables[j] = pSawTable;
-		m_pTriangleTables[j] = pTriTable;
-
 		dSeedFreq *= 2.0;
 	}
 }
 
-//	Unload the arrays and delete the pointers
-void WTOscillator::destroyWaveTables() {
-	for (int i = 0; i < NUM_TABLES; i++) {
-		double* p = m_pSawTables[i];
-		if (p) {
-			delete[] p;
-			m_pSawTables[i] = 0;
-		}
-
-		p = m_pTriangleTables[i];
-		if (p) {
-			delete[] p;
-			m_pTriangleTables[i] = 0;
-		}
-	}
-}
-
 //	Get table index based on current m_dFo
 int WTOscillator::getTableIndex() {
 	if (m_uWaveform == SINE) {
@@ -198,9 +174,9 @@ void WTOscillator::selectTable() {
 
 	//	choose table
 	if (m_uWaveform == SAW1 || m_uWaveform == SAW2 || m_uWaveform == SAW3 || m_uWaveform == SQUARE) {
-		m_pCurrentTable = m_pSawTables[m_nCurrentTableIndex];
+		m_pCurrentTable = m_dSawTables[m_nCurrentTableIndex];
 	} else if (m_uWaveform == TRI) {
-		m_pCurrentTable = m_pTriangleTables[m_nCurrentTableIndex];
+		m_pCurrentTable = m_dTriangleTables[m_nCurrentTableIndex];
 	}
 }
 
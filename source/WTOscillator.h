@@ -1,5 +1,5 @@
 #pragma once
-#include "oscillator.h"
+#include "Oscillator.h"
 
 #define WT_LENGTH 512
 #define NUM_TABLES 9
@@ -14,10 +14,11 @@ protected:
 	double m_dReadIndex;
 	double m_dWT_inc;
 
-	//	tables
+	//	tables; in the object, so a new sample rate refills them in place
+	//	rather than allocating
 	double m_dSineTable[WT_LENGTH];
-	double* m_pSawTables[NUM_TABLES];
-	double* m_pTriangleTables[NUM_TABLES];
+	double m_dSawTables[NUM_TABLES][WT_LENGTH];
+	double m_dTriangleTables[NUM_TABLES][WT_LENGTH];
 
 	//	for storing current table
 	double* m_pCurrentTable;
@@ -30,9 +31,8 @@ protected:
 	int getTableIndex();
 	void selectTable();
 
-	//	create an destory tables
+	//	fill the tables for the sample rate
 	void createWaveTables();
-	void destroyWaveTables();
 
 	//	do the selected wavetable
 	double doWaveTable(double& dReadIndex, double dWT_inc);
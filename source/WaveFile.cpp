@@ -0,0 +1,477 @@
+#include "WaveFile.h"
+#include "BatchMath.h"
+#include <string.h>
+
+#if defined _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//	page size for prefetching; 4K is the smallest we run on
+#define WAVE_FILE_PAGE_SIZE 4096
+
+//	format tags
+#define WAVE_FILE_TAG_PCM 1
+#define WAVE_FILE_TAG_FLOAT 3
+#define WAVE_FILE_TAG_EXTENSIBLE 0xFFFE
+
+//	integer PCM is scaled as a 32 bit value, like CWaveData always did
+static const float fPCM16Scale = 1.0f / 32768.0f;
+static const float fPCM32Scale = 1.0f / 2147483648.0f;
+
+static inline UINT readU16(const unsigned char* p) {
+	return (UINT)p[0] | ((UINT)p[1] << 8);
+}
+
+static inline UINT readU32(const unsigned char* p) {
+	return (UINT)p[0] | ((UINT)p[1] << 8) | ((UINT)p[2] << 16) | ((UINT)p[3] << 24);
+}
+
+//------------------------------------------------------------------------
+//	conversion kernels, uCount samples each; all paths are exact (int to
+//	float rounds the same everywhere and the scales are powers of 2)
+//------------------------------------------------------------------------
+static void pcm16Scalar(const unsigned char* pIn, float* pOut, UINT uCount) {
+	for (UINT i = 0; i < uCount; i++) {
+		short s;
+		memcpy(&s, pIn + i * 2, 2);
+		pOut[i] = (float)s * fPCM16Scale;
+	}
+}
+
+static void pcm24Scalar(const unsigned char* pIn, float* pOut, UINT uCount) {
+	for (UINT i = 0; i < uCount; i++) {
+		const unsigned char* p = pIn + i * 3;
+		int n = (int)(((UINT)p[0] << 8) | ((UINT)p[1] << 16) | ((UINT)p[2] << 24));
+		pOut[i] = (float)n * fPCM32Scale;
+	}
+}
+
+static void pcm32Scalar(const unsigned char* pIn, float* pOut, UINT uCount) {
+	for (UINT i = 0; i < uCount; i++) {
+		int n;
+		memcpy(&n, pIn + i * 4, 4);
+		pOut[i] = (float)n * fPCM32Scale;
+	}
+}
+
+static void float32Copy(const unsigned char* pIn, float* pOut, UINT uCount) {
+	memcpy(pOut, pIn, uCount * sizeof(float));
+}
+
+static void float64Scalar(const unsigned char* pIn, float* pOut, UINT uCount) {
+	for (UINT i = 0; i < uCount; i++) {
+		double d;
+		memcpy(&d, pIn + i * 8, 8);
+		pOut[i] = (float)d;
+	}
+}
+
+#if BATCH_MATH_X86
+//------------------------------------------------------------------------
+//	SSE2; 24 bit needs a byte shuffle, so it stays scalar here
+//------------------------------------------------------------------------
+BATCH_TARGET_SSE2 static void pcm16SSE2(const unsigned char* pIn, float* pOut, UINT uCount) {
+	const __m128 vScale = _mm_set1_ps(fPCM16Scale);
+	UINT i = 0;
+	for (; i + 8 <= uCount; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(pIn + i * 2));
+		//	the sample in the top half, then shifted down with its sign
+		__m128i vLo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+		__m128i vHi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+		_mm_storeu_ps(pOut + i, _mm_mul_ps(_mm_cvtepi32_ps(vLo), vScale));
+		_mm_storeu_ps(pOut + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(vHi), vScale));
+	}
+	pcm16Scalar(pIn + i * 2, pOut + i, uCount - i);
+}
+
+BATCH_TARGET_SSE2 static void pcm32SSE2(const unsigned char* pIn, float* pOut, UINT uCount) {
+	const __m128 vScale = _mm_set1_ps(fPCM32Scale);
+	UINT i = 0;
+	for (; i + 4 <= uCount; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(pIn + i * 4));
+		_mm_storeu_ps(pOut + i, _mm_mul_ps(_mm_cvtepi32_ps(v), vScale));
+	}
+	pcm32Scalar(pIn + i * 4, pOut + i, uCount - i);
+}
+
+BATCH_TARGET_SSE2 static void float64SSE2(const unsigned char* pIn, float* pOut, UINT uCount) {
+	UINT i = 0;
+	for (; i + 4 <= uCount; i += 4) {
+		__m128 vLo = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(pIn + i * 8)));
+		__m128 vHi = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(pIn + i * 8 + 16)));
+		_mm_storeu_ps(pOut + i, _mm_movelh_ps(vLo, vHi));
+	}
+	float64Scalar(pIn + i * 8, pOut + i, uCount - i);
+}
+
+//------------------------------------------------------------------------
+//	AVX2
+//------------------------------------------------------------------------
+BATCH_TARGET_AVX2 static void pcm16AVX2(const unsigned char* pIn, float* pOut, UINT uCount) {
+	const __m256 vScale = _mm256_set1_ps(fPCM16Scale);
+	UINT i = 0;
+	for (; i + 8 <= uCount; i += 8) {
+		__m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(pIn + i * 2)));
+		_mm256_storeu_ps(pOut + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), vScale));
+	}
+	pcm16Scalar(pIn + i * 2, pOut + i, uCount - i);
+}
+
+//	8 samples are 24 bytes: 12 into each 128 bit lane, then each 3 bytes
+//	go to the top of a 32 bit lane. The second load reads 4 bytes past
+//	the 24, so the loop stops 2 samples short of the end
+BATCH_TARGET_AVX2 static void pcm24AVX2(const unsigned char* pIn, float* pOut, UINT uCount) {
+	const __m256 vScale = _mm256_set1_ps(fPCM32Scale);
+	const __m256i vShuffle = _mm256_setr_epi8(
+		-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+		-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+	UINT i = 0;
+	for (; i + 10 <= uCount; i += 8) {
+		const unsigned char* p = pIn + i * 3;
+		__m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)p)),
+			_mm_loadu_si128((const __m128i*)(p + 12)), 1);
+		v = _mm256_shuffle_epi8(v, vShuffle);
+		_mm256_storeu_ps(pOut + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), vScale));
+	}
+	pcm24Scalar(pIn + i * 3, pOut + i, uCount - i);
+}
+
+BATCH_TARGET_AVX2 static void pcm32AVX2(const unsigned char* pIn, float* pOut, UINT uCount) {
+	const __m256 vScale = _mm256_set1_ps(fPCM32Scale);
+	UINT i = 0;
+	for (; i + 8 <= uCount; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(pIn + i * 4));
+		_mm256_storeu_ps(pOut + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), vScale));
+	}
+	pcm32Scalar(pIn + i * 4, pOut + i, uCount - i);
+}
+
+BATCH_TARGET_AVX2 static void float64AVX2(const unsigned char* pIn, float* pOut, UINT uCount) {
+	UINT i = 0;
+	for (; i + 4 <= uCount; i += 4) {
+		_mm_storeu_ps(pOut + i, _mm256_cvtpd_ps(_mm256_loadu_pd((const double*)(pIn + i * 8))));
+	}
+	float64Scalar(pIn + i * 8, pOut + i, uCount - i);
+}
+#endif // BATCH_MATH_X86
+
+//------------------------------------------------------------------------
+//	dispatch; indexed by getBatchMathISA(), then by WAVE_FILE_ format
+//------------------------------------------------------------------------
+typedef void (*WaveFileKernel)(const unsigned char*, float*, UINT);
+
+static const WaveFileKernel waveFileKernels[][WAVE_FILE_FORMATS] = {
+	{ pcm16Scalar, pcm24Scalar, pcm32Scalar, float32Copy, float64Scalar },
+#if BATCH_MATH_X86
+	{ pcm16SSE2, pcm24Scalar, pcm32SSE2, float32Copy, float64SSE2 },
+	{ pcm16AVX2, pcm24AVX2, pcm32AVX2, float32Copy, float64AVX2 },
+#endif
+};
+
+WaveFile::WaveFile(void) {
+	m_pMapping = 0;
+	m_uMappingSize = 0;
+#if defined _WIN32
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_hMapping = 0;
+#endif
+	m_pData = 0;
+	close();
+}
+
+WaveFile::~WaveFile(void) {
+	close();
+}
+
+/*
+	WaveFile::open()
+	Maps the file read-only and parses the chunks; the data is not touched.
+*/
+bool WaveFile::open(const char* pPath) {
+	close();
+
+#if defined _WIN32
+	m_hFile = CreateFileA(pPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_hFile == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_hFile, &fileSize) || fileSize.QuadPart < 12) {
+		close();
+		return false;
+	}
+	m_uMappingSize = (unsigned long long)fileSize.QuadPart;
+
+	m_hMapping = CreateFileMappingA(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!m_hMapping) {
+		close();
+		return false;
+	}
+
+	m_pMapping = MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_pMapping) {
+		close();
+		return false;
+	}
+#else
+	int nFile = ::open(pPath, O_RDONLY);
+	if (nFile < 0) {
+		return false;
+	}
+
+	struct stat fileInfo;
+	if (fstat(nFile, &fileInfo) != 0 || fileInfo.st_size < 12) {
+		::close(nFile);
+		return false;
+	}
+	m_uMappingSize = (unsigned long long)fileInfo.st_size;
+
+	void* pMapping = mmap(NULL, (size_t)m_uMappingSize, PROT_READ, MAP_PRIVATE, nFile, 0);
+
+	//	the mapping holds its own reference to the file
+	::close(nFile);
+
+	if (pMapping == MAP_FAILED) {
+		m_uMappingSize = 0;
+		return false;
+	}
+	m_pMapping = pMapping;
+#endif
+
+	if (!parse()) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void WaveFile::close() {
+#if defined _WIN32
+	if (m_pMapping) {
+		UnmapViewOfFile(m_pMapping);
+	}
+	if (m_hMapping) {
+		CloseHandle(m_hMapping);
+	}
+	if (m_hFile != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_hFile);
+	}
+	m_hMapping = 0;
+	m_hFile = INVALID_HANDLE_VALUE;
+#else
+	if (m_pMapping) {
+		munmap(m_pMapping, (size_t)m_uMappingSize);
+	}
+#endif
+
+	m_pMapping = 0;
+	m_uMappingSize = 0;
+
+	m_uChannels = 0;
+	m_uSampleRate = 0;
+	m_uSampleFormat = WAVE_FILE_PCM16;
+	m_uBytesPerFrame = 0;
+	m_uBytesPerSample = 0;
+	m_pData = 0;
+	m_uFrameCount = 0;
+
+	m_bHasSampleChunk = false;
+	m_uMIDINote = 0;
+	m_uMIDIPitchFraction = 0;
+	m_uSMPTEFormat = 0;
+	m_uSMPTEOffset = 0;
+	m_uLoopCount = 0;
+	m_uLoopType = 0;
+	m_uLoopStartFrame = 0;
+	m_uLoopEndFrame = 0;
+}
+
+/*
+	WaveFile::parse()
+	RIFF/WAVE header, then the chunks in any order; each one is padded
+	to an even length. A chunk running past the end of the file is cut
+	to what is there (recorders often leave the data length unset).
+*/
+bool WaveFile::parse() {
+	const unsigned char* pFile = (const unsigned char*)m_pMapping;
+	if (memcmp(pFile, "RIFF", 4) != 0 || memcmp(pFile + 8, "WAVE", 4) != 0) {
+		return false;
+	}
+
+	bool bFormat = false;
+	const unsigned char* pData = 0;
+	unsigned long long uDataLength = 0;
+
+	unsigned long long uOffset = 12;
+	while (uOffset + 8 <= m_uMappingSize) {
+		const unsigned char* pChunk = pFile + uOffset;
+		unsigned long long uLength = readU32(pChunk + 4);
+		unsigned long long uAvailable = m_uMappingSize - uOffset - 8;
+		if (uLength > uAvailable) {
+			uLength = uAvailable;
+		}
+
+		if (memcmp(pChunk, "fmt ", 4) == 0) {
+			bFormat = parseFormat(pChunk + 8, (UINT)uLength);
+			if (!bFormat) {
+				return false;
+			}
+		} else if (memcmp(pChunk, "data", 4) == 0) {
+			pData = pChunk + 8;
+			uDataLength = uLength;
+		} else if (memcmp(pChunk, "smpl", 4) == 0) {
+			parseSampleChunk(pChunk + 8, (UINT)uLength);
+		}
+
+		uOffset += 8 + uLength + (uLength & 1);
+	}
+
+	if (!bFormat || !pData) {
+		return false;
+	}
+
+	unsigned long long uFrames = uDataLength / m_uBytesPerFrame;
+	m_uFrameCount = uFrames > 0xFFFFFFFF ? 0xFFFFFFFF : (UINT)uFrames;
+	m_pData = pData;
+
+	return true;
+}
+
+bool WaveFile::parseFormat(const unsigned char* pChunk, UINT uLength) {
+	if (uLength < 16) {
+		return false;
+	}
+
+	UINT uTag = readU16(pChunk);
+	m_uChannels = readU16(pChunk + 2);
+	m_uSampleRate = readU32(pChunk + 4);
+	UINT uBlockAlign = readU16(pChunk + 12);
+	UINT uBits = readU16(pChunk + 14);
+
+	//	EXTENSIBLE: the real tag is the start of the sub format GUID
+	if (uTag == WAVE_FILE_TAG_EXTENSIBLE) {
+		if (uLength < 40) {
+			return false;
+		}
+		uTag = readU16(pChunk + 24);
+	}
+
+	if (m_uChannels == 0 || uBlockAlign == 0 || uBlockAlign % m_uChannels != 0) {
+		return false;
+	}
+	m_uBytesPerFrame = uBlockAlign;
+	m_uBytesPerSample = uBlockAlign / m_uChannels;
+
+	if (uTag == WAVE_FILE_TAG_PCM) {
+		if (uBits == 16 && m_uBytesPerSample == 2) {
+			m_uSampleFormat = WAVE_FILE_PCM16;
+		} else if (uBits == 24 && m_uBytesPerSample == 3) {
+			m_uSampleFormat = WAVE_FILE_PCM24;
+		} else if ((uBits == 24 || uBits == 32) && m_uBytesPerSample == 4) {
+			//	24 bit in a 4 byte container is left justified
+			m_uSampleFormat = WAVE_FILE_PCM32;
+		} else {
+			return false;
+		}
+	} else if (uTag == WAVE_FILE_TAG_FLOAT) {
+		if (uBits == 32 && m_uBytesPerSample == 4) {
+			m_uSampleFormat = WAVE_FILE_FLOAT32;
+		} else if (uBits == 64 && m_uBytesPerSample == 8) {
+			m_uSampleFormat = WAVE_FILE_FLOAT64;
+		} else {
+			return false;
+		}
+	} else {
+		//	compressed, uLaw/aLaw, etc.
+		return false;
+	}
+
+	return true;
+}
+
+/*
+	WaveFile::parseSampleChunk()
+	smpl: manufacturer, product, sample period, MIDI unity note, pitch
+	fraction, SMPTE format and offset, loop count, sampler data, then
+	24 bytes per loop: cue point ID, type, start, end, fraction, play
+	count. Only the first loop is kept.
+*/
+void WaveFile::parseSampleChunk(const unsigned char* pChunk, UINT uLength) {
+	if (uLength < 36) {
+		return;
+	}
+
+	m_bHasSampleChunk = true;
+	m_uMIDINote = readU32(pChunk + 12);
+	m_uMIDIPitchFraction = readU32(pChunk + 16);
+	m_uSMPTEFormat = readU32(pChunk + 20);
+	m_uSMPTEOffset = readU32(pChunk + 24);
+	m_uLoopCount = readU32(pChunk + 28);
+
+	if (m_uLoopCount > 0 && uLength >= 36 + 24) {
+		m_uLoopType = readU32(pChunk + 36 + 4);
+		m_uLoopStartFrame = readU32(pChunk + 36 + 8);
+		m_uLoopEndFrame = readU32(pChunk + 36 + 12);
+	} else {
+		m_uLoopCount = 0;
+	}
+}
+
+const float* WaveFile::getFloatData() {
+	if (!m_pData || m_uSampleFormat != WAVE_FILE_FLOAT32 || ((size_t)m_pData & (sizeof(float) - 1)) != 0) {
+		return 0;
+	}
+	return (const float*)m_pData;
+}
+
+UINT WaveFile::readFrames(UINT uStartFrame, UINT uFrames, float* pOutput) {
+	if (!m_pData || uStartFrame >= m_uFrameCount) {
+		return 0;
+	}
+	if (uFrames > m_uFrameCount - uStartFrame) {
+		uFrames = m_uFrameCount - uStartFrame;
+	}
+
+	const unsigned char* pIn = m_pData + (unsigned long long)uStartFrame * m_uBytesPerFrame;
+	waveFileKernels[getBatchMathISA()][m_uSampleFormat](pIn, pOutput, uFrames * m_uChannels);
+
+	return uFrames;
+}
+
+/*
+	WaveFile::prefetch()
+	Starts the OS reading the range (where there is a hint for it) and
+	touches one byte per page, so this blocks until the pages are in.
+*/
+void WaveFile::prefetch(UINT uStartFrame, UINT uFrames) {
+	if (!m_pData || uStartFrame >= m_uFrameCount) {
+		return;
+	}
+	if (uFrames > m_uFrameCount - uStartFrame) {
+		uFrames = m_uFrameCount - uStartFrame;
+	}
+
+	const unsigned char* pStart = m_pData + (unsigned long long)uStartFrame * m_uBytesPerFrame;
+	size_t uBytes = (size_t)uFrames * m_uBytesPerFrame;
+
+#if !defined _WIN32
+	//	madvise() wants a page aligned start
+	size_t uMisalign = (size_t)pStart & (WAVE_FILE_PAGE_SIZE - 1);
+	madvise((void*)(pStart - uMisalign), uBytes + uMisalign, MADV_WILLNEED);
+#endif
+
+	volatile unsigned char uTouch = 0;
+	for (size_t i = 0; i < uBytes; i += WAVE_FILE_PAGE_SIZE) {
+		uTouch += pStart[i];
+	}
+	if (uBytes > 0) {
+		uTouch += pStart[uBytes - 1];
+	}
+}
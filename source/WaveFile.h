@@ -0,0 +1,98 @@
+#pragma once
+#include "pluginconstants.h"
+
+//	sample formats of the data chunk
+enum {
+	WAVE_FILE_PCM16,
+	WAVE_FILE_PCM24,	//	3 byte packed; 24 bit in 4 byte containers reads as PCM32
+	WAVE_FILE_PCM32,
+	WAVE_FILE_FLOAT32,
+	WAVE_FILE_FLOAT64,
+	WAVE_FILE_FORMATS
+};
+
+/*
+	WaveFile
+	A WAV file read in place from a read-only memory mapping.
+
+	open() maps the file and walks the RIFF chunks for fmt, data and
+	smpl; nothing is copied or converted, so opening a large sample
+	costs about the same as a small one. The sample data stays in the
+	mapping and is only converted when readFrames() asks for a range,
+	so the OS pages in just the parts that are played. Float files
+	whose data chunk is aligned can be used directly (getFloatData()).
+
+	Every offset and length in the file is checked against the mapping;
+	a truncated data chunk is clipped to what is there. PCM 16, 24 (3 or
+	4 byte) and 32 bit, float 32 and 64 bit, plain or EXTENSIBLE.
+	Little endian hosts only, like the PresetBank.
+
+	open() and close() are not realtime; readFrames() does not allocate
+	but may page fault, so call prefetch() ahead of it off the audio
+	thread when streaming.
+*/
+class WaveFile {
+public:
+	WaveFile(void);
+	~WaveFile(void);
+
+	//	false if missing, not a WAV or an unsupported format
+	bool open(const char* pPath);
+	void close();
+
+	bool isOpen() { return m_pData != 0; }
+
+	UINT getChannels() { return m_uChannels; }
+	UINT getSampleRate() { return m_uSampleRate; }
+	UINT getFrameCount() { return m_uFrameCount; }
+	UINT getSampleFormat() { return m_uSampleFormat; }
+
+	//	the data chunk, interleaved, in the file's format
+	const unsigned char* getData() { return m_pData; }
+
+	//	the data chunk as floats if it already is (and is aligned), else NULL
+	const float* getFloatData();
+
+	//	uFrames from uStartFrame, interleaved, converted to -1.0 -> +1.0;
+	//	stops at the end of the data, returns the frames written
+	UINT readFrames(UINT uStartFrame, UINT uFrames, float* pOutput);
+
+	//	ask the OS to read a range in ahead of readFrames()
+	void prefetch(UINT uStartFrame, UINT uFrames);
+
+	//	smpl chunk, first loop only; frames, not interleaved samples
+	bool m_bHasSampleChunk;
+	UINT m_uMIDINote;
+	UINT m_uMIDIPitchFraction;
+	UINT m_uSMPTEFormat;
+	UINT m_uSMPTEOffset;
+	UINT m_uLoopCount;
+	UINT m_uLoopType;
+	UINT m_uLoopStartFrame;
+	UINT m_uLoopEndFrame;
+
+protected:
+	//	the mapping
+	void* m_pMapping;
+	unsigned long long m_uMappingSize;
+#if defined _WIN32
+	void* m_hFile;
+	void* m_hMapping;
+#endif
+
+	//	fmt
+	UINT m_uChannels;
+	UINT m_uSampleRate;
+	UINT m_uSampleFormat;
+	UINT m_uBytesPerFrame;
+	UINT m_uBytesPerSample;
+
+	//	data, in the mapping
+	const unsigned char* m_pData;
+	UINT m_uFrameCount;
+
+	//	walk the chunks; nothing is trusted until checked against the size
+	bool parse();
+	bool parseFormat(const unsigned char* pChunk, UINT uLength);
+	void parseSampleChunk(const unsigned char* pChunk, UINT uLength);
+};
@@ -905,9 +905,7 @@ public:
 		// just do the difference equation: y(n) = a0x(n) + a1x(n-1) + a2x(n-2) - b1y(n-1) - b2y(n-2)
 		float yn = m_f_a0 * f_xn + m_f_a1 * m_f_Xz_1 + m_f_a2 * m_f_Xz_2 - m_f_b1 * m_f_Yz_1 - m_f_b2 * m_f_Yz_2;
 
-		// underflow check
-		if (yn > 0.0 && yn < FLT_MIN_PLUS) yn = 0;
-		if (yn < 0.0 && yn > FLT_MIN_MINUS) yn = 0;
+		// no underflow check: process() runs under a DenormalGuard (FTZ/DAZ)
 
 		// shuffle delays
 		// Y delays
@@ -947,6 +945,9 @@ public:	// Functions
 	// (3) call this once per sample period
 	void incTimer();
 
+	// or once per block of uSamples; same state as uSamples calls to incTimer()
+	void incTimer(UINT uSamples);
+
 	// (4) get the current vector mix ratios
 	void getVectorMixValues(float& fA, float& fB, float& fC, float& fD) { fA = m_fA_Mix; fB = m_fB_Mix, fC = m_fC_Mix, fD = m_fD_Mix; }
 
@@ -1080,7 +1081,7 @@ public:	// Functions
 
 //
 // This is a helper object for reading Wave files into floating point buffers.
-// It is NOT optimized for speed (yet)
+// The file is memory mapped and parsed by WaveFile (WaveFile.h)
 #if defined _WINDOWS || defined _WINDLL
 #include <mmsystem.h>
 
@@ -1120,7 +1121,7 @@ public:	// Functions
 	float* m_pWaveBuffer;
 
 protected:
-	bool readWaveFile(char* pFilePath);
+	bool readWaveFile(const char* pFilePath);
 	HANDLE m_hFile;
 
 };
@@ -0,0 +1,302 @@
+/*
+	DenormalTest
+	Each kernel that lost its per sample underflow check to the
+	DenormalGuard is struck with an impulse and left to ring down to
+	silence, with and without the guard:
+		the voice filter, a resonant VoiceFilterBank SVF, as a voice's
+		release tail
+		BiQuadCascade, the output DC blocker's structure, run as a
+		resonant low pass
+		CBiQuad::doBiQuad, the same low pass one sample at a time
+		CEnvelopeDetector::detect, the meters' detector, releasing
+	The tails pass through the denormal range; without the guard every
+	multiply there is a microcode assist.
+
+	Under the guard the cost per block must stay flat from the first
+	block to the last: the slowest window of blocks may be at most
+	DENORMAL_FLAT_LIMIT times the fastest. The unguarded run is only
+	reported, and checked to really reach denormals, so the test cannot
+	pass by decaying too fast or too slow. The guard must also restore
+	the FPU mode when it goes out of scope.
+
+	Timing is checked in optimized builds only; DenormalTest --no-budget
+	skips it.
+*/
+#include "TestUtils.h"
+#include "BiQuadCascade.h"
+#include "VoiceFilterBank.h"
+#include "DenormalGuard.h"
+
+#define DENORMAL_SAMPLE_RATE 48000.0
+#define DENORMAL_MAX_CHANNELS 32	//	the widest case, a lane per voice filter lane
+#define DENORMAL_STAGES BIQUAD_CASCADE_MAX_STAGES
+#define DENORMAL_BLOCK 256
+#define DENORMAL_BLOCKS 256			//	about 1.4 s; the filter tails are denormal from roughly 0.6 s on
+#define DENORMAL_WINDOW 8			//	blocks per window; a window's time is its fastest block
+#define DENORMAL_FLAT_LIMIT 3.0		//	noise on a busy machine, far below a denormal stall
+
+//	100 Hz, Q 2: a slow enough ring down to spend many blocks in each range
+#define DENORMAL_FC 100.0
+#define DENORMAL_Q 2.0
+
+//	40 dB per release time, so the envelope is denormal from about 0.95 s on
+#define DENORMAL_ATTACK_MSEC 0.01f
+#define DENORMAL_RELEASE_MSEC 50.0f
+#define DENORMAL_DETECTORS 16		//	the meters run one per channel; more to make a block worth timing
+
+static_assert(VOICE_FILTER_LANES <= DENORMAL_MAX_CHANNELS && BIQUAD_CASCADE_MAX_CHANNELS <= DENORMAL_MAX_CHANNELS,
+	"denormalBlock is too narrow");
+
+static float denormalBlock[DENORMAL_BLOCK * DENORMAL_MAX_CHANNELS];
+
+static VoiceFilterBank denormalVoiceFilter;
+static BiQuadCascade denormalCascade;
+static CBiQuad denormalBiQuads[BIQUAD_CASCADE_MAX_CHANNELS][DENORMAL_STAGES];
+static CEnvelopeDetector denormalDetectors[DENORMAL_DETECTORS];
+
+//	every voice sounding, in stereo, so every lane rings
+static void resetVoiceFilter() {
+	for (UINT i = 0; i < MAX_VOICES; i++) {
+		denormalVoiceFilter.startVoice(i, VOICE_FILTER_KEYTRACK_FREQUENCY, true);
+	}
+}
+
+static void processVoiceFilter(float* pBlock, int nSamples) {
+	UINT uVoiceMask = (1u << MAX_VOICES) - 1;
+	denormalVoiceFilter.process(pBlock, nSamples, uVoiceMask | (uVoiceMask << VOICE_RIGHT_LANE_OFFSET));
+}
+
+static void resetCascade() {
+	denormalCascade.flushDelays();
+}
+
+static void processCascade(float* pBlock, int nSamples) {
+	denormalCascade.process(pBlock, nSamples);
+}
+
+static void resetBiQuads() {
+	for (int nChannel = 0; nChannel < BIQUAD_CASCADE_MAX_CHANNELS; nChannel++) {
+		for (int nStage = 0; nStage < DENORMAL_STAGES; nStage++) {
+			denormalBiQuads[nChannel][nStage].flushDelays();
+		}
+	}
+}
+
+static void processBiQuads(float* pBlock, int nSamples) {
+	for (int n = 0; n < nSamples; n++) {
+		for (int nChannel = 0; nChannel < BIQUAD_CASCADE_MAX_CHANNELS; nChannel++) {
+			float& fSample = pBlock[n * BIQUAD_CASCADE_MAX_CHANNELS + nChannel];
+			for (int nStage = 0; nStage < DENORMAL_STAGES; nStage++) {
+				fSample = denormalBiQuads[nChannel][nStage].doBiQuad(fSample);
+			}
+		}
+	}
+}
+
+static void resetDetectors() {
+	for (int i = 0; i < DENORMAL_DETECTORS; i++) {
+		denormalDetectors[i].prepareForPlay();
+	}
+}
+
+static void processDetectors(float* pBlock, int nSamples) {
+	for (int n = 0; n < nSamples; n++) {
+		for (int i = 0; i < DENORMAL_DETECTORS; i++) {
+			pBlock[n * DENORMAL_DETECTORS + i] = denormalDetectors[i].detect(pBlock[n * DENORMAL_DETECTORS + i]);
+		}
+	}
+}
+
+//	one kernel: nChannels interleaved channels, an impulse on each to start the tail
+struct DenormalCase {
+	const char* pName;
+	int nChannels;
+	void (*pReset)();
+	void (*pProcess)(float* pBlock, int nSamples);
+};
+
+static const DenormalCase denormalCases[] = {
+	{ "VoiceFilterBank", VOICE_FILTER_LANES, resetVoiceFilter, processVoiceFilter },
+	{ "BiQuadCascade", BIQUAD_CASCADE_MAX_CHANNELS, resetCascade, processCascade },
+	{ "CBiQuad", BIQUAD_CASCADE_MAX_CHANNELS, resetBiQuads, processBiQuads },
+	{ "CEnvelopeDetector", DENORMAL_DETECTORS, resetDetectors, processDetectors },
+};
+
+static void setupCases() {
+	//	SVF Q DENORMAL_Q, through the Q control's mapping (see VoiceFilterBank::update())
+	denormalVoiceFilter.setSampleRate(DENORMAL_SAMPLE_RATE);
+	denormalVoiceFilter.m_uFilterType = VoiceFilterBank::SVF_LPF;
+	denormalVoiceFilter.m_uKeyTrack = 0;
+	denormalVoiceFilter.m_uNLP = 0;
+	denormalVoiceFilter.m_dFcControl = DENORMAL_FC;
+	denormalVoiceFilter.m_dQControl = MIN_FILTER_Q + (MAX_FILTER_Q - MIN_FILTER_Q) *
+		(DENORMAL_Q - VOICE_FILTER_SVF_MIN_Q) / (VOICE_FILTER_SVF_MAX_Q - VOICE_FILTER_SVF_MIN_Q);
+	denormalVoiceFilter.update();
+
+	BiQuadCoeffs coeffs = BiQuadCascade::calculateLPF(DENORMAL_FC, DENORMAL_Q, DENORMAL_SAMPLE_RATE);
+	denormalCascade.init(BIQUAD_CASCADE_MAX_CHANNELS, DENORMAL_STAGES);
+	for (int nStage = 0; nStage < DENORMAL_STAGES; nStage++) {
+		denormalCascade.setCoefficients(nStage, coeffs, false);
+	}
+	for (int nChannel = 0; nChannel < BIQUAD_CASCADE_MAX_CHANNELS; nChannel++) {
+		for (int nStage = 0; nStage < DENORMAL_STAGES; nStage++) {
+			CBiQuad& biQuad = denormalBiQuads[nChannel][nStage];
+			biQuad.m_f_a0 = coeffs.a0;
+			biQuad.m_f_a1 = coeffs.a1;
+			biQuad.m_f_a2 = coeffs.a2;
+			biQuad.m_f_b1 = coeffs.b1;
+			biQuad.m_f_b2 = coeffs.b2;
+		}
+	}
+
+	//	a near instant attack, so the impulse takes the envelope to 1
+	for (int i = 0; i < DENORMAL_DETECTORS; i++) {
+		denormalDetectors[i].init((float)DENORMAL_SAMPLE_RATE, DENORMAL_ATTACK_MSEC, DENORMAL_RELEASE_MSEC, false, DETECT_MODE_PEAK, false);
+	}
+}
+
+/*
+	renderTail()
+	One ring down. pBlockTime_nSec[n] is lowered to the time of block n
+	if this run was faster, so over several runs it holds the fastest.
+	Returns the number of blocks whose output had a denormal in it.
+*/
+static int renderTail(const DenormalCase& test, bool bGuard, double* pBlockTime_nSec) {
+	test.pReset();
+
+	int nDenormalBlocks = 0;
+	for (int nBlock = 0; nBlock < DENORMAL_BLOCKS; nBlock++) {
+		memset(denormalBlock, 0, sizeof(denormalBlock));
+		if (nBlock == 0) {
+			for (int nChannel = 0; nChannel < test.nChannels; nChannel++) {
+				denormalBlock[nChannel] = 1.0f;
+			}
+		}
+
+		double dStart = getTestTime_nSec();
+		if (bGuard) {
+			DenormalGuard denormalGuard;
+			test.pProcess(denormalBlock, DENORMAL_BLOCK);
+		} else {
+			test.pProcess(denormalBlock, DENORMAL_BLOCK);
+		}
+		double dTime = getTestTime_nSec() - dStart;
+		if (dTime < pBlockTime_nSec[nBlock]) {
+			pBlockTime_nSec[nBlock] = dTime;
+		}
+
+		for (int i = 0; i < DENORMAL_BLOCK * test.nChannels; i++) {
+			if (fpclassify(denormalBlock[i]) == FP_SUBNORMAL) {
+				nDenormalBlocks++;
+				break;
+			}
+		}
+	}
+	return nDenormalBlocks;
+}
+
+//	fastest and slowest window, each window timed by its fastest block
+static void getWindowRange(const double* pBlockTime_nSec, double& dFastest_nSec, double& dSlowest_nSec) {
+	dFastest_nSec = 1.0e30;
+	dSlowest_nSec = 0.0;
+	for (int nWindow = 0; nWindow < DENORMAL_BLOCKS; nWindow += DENORMAL_WINDOW) {
+		double dWindow_nSec = 1.0e30;
+		for (int n = nWindow; n < nWindow + DENORMAL_WINDOW; n++) {
+			dWindow_nSec = fmin(dWindow_nSec, pBlockTime_nSec[n]);
+		}
+		dFastest_nSec = fmin(dFastest_nSec, dWindow_nSec);
+		dSlowest_nSec = fmax(dSlowest_nSec, dWindow_nSec);
+	}
+}
+
+//	a denormal product is kept outside the guard and flushed inside it
+static bool checkGuardScope() {
+	volatile float fTiny = 1.0e-30f;
+	volatile float fScale = 1.0e-10f;
+
+	float fBefore = fTiny * fScale;
+	float fInside = 0.0f;
+	{
+		DenormalGuard denormalGuard;
+		fInside = fTiny * fScale;
+	}
+	float fAfter = fTiny * fScale;
+
+#if DENORMAL_GUARD_SSE || DENORMAL_GUARD_ARM64
+	bool bOK = fBefore != 0.0f && fInside == 0.0f && fAfter != 0.0f;
+#else
+	bool bOK = fBefore == fAfter;
+	(void)fInside;
+#endif
+	printf("guard scope: %g before, %g inside, %g after%s\n", fBefore, fInside, fAfter, bOK ? "" : "  WRONG");
+	return bOK;
+}
+
+/*
+	checkCase()
+	Both ring downs of one kernel, TEST_TIMING_RUNS times when timed.
+	Returns the number of failures.
+*/
+static int checkCase(const DenormalCase& test, bool bTime) {
+	static double dGuarded_nSec[DENORMAL_BLOCKS];
+	static double dUnguarded_nSec[DENORMAL_BLOCKS];
+	for (int n = 0; n < DENORMAL_BLOCKS; n++) {
+		dGuarded_nSec[n] = 1.0e30;
+		dUnguarded_nSec[n] = 1.0e30;
+	}
+
+	int nUnguardedDenormals = 0;
+	int nGuardedDenormals = 0;
+	for (int nRun = 0; nRun < (bTime ? TEST_TIMING_RUNS : 1); nRun++) {
+		nUnguardedDenormals = renderTail(test, false, dUnguarded_nSec);
+		nGuardedDenormals = renderTail(test, true, dGuarded_nSec);
+	}
+
+	//	the unguarded tail has to get there, or the guarded run proves nothing
+	int nFailures = 0;
+	printf("%s\n  blocks with denormal output: %d of %d unguarded, %d guarded\n", test.pName,
+		nUnguardedDenormals, DENORMAL_BLOCKS, nGuardedDenormals);
+	if (nUnguardedDenormals < DENORMAL_WINDOW) {
+		printf("  the unguarded tail never stays denormal; retune the case\n");
+		nFailures++;
+	}
+#if DENORMAL_GUARD_SSE || DENORMAL_GUARD_ARM64
+	if (nGuardedDenormals != 0) {
+		printf("  DENORMALS UNDER THE GUARD\n");
+		nFailures++;
+	}
+#endif
+
+	if (bTime) {
+		double dFastest_nSec = 0.0;
+		double dSlowest_nSec = 0.0;
+		getWindowRange(dUnguarded_nSec, dFastest_nSec, dSlowest_nSec);
+		printf("  unguarded %8.0f to %8.0f ns/block (%5.1fx)\n", dFastest_nSec, dSlowest_nSec, dSlowest_nSec / dFastest_nSec);
+
+		getWindowRange(dGuarded_nSec, dFastest_nSec, dSlowest_nSec);
+		bool bFlat = dSlowest_nSec <= DENORMAL_FLAT_LIMIT * dFastest_nSec;
+		printf("  guarded   %8.0f to %8.0f ns/block (%5.1fx of %.1fx)%s\n", dFastest_nSec, dSlowest_nSec,
+			dSlowest_nSec / dFastest_nSec, DENORMAL_FLAT_LIMIT, bFlat ? "" : "  NOT FLAT");
+		if (!bFlat) {
+			nFailures++;
+		}
+	}
+	return nFailures;
+}
+
+int main(int argc, char** argv) {
+	bool bTime = TEST_BUDGETS && !hasTestOption(argc, argv, "--no-budget");
+	int nFailures = 0;
+
+	if (!checkGuardScope()) {
+		nFailures++;
+	}
+
+	setupCases();
+	for (int i = 0; i < (int)(sizeof(denormalCases) / sizeof(denormalCases[0])); i++) {
+		nFailures += checkCase(denormalCases[i], bTime);
+	}
+
+	printf("%d failures\n", nFailures);
+	return nFailures ? 1 : 0;
+}
@@ -0,0 +1,134 @@
+/*
+	PresetBankTest
+	Round trip of a bank file: SynthStates go through writeBankFile(),
+	the file is mapped with open(), and every program, column and value
+	must come back exactly, for the whole SynthState schema. A truncated
+	file and one of another version must be refused.
+
+	Needs the VST3 SDK (SynthState and PresetBank use its types), so it
+	is only built as part of the plug-in build.
+*/
+#include "TestUtils.h"
+#include "PresetBank.h"
+
+using namespace Quero;
+
+#define BANK_TEST_FILE "PresetBankTest.nspb"
+#define BANK_TEST_BAD_FILE "PresetBankTestBad.nspb"
+#define BANK_TEST_PROGRAMS 5
+
+static const char* bankTestNames[BANK_TEST_PROGRAMS] = { "Init", "Fat Bass", "Glass Pad", "Sync Lead", "Noise Sweep" };
+static const UINT bankTestNumbers[BANK_TEST_PROGRAMS] = { 0, 5, 17, 64, 127 };
+
+//	a different in-range value in every field of every program
+static void fillProgram(SynthState& state, int nProgram) {
+	const SynthStateField* pSchema = SynthState::getSchema();
+	for (int i = 0; i < SynthState::getFieldCount(); i++) {
+		double dFraction = (double)((nProgram * 7 + i * 3) % 11) / 10.0;
+		state.setValue(pSchema[i].uParamID, pSchema[i].dMin + dFraction * (pSchema[i].dMax - pSchema[i].dMin));
+	}
+}
+
+//	a copy of the bank, cut short by nTrim bytes, with the version replaced
+static bool writeDamagedCopy(const char* pPath, int nTrim, Steinberg::uint32 uVersion) {
+	static unsigned char bankBytes[1 << 20];
+
+	FILE* pFile = fopen(BANK_TEST_FILE, "rb");
+	if (!pFile) {
+		return false;
+	}
+	size_t uSize = fread(bankBytes, 1, sizeof(bankBytes), pFile);
+	fclose(pFile);
+
+	((PresetBankHeader*)bankBytes)->uVersion = uVersion;
+
+	pFile = fopen(pPath, "wb");
+	if (!pFile) {
+		return false;
+	}
+	bool bSuccess = fwrite(bankBytes, 1, uSize - nTrim, pFile) == uSize - nTrim;
+	return fclose(pFile) == 0 && bSuccess;
+}
+
+int main() {
+	int nFailures = 0;
+
+	static SynthState programs[BANK_TEST_PROGRAMS];
+	for (int i = 0; i < BANK_TEST_PROGRAMS; i++) {
+		fillProgram(programs[i], i);
+	}
+
+	if (!PresetBank::writeBankFile(BANK_TEST_FILE, programs, bankTestNames, bankTestNumbers, BANK_TEST_PROGRAMS)) {
+		printf("writeBankFile failed for %d fields\n", SynthState::getFieldCount());
+		return 1;
+	}
+
+	PresetBank bank;
+	if (!bank.open(BANK_TEST_FILE)) {
+		printf("open failed\n");
+		return 1;
+	}
+
+	//	the columns are the schema
+	const SynthStateField* pSchema = SynthState::getSchema();
+	if (bank.getFieldCount() != SynthState::getFieldCount()) {
+		printf("%d fields, the schema has %d\n", bank.getFieldCount(), SynthState::getFieldCount());
+		return 1;
+	}
+	for (int i = 0; i < bank.getFieldCount(); i++) {
+		if (bank.getFieldID(i) != pSchema[i].uParamID) {
+			printf("field %d is ID %u, the schema has %u\n", i, bank.getFieldID(i), pSchema[i].uParamID);
+			nFailures++;
+		}
+	}
+
+	//	by program number and by name, every value exact
+	for (int i = 0; i < BANK_TEST_PROGRAMS; i++) {
+		const PresetBankRecord* pRecord = bank.getProgramRecord(bankTestNumbers[i]);
+		const double* pValues = bank.getProgramValues(bankTestNumbers[i]);
+		if (!pRecord || !pValues) {
+			printf("program %u missing\n", bankTestNumbers[i]);
+			nFailures++;
+			continue;
+		}
+		if (strcmp(pRecord->szName, bankTestNames[i]) != 0 || bank.findProgram(bankTestNames[i]) != pRecord) {
+			printf("program %u is \"%s\", not \"%s\"\n", bankTestNumbers[i], pRecord->szName, bankTestNames[i]);
+			nFailures++;
+		}
+
+		int nWrong = 0;
+		for (int j = 0; j < bank.getFieldCount(); j++) {
+			if (pValues[j] != programs[i].getValue(bank.getFieldID(j))) {
+				nWrong++;
+			}
+		}
+		if (nWrong) {
+			printf("program %u: %d of %d values changed\n", bankTestNumbers[i], nWrong, bank.getFieldCount());
+			nFailures++;
+		}
+	}
+
+	if (bank.getProgramValues(1) || bank.findProgram("No Such Program")) {
+		printf("an empty slot or unknown name was found\n");
+		nFailures++;
+	}
+	bank.close();
+
+	//	damaged files are refused
+	PresetBank badBank;
+	if (!writeDamagedCopy(BANK_TEST_BAD_FILE, 8, PRESET_BANK_VERSION) || badBank.open(BANK_TEST_BAD_FILE)) {
+		printf("a truncated bank was accepted\n");
+		nFailures++;
+	}
+	if (!writeDamagedCopy(BANK_TEST_BAD_FILE, 0, PRESET_BANK_VERSION - 1) || badBank.open(BANK_TEST_BAD_FILE)) {
+		printf("a version %d bank was accepted\n", PRESET_BANK_VERSION - 1);
+		nFailures++;
+	}
+	badBank.close();
+
+	remove(BANK_TEST_FILE);
+	remove(BANK_TEST_BAD_FILE);
+
+	printf("%d programs of %d fields, %d failures\n", BANK_TEST_PROGRAMS, SynthState::getFieldCount(), nFailures);
+	return nFailures ? 1 : 0;
+}
@@ -0,0 +1,262 @@
+/*
+	RenderTest
+	Golden-render regression test for the oscillators: every
+	QBLimitedOscillator waveform, every WTOscillator table range and
+	every LFO waveform and mode is rendered and compared with the
+	reference renders in test/golden within RENDER_TOLERANCE.
+
+	Each case also has a cost budget in ns/sample, given in steps of
+	the calibration loop (TestUtils.h) so it holds on any machine. The
+	budgets are checked in optimized builds only.
+
+	RenderTest --update		rewrite the reference renders
+	RenderTest --no-budget	skip the timing (e.g. under a debugger)
+
+	A change that is meant to alter the sound updates the goldens in the
+	same commit; one that is not must pass unchanged.
+*/
+#include "TestUtils.h"
+#include "QBLimitedOscillator.h"
+#include "WTOscillator.h"
+#include "LFO.h"
+
+#define RENDER_SAMPLE_RATE 48000.0	//	not 44100; WTOscillator only fills its tables on a rate change
+#define RENDER_LENGTH 1024
+#define RENDER_NOISE_SEED 0x2545F491
+#define RENDER_TOLERANCE 1.0e-4		//	libm and compiler differences, far below anything audible
+
+//	samples per timed run
+#define RENDER_BENCH_LENGTH 65536
+
+enum {
+	RENDER_QBLIMITED,
+	RENDER_WAVETABLE,
+	RENDER_LFO,
+	RENDER_KINDS
+};
+
+static const char* renderGoldenFiles[RENDER_KINDS] = {
+	"qblimited.f32",
+	"wavetable.f32",
+	"lfo.f32"
+};
+
+struct RenderCase {
+	const char* pName;
+	int nKind;
+	UINT uWaveform;
+	UINT uLFOMode;
+	double dFo;
+	double dBudget;		//	ns/sample in calibration steps
+};
+
+//	QBLimitedOscillator: each waveform below Fs/8 (8 point BLEP) and above it (2 point)
+//	WTOscillator: each table range, at 3/4 of its top frequency, and above the last (sine)
+//	LFO: each waveform in each mode, fast enough to cover whole cycles
+//	the cases of one kind stay together; each kind is one golden file
+static const RenderCase renderCases[] = {
+	{ "qb sine 220",		RENDER_QBLIMITED,	Oscillator::SINE,	0,	220.0,		10.0 },
+	{ "qb saw1 220",		RENDER_QBLIMITED,	Oscillator::SAW1,	0,	220.0,		10.0 },
+	{ "qb saw2 220",		RENDER_QBLIMITED,	Oscillator::SAW2,	0,	220.0,		40.0 },
+	{ "qb saw3 220",		RENDER_QBLIMITED,	Oscillator::SAW3,	0,	220.0,		40.0 },
+	{ "qb tri 220",			RENDER_QBLIMITED,	Oscillator::TRI,	0,	220.0,		10.0 },
+	{ "qb square 220",		RENDER_QBLIMITED,	Oscillator::SQUARE,	0,	220.0,		20.0 },
+	{ "qb noise 220",		RENDER_QBLIMITED,	Oscillator::NOISE,	0,	220.0,		8.0 },
+	{ "qb pnoise 220",		RENDER_QBLIMITED,	Oscillator::PNOISE,	0,	220.0,		10.0 },
+	{ "qb sine 8000",		RENDER_QBLIMITED,	Oscillator::SINE,	0,	8000.0,		10.0 },
+	{ "qb saw1 8000",		RENDER_QBLIMITED,	Oscillator::SAW1,	0,	8000.0,		10.0 },
+	{ "qb saw2 8000",		RENDER_QBLIMITED,	Oscillator::SAW2,	0,	8000.0,		40.0 },
+	{ "qb saw3 8000",		RENDER_QBLIMITED,	Oscillator::SAW3,	0,	8000.0,		40.0 },
+	{ "qb tri 8000",		RENDER_QBLIMITED,	Oscillator::TRI,	0,	8000.0,		10.0 },
+	{ "qb square 8000",		RENDER_QBLIMITED,	Oscillator::SQUARE,	0,	8000.0,		20.0 },
+	{ "qb noise 8000",		RENDER_QBLIMITED,	Oscillator::NOISE,	0,	8000.0,		8.0 },
+	{ "qb pnoise 8000",		RENDER_QBLIMITED,	Oscillator::PNOISE,	0,	8000.0,		10.0 },
+
+	{ "wt sine",			RENDER_WAVETABLE,	Oscillator::SINE,	0,	440.0,		8.0 },
+	{ "wt saw table 0",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	20.625,		10.0 },
+	{ "wt saw table 1",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	41.25,		10.0 },
+	{ "wt saw table 2",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	82.5,		10.0 },
+	{ "wt saw table 3",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	165.0,		10.0 },
+	{ "wt saw table 4",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	330.0,		10.0 },
+	{ "wt saw table 5",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	660.0,		10.0 },
+	{ "wt saw table 6",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	1320.0,		10.0 },
+	{ "wt saw table 7",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	2640.0,		10.0 },
+	{ "wt saw table 8",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	5280.0,		10.0 },
+	{ "wt saw sine",		RENDER_WAVETABLE,	Oscillator::SAW1,	0,	10000.0,	10.0 },
+	{ "wt tri table 0",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	20.625,		12.0 },
+	{ "wt tri table 1",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	41.25,		12.0 },
+	{ "wt tri table 2",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	82.5,		12.0 },
+	{ "wt tri table 3",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	165.0,		12.0 },
+	{ "wt tri table 4",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	330.0,		12.0 },
+	{ "wt tri table 5",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	660.0,		12.0 },
+	{ "wt tri table 6",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	1320.0,		12.0 },
+	{ "wt tri table 7",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	2640.0,		12.0 },
+	{ "wt tri table 8",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	5280.0,		12.0 },
+	{ "wt tri sine",		RENDER_WAVETABLE,	Oscillator::TRI,	0,	10000.0,	12.0 },
+	{ "wt square table 0",	RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	20.625,		28.0 },
+	{ "wt square table 1",	RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	41.25,		28.0 },
+	{ "wt square table 2",	RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	82.5,		28.0 },
+	{ "wt square table 3",	RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	165.0,		28.0 },
+	{ "wt square table 4",	RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	330.0,		28.0 },
+	{ "wt square table 5",	RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	660.0,		28.0 },
+	{ "wt square table 6",	RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	1320.0,		28.0 },
+	{ "wt square table 7",	RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	2640.0,		28.0 },
+	{ "wt square table 8",	RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	5280.0,		28.0 },
+	{ "wt square sine",		RENDER_WAVETABLE,	Oscillator::SQUARE,	0,	10000.0,	10.0 },
+
+	{ "lfo sine sync",		RENDER_LFO,	Oscillator::sine,	Oscillator::sync,	93.75,	10.0 },
+	{ "lfo sine shot",		RENDER_LFO,	Oscillator::sine,	Oscillator::shot,	93.75,	10.0 },
+	{ "lfo sine free",		RENDER_LFO,	Oscillator::sine,	Oscillator::free,	93.75,	10.0 },
+	{ "lfo usaw sync",		RENDER_LFO,	Oscillator::usaw,	Oscillator::sync,	93.75,	6.0 },
+	{ "lfo usaw shot",		RENDER_LFO,	Oscillator::usaw,	Oscillator::shot,	93.75,	6.0 },
+	{ "lfo usaw free",		RENDER_LFO,	Oscillator::usaw,	Oscillator::free,	93.75,	6.0 },
+	{ "lfo dsaw sync",		RENDER_LFO,	Oscillator::dsaw,	Oscillator::sync,	93.75,	6.0 },
+	{ "lfo dsaw shot",		RENDER_LFO,	Oscillator::dsaw,	Oscillator::shot,	93.75,	6.0 },
+	{ "lfo dsaw free",		RENDER_LFO,	Oscillator::dsaw,	Oscillator::free,	93.75,	6.0 },
+	{ "lfo tri sync",		RENDER_LFO,	Oscillator::tri,	Oscillator::sync,	93.75,	8.0 },
+	{ "lfo tri shot",		RENDER_LFO,	Oscillator::tri,	Oscillator::shot,	93.75,	8.0 },
+	{ "lfo tri free",		RENDER_LFO,	Oscillator::tri,	Oscillator::free,	93.75,	8.0 },
+	{ "lfo square sync",	RENDER_LFO,	Oscillator::square,	Oscillator::sync,	93.75,	8.0 },
+	{ "lfo square shot",	RENDER_LFO,	Oscillator::square,	Oscillator::shot,	93.75,	8.0 },
+	{ "lfo square free",	RENDER_LFO,	Oscillator::square,	Oscillator::free,	93.75,	8.0 },
+	{ "lfo expo sync",		RENDER_LFO,	Oscillator::expo,	Oscillator::sync,	93.75,	24.0 },
+	{ "lfo expo shot",		RENDER_LFO,	Oscillator::expo,	Oscillator::shot,	93.75,	24.0 },
+	{ "lfo expo free",		RENDER_LFO,	Oscillator::expo,	Oscillator::free,	93.75,	24.0 },
+	{ "lfo rsh sync",		RENDER_LFO,	Oscillator::rsh,	Oscillator::sync,	750.0,	8.0 },
+	{ "lfo rsh shot",		RENDER_LFO,	Oscillator::rsh,	Oscillator::shot,	750.0,	8.0 },
+	{ "lfo rsh free",		RENDER_LFO,	Oscillator::rsh,	Oscillator::free,	750.0,	8.0 },
+	{ "lfo qrsh sync",		RENDER_LFO,	Oscillator::qrsh,	Oscillator::sync,	750.0,	8.0 },
+	{ "lfo qrsh shot",		RENDER_LFO,	Oscillator::qrsh,	Oscillator::shot,	750.0,	8.0 },
+	{ "lfo qrsh free",		RENDER_LFO,	Oscillator::qrsh,	Oscillator::free,	750.0,	8.0 },
+};
+
+static const int renderCaseCount = sizeof(renderCases) / sizeof(RenderCase);
+
+//	set up like a voice does for a new note
+static void startCase(Oscillator& osc, const RenderCase& renderCase) {
+	osc.setSampleRate(RENDER_SAMPLE_RATE);
+	osc.setNoiseSeed(RENDER_NOISE_SEED);
+	osc.m_uWaveform = renderCase.uWaveform;
+	osc.m_uLFOMode = renderCase.uLFOMode;
+	osc.setOscFo(renderCase.dFo);
+	osc.startOscillator();
+	osc.update();
+}
+
+template <class T>
+static void renderOscillator(T& osc, float* pBuffer, int nLength) {
+	for (int i = 0; i < nLength; i++) {
+		pBuffer[i] = (float)osc.doOscillate();
+	}
+}
+
+//	renders a case and, when bTime is set, times it: the cost of the
+//	fastest run in ns/sample and in calibration steps
+template <class T>
+static void runCase(const RenderCase& renderCase, float* pBuffer, float* pBenchBuffer, bool bTime,
+	double& dTime_nSec, double& dSteps) {
+	T osc;
+	startCase(osc, renderCase);
+	renderOscillator(osc, pBuffer, RENDER_LENGTH);
+
+	dTime_nSec = 0.0;
+	dSteps = 0.0;
+	if (!bTime) {
+		return;
+	}
+
+	//	a one shot LFO stops after a cycle; time it over one long cycle
+	RenderCase benchCase = renderCase;
+	if (renderCase.nKind == RENDER_LFO && renderCase.uLFOMode == Oscillator::shot) {
+		benchCase.dFo = RENDER_SAMPLE_RATE / RENDER_BENCH_LENGTH;
+	}
+
+	dSteps = 1.0e30;
+	for (int nRun = 0; nRun < TEST_TIMING_RUNS; nRun++) {
+		double dStep_nSec = getCalibrationStep_nSec();
+
+		startCase(osc, benchCase);
+		double dStart = getTestTime_nSec();
+		renderOscillator(osc, pBenchBuffer, RENDER_BENCH_LENGTH);
+		double dTime = (getTestTime_nSec() - dStart) / RENDER_BENCH_LENGTH;
+
+		if (dTime / dStep_nSec < dSteps) {
+			dSteps = dTime / dStep_nSec;
+			dTime_nSec = dTime;
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	bool bUpdate = hasTestOption(argc, argv, "--update");
+	bool bTime = TEST_BUDGETS && !bUpdate && !hasTestOption(argc, argv, "--no-budget");
+
+	static float fRender[renderCaseCount][RENDER_LENGTH];
+	static float fGolden[renderCaseCount][RENDER_LENGTH];
+	static float fBench[RENDER_BENCH_LENGTH];
+
+	//	render everything, timing as we go
+	double dTime_nSec[renderCaseCount];
+	double dSteps[renderCaseCount];
+	for (int i = 0; i < renderCaseCount; i++) {
+		if (renderCases[i].nKind == RENDER_QBLIMITED) {
+			runCase<QBLimitedOscillator>(renderCases[i], fRender[i], fBench, bTime, dTime_nSec[i], dSteps[i]);
+		} else if (renderCases[i].nKind == RENDER_WAVETABLE) {
+			runCase<WTOscillator>(renderCases[i], fRender[i], fBench, bTime, dTime_nSec[i], dSteps[i]);
+		} else {
+			runCase<LFO>(renderCases[i], fRender[i], fBench, bTime, dTime_nSec[i], dSteps[i]);
+		}
+	}
+
+	//	the goldens are one file per kind, the cases in table order
+	int nFailures = 0;
+	for (int nKind = 0; nKind < RENDER_KINDS; nKind++) {
+		int nFirst = 0;
+		int nCount = 0;
+		for (int i = 0; i < renderCaseCount; i++) {
+			if (renderCases[i].nKind == nKind) {
+				if (nCount++ == 0) {
+					nFirst = i;
+				}
+			}
+		}
+
+		if (bUpdate) {
+			if (!writeGoldenFile(renderGoldenFiles[nKind], fRender[nFirst], nCount * RENDER_LENGTH)) {
+				nFailures++;
+			}
+			continue;
+		}
+
+		if (!readGoldenFile(renderGoldenFiles[nKind], fGolden[nFirst], nCount * RENDER_LENGTH)) {
+			nFailures += nCount;
+		}
+	}
+
+	if (bUpdate) {
+		printf("wrote %d cases\n", renderCaseCount);
+		return nFailures ? 1 : 0;
+	}
+
+	for (int i = 0; i < renderCaseCount; i++) {
+		const RenderCase& renderCase = renderCases[i];
+		double dError = getMaxError(fRender[i], fGolden[i], RENDER_LENGTH);
+		bool bSoundOK = dError <= RENDER_TOLERANCE;
+
+		bool bTimeOK = true;
+		if (bTime) {
+			bTimeOK = dSteps[i] <= renderCase.dBudget;
+			printf("%-20s max error %.2e  %6.2f ns/sample (%5.1f of %5.1f steps)%s%s\n", renderCase.pName, dError,
+				dTime_nSec[i], dSteps[i], renderCase.dBudget, bSoundOK ? "" : "  SOUND CHANGED", bTimeOK ? "" : "  OVER BUDGET");
+		} else {
+			printf("%-20s max error %.2e%s\n", renderCase.pName, dError, bSoundOK ? "" : "  SOUND CHANGED");
+		}
+
+		if (!bSoundOK || !bTimeOK) {
+			nFailures++;
+		}
+	}
+
+	printf("%d of %d cases failed\n", nFailures, renderCaseCount);
+	return nFailures ? 1 : 0;
+}
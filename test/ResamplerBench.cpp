@@ -0,0 +1,111 @@
+/*
+	ResamplerBench
+	Cost and quality of each SincResampler tier, the numbers in the
+	SincResampler doc comment: one voice reading a 48kHz sine at a
+	given step, timed per output sample, and the error level of what
+	it reads against the exact sine, in dB below the signal.
+
+	A report, not a test; it is not run by ctest. Build it optimized.
+*/
+#include "TestUtils.h"
+#include "SincResampler.h"
+
+#define RESAMPLER_SAMPLE_RATE 48000.0
+#define RESAMPLER_FRAMES 65536
+#define RESAMPLER_OUTPUT 32768		//	samples read per timed run
+
+//	the sine, with room either side for the longest kernel
+static float resamplerFrames[SINC_RESAMPLER_HISTORY + RESAMPLER_FRAMES + SINC_RESAMPLER_LOOKAHEAD];
+static float resamplerOutput[RESAMPLER_OUTPUT];
+
+static const char* resamplerTierNames[SAMPLE_QUALITIES] = { "LINEAR", "4 POINT", "16 POINT", "64 POINT" };
+
+static void fillSine(double dFrequency) {
+	double dOmega = 2.0 * pi * dFrequency / RESAMPLER_SAMPLE_RATE;
+	for (int i = 0; i < SINC_RESAMPLER_HISTORY + RESAMPLER_FRAMES + SINC_RESAMPLER_LOOKAHEAD; i++) {
+		resamplerFrames[i] = (float)sin(dOmega * (i - SINC_RESAMPLER_HISTORY));
+	}
+}
+
+//	RESAMPLER_OUTPUT samples stepping dReadInc frames; the read stays in the buffer
+static void readSine(SincResampler& resampler, double dReadInc) {
+	const float* pFrames = resamplerFrames + SINC_RESAMPLER_HISTORY;
+	double dPosition = 0.0;
+	for (int n = 0; n < RESAMPLER_OUTPUT; n++) {
+		int nFrame = (int)dPosition;
+		resamplerOutput[n] = (float)resampler.interpolate(pFrames + nFrame, dPosition - nFrame);
+		dPosition += dReadInc;
+		if (dPosition >= RESAMPLER_FRAMES - 1) {
+			dPosition -= RESAMPLER_FRAMES - 1;
+		}
+	}
+}
+
+//	fastest of TEST_TIMING_RUNS, in ns per output sample
+static double timeRead(SincResampler& resampler, double dReadInc) {
+	double dBest = 1.0e30;
+	for (int nRun = 0; nRun < TEST_TIMING_RUNS; nRun++) {
+		double dStart = getTestTime_nSec();
+		readSine(resampler, dReadInc);
+		dBest = fmin(dBest, getTestTime_nSec() - dStart);
+	}
+	return dBest / RESAMPLER_OUTPUT;
+}
+
+//	RMS error against the exact sine at each read position, dB below the sine's RMS
+static double getErrorLevel_dB(double dFrequency, double dReadInc) {
+	double dOmega = 2.0 * pi * dFrequency / RESAMPLER_SAMPLE_RATE;
+	double dSumSquares = 0.0;
+	double dPosition = 0.0;
+	for (int n = 0; n < RESAMPLER_OUTPUT; n++) {
+		double dError = resamplerOutput[n] - sin(dOmega * dPosition);
+		dSumSquares += dError * dError;
+		dPosition += dReadInc;
+		if (dPosition >= RESAMPLER_FRAMES - 1) {
+			dPosition -= RESAMPLER_FRAMES - 1;
+		}
+	}
+	double dRMS = sqrt(dSumSquares / RESAMPLER_OUTPUT);
+	return 20.0 * log10(fmax(dRMS, 1.0e-12) / sqrt(0.5));
+}
+
+static double measureTier(SincResampler& resampler, double dFrequency, double dReadInc, double* pTime_nSec) {
+	fillSine(dFrequency);
+	resampler.setReadIncrement(dReadInc);
+	if (pTime_nSec) {
+		*pTime_nSec = timeRead(resampler, dReadInc);
+	} else {
+		readSine(resampler, dReadInc);
+	}
+	return getErrorLevel_dB(dFrequency, dReadInc);
+}
+
+int main() {
+	double dStep_nSec = 1.0e30;
+	for (int nRun = 0; nRun < TEST_TIMING_RUNS; nRun++) {
+		dStep_nSec = fmin(dStep_nSec, getCalibrationStep_nSec());
+	}
+
+#if !TEST_BUDGETS
+	printf("NOTE: not an optimized build; the times mean little\n");
+#endif
+	printf("calibration step %.3f ns\n\n", dStep_nSec);
+	printf("%-10s %10s %6s %10s %10s %14s\n", "tier", "ns/sample", "steps", "1kHz", "10kHz", "10kHz x1.5");
+
+	SincResampler resampler;
+	for (UINT uQuality = 0; uQuality < SAMPLE_QUALITIES; uQuality++) {
+		resampler.setQuality(uQuality);
+
+		//	the doc comment's case: a little over an octave down
+		double dTime_nSec = 0.0;
+		double dError1k_dB = measureTier(resampler, 1000.0, 0.37, &dTime_nSec);
+		double dError10k_dB = measureTier(resampler, 10000.0, 0.37, 0);
+
+		//	pitched up: the anti-alias band also dulls the top
+		double dErrorUp_dB = measureTier(resampler, 10000.0, 1.5, 0);
+
+		printf("%-10s %10.2f %6.1f %7.0f dB %7.0f dB %11.0f dB\n", resamplerTierNames[uQuality], dTime_nSec,
+			dTime_nSec / dStep_nSec, dError1k_dB, dError10k_dB, dErrorUp_dB);
+	}
+	return 0;
+}
@@ -0,0 +1,278 @@
+/*
+	SynthBench
+	Microbenchmarks for the synthfunctions.h primitives. For each one,
+	over inputs drawn from the range it sees in the synth:
+
+		thru	ns per call with independent inputs (throughput)
+		lat		ns per call when each input waits on the last output
+				(latency, including the feedback printed in the header; a
+				BLEP that is mostly an early out hides under it)
+		steps	thru in calibration steps (TestUtils.h), to compare machines
+		max/rms	error against libm; relative where marked
+
+	A report, not a test; it is not run by ctest. Build it optimized.
+*/
+#include "TestUtils.h"
+#include "synthfunctions.h"
+#include "SynthParamLimits.h"
+
+#define BENCH_INPUTS 4096			//	inputs per pass; small enough to stay in L1
+#define BENCH_PASSES 256			//	passes per timed run
+#define BENCH_ACCURACY_POINTS (1 << 20)
+#define BENCH_SAMPLE_RATE 48000.0
+
+//	the same inputs on every run
+static unsigned int benchRandom = 0x2545F491;
+
+static double getBenchRandom() {
+	benchRandom = benchRandom * 1664525 + 1013904223;
+	return (double)benchRandom / 4294967296.0;
+}
+
+static double getUniform(double dMin, double dMax) {
+	return dMin + (dMax - dMin) * getBenchRandom();
+}
+
+static double getLogUniform(double dMin, double dMax) {
+	return dMin * pow(dMax / dMin, getBenchRandom());
+}
+
+static double benchInputs[BENCH_INPUTS];
+static double benchInputs2[BENCH_INPUTS];
+static volatile double benchSink = 0.0;
+
+//	the phases of an oscillator at dFo, which is what the BLEPs are fed
+static void fillPhases(double* pInputs, double dFo) {
+	double dInc = dFo / BENCH_SAMPLE_RATE;
+	double dModulo = 0.0;
+	for (int i = 0; i < BENCH_INPUTS; i++) {
+		pInputs[i] = dModulo;
+		dModulo += dInc;
+		if (dModulo >= 1.0) {
+			dModulo -= 1.0;
+		}
+	}
+}
+
+//	fastest of TEST_TIMING_RUNS, in ns per call
+template <class F>
+static double timeThroughput(F function) {
+	double dBest = 1.0e30;
+	for (int nRun = 0; nRun < TEST_TIMING_RUNS; nRun++) {
+		double dSum = 0.0;
+		double dStart = getTestTime_nSec();
+		for (int nPass = 0; nPass < BENCH_PASSES; nPass++) {
+			for (int i = 0; i < BENCH_INPUTS; i++) {
+				dSum += function(benchInputs[i], benchInputs2[i]);
+			}
+		}
+		double dTime = getTestTime_nSec() - dStart;
+		benchSink = dSum;
+		if (dTime < dBest) {
+			dBest = dTime;
+		}
+	}
+	return dBest / ((double)BENCH_PASSES * BENCH_INPUTS);
+}
+
+//	each input depends on the last output through "+ y * 0.0", which the
+//	compiler may not fold (y could be NaN)
+template <class F>
+static double timeLatency(F function) {
+	double dBest = 1.0e30;
+	for (int nRun = 0; nRun < TEST_TIMING_RUNS; nRun++) {
+		double y = 0.0;
+		double dStart = getTestTime_nSec();
+		for (int nPass = 0; nPass < BENCH_PASSES; nPass++) {
+			for (int i = 0; i < BENCH_INPUTS; i++) {
+				y = function(benchInputs[i] + y * 0.0, benchInputs2[i]);
+			}
+		}
+		double dTime = getTestTime_nSec() - dStart;
+		benchSink = y;
+		if (dTime < dBest) {
+			dBest = dTime;
+		}
+	}
+	return dBest / ((double)BENCH_PASSES * BENCH_INPUTS);
+}
+
+//	max and RMS error against the reference over BENCH_ACCURACY_POINTS
+//	fresh inputs; relative to the reference when bRelative is set
+template <class F, class R, class G>
+static void measureAccuracy(F function, R reference, G generator, bool bRelative, double& dMaxError, double& dRMSError) {
+	double dSumSquares = 0.0;
+	dMaxError = 0.0;
+	for (int i = 0; i < BENCH_ACCURACY_POINTS; i++) {
+		double x = 0.0;
+		double x2 = 0.0;
+		generator(x, x2);
+
+		double dRef = reference(x, x2);
+		double dError = fabs(function(x, x2) - dRef);
+		if (bRelative && dRef != 0.0) {
+			dError /= fabs(dRef);
+		}
+		dSumSquares += dError * dError;
+		if (dError > dMaxError) {
+			dMaxError = dError;
+		}
+	}
+	dRMSError = sqrt(dSumSquares / BENCH_ACCURACY_POINTS);
+}
+
+static double benchStep_nSec = 1.0;
+static double benchFeedback_nSec = 0.0;
+
+static void printRow(const char* pName, const char* pRange, double dThroughput, double dLatency) {
+	printf("%-32s %-14s %7.2f %7.2f %6.1f", pName, pRange, dThroughput, dLatency, dThroughput / benchStep_nSec);
+}
+
+//	a primitive with no libm counterpart
+template <class F, class G>
+static void benchFunction(const char* pName, const char* pRange, F function, G generator) {
+	for (int i = 0; i < BENCH_INPUTS; i++) {
+		generator(benchInputs[i], benchInputs2[i]);
+	}
+	printRow(pName, pRange, timeThroughput(function), timeLatency(function));
+	printf("        -          -\n");
+}
+
+template <class F, class R, class G>
+static void benchFunction(const char* pName, const char* pRange, F function, R reference, G generator, bool bRelative) {
+	for (int i = 0; i < BENCH_INPUTS; i++) {
+		generator(benchInputs[i], benchInputs2[i]);
+	}
+	double dThroughput = timeThroughput(function);
+	double dLatency = timeLatency(function);
+
+	double dMaxError = 0.0;
+	double dRMSError = 0.0;
+	measureAccuracy(function, reference, generator, bRelative, dMaxError, dRMSError);
+
+	printRow(pName, pRange, dThroughput, dLatency);
+	printf(" %9.2e  %9.2e%s\n", dMaxError, dRMSError, bRelative ? " rel" : "");
+}
+
+//	the BLEPs at an oscillator pitch; the work is only near the edges, so
+//	the pitch sets the cost
+template <class F>
+static void benchBLEP(const char* pName, double dFo, F function) {
+	char szRange[32];
+	snprintf(szRange, sizeof(szRange), "%g Hz", dFo);
+	fillPhases(benchInputs, dFo);
+	for (int i = 0; i < BENCH_INPUTS; i++) {
+		benchInputs2[i] = dFo / BENCH_SAMPLE_RATE;
+	}
+	printRow(pName, szRange, timeThroughput(function), timeLatency(function));
+	printf("        -          -\n");
+}
+
+int main() {
+	benchStep_nSec = 1.0e30;
+	for (int nRun = 0; nRun < TEST_TIMING_RUNS; nRun++) {
+		benchStep_nSec = fmin(benchStep_nSec, getCalibrationStep_nSec());
+	}
+
+	//	the cost of the latency loop's own feedback
+	for (int i = 0; i < BENCH_INPUTS; i++) {
+		benchInputs[i] = getBenchRandom();
+		benchInputs2[i] = 0.0;
+	}
+	benchFeedback_nSec = timeLatency([](double x, double) { return x; });
+
+#if !TEST_BUDGETS
+	printf("NOTE: not an optimized build; the times mean little\n");
+#endif
+	printf("calibration step %.3f ns, latency feedback %.3f ns\n\n", benchStep_nSec, benchFeedback_nSec);
+	printf("%-32s %-14s %7s %7s %6s %10s %10s\n", "primitive", "inputs", "thru", "lat", "steps", "max err", "rms err");
+
+	//	oscillator and LFO sines
+	benchFunction("parabolicSine", "-pi..pi",
+		[](double x, double) { return parabolicSine(x); },
+		[](double x, double) { return sin(x); },
+		[](double& x, double&) { x = getUniform(-pi, pi); }, false);
+	benchFunction("parabolicSine (low precision)", "-pi..pi",
+		[](double x, double) { return parabolicSine(x, false); },
+		[](double x, double) { return sin(x); },
+		[](double& x, double&) { x = getUniform(-pi, pi); }, false);
+	benchFunction("BhaskaraISine", "-pi..pi",
+		[](double x, double) { return BhaskaraISine(x); },
+		[](double x, double) { return sin(x); },
+		[](double& x, double&) { x = getUniform(-pi, pi); }, false);
+
+	//	pitch; the modulation range is +/-2 octaves
+	benchFunction("pitchShiftMultiplier", "-24..24 st",
+		[](double x, double) { return pitchShiftMultiplier(x); },
+		[](double x, double) { return pow(2.0, x / 12.0); },
+		[](double& x, double&) { x = getUniform(-24.0, 24.0); }, true);
+	benchFunction("fastPow(2, x)", "-1..1",
+		[](double x, double) { return fastPow(2.0, x); },
+		[](double x, double) { return pow(2.0, x); },
+		[](double& x, double&) { x = getUniform(-1.0, 1.0); }, true);
+	benchFunction("fastpow2", "-10..10",
+		[](double x, double) { return (double)fastpow2((float)x); },
+		[](double x, double) { return pow(2.0, (double)(float)x); },
+		[](double& x, double&) { x = getUniform(-10.0, 10.0); }, true);
+	benchFunction("fastlog2", "0.01..100 log",
+		[](double x, double) { return (double)fastlog2((float)x); },
+		[](double x, double) { return log((double)(float)x) / log(2.0); },
+		[](double& x, double&) { x = getLogUniform(0.01, 100.0); }, false);
+
+	//	filter cutoff: a log-placed control, modulated over the whole range
+	benchFunction("calcModulatedValueVoltOctaveExp", "80..18k, +/-1",
+		[](double x, double x2) { return calcModulatedValueVoltOctaveExp(MIN_FILTER_FC, MAX_FILTER_FC, x, x2, true); },
+		[](double x, double x2) {
+			double dOctaves = log(MAX_FILTER_FC / MIN_FILTER_FC) / log(2.0);
+			double dOffset = log(x / MIN_FILTER_FC) / log(2.0) / dOctaves - 0.5;
+			double dValue = MIN_FILTER_FC * pow(2.0, dOffset * dOctaves) * pow(2.0, bipolarToUnipolar(x2) * dOctaves);
+			return fmax(fmin(dValue, MAX_FILTER_FC), MIN_FILTER_FC);
+		},
+		[](double& x, double& x2) { x = getLogUniform(MIN_FILTER_FC, MAX_FILTER_FC); x2 = getUniform(-1.0, 1.0); }, true);
+
+	//	saturation
+	benchFunction("tanh_table", "-1..1",
+		[](double x, double) { return tanh_table(x); },
+		[](double x, double) { return tanh(x); },
+		[](double& x, double&) { x = getUniform(-1.0, 1.0); }, false);
+	benchFunction("fasttanh", "-3..3",
+		[](double x, double) { return (double)fasttanh((float)x); },
+		[](double x, double) { return tanh(x); },
+		[](double& x, double&) { x = getUniform(-3.0, 3.0); }, false);
+
+	//	EG and LFO shapes; these call libm, so they have no error of their own
+	benchFunction("convexTransform", "0..1",
+		[](double x, double) { return convexTransform(x); },
+		[](double& x, double&) { x = getBenchRandom(); });
+	benchFunction("concaveTransform", "0..1",
+		[](double x, double) { return concaveTransform(x); },
+		[](double& x, double&) { x = getBenchRandom(); });
+	benchFunction("concaveInvertedTransform", "0..1",
+		[](double x, double) { return concaveInvertedTransform(x); },
+		[](double& x, double&) { x = getBenchRandom(); });
+	benchFunction("capChargeTransform", "0..1",
+		[](double x, double) { return capChargeTransform(x); },
+		[](double& x, double&) { x = getBenchRandom(); });
+	benchFunction("linearIn_dB_DecayTransform", "0..1",
+		[](double x, double) { return linearIn_dB_DecayTransform(x); },
+		[](double& x, double&) { x = getBenchRandom(); });
+
+	//	noise; the register is the state, so the input is the register
+	benchFunction("doPNSequence", "register",
+		[](double x, double) { UINT uRegister = (UINT)x; return doPNSequence(uRegister); },
+		[](double& x, double&) { x = (double)(UINT)(getBenchRandom() * 4294967295.0); });
+
+	//	BLEP residuals, as QBLimitedOscillator calls them
+	benchBLEP("doPolyBLEP_2", 220.0,
+		[](double x, double dInc) { return doPolyBLEP_2(x, dInc, 1.0, false); });
+	benchBLEP("doPolyBLEP_2", 8000.0,
+		[](double x, double dInc) { return doPolyBLEP_2(x, dInc, 1.0, false); });
+	benchBLEP("doBLEP_N 8 point", 220.0,
+		[](double x, double dInc) { return doBLEP_N(&dBLEPTable_8_BLKHAR[0], 4096, x, dInc, 1.0, false, 4, false); });
+	benchBLEP("doBLEP_N 8 point", 2000.0,
+		[](double x, double dInc) { return doBLEP_N(&dBLEPTable_8_BLKHAR[0], 4096, x, dInc, 1.0, false, 4, false); });
+	benchBLEP("doBLEP_N 2 point", 8000.0,
+		[](double x, double dInc) { return doBLEP_N(&dBLEPTable[0], 4096, x, dInc, 1.0, false, 1, true); });
+
+	return 0;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+//	where the reference renders live; set by test/CMakeLists.txt
+#ifndef NANOSYNTH_TEST_DATA_DIR
+#define NANOSYNTH_TEST_DATA_DIR "."
+#endif
+
+//	timing is only meaningful in an optimized build
+#if defined NDEBUG
+#define TEST_BUDGETS 1
+#else
+#define TEST_BUDGETS 0
+#endif
+
+//	repeats of a timed run; the fastest one is taken, so the OS and the
+//	other processes only ever make a run slower
+#define TEST_TIMING_RUNS 7
+
+#define TEST_CALIBRATION_STEPS (1 << 16)
+
+inline double getTestTime_nSec() {
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+	getCalibrationStep_nSec()
+	ns per step of a dependent multiply-add chain, over nSteps steps. It
+	runs at the machine's clock with nothing to hide the latency, so
+	budgets given as a multiple of it hold on faster and slower machines
+	alike. Timing one right before each timed run also cancels a machine
+	that changes speed between runs (turbo, a busy neighbour core).
+*/
+inline double getCalibrationStep_nSec(int nSteps = TEST_CALIBRATION_STEPS) {
+	static volatile double dSeed = 0.5;
+	volatile double dSink = 0.0;
+
+	double x = dSeed;
+	double dStart = getTestTime_nSec();
+	for (int i = 0; i < nSteps; i++) {
+		x = x * 0.999999 + 0.000001;
+	}
+	double dTime = getTestTime_nSec() - dStart;
+	dSink = x;
+	(void)dSink;
+
+	return dTime / nSteps;
+}
+
+//	true for "--name" anywhere on the command line
+inline bool hasTestOption(int argc, char** argv, const char* pOption) {
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], pOption) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//	reference renders are raw little endian floats, one case after another
+inline bool readGoldenFile(const char* pName, float* pBuffer, int nLength) {
+	char szPath[1024];
+	snprintf(szPath, sizeof(szPath), "%s/golden/%s", NANOSYNTH_TEST_DATA_DIR, pName);
+
+	FILE* pFile = fopen(szPath, "rb");
+	if (!pFile) {
+		printf("missing %s (run with --update to create it)\n", szPath);
+		return false;
+	}
+	bool bSuccess = fread(pBuffer, sizeof(float), nLength, pFile) == (size_t)nLength;
+	fclose(pFile);
+	if (!bSuccess) {
+		printf("short %s (run with --update after adding cases)\n", szPath);
+	}
+	return bSuccess;
+}
+
+inline bool writeGoldenFile(const char* pName, const float* pBuffer, int nLength) {
+	char szPath[1024];
+	snprintf(szPath, sizeof(szPath), "%s/golden/%s", NANOSYNTH_TEST_DATA_DIR, pName);
+
+	FILE* pFile = fopen(szPath, "wb");
+	if (!pFile) {
+		printf("cannot write %s\n", szPath);
+		return false;
+	}
+	bool bSuccess = fwrite(pBuffer, sizeof(float), nLength, pFile) == (size_t)nLength;
+	bSuccess = fclose(pFile) == 0 && bSuccess;
+	return bSuccess;
+}
+
+//	largest absolute difference; NaN in either counts as a full scale miss
+inline double getMaxError(const float* pA, const float* pB, int nLength) {
+	double dMaxError = 0.0;
+	for (int i = 0; i < nLength; i++) {
+		double dError = fabs((double)pA[i] - (double)pB[i]);
+		if (dError != dError) {
+			dError = 1.0e30;
+		}
+		if (dError > dMaxError) {
+			dMaxError = dError;
+		}
+	}
+	return dMaxError;
+}